@@ -42,6 +42,15 @@ typedef enum error_t {
     /// Erreur de cas dans un if ou un switch (default alors que ça ne devrait pas)
     ERROR_HANDLE,
 
+    /// Données lues invalides (ex: entête de conteneur absent ou corrompu)
+    ERROR_FORMAT,
+
+    /// Somme de contrôle d'un bloc du message invalide
+    ERROR_CHECKSUM,
+
+    /// Tag d'authentification du message invalide
+    ERROR_AUTHENTIFICATION,
+
 
     /// Nombre total d'erreur de la liste. Pas un véritable code d'erreur
     ERROR_COUNT,
@@ -59,11 +68,860 @@ const char* const ERROR_STRS[] =
                 "ERROR_INVARG: Problème d'argument passés.",
                 "ERROR_NOMEM: Impossible d'assigner la mémoire.",
                 "ERROR_OPEN: Impossible d'ouvrir le fichier.",
-                "ERROR_HANDLE: Erreur de cas dans un if ou un switch."
+                "ERROR_HANDLE: Erreur de cas dans un if ou un switch.",
+                "ERROR_FORMAT: Données invalides ou corrompues.",
+                "ERROR_CHECKSUM: Somme de contrôle invalide (mauvaise clé ou image modifiée).",
+                "ERROR_AUTHENTIFICATION: Message non authentique (mauvaise clé ou message modifié)."
         };
 
 
 
+/** \enum modeInsertion_t header.h
+ *  \brief Liste les méthodes d'insertion/de lecture du message dans l'image.
+ *
+ *  Les valeurs correspondent aux choix proposés à l'utilisateur dans les menus de cryptage et de décryptage.
+ */
+typedef enum modeInsertion_t {
+    /// Insertion classique: pixel par pixel
+    MODE_CLASSIQUE = 1,
+
+    /// Insertion chiffrée: parcours pseudo aléatoire des pixels déterminé par une clé
+    MODE_CHIFFRE,
+
+    /// Insertion par syndrome de Hamming
+    MODE_HAMMING,
+
+    /// Insertion chiffrée dont le parcours se calcule position par position (réseau de Feistel), sans table
+    MODE_CHIFFRE_CALCULABLE,
+
+    /// Insertion de k bits de poids faible par pixel (k de 1 à 4, éventuellement différent pour chaque canal)
+    MODE_KLSB,
+
+    /// Insertion par code syndrome-treillis (STC): nombre de modifications quasi minimal quelle que soit la taille du message
+    MODE_STC,
+
+    /// Insertion par code de Hamming ternaire: le sens de la modification (+1 ou -1) porte aussi de l'information
+    MODE_TERNAIRE,
+
+    /// Insertion par LSB matching revisited: 2 bits par paire de pixels, 0,375 modification par bit
+    MODE_LSBMR,
+
+    /// Insertion de Hamming dont les blocs sont pris dans le parcours calculable d'une clé (voir parcoursCalculable_t)
+    MODE_HAMMING_CHIFFRE,
+
+    /// Insertion classique ou de Hamming limitée aux pixels des zones texturées (voir calculerCoutsAdaptatifs)
+    MODE_ADAPTATIF,
+} modeInsertion_t;
+
+
+/// Nombre maximal de bits de poids faible utilisés par pixel en mode MODE_KLSB
+#define K_MAX_KLSB 4
+
+/// Nombre de bits du message représentés par une unité du prefixe en mode MODE_KLSB (le prefixe ne peut pas dépasser la taille de l'image)
+#define BITS_UNITE_PREFIXE_KLSB 4
+
+
+/// Bit de l'octet parametre indiquant un découpage de Hamming en deux segments (mode MODE_HAMMING), voir determineSegmentsHamming
+#define HAMMING_SEGMENTE 0x80u
+
+/// Nombre maximal de lignes d'une matrice de Hamming choisie par determineSegmentsHamming (2^16 - 1 colonnes)
+#define LIGNES_MAX_HAMMING 16
+
+
+/// Coût maximal d'un pixel en mode MODE_ADAPTATIF (zone uniforme, bords de l'image)
+#define COUT_MAX_ADAPTATIF 127
+
+/// Nombre de valeurs de coût possibles en mode MODE_ADAPTATIF
+#define NB_COUTS_ADAPTATIFS (COUT_MAX_ADAPTATIF + 1)
+
+
+/// Hauteur de la sous-matrice STC utilisée à l'insertion (2^HAUTEUR_STC états dans le treillis)
+#define HAUTEUR_STC 7
+
+/// Hauteur minimale de la sous-matrice STC
+#define HAUTEUR_STC_MIN 2
+
+/// Hauteur maximale de la sous-matrice STC
+#define HAUTEUR_STC_MAX 10
+
+
+/// Nombre minimal de trits par bloc du code de Hamming ternaire (4 pixels par bloc)
+#define TRITS_MIN_TERNAIRE 2
+
+/// Nombre maximal de trits par bloc du code de Hamming ternaire (1093 pixels par bloc)
+#define TRITS_MAX_TERNAIRE 7
+
+/// Nombre de bits du message regroupés pour être convertis en trits (2^11 <= 3^7)
+#define BITS_GROUPE_TERNAIRE 11
+
+/// Nombre de trits qui représentent un groupe de BITS_GROUPE_TERNAIRE bits
+#define TRITS_GROUPE_TERNAIRE 7
+
+
+/// Taille du tampon d'écriture utilisé par le décodage fusionné (en octets)
+#define TAILLE_TAMPON_FLUX 65536
+
+/// Taille en octets du suffixe d'extension ajouté par addExtensionSuffix
+#define TAILLE_SUFFIXE_EXTENSION 5
+
+/// Taille maximale d'une ligne de l'entête d'un PAM (P7)
+#define TAILLE_LIGNE_PAM 256
+
+/// Taille maximale du TUPLTYPE d'un PAM, '\0' compris
+#define TAILLE_TUPLTYPE_PAM 64
+
+/// Nombre maximal de composantes qu'un masque de canaux peut sélectionner
+#define CANAUX_MAX 8
+
+/// Longueur maximale d'une ligne de pixels écrite dans un P2/P3
+#define LONGUEUR_LIGNE_ASCII 70
+
+/// Taille minimale des entêtes d'un BMP: BITMAPFILEHEADER (14 octets) et BITMAPINFOHEADER (40 octets)
+#define TAILLE_ENTETE_BMP 54
+
+/// Nombre d'octets lus dans le chunk fmt d'un WAV (WAVEFORMATEXTENSIBLE, jusqu'au début du GUID du sous-format)
+#define TAILLE_FORMAT_WAV 26
+
+/// Signature des 8 premiers octets d'un PNG
+#define SIGNATURE_PNG "\x89PNG\r\n\x1a\n"
+
+
+/// Signature placée au début de l'entête du conteneur
+#define MAGIC_CONTENEUR "STG"
+
+/// Version du format de l'entête du conteneur
+#define VERSION_CONTENEUR 1
+
+/// Taille en octets de la partie fixe de l'entête du conteneur (signature comprise)
+#define TAILLE_ENTETE_FIXE 15
+
+/// Taille maximale du nom de fichier enregistré dans l'entête du conteneur
+#define TAILLE_NOM_CONTENEUR 255
+
+/// Indicateur de l'entête: le message est un fichier (sinon un texte)
+#define FLAG_CONTENEUR_FICHIER 0x0001u
+
+/// Indicateur de l'entête: une table de CRC32C (un par bloc du message) précède le message
+#define FLAG_CONTENEUR_CRC 0x0002u
+
+/// Indicateur de l'entête: le message a été compressé par compresserCharge avant l'insertion
+#define FLAG_CONTENEUR_COMPRESSE 0x0004u
+
+/// Indicateur de l'entête: le message a été chiffré par chiffrerCharge (ChaCha20-Poly1305) avant l'insertion
+#define FLAG_CONTENEUR_CHIFFRE 0x0008u
+
+/// Indicateur de l'entête: l'image ne contient qu'un fragment du message, réparti sur plusieurs images par repartirCharge
+#define FLAG_CONTENEUR_FRAGMENT 0x0010u
+
+/// Taille en octets de la description du fragment qui suit le nom si FLAG_CONTENEUR_FRAGMENT est présent
+#define TAILLE_FRAGMENT_CONTENEUR 16
+
+/// Indicateur de l'entête: le message est une archive de plusieurs fichiers précédée de son index (voir construireArchive)
+#define FLAG_CONTENEUR_ARCHIVE 0x0020u
+
+/// Taille en octets d'une entrée de l'index d'une archive, hors nom
+#define TAILLE_ENTREE_ARCHIVE 14
+
+/// Nombre maximal de fichiers dans une archive
+#define NB_ENTREES_ARCHIVE_MAX 65535
+
+/// Taille maximale en octets de l'entête du conteneur
+#define TAILLE_ENTETE_MAX (TAILLE_ENTETE_FIXE + TAILLE_NOM_CONTENEUR + TAILLE_FRAGMENT_CONTENEUR)
+
+/// Indicateurs de l'entête: composantes qui contiennent le message (bit c pour la composante c, soit rouge, vert, bleu pour un P6; 0 pour toutes les composantes)
+#define MASQUE_CANAUX_CONTENEUR 0xFF00u
+
+/// Position du masque des canaux dans les indicateurs de l'entête
+#define DECALAGE_CANAUX_CONTENEUR 8
+
+/// Taille par défaut d'un bloc vérifié par CRC32C (log2, soit 4096 octets)
+#define LOG2_BLOC_CRC 12
+
+/// Taille maximale d'un bloc vérifié par CRC32C (log2): un bloc doit tenir dans le tampon du flux de sortie
+#define LOG2_BLOC_CRC_MAX 16
+
+/// Nombre maximal de threads utilisés pour la vérification des blocs
+#define NB_THREADS_VERIFICATION_MAX 16
+
+/// Nombre maximal de threads utilisés pour insérer ou extraire les fragments d'un message réparti
+#define NB_THREADS_REPARTITION_MAX 16
+
+/// Nombre maximal d'images sur lesquelles un message peut être réparti
+#define NB_FRAGMENTS_MAX 65535
+
+/// Taille de la table de hachage du compresseur LZ (log2 du nombre d'entrées)
+#define LOG2_TABLE_LZ 14
+
+/// Longueur minimale d'une répétition encodée par le compresseur LZ
+#define LONGUEUR_MIN_LZ 4
+
+/// Distance maximale d'une répétition (la distance est codée sur 2 octets)
+#define DISTANCE_MAX_LZ 65535
+
+/// Taille de l'échantillon compressé pour estimer si un gros message est compressible
+#define TAILLE_ECHANTILLON_LZ 65536
+
+/// Taille d'une empreinte SHA-256 en octets
+#define TAILLE_SHA256 32
+
+/// Taille de la clé ChaCha20 en octets
+#define TAILLE_CLE_AEAD 32
+
+/// Taille du sel de dérivation de la clé en octets
+#define TAILLE_SEL_AEAD 16
+
+/// Taille du nonce ChaCha20 en octets
+#define TAILLE_NONCE_AEAD 12
+
+/// Taille du tag Poly1305 en octets
+#define TAILLE_TAG_AEAD 16
+
+/// Octets ajoutés au message par chiffrerCharge: sel | nonce | chiffré | tag
+#define TAILLE_SURCOUT_AEAD (TAILLE_SEL_AEAD + TAILLE_NONCE_AEAD + TAILLE_TAG_AEAD)
+
+/// Nombre d'itérations de PBKDF2-HMAC-SHA256 pour dériver la clé à partir du mot de passe
+#define ITERATIONS_PBKDF2 100000
+
+/// Schéma de permutation de l'entête: aucune permutation des bits du message
+#define PERMUTATION_AUCUNE 0
+
+/// Schéma de permutation de l'entête: bits du message permutés par permuterTableau
+#define PERMUTATION_TABLEAU 1
+
+
+/** \struct enteteConteneur_t header.h
+ *  \brief Entête auto-descriptif caché juste après le prefixe de taille.
+ *
+ *  L'entête est toujours inséré de manière classique (pixel par pixel) à partir de la fin du prefixe, puis le message est inséré juste après avec la méthode choisie.
+ *  Il permet au décodage de connaitre la méthode, les paramètres de Hamming, la permutation, la taille et le nom du message sans rien demander à l'utilisateur (hors clés). \n
+ *  Le paramètre vaut le nombre de lignes de la matrice de Hamming (MODE_HAMMING) les bits par canal (MODE_KLSB, voir encoderBitsParCanal), la hauteur de la sous-matrice (MODE_STC) ou le nombre de trits par bloc (MODE_TERNAIRE). \n
+ *  Format (octets, big-endian): "STG" | version | mode | paramètre | permutation | indicateurs (2) | longueur du message (4) | taille des blocs CRC (log2) | longueur du nom | nom.
+ *  \n Si FLAG_CONTENEUR_COMPRESSE est présent, le message inséré est la version compressée (compresserCharge) et la longueur est celle du message compressé.
+ *  \n Si FLAG_CONTENEUR_CHIFFRE est présent, le message inséré est chiffré et authentifié (chiffrerCharge), après l'éventuelle compression. Le tag authentifie aussi l'entête sérialisé, ou celui du message complet pour un fragment (voir enteteMessage).
+ *  \n Si FLAG_CONTENEUR_CRC est présent, le flux inséré commence par la table des CRC32C (4 octets par bloc) suivie du message.
+ *  \n Si MASQUE_CANAUX_CONTENEUR n'est pas nul, le flux n'est inséré que dans les canaux indiqués (voir extraireVueCanaux), le prefixe et l'entête utilisent toujours tous les canaux.
+ *  \n Si FLAG_CONTENEUR_FRAGMENT est présent, le nom est suivi de: numéro du fragment (2) | nombre de fragments (2) | position du fragment dans le message (4) | taille du message complet (4) | CRC32C du message complet (4). La longueur du message est alors celle du fragment.
+ *  \n Si FLAG_CONTENEUR_ARCHIVE est présent, le message commence par l'index de l'archive: nombre de fichiers (2) puis pour chaque fichier longueur du nom | nom | indicateurs (FLAG_CONTENEUR_COMPRESSE et FLAG_CONTENEUR_CHIFFRE, 1) | position dans le message (4) | taille (4) | CRC32C du fichier inséré (4). Les fichiers suivent l'index, chacun compressé et chiffré séparément.
+ *
+ *  \see serialiserEnteteConteneur
+ *  \see lireEnteteConteneur
+ */
+typedef struct enteteConteneur_t {
+    /// Version du format (VERSION_CONTENEUR)
+    unsigned char version;
+    /// Méthode d'insertion du message (modeInsertion_t)
+    unsigned char mode;
+    /// Paramètre de la méthode: nombre de lignes de la matrice de Hamming, bits par canal en k-LSB, hauteur STC ou trits par bloc (0 si inutilisé)
+    unsigned char parametre;
+    /// Schéma de permutation des bits du message (PERMUTATION_AUCUNE ou PERMUTATION_TABLEAU)
+    unsigned char permutation;
+    /// Taille des blocs vérifiés par CRC32C (log2, 0 si FLAG_CONTENEUR_CRC est absent)
+    unsigned char blocCrc;
+    /// Indicateurs (FLAG_CONTENEUR_*)
+    unsigned int flags;
+    /// Taille du message en octets
+    unsigned long longueurCharge;
+    /// Nom du fichier caché (chaine vide pour un texte)
+    char nom[TAILLE_NOM_CONTENEUR + 1];
+    /// Numéro du fragment, à partir de 0 (FLAG_CONTENEUR_FRAGMENT)
+    unsigned int indexFragment;
+    /// Nombre de fragments du message (FLAG_CONTENEUR_FRAGMENT)
+    unsigned int nbFragments;
+    /// Position du fragment dans le message complet, en octets (FLAG_CONTENEUR_FRAGMENT)
+    unsigned long debutFragment;
+    /// Taille du message complet (FLAG_CONTENEUR_FRAGMENT)
+    unsigned long longueurTotale;
+    /// CRC32C du message complet: identifie les fragments d'un même message et vérifie leur assemblage (FLAG_CONTENEUR_FRAGMENT)
+    unsigned int crcTotal;
+} enteteConteneur_t;
+
+
+/// Taille d'une page du cache de lecture partielle (en octets, i.e en pixels)
+#define TAILLE_PAGE_CACHE 4096
+
+/// Nombre de pages gardées en mémoire par le cache de lecture partielle
+#define NB_PAGES_CACHE 16
+
+
+/** \struct sourceImage_t header.h
+ *  \brief Accès aux pixels d'une image, soit depuis un tableau en mémoire, soit directement dans le fichier.
+ *
+ *  Dans le second cas, seules les pages de TAILLE_PAGE_CACHE octets contenant les pixels demandés sont lues (avec pread), ce qui permet de ne lire que le prefixe et la partie de l'image qui contient le message.
+ *
+ *  \see ouvrirSourceImage
+ *  \see lireEchantillon
+ */
+typedef struct sourceImage_t {
+    /// Tableau de pixels si l'image est en mémoire, NULL si on lit dans le fichier
+    const int *matriceImage;
+    /// Descripteur du fichier image (-1 si l'image est en mémoire)
+    int descripteur;
+    /// Position du premier pixel dans le fichier
+    long int beginningImage;
+    /// Nombre de pixels de l'image
+    long int dimension;
+    /// Pages en cache, NB_PAGES_CACHE * TAILLE_PAGE_CACHE octets
+    unsigned char *pages;
+    /// Numéro de la page présente dans chaque emplacement du cache (-1 si vide)
+    long int numeroPage[NB_PAGES_CACHE];
+    /// Nombre d'octets lus dans le fichier depuis l'ouverture
+    long int octetsLus;
+    /// Masque des canaux lus (0 si tous les pixels sont lus), voir vueCanauxSource
+    unsigned int masqueCanaux;
+    /// Nombre de canaux lus par pixel (0 si tous les pixels sont lus)
+    int nbCanauxVue;
+    /// Canaux lus, dans l'ordre croissant
+    int canauxVue[CANAUX_MAX];
+    /// Nombre d'échantillons par ligne de l'image (0 si inconnu), voir geometrieSource
+    long int largeurLigne;
+    /// Nombre d'échantillons par pixel (1 pour P2/P5, 3 pour P3/P6, DEPTH pour P7)
+    int nbCanaux;
+    /// Pixels décodés par ouvrirSourceFormat, libérés par fermerSourceImage (NULL sinon)
+    int *matriceAllouee;
+    /// Échantillons d'un PNG décodés par ouvrirSourceFormat, un octet chacun, libérés par fermerSourceImage (NULL sinon)
+    unsigned char *octetsImage;
+    /// Octets d'une ligne dans le fichier, bourrage compris (0 si les lignes sont contiguës), voir pasLigneFormat
+    long int pasLigne;
+    /// Octets d'un échantillon dans le fichier (1, ou 2 et 3 pour un WAV 16 et 24 bits), voir octetsEchantillonFormat
+    int octetsEchantillon;
+} sourceImage_t;
+
+
+/// Nombre d'emplacements de la file de trames: lecture, insertion et écriture avancent en parallèle sur des trames différentes
+#define NB_TRAMES_FILE 4
+
+/// Nombre maximal de plans d'une trame (Y, Cb et Cr pour un Y4M, un seul plan pour un PNM)
+#define PLANS_MAX_FLUX 3
+
+/// Taille maximale de la ligne d'entête d'un flux Y4M (et des paramètres d'une trame)
+#define TAILLE_ENTETE_Y4M 256
+
+/// Largeur et hauteur maximales d'une vidéo Y4M
+#define DIMENSION_MAX_Y4M 65536
+
+
+/** \struct formatFlux_t header.h
+ *  \brief Format d'un flux de trames: PNM concaténés ou vidéo YUV4MPEG2 (Y4M) 8 bits.
+ *
+ *  Un Y4M commence par une ligne d'entête (géométrie et sous-échantillonnage de la chrominance) commune à toutes les trames, chaque trame contient ensuite les plans Y, Cb et Cr à la suite.
+ *
+ *  \see ouvrirFlux
+ */
+typedef struct formatFlux_t {
+    /// Vaut 1 pour un flux Y4M, 0 pour des PNM concaténés
+    int y4m;
+    /// Ligne d'entête du Y4M, sans le retour à la ligne (recopiée telle quelle dans le flux créé)
+    char enteteY4M[TAILLE_ENTETE_Y4M];
+    /// Largeur des trames Y4M
+    long int largeur;
+    /// Hauteur des trames Y4M
+    long int hauteur;
+    /// Nombre de plans des trames Y4M (1 pour mono, 3 sinon)
+    int nbPlans;
+    /// Nombre d'échantillons de chaque plan des trames Y4M
+    long int taillePlans[PLANS_MAX_FLUX];
+} formatFlux_t;
+
+
+/** \struct trameFlux_t header.h
+ *  \brief Une trame (P5 ou P6 8 bits, ou trame Y4M) d'un flux de trames.
+ *
+ *  Les plans sont stockés à la suite dans pixels: une vue sur certains plans (voir copierVueTrame) les parcourt en place.
+ *
+ *  \see lireTrame
+ */
+typedef struct trameFlux_t {
+    /// Type de la trame (P5 ou P6, chaine vide pour une trame Y4M)
+    char typeFile[3];
+    /// Largeur de la trame
+    long int largeur;
+    /// Hauteur de la trame
+    long int hauteur;
+    /// Intensité maximale des pixels (au plus 255)
+    long int pixelIntensity;
+    /// Nombre d'échantillons par pixel (1 pour P5, 3 pour P6)
+    long int profondeur;
+    /// Nombre d'échantillons de la trame
+    long int dimension;
+    /// Échantillons de la trame
+    unsigned char *pixels;
+    /// Taille allouée de pixels, réutilisée d'une trame à l'autre
+    long int capacite;
+    /// Nombre de plans de la trame
+    int nbPlans;
+    /// Nombre d'échantillons de chaque plan
+    long int taillePlans[PLANS_MAX_FLUX];
+} trameFlux_t;
+
+
+/** \struct fileTrames_t header.h
+ *  \brief File circulaire de trames partagée par les étapes de lecture, d'insertion et d'écriture d'un flux.
+ *
+ *  Une trame d'indice n occupe l'emplacement n % NB_TRAMES_FILE. Elle est lue quand n < nbLues, traitée quand n < nbTraitees et écrite quand n < nbEcrites, avec nbEcrites <= nbTraitees <= nbLues <= nbEcrites + NB_TRAMES_FILE.
+ *
+ *  \see cacherDansFlux
+ */
+typedef struct fileTrames_t {
+    /// Emplacements des trames
+    trameFlux_t trames[NB_TRAMES_FILE];
+    /// Nombre de trames lues
+    long int nbLues;
+    /// Nombre de trames traitées
+    long int nbTraitees;
+    /// Nombre de trames écrites
+    long int nbEcrites;
+    /// Fin du flux d'entrée atteinte
+    int finLecture;
+    /// Plus aucune trame ne sera traitée
+    int finTraitement;
+    /// Première erreur rencontrée par une étape (ERROR_OK sinon), elle arrête les autres
+    int error;
+    /// Format du flux d'entrée (et du flux créé)
+    formatFlux_t format;
+    /// Flux d'entrée
+    FILE *entree;
+    /// Flux de sortie
+    FILE *sortie;
+    /// Protège les compteurs et error
+    pthread_mutex_t verrou;
+    /// Signalé à chaque avancée d'une étape
+    pthread_cond_t changement;
+} fileTrames_t;
+
+
+/// Nombre de tours du réseau de Feistel du parcours calculable
+#define NB_TOURS_FEISTEL 4
+
+
+/** \struct parcoursCalculable_t header.h
+ *  \brief Parcours pseudo aléatoire des pixels dont chaque position se calcule indépendamment des autres.
+ *
+ *  Le parcours est une permutation de [0, taille[ obtenue avec un réseau de Feistel équilibré sur 2*demiBits bits, initialisé par la clé.
+ *  Les valeurs qui sortent de [0, taille[ sont re-chiffrées jusqu'à retomber dans l'intervalle (cycle walking). \n
+ *  Contrairement à genererTableParcours, aucune table de la taille de l'image n'est nécessaire: on peut calculer directement où se trouve le n-ième bit du message.
+ *
+ *  \see initParcoursCalculable
+ *  \see positionParcoursCalculable
+ */
+typedef struct parcoursCalculable_t {
+    /// Première position du parcours (i.e taille du prefixe)
+    long int debut;
+    /// Nombre de positions parcourues
+    long int taille;
+    /// Nombre de bits de chaque moitié du réseau de Feistel
+    unsigned int demiBits;
+    /// Masque de demiBits bits
+    unsigned long long masque;
+    /// Clés de tour dérivées de la clé secrète
+    unsigned long long clesTour[NB_TOURS_FEISTEL];
+} parcoursCalculable_t;
+
+
+/** \struct lecteurBits_t header.h
+ *  \brief Contexte de lecture des bits cachés dans un tableau de pixels.
+ *
+ *  Permet de récupérer le n-ième bit du message caché directement depuis l'image, quel que soit le mode d'insertion, sans passer par un tableau de bits intermédiaire.
+ *
+ *  \see initLecteurBits
+ *  \see lireBitExtrait
+ */
+typedef struct lecteurBits_t {
+    /// Source des pixels de l'image
+    sourceImage_t *source;
+    /// Taille du tableau de pixels
+    long int dimension;
+    /// Position du premier pixel du message (i.e taille du prefixe)
+    int debut;
+    /// Mode d'insertion utilisé (modeInsertion_t)
+    int mode;
+    /// Table du parcours pseudo aléatoire (mode MODE_CHIFFRE) ou des pixels sélectionnés (mode MODE_ADAPTATIF), NULL sinon
+    int *tablePermuteIndex;
+    /// Parcours calculable (modes MODE_CHIFFRE_CALCULABLE et MODE_HAMMING_CHIFFRE uniquement)
+    parcoursCalculable_t parcours;
+    /// Nombre de lignes de la matrice de Hamming (modes MODE_HAMMING et MODE_HAMMING_CHIFFRE, segment final si nbBlocsGrands > 0), hauteur STC (mode MODE_STC) ou trits par bloc (mode MODE_TERNAIRE)
+    unsigned int rows;
+    /// Nombre de colonnes de la matrice de Hamming (mode MODE_HAMMING, 0 en mode MODE_ADAPTATIF classique), taille du flux caché en bits (mode MODE_STC) ou pixels par bloc (mode MODE_TERNAIRE)
+    unsigned int columns;
+    /// Nombre de blocs de Hamming à rows + 1 lignes placés avant les blocs à rows lignes (modes MODE_HAMMING et MODE_HAMMING_CHIFFRE, 0 pour une taille unique)
+    long int nbBlocsGrands;
+    /// Dernier bloc de Hamming dont le syndrome a été calculé, prochain bloc STC à traiter (-1 si aucun)
+    long int blocCache;
+    /// Syndrome du bloc blocCache (syndrome STC en cours avant le bloc blocCache)
+    unsigned int syndromeCache;
+    /// Nombre de bits cachés dans chaque canal R, G, B (mode MODE_KLSB uniquement)
+    int bitsParCanal[3];
+    /// Nombre de bits cachés dans 3 pixels consécutifs (mode MODE_KLSB uniquement)
+    int bitsCycle;
+    /// Table du code ternaire (mode MODE_TERNAIRE uniquement, NULL sinon), voir genererTableTernaire
+    unsigned int *tableTernaire;
+    /// Dernier groupe de BITS_GROUPE_TERNAIRE bits lu (-1 si aucun)
+    long int groupeCache;
+    /// Valeur du groupe groupeCache
+    unsigned int valeurGroupe;
+} lecteurBits_t;
+
+
+/** \struct fluxSortie_t header.h
+ *  \brief Flux de sortie qui regroupe les bits décodés en octets et les écrit au fur et à mesure dans un fichier.
+ *
+ *  \see ouvrirFluxSortie
+ *  \see ecrireBitFlux
+ *  \see fermerFluxSortie
+ */
+typedef struct fluxSortie_t {
+    /// Fichier de destination (fichier créé ou stdout)
+    FILE *fichier;
+    /// Tampon des octets en attente d'écriture
+    unsigned char tampon[TAILLE_TAMPON_FLUX];
+    /// Nombre d'octets présents dans le tampon
+    size_t remplissage;
+    /// Octet en cours de construction
+    unsigned int octetCourant;
+    /// Nombre de bits déjà placés dans octetCourant
+    int nbBitsCourant;
+    /// Nombre d'octets qu'il reste à écrire dans le fichier, les octets suivants sont ignorés
+    long int octetsRestants;
+    /// CRC32C attendu pour chaque bloc (NULL si aucune vérification)
+    const unsigned int *crcAttendus;
+    /// Taille d'un bloc vérifié en octets (diviseur de TAILLE_TAMPON_FLUX)
+    long int tailleBloc;
+    /// Nombre d'octets du bloc en cours déjà placés dans le tampon
+    long int remplissageBloc;
+    /// Numéro du bloc en cours
+    long int blocCourant;
+} fluxSortie_t;
+
+
+/** \struct sha256_t header.h
+ *  \brief Contexte de calcul incrémental d'une empreinte SHA-256.
+ *
+ *  \see initSha256
+ *  \see majSha256
+ *  \see finSha256
+ */
+typedef struct sha256_t {
+    /// Variables de chainage
+    unsigned int etat[8];
+    /// Bloc de 64 octets en cours de remplissage
+    unsigned char bloc[64];
+    /// Nombre d'octets présents dans bloc
+    size_t remplissage;
+    /// Nombre total d'octets hachés
+    unsigned long long taille;
+} sha256_t;
+
+
+/** \struct poly1305_t header.h
+ *  \brief Contexte de calcul incrémental d'un tag Poly1305 (arithmétique sur 5 morceaux de 26 bits).
+ *
+ *  \see initPoly1305
+ *  \see majPoly1305
+ *  \see finPoly1305
+ */
+typedef struct poly1305_t {
+    /// Clé r, clampée
+    unsigned int r[5];
+    /// Clé s, ajoutée à la fin
+    unsigned int s[4];
+    /// Accumulateur
+    unsigned int h[5];
+    /// Bloc de 16 octets en cours de remplissage
+    unsigned char bloc[16];
+    /// Nombre d'octets présents dans bloc
+    size_t remplissage;
+} poly1305_t;
+
+
+/// Taille de la fenêtre deflate: distance maximale d'une répétition (doit être une puissance de 2)
+#define TAILLE_FENETRE_DEFLATE 32768
+
+/// Nombre de codes littéral/longueur d'un code deflate (286 utilisables, 288 dans le code fixe)
+#define NB_LITTERAUX_DEFLATE 288
+
+/// Nombre de codes de distance d'un code deflate (30 utilisables, 32 dans le code fixe)
+#define NB_DISTANCES_DEFLATE 32
+
+/// Longueur maximale d'un code de Huffman deflate
+#define LONGUEUR_MAX_HUFFMAN 15
+
+/// Nombre de bits décodés en une lecture par la table rapide d'un code de Huffman
+#define BITS_TABLE_HUFFMAN 10
+
+/// Longueur minimale d'une répétition deflate
+#define LONGUEUR_MIN_DEFLATE 3
+
+/// Longueur maximale d'une répétition deflate
+#define LONGUEUR_MAX_DEFLATE 258
+
+/// Nombre d'octets compressés par bloc deflate dynamique à l'écriture d'un PNG
+#define TAILLE_BLOC_DEFLATE 65536
+
+/// Taux de compression maximal d'un flux deflate (une copie de 258 octets codée sur au moins 2 bits): borne la taille décompressée d'un PNG
+#define TAUX_MAX_DEFLATE 1032
+
+/// Taille de la table de hachage du compresseur deflate (log2 du nombre d'entrées)
+#define LOG2_HACHAGE_DEFLATE 15
+
+/// Nombre maximal de candidats examinés par le compresseur deflate pour chaque position
+#define CHAINE_MAX_DEFLATE 32
+
+/// Nombre d'octets décompressés transmis aux lignes du PNG à la fois (diviseur de TAILLE_FENETRE_DEFLATE)
+#define TAILLE_VIDAGE_PNG 4096
+
+/// Taille maximale d'un chunk IDAT écrit
+#define TAILLE_IDAT_PNG 65536
+
+
+/** \struct huffman_t header.h
+ *  \brief Code de Huffman canonique d'un bloc deflate, prêt pour le décodage.
+ *
+ *  \see construireHuffman
+ */
+typedef struct huffman_t {
+    /// Nombre de codes de chaque longueur
+    unsigned short nombre[LONGUEUR_MAX_HUFFMAN + 1];
+    /// Symboles rangés par longueur de code puis par valeur
+    unsigned short symboles[NB_LITTERAUX_DEFLATE];
+    /// Table indexée par les BITS_TABLE_HUFFMAN prochains bits: (symbole << 4) | longueur, 0 si le code est plus long
+    unsigned short rapide[1 << BITS_TABLE_HUFFMAN];
+} huffman_t;
+
+
+/** \struct decodeurPNG_t header.h
+ *  \brief État de la décompression d'un PNG: les octets sortent dans une fenêtre circulaire puis sont défiltrés ligne par ligne.
+ *
+ *  Le décompresseur ne garde que la fenêtre de TAILLE_FENETRE_DEFLATE octets et deux lignes, mais les lignes défiltrées sont rangées dans l'image entière (matrice ou octets): la mémoire est celle de l'image décompressée.
+ *
+ *  \see readImagePNG
+ */
+typedef struct decodeurPNG_t {
+    /// Le fichier, positionné dans les données du chunk IDAT courant
+    FILE* fichier;
+    /// Octets restants dans le chunk IDAT courant
+    long int resteChunk;
+    /// Vaut 1 après le dernier chunk IDAT
+    int finIdat;
+    /// Vaut 1 si le flux a été lu au-delà de sa fin
+    int epuise;
+    /// Réservoir de bits, bit de poids faible en premier
+    unsigned long long reservoir;
+    /// Nombre de bits dans le réservoir
+    int nbBits;
+    /// Fenêtre circulaire des derniers octets produits
+    unsigned char *fenetre;
+    /// Nombre d'octets produits
+    long int position;
+    /// Nombre d'octets déjà transmis aux lignes
+    long int vide;
+    /// Somme Adler-32 des octets transmis
+    unsigned int adler;
+    /// Ligne en cours de remplissage (octet de filtre puis octetsLigne octets)
+    unsigned char *ligne;
+    /// Ligne précédente défiltrée (zéros avant la première ligne)
+    unsigned char *precedente;
+    /// Octets présents dans ligne
+    long int remplissage;
+    /// Nombre d'octets d'une ligne sans l'octet de filtre
+    long int octetsLigne;
+    /// Nombre d'octets par pixel
+    int profondeur;
+    /// Ligne en cours
+    long int numeroLigne;
+    /// Nombre de lignes de l'image
+    long int nbLignes;
+    /// Matrice qui reçoit les échantillons (NULL si octets est utilisé)
+    int *matrice;
+    /// Tableau d'octets qui reçoit les échantillons (NULL si matrice est utilisée)
+    unsigned char *octets;
+} decodeurPNG_t;
+
+
+/** \struct encodeurPNG_t header.h
+ *  \brief État de la compression d'un PNG: les lignes filtrées sont compressées par blocs de TAILLE_BLOC_DEFLATE octets.
+ *
+ *  \see writeImagePNG
+ */
+typedef struct encodeurPNG_t {
+    /// Le fichier PNG écrit
+    FILE* fichier;
+    /// Historique (au plus TAILLE_FENETRE_DEFLATE octets) puis octets du bloc en cours
+    unsigned char *donnees;
+    /// Octets d'historique au début de donnees
+    long int historique;
+    /// Octets présents dans donnees
+    long int remplissage;
+    /// Dernière position de chaque hachage de 3 octets (-1 si vide)
+    int *tete;
+    /// Position précédente de même hachage, pour chaque position de donnees
+    int *precedent;
+    /// Littéral, ou longueur de la répétition, de chaque symbole du bloc
+    unsigned short *symboles;
+    /// Distance de la répétition de chaque symbole (0 pour un littéral)
+    unsigned short *distances;
+    /// Nombre de symboles du bloc
+    long int nbSymboles;
+    /// Réservoir de bits, bit de poids faible en premier
+    unsigned long long reservoir;
+    /// Nombre de bits dans le réservoir
+    int nbBits;
+    /// Données du chunk IDAT en cours
+    unsigned char *idat;
+    /// Octets présents dans idat
+    long int tailleIdat;
+    /// Somme Adler-32 des octets compressés
+    unsigned int adler;
+    /// Erreur d'écriture
+    int error;
+} encodeurPNG_t;
+
+
+/** \struct verificationBlocs_t header.h
+ *  \brief Travail d'un thread de vérification: les blocs premierBloc, premierBloc + pas, premierBloc + 2*pas, etc.
+ *
+ *  Chaque thread possède sa propre source (cache de pages) et sa propre copie du lecteur (cache du syndrome de Hamming), les tables de parcours et de permutation sont partagées en lecture seule.
+ *
+ *  \see verifierChargeParallele
+ */
+typedef struct verificationBlocs_t {
+    /// Copie du lecteur de bits propre au thread
+    lecteurBits_t lecteur;
+    /// Source de pixels propre au thread
+    sourceImage_t source;
+    /// Table de dépermutation partagée (NULL si le message n'est pas permuté)
+    const int *tableIndex;
+    /// Position (en octets) du premier octet du message dans le flux inséré
+    long int debutOctet;
+    /// Taille du message en octets
+    long int longueurCharge;
+    /// CRC32C attendus, un par bloc
+    const unsigned int *crcAttendus;
+    /// Taille d'un bloc en octets
+    long int tailleBloc;
+    /// Premier bloc vérifié par le thread
+    long int premierBloc;
+    /// Nombre de blocs entre deux blocs vérifiés par le thread
+    long int pas;
+    /// Premier bloc invalide trouvé par le thread (-1 si aucun)
+    long int blocInvalide;
+    /// Code d'erreur du thread
+    int error;
+} verificationBlocs_t;
+
+
+/** \struct imageChargee_t header.h
+ *  \brief Une image (ou un son) chargée en mémoire avec tout ce qu'il faut pour la réécrire.
+ *
+ *  \see chargerImage
+ *  \see ecrireImageChargee
+ */
+typedef struct imageChargee_t {
+    /// Type du fichier (P2, P3, P5, P6, P7, BMP, PNG ou WAV)
+    char typeFile[50];
+    /// TUPLTYPE d'un PAM ou d'un PNG
+    char tuplType[TAILLE_TUPLTYPE_PAM];
+    /// Largeur de l'image
+    long int imageWidth;
+    /// Hauteur de l'image
+    long int imageHeight;
+    /// Nombre d'échantillons par pixel
+    long int profondeur;
+    /// Intensité maximale des échantillons
+    long int pixelIntensity;
+    /// Position des échantillons dans le fichier
+    long int beginningImage;
+    /// Nombre d'échantillons
+    long int dimension;
+    /// Échantillons de l'image
+    int *matriceImage;
+} imageChargee_t;
+
+
+/** \struct travailFragments_t header.h
+ *  \brief Travail d'un thread de répartition: les images premiereImage, premiereImage + pas, premiereImage + 2*pas, etc.
+ *
+ *  Les chemins, les entêtes et le message sont partagés: chaque thread n'écrit que dans les cases de ses images.
+ *
+ *  \see repartirCharge
+ *  \see reconstituerCharge
+ */
+typedef struct travailFragments_t {
+    /// Chemins des images lues
+    char **pathsEntree;
+    /// Chemins des images créées (NULL pour une extraction)
+    char **pathsSortie;
+    /// Entête de chaque fragment: donné pour une insertion, lu pour une extraction
+    enteteConteneur_t *entetes;
+    /// Message complet à répartir (NULL pour une extraction)
+    const unsigned char *charge;
+    /// Fragments extraits, alloués par le thread (NULL pour une insertion)
+    unsigned char **fragments;
+    /// Nombre d'images
+    int nbImages;
+    /// Première image traitée par le thread
+    int premiereImage;
+    /// Nombre d'images entre deux images traitées par le thread
+    int pas;
+    /// Première image en erreur (-1 si aucune)
+    int imageInvalide;
+    /// Code d'erreur du thread
+    int error;
+} travailFragments_t;
+
+
+/** \struct travailCopies_t header.h
+ *  \brief Travail d'un thread de copies: les copies premiereSortie, premiereSortie + pas, premiereSortie + 2*pas, etc.
+ *
+ *  L'image d'origine est partagée en lecture seule. Le thread garde une copie entière de l'image: il y insère chaque message puis restaure la zone modifiée depuis l'image d'origine.
+ *
+ *  \see cacherDansCopies
+ */
+typedef struct travailCopies_t {
+    /// Chemin de l'image d'origine (recopiée pour un BMP ou un WAV)
+    char *pathCouverture;
+    /// Image d'origine, chargée une seule fois
+    const imageChargee_t *couverture;
+    /// Chemins des copies à créer
+    char **pathsSortie;
+    /// Entête du message de chaque copie
+    const enteteConteneur_t *entetes;
+    /// Message de chaque copie
+    unsigned char **charges;
+    /// Fin de la zone modifiée de chaque copie, en échantillons
+    long int *finsModifications;
+    /// Nombre de copies
+    int nbSorties;
+    /// Première copie créée par le thread
+    int premiereSortie;
+    /// Nombre de copies entre deux copies créées par le thread
+    int pas;
+    /// Première copie en erreur (-1 si aucune)
+    int sortieInvalide;
+    /// Code d'erreur du thread
+    int error;
+} travailCopies_t;
+
+
+/** \struct entreeArchive_t header.h
+ *  \brief Entrée de l'index d'une archive cachée (FLAG_CONTENEUR_ARCHIVE).
+ *
+ *  \see lireIndexArchive
+ *  \see extraireEntreeArchive
+ */
+typedef struct entreeArchive_t {
+    /// Nom du fichier
+    char nom[TAILLE_NOM_CONTENEUR + 1];
+    /// Transformations appliquées au fichier (FLAG_CONTENEUR_COMPRESSE, FLAG_CONTENEUR_CHIFFRE)
+    unsigned int flags;
+    /// Position du fichier dans le message, en octets
+    unsigned long position;
+    /// Taille du fichier inséré (après compression et chiffrement)
+    unsigned long longueur;
+    /// CRC32C du fichier inséré
+    unsigned int crc;
+} entreeArchive_t;
+
+
+
 
 
 
@@ -142,7 +1000,7 @@ int depermuterTableau(char* key,int tailleTable, unsigned char** table);
 
 
 /**
- * @fn int hideDimMsg(size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int* lengthDimensionPrefix)
+ * @fn int hideDimMsg(size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, long int* lengthDimensionPrefix)
  * @brief Cette fonction modifie les LSB d'un tableau de pixel pour y ajouter le prefixe correspondant à la taille du message secret.
  *
  * La taille du prefixe est determinée en convertissant la taille du tableau de pixel en binaire, puis en comptant le nombre de bits inclus dans le nombre binaire. \n
@@ -165,7 +1023,7 @@ int depermuterTableau(char* key,int tailleTable, unsigned char** table);
  * @param lengthDimensionPrefix Taille du prefixe, cette variable est un passage par adresse.
  * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
  */
-int hideDimMsg(size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int* lengthDimensionPrefix);
+int hideDimMsg(size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, long int* lengthDimensionPrefix);
 
 
 
@@ -184,12 +1042,12 @@ int hideDimMsg(size_t tailleMsgBit, int* matriceImage, long int dimension, long
  * @param dimension La taille du tableau précédent (i.e taille de l'image). De type long int
  * @param pixelIntensity L'intensité maximale des pixels de l'image.
  * @param lengthDimensionPrefix Taille du prefixe. Le prefixe correspond aux pixels dont les LSBs forment la taille du message secret. Il est inséré par la fonction hideDimMsg.
- * @param crypt Cette variable de type int permet de spécifier si on insère les bits un par un (=0) où si on les insère dans un chemin pseudo aléatoire (=1)
- * @param keyCrypt Cette variable correspond à la clé secrète utile pour générer le chemin pseudo aléatoire si la variable crypt est égal à 1.
+ * @param crypt Cette variable de type int permet de spécifier si on insère les bits un par un (=0), dans un chemin pseudo aléatoire (=1) ou dans un chemin pseudo aléatoire calculable position par position (=2, voir parcoursCalculable_t)
+ * @param keyCrypt Cette variable correspond à la clé secrète utile pour générer le chemin pseudo aléatoire si la variable crypt est égal à 1 ou 2.
  *
  * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
  *
- * @warning La variable crypt doit valoir uniquement 0 ou 1. \n La variable keyCrypt doit valoir NULL si crypt vaut 0, sinon elle doit étre égale à un mot de passe secret.
+ * @warning La variable crypt doit valoir uniquement 0, 1 ou 2. \n La variable keyCrypt doit valoir NULL si crypt vaut 0, sinon elle doit étre égale à un mot de passe secret.
  */
 int hideMessage(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, int crypt, char* keyCrypt);
 
@@ -219,7 +1077,7 @@ int readExtensionSuffix(const unsigned char* msgSecret, int lengthmsgSecret, cha
 
 
 /**
- * @fn int decryptPrefix(const int *matriceImage, long int dimension, int* prefixInt, int* lengthDimensionPrefix)
+ * @fn int decryptPrefix(const int *matriceImage, long int dimension, long int* prefixInt, long int* lengthDimensionPrefix)
  * @brief Cette fonction lit les n premiers LSBs d'un tableau de pixel et les convertit en entier. n étant passé en paramètre.
  *
  * @param matriceImage Tableau de pixels dans lequel on souhaite lire le prefixe.
@@ -231,11 +1089,11 @@ int readExtensionSuffix(const unsigned char* msgSecret, int lengthmsgSecret, cha
  *
  * @see hideDimMsg
  */
-int decryptPrefix(const int *matriceImage, long int dimension, int* prefixInt, int* lengthDimensionPrefix);
+int decryptPrefix(const int *matriceImage, long int dimension, long int* prefixInt, long int* lengthDimensionPrefix);
 
 
 /**
- * @fn int decryptMessage(const int *matriceImage, long int dimension, int prefixInt, int lengthDimensionPrefix,int crypt, char* keyCript, long int *tailleMsgDecrypt, unsigned char **messageSecretBitOutput)
+ * @fn int decryptMessage(const int *matriceImage, long int dimension, long int prefixInt, long int lengthDimensionPrefix,int crypt, char* keyCript, long int *tailleMsgDecrypt, unsigned char **messageSecretBitOutput)
  * @brief Cette fonction lit les LSBs d'un tableau de bits et les place dans un tableau de bits.
  *
  * Tout comme la fonction hideMessage, cette fonction possède deux mode: \n
@@ -253,7 +1111,7 @@ int decryptPrefix(const int *matriceImage, long int dimension, int* prefixInt, i
  *
  * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
  */
-int decryptMessage(const int *matriceImage, long int dimension, int prefixInt, int lengthDimensionPrefix,int crypt, char* keyCript, long int *tailleMsgDecrypt, unsigned char **messageSecretBitOutput);
+int decryptMessage(const int *matriceImage, long int dimension, long int prefixInt, long int lengthDimensionPrefix,int crypt, char* keyCript, long int *tailleMsgDecrypt, unsigned char **messageSecretBitOutput);
 
 
 
@@ -262,387 +1120,2541 @@ int decryptMessage(const int *matriceImage, long int dimension, int prefixInt, i
 
 
 /************************************************
- *  Fonctions Conversion
+ *  Fonctions décodage fusionné
  ***********************************************/
 
 /**
- * @fn int* num_to_bit(int a, int *len)
- * @brief Convertit un entier en un tableau binaire.
+ * @fn int genererTableParcours(char* keyCrypt, long int dimension, int lengthDimensionPrefix, int** tablePermuteIndex)
+ * @brief Génère le parcours pseudo aléatoire des pixels utilisé par le mode chiffré.
  *
- * La fonction retourne un tableau binaire en fonction d'un entier passé en paramètre. La fonction retourne aussi en passage par adresse la taille du tableau binaire.
+ * Le parcours est un mélange de Fisher-Yates des positions [lengthDimensionPrefix, dimension[ initialisé avec le hash de la clé.
+ * \n Cette fonction est utilisée à la fois à l'insertion (hideMessage) et à la lecture (decryptMessage, lecteurBits_t) pour garantir le même parcours.
  *
- * @param a L'entier que l'on veut convertir
- * @param len Passage par adresse de la valeur de la taille du tableau binaire
- * @return Tableau binaire
+ * @param keyCrypt La clé secrète.
+ * @param dimension Taille du tableau de pixels.
+ * @param lengthDimensionPrefix Taille du prefixe: les positions du prefixe ne sont pas mélangées.
+ * @param tablePermuteIndex Passage par adresse de la table du parcours, de taille dimension.
  *
- * @warning Le tableau binaire ne doit pas être initialisé avant d'utiliser la fonction. L'allocation dynamique se fait dans la fonction.
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @warning La table est allouée dans la fonction. L'utilisateur doit la libérer après utilisation.
  */
-int* num_to_bit(int a, int *len);
+int genererTableParcours(char* keyCrypt, long int dimension, int lengthDimensionPrefix, int** tablePermuteIndex);
 
 /**
- * @fn unsigned char* stringToBinary(char* s, size_t *length)
- * @brief Convertit une chaine de caractère en un tableau binaire de type unsigned char.
+ * @fn int genererTableDepermutation(char* key, int tailleTable, int** tableIndex)
+ * @brief Calcule, pour chaque position du message, la position qu'elle occupe dans le message permuté par permuterTableau.
  *
- * La fonction retourne un pointer vers un unsigned char comportant la chaine de caractère passée en paramètre sous format binaire. La taille de ce tableau est également renvoyé en passage par adresse.
- * \n L'allocation dynamique du tableau se fait dans la fonction.
+ * La fonction rejoue les échanges de depermuterTableau sur une table d'indices au lieu du tableau de bits: le bit k du message d'origine est le bit tableIndex[k] du message permuté.
  *
- * @param s La chaine de caractère (Pointer vers char)
- * @param length Passage par adresse de la taille du tableau binaire (type size_t)
- * @return Tableau binaire de type pointeur vers unsigned char
+ * @param key Le mot de passe utilisé lors de la permutation.
+ * @param tailleTable La taille du message permuté (en bits).
+ * @param tableIndex Passage par adresse de la table d'indices, allouée dans la fonction.
  *
- * @warning Le tableau binaire ne doit pas être initialisé avant d'utiliser la fonction. L'allocation dynamique se fait dans la fonction.
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @see depermuterTableau
  */
-unsigned char* stringToBinary(char* s, size_t *length);
-
+int genererTableDepermutation(char* key, int tailleTable, int** tableIndex);
 
 /**
- * @fn unsigned long hash(unsigned char *str)
- * @brief Renvoit le hash de type unsigned long d'une chaine de caractère (unsigned également). Le hash est calculé suivant l'algorithme djb2 créé par Dan Bernstein.
+ * @fn void initParcoursCalculable(parcoursCalculable_t* parcours, char* keyCrypt, long int dimension, int lengthDimensionPrefix)
+ * @brief Initialise le parcours calculable des positions [lengthDimensionPrefix, dimension[ à partir d'une clé.
  *
- * @param str La chaine de caractère que l'on souhaite hasher, de type unsigned char.
- * @return Renvoit le hash correspondant à la chaine de caractère, de type unsigned long.
+ * @param parcours Le parcours à initialiser.
+ * @param keyCrypt La clé secrète.
+ * @param dimension Taille du tableau de pixels.
+ * @param lengthDimensionPrefix Taille du prefixe, qui n'est pas mélangé.
  *
- * @see http://www.cse.yorku.ca/~oz/hash.html
+ * @see positionParcoursCalculable
  */
-unsigned long hash(unsigned char *str);
+void initParcoursCalculable(parcoursCalculable_t* parcours, char* keyCrypt, long int dimension, int lengthDimensionPrefix);
 
 /**
- * @fn int binaryToUChar(long int tailleMsgDecrypt, const unsigned char *messageSecretBitOutput, unsigned char **msgSecret, int* lengthmsgSecret)
- * @brief Cette fonction prend en entrée un tableau binaire et renvoit un tableau de unsigned char, convertit par groupe d'octets.
- *
- * Le tableau de sortie est alloué dans la fonction et sa taille est renvoyé en passage par adresse.
- *
- * @param tailleMsgDecrypt La taille du tableau binaire que l'on souhaite convertir, de type long int.
- * @param messageSecretBitOutput Le tableau binaire que l'on souhaite convertir de type unsigned char. (Mais stocké avec du binaire).
- * @param msgSecret Passage par adresse du tableau des unsigned char.
- * @param lengthmsgSecret Passage par adresse de la taille du tableau converti.
+ * @fn long int positionParcoursCalculable(const parcoursCalculable_t* parcours, long int index)
+ * @brief Renvoit la position dans l'image du index-ième pixel du parcours, en temps constant.
  *
- * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ * @param parcours Le parcours initialisé par initParcoursCalculable.
+ * @param index Numéro du pixel dans le parcours, entre 0 et parcours->taille - 1.
  *
- * @warning Le tableau de sortie msgSecret ne doit pas être alloué avant la fonction, l'allocation dynamique de mémoire ce fait dans la fonction. L'utilisateur doit free ce tableau après utilisation.
+ * @return La position du pixel dans le tableau de pixels (prefixe compris).
  */
-int binaryToUChar(long int tailleMsgDecrypt, const unsigned char *messageSecretBitOutput, unsigned char **msgSecret, int* lengthmsgSecret);
+long int positionParcoursCalculable(const parcoursCalculable_t* parcours, long int index);
 
 /**
- * @fn void printbincharpad(char c, char* tabBit)
- * @brief Cette fonction convertit un caractère en un tableau de binaire.
- *
- * Le tableau passé en passage par adresse contenant le tableau binaire du caractère doit être alloué avant la fonction.
+ * @fn void sourceMemoire(sourceImage_t* source, const int* matriceImage, long int dimension)
+ * @brief Initialise une source de pixels sur un tableau déjà chargé en mémoire.
  *
- * @param c Le caractère que l'on souhaite convertir en binaire.
- * @param tabBit Passage par adresse du tableau binaire de taille 8 et de type char.
+ * @param source La source à initialiser.
+ * @param matriceImage Tableau de pixels.
+ * @param dimension Taille du tableau de pixels.
  */
-void printbincharpad(char c, char* tabBit);
-
+void sourceMemoire(sourceImage_t* source, const int* matriceImage, long int dimension);
 
 /**
- * @fn int addExtension(char** fileOutput, const char *extensionPixelMap)
- * @brief Cette fonction ajoute une chaine de caractère (Une extension dans notre cas) à une autre chaine de caractère (un nom de fichier dans notre cas)
+ * @fn int ouvrirSourceImage(sourceImage_t* source, char* pathFile, long int beginningImage, long int dimension)
+ * @brief Ouvre une source de pixels qui lit l'image directement dans le fichier, page par page et uniquement à la demande.
  *
- * La réallocation dynamique se fait à l'interieur de la fonction.
- * \n Nul besoin de passer la taille des deux chaines de caractères.
- * \n L'extension se rajoute à la toute fin de la chaine de caractère.
- * \n L'extension doit contenir un '.' en début de chaine.
+ * Contrairement à readImage, rien n'est lu à l'ouverture: chaque appel à lireEchantillon ne lit (avec pread) que la page qui contient le pixel demandé si elle n'est pas déjà en cache.
  *
- * @param fileOutput Passage par adresse de la chaine de caractère à laquelle on souhaite ajouter l'extension.
- * @param extensionPixelMap Chaine de caractère (i.e l'extension) que l'on souhaite ajouter à la fin.
+ * @param source La source à initialiser.
+ * @param pathFile Chemin vers le fichier portable pixmap.
+ * @param beginningImage Position du premier pixel dans le fichier (voir readHeader).
+ * @param dimension Nombre de pixels de l'image.
  *
  * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @see fermerSourceImage
  */
-int addExtension(char** fileOutput, const char *extensionPixelMap);
-
-
-
-
-
-
-
-/************************************************
- *  Fonctions manipulation de fichiers
- ***********************************************/
+int ouvrirSourceImage(sourceImage_t* source, char* pathFile, long int beginningImage, long int dimension);
 
 /**
- * @fn int readHeader(char* pathFile, char* typeFile, long int *imageWidth, long int *imageHeight, long int *pixelIntensity, long int *positionCursor)
- * @brief Cette fonction récupère les informations du header d'un fichier portable pixel map.
+ * @fn int ouvrirSourceFormat(sourceImage_t* source, char* pathFile, const char* typeFile, long int imageWidth, long int profondeur, long int pixelIntensity, long int beginningImage, long int dimension)
+ * @brief Ouvre la source de pixels adaptée au format de l'image et fixe sa géométrie (voir geometrieSource).
  *
- * La fonction ouvre un fichier portable pixmap et lit le header qui la compose. Elle récupère les dimensions de l'image, la profondeur des pixels ainsi que le type de fichier. Elle retourne également la position du curseur à laquelle se trouve la fin du header.
- * \n La fonction fait abstraction des commentaires présents dans le header (lignes commençant par '#')
+ * Les formats binaires sont lus à la demande (ouvrirSourceImage), les octets de bourrage des lignes d'un BMP sont sautés par lireEchantillon. Un P2/P3 est décodé en mémoire par readImageASCII, un PNG par readImagePNGOctets (un octet par échantillon, l'image entière), le tableau est libéré par fermerSourceImage.
  *
- * @param pathFile Chaine de caractères representant le chemin vers le fichier portable pixmap que l'on souhaite analyser.
- * @param typeFile Passage par adresse d'une chaine de caractère representant le type de fichier. (Exemple: P5 ou P6)
- * @param imageWidth Passage par adresse de la largeur de l'image en pixel. Type long int.
- * @param imageHeight Passage par adresse de la hauteur de l'image en pixel. Type long int.
- * @param pixelIntensity Passage par adresse de l'intensité des pixels (par exemple 255). Type long int.
- * @param positionCursor Passage par adresse de la position du curseur de la fin du header, utile afin de savoir à partir de quelle ligne commence la matrice image. Type long int.
+ * @param source La source à initialiser.
+ * @param pathFile Chemin vers l'image.
+ * @param typeFile Type du fichier (voir lireFormatImage).
+ * @param imageWidth Largeur de l'image en pixels.
+ * @param profondeur Nombre de composantes par pixel.
+ * @param pixelIntensity Intensité maximale des pixels.
+ * @param beginningImage Position du premier pixel dans le fichier.
+ * @param dimension Nombre de pixels de l'image.
  *
  * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
  */
-int readHeader(char* pathFile, char* typeFile, long int *imageWidth, long int *imageHeight, long int *pixelIntensity, long int *positionCursor);
+int ouvrirSourceFormat(sourceImage_t* source, char* pathFile, const char* typeFile, long int imageWidth, long int profondeur, long int pixelIntensity, long int beginningImage, long int dimension);
 
 /**
- * @fn int readImage(char* pathFile, int* matrice, long int beginningImage, long int dimension)
- * @brief Cette fonction lit une image portable pixmap et retourne un tableau de 1 dimension contenant la matrice des pixels de l'image.
- *
- * La dimension du tableau doit être calculé au préalable (i.e longueur*hauteur ou longueur*hauteur*3 dépendant de si l'image est en noir et blanc ou non).
+ * @fn int lireEchantillon(sourceImage_t* source, long int position)
+ * @brief Renvoit la valeur du pixel numéro position.
  *
- * @param pathFile Chaine de caractères représentant le chemin vers le fichier portable pixmap que l'on souhaite analyser.
- * @param matrice Tableau d'entiers qui contiendra la matrice des pixels de l'image.
- * @param beginningImage Position du curseur à partir de laquelle la matrice de l'image commence. Cette position peut être determinée grâce à la fonction readHeader.
- * @param dimension Dimension du tableau de la matrice image, à determiner avant d'utiliser la fonction.
+ * Les échantillons de plusieurs octets d'un WAV sont réassemblés et rendus en binaire décalé, comme par readImageWAV.
  *
- * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ * @param source La source de pixels.
+ * @param position Position du pixel, entre 0 et dimension-1 (position dans la vue des canaux si vueCanauxSource a été appelée).
  *
- * @see readHeader
- * @warning Le tableau qui contiendra la matrice des pixels de l'image doit être alloué avant d'appeller la fonction. Et l'utilisateur est libre de le free après.
+ * @return La valeur du pixel, ou 0 si le pixel n'a pas pu être lu.
  */
-int readImage(char* pathFile, int* matrice, long int beginningImage, long int dimension);
+int lireEchantillon(sourceImage_t* source, long int position);
 
 /**
- * @fn int writeHeader(char* pathFile, char* typeFile, long int imageWidth, long int imageHeight, long int pixelIntensity, long int *positionCursor)
- * @brief Cette fonction recrée un header d'un fichier portable pixmap en fonction des données passées en paramètre.
+ * @fn void fermerSourceImage(sourceImage_t* source)
+ * @brief Ferme le fichier et libère le cache d'une source ouverte par ouvrirSourceImage, ou les pixels décodés par ouvrirSourceFormat. Sans effet sur une source en mémoire.
  *
- * Cette fonction est la complémentaire de la fonction readHeader.
+ * @param source La source à fermer.
+ */
+void fermerSourceImage(sourceImage_t* source);
+
+/**
+ * @fn int decryptPrefixSource(sourceImage_t* source, long int* prefixInt, long int* lengthDimensionPrefix)
+ * @brief Equivalent de decryptPrefix qui lit le prefixe depuis une source de pixels. Seule la première page de l'image est lue.
  *
- * @param pathFile Chaine de caractère representant le chemin vers le fichier portable pixmap où l'on souhaite ajouter le header. Si le fichier n'existe pas, il sera créé.
- * @param typeFile Chaine de caractère representant le type de fichier. (Exemple: P5 ou P6)
- * @param imageWidth Largeur de l'image en pixel. Type long int.
- * @param imageHeight Hauteur de l'image en pixel. Type long int.
- * @param pixelIntensity Intensité des pixels (par exemple 255). Type long int.
- * @param positionCursor Passage par adresse de la position du curseur de la fin du header, utile afin de savoir à partir de quelle ligne commence la matrice image. Type long int.
+ * @param source La source de pixels.
+ * @param prefixInt Passage par adresse de la valeur entière du prefixe.
+ * @param lengthDimensionPrefix Passage par adresse de la taille du prefixe.
  *
  * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
  *
- * @warning Le fichier peut ou ne peut pas exister. Le cas échéant, il sera crée.
- * @warning Les commentaires ne peuvent pas être ajouté dans ce nouveau header.
+ * @see decryptPrefix
  */
-int writeHeader(char* pathFile, char* typeFile, long int imageWidth, long int imageHeight, long int pixelIntensity, long int *positionCursor);
+int decryptPrefixSource(sourceImage_t* source, long int* prefixInt, long int* lengthDimensionPrefix);
 
 /**
- * @fn int writeImage(char* pathFile, int* matrice, long int beginningImage, long int dimension)
- * @brief Cette fonction ajoute une matrice de pixel passée en paramètre à un fichier portable pixmap.
- *
- * Cette fonction est la complémentaire de la fonction readImage.
+ * @fn int initLecteurBits(lecteurBits_t* lecteur, sourceImage_t* source, int lengthDimensionPrefix, int mode, char* keyCrypt, unsigned int rows, unsigned int columns)
+ * @brief Initialise un lecteur de bits sur une source de pixels.
  *
- * @param pathFile Chaine de caractère representant le chemin vers le fichier portable pixmap où l'on souhaite ajouter le header. Le fichier doit être créé au préalable.
- * @param matrice Matrice de pixel que l'on souhaite ajouter à l'image.
- * @param beginningImage Position du curseur representant la fin du header de l'image. Peut être determiné grâce à la fonction writeHeader
- * @param dimension Dimension du tableau de pixel.
+ * @param lecteur Le lecteur à initialiser.
+ * @param source Source des pixels dans lesquels le message est caché (en mémoire ou lue à la demande dans le fichier).
+ * @param lengthDimensionPrefix Taille du prefixe (position du début du message).
+ * @param mode Le mode d'insertion (modeInsertion_t).
+ * @param keyCrypt La clé du parcours pseudo aléatoire si mode vaut MODE_CHIFFRE, NULL sinon.
+ * @param rows Nombre de lignes de la matrice de Hamming si mode vaut MODE_HAMMING, paramètre de l'entête (bits par canal, hauteur ou trits par bloc) si mode vaut MODE_KLSB, MODE_STC ou MODE_TERNAIRE.
+ * @param columns Nombre de colonnes de la matrice de Hamming si mode vaut MODE_HAMMING, taille du flux caché en bits si mode vaut MODE_STC.
  *
  * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
  *
- * @warning Le fichier doit être créé avant d'appeller cette fonction.
- * @see writeHeader
+ * @see libererLecteurBits
  */
-int writeImage(char* pathFile, int* matrice, long int beginningImage, long int dimension);
+int initLecteurBits(lecteurBits_t* lecteur, sourceImage_t* source, int lengthDimensionPrefix, int mode, char* keyCrypt, unsigned int rows, unsigned int columns);
 
 /**
- * @fn int fileToBinary(char* fileToCrypt,unsigned char** msgSecretBit, size_t *length)
- * @brief Cette fonction lit un fichier et le convertit en un tableau binaire.
- *
- * Cette fonction prend un chemin vers un fichier en paramètre d'entrée et convertit le contenu de ce fichier en tableau binaire.
- * \n Une étape intermediaire est utilisée pour ce faire: d'abord la fonction lit le fichier char par char, puis grâce à la fonction printbincharpad, la fonction convertit les char en tableau binaire.
+ * @fn unsigned int lireBitExtrait(lecteurBits_t* lecteur, long int position)
+ * @brief Renvoit le bit numéro position du message caché.
  *
- * @param fileToCrypt Chaine de caractères correspondant au chemin vers le fichier que l'on veut convertir.
- * @param msgSecretBit Passage par adresse d'un tableau 1D contenant le tableau binaire correspondant au fichier.
- * @param length Passage par adresse de la taille du tableau binaire généré. De type size_t.
+ * En mode Hamming, le syndrome d'un bloc est le XOR des numéros de colonne (à partir de 1) des pixels dont le LSB vaut 1, ce qui évite la multiplication de matrices.
+ * Le syndrome du dernier bloc lu est gardé en cache: une lecture séquentielle ne calcule chaque syndrome qu'une seule fois.
  *
- * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ * @param lecteur Le lecteur de bits initialisé par initLecteurBits.
+ * @param position Position du bit dans le message.
  *
- * @warning Le tableau binaire est alloué dans la fonction. L'user doit le free après utilisation.
- * @see printbincharpad
+ * @return La valeur du bit (0 ou 1).
  */
-int fileToBinary(char* fileToCrypt,unsigned char** msgSecretBit, size_t *length);
+unsigned int lireBitExtrait(lecteurBits_t* lecteur, long int position);
+
+/**
+ * @fn unsigned char lireOctetExtrait(lecteurBits_t* lecteur, long int indexOctet)
+ * @brief Renvoit l'octet numéro indexOctet du message caché, en ne lisant que les 8 bits qui le composent.
+ *
+ * @param lecteur Le lecteur de bits initialisé par initLecteurBits.
+ * @param indexOctet Position de l'octet dans le message.
+ *
+ * @return La valeur de l'octet.
+ */
+unsigned char lireOctetExtrait(lecteurBits_t* lecteur, long int indexOctet);
+
+/**
+ * @fn int plageEchantillonsBits(const lecteurBits_t* lecteur, long int premierBit, long int nbBits, long int* debut, long int* fin)
+ * @brief Calcule la plage d'échantillons qui contient les bits premierBit à premierBit + nbBits - 1 du message caché.
+ *
+ * La plage n'est calculable que pour les modes qui insèrent le message dans des échantillons consécutifs: MODE_CLASSIQUE, MODE_LSBMR, MODE_KLSB et MODE_HAMMING.
+ *
+ * @param lecteur Le lecteur de bits initialisé par initLecteurBits.
+ * @param premierBit Position du premier bit dans le message.
+ * @param nbBits Nombre de bits.
+ * @param debut Passage par adresse du premier échantillon de la plage.
+ * @param fin Passage par adresse de l'échantillon qui suit la plage.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_INVARG si les bits ne sont pas dans des échantillons consécutifs.
+ */
+int plageEchantillonsBits(const lecteurBits_t* lecteur, long int premierBit, long int nbBits, long int* debut, long int* fin);
+
+/**
+ * @fn void libererLecteurBits(lecteurBits_t* lecteur)
+ * @brief Libère la mémoire allouée par initLecteurBits.
+ *
+ * @param lecteur Le lecteur à libérer.
+ */
+void libererLecteurBits(lecteurBits_t* lecteur);
+
+/**
+ * @fn void ouvrirFluxSortie(fluxSortie_t* flux, FILE* fichier, long int octetsUtiles)
+ * @brief Prépare un flux de sortie vers un fichier déjà ouvert.
+ *
+ * @param flux Le flux à initialiser.
+ * @param fichier Le fichier de destination.
+ * @param octetsUtiles Nombre d'octets à écrire. Les octets suivants (ex: suffixe d'extension) sont ignorés.
+ */
+void ouvrirFluxSortie(fluxSortie_t* flux, FILE* fichier, long int octetsUtiles);
+
+/**
+ * @fn int ecrireBitFlux(fluxSortie_t* flux, unsigned int bit)
+ * @brief Ajoute un bit au flux de sortie. Dès que 8 bits sont réunis, l'octet est placé dans le tampon, qui est écrit dans le fichier lorsqu'il est plein.
+ *
+ * @param flux Le flux de sortie.
+ * @param bit Le bit à ajouter (0 ou 1), bit de poids fort en premier.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int ecrireBitFlux(fluxSortie_t* flux, unsigned int bit);
+
+/**
+ * @fn int fermerFluxSortie(fluxSortie_t* flux)
+ * @brief Écrit les octets restant dans le tampon du flux. Le fichier n'est pas fermé.
+ *
+ * @param flux Le flux de sortie.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int fermerFluxSortie(fluxSortie_t* flux);
+
+/**
+ * @fn void verifierFluxSortie(fluxSortie_t* flux, const unsigned int* crcAttendus, long int tailleBloc)
+ * @brief Active la vérification CRC32C des octets écrits dans le flux: chaque bloc est vérifié dès qu'il est complet, avant d'être écrit dans le fichier.
+ *
+ * @param flux Le flux de sortie ouvert par ouvrirFluxSortie.
+ * @param crcAttendus CRC32C attendu pour chaque bloc.
+ * @param tailleBloc Taille d'un bloc en octets, diviseur de TAILLE_TAMPON_FLUX.
+ */
+void verifierFluxSortie(fluxSortie_t* flux, const unsigned int* crcAttendus, long int tailleBloc);
+
+/**
+ * @fn int decryptMessageVersFichier(lecteurBits_t* lecteur, const int* tableIndex, long int debutOctet, FILE* fichier, long int octetsUtiles, const unsigned int* crcAttendus, long int tailleBloc)
+ * @brief Décode en une seule passe les octets [debutOctet, debutOctet + octetsUtiles[ du flux caché et les écrit dans un fichier déjà ouvert.
+ *
+ * Si des CRC32C sont fournis, chaque bloc est vérifié dès qu'il a été décodé: le décodage s'arrête au premier bloc invalide, avant que celui-ci ne soit écrit.
+ *
+ * @param lecteur Le lecteur de bits initialisé sur l'image.
+ * @param tableIndex Table générée par genererTableDepermutation si le message a été permuté, NULL sinon.
+ * @param debutOctet Position du premier octet à écrire dans le flux caché (ex: taille de la table des CRC).
+ * @param fichier Le fichier de destination (fichier créé ou stdout).
+ * @param octetsUtiles Nombre d'octets à écrire.
+ * @param crcAttendus CRC32C attendu pour chaque bloc, NULL pour ne pas vérifier.
+ * @param tailleBloc Taille d'un bloc en octets (ignoré si crcAttendus vaut NULL).
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé, ERROR_CHECKSUM si un bloc est invalide.
+ *
+ * @see decryptMessageStream
+ */
+int decryptMessageVersFichier(lecteurBits_t* lecteur, const int* tableIndex, long int debutOctet, FILE* fichier, long int octetsUtiles, const unsigned int* crcAttendus, long int tailleBloc);
+
+/**
+ * @fn int decryptMessageStream(lecteurBits_t* lecteur, long int tailleMsgBit, char* keyPermutation, int estFichier, char** fileOutput)
+ * @brief Décode le message caché en une seule passe, de l'image jusqu'au fichier de sortie.
+ *
+ * Cette fonction remplace l'enchainement decryptMessage / depermuterTableau / binaryToUChar / readExtensionSuffix / createFileFromByte: \n
+ * les LSBs sont lus directement dans l'image, regroupés en octets par décalages et écrits au fur et à mesure, sans tableau de bits ni tableau d'octets de la taille du message.
+ * \n Si le message est un fichier, le suffixe d'extension (40 derniers bits) est lu en premier afin de créer le fichier, puis il est retiré de la sortie.
+ * \n Si le message est un texte, il est écrit sur la sortie standard.
+ *
+ * @param lecteur Le lecteur de bits initialisé sur l'image.
+ * @param tailleMsgBit Taille du message caché en bits (suffixe compris).
+ * @param keyPermutation La clé de la table de permutation si le message a été permuté par permuterTableau, NULL sinon.
+ * @param estFichier 1 si le message est un fichier, 0 si c'est un texte.
+ * @param fileOutput Passage par adresse du nom du fichier à créer (sans l'extension). L'extension lue dans le suffixe y est ajoutée. Ignoré si estFichier vaut 0.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @see lireBitExtrait
+ * @see genererTableDepermutation
+ */
+int decryptMessageStream(lecteurBits_t* lecteur, long int tailleMsgBit, char* keyPermutation, int estFichier, char** fileOutput);
+
+/**
+ * @fn int decryptPlageOctets(lecteurBits_t* lecteur, long int tailleMsgBit, int estFichier, long int offset, long int longueur, unsigned char* sortie, long int* octetsLus)
+ * @brief Extrait uniquement les octets [offset, offset+longueur[ du message caché.
+ *
+ * Chaque octet est lu directement à sa position dans l'image (classique, parcours calculable ou blocs de Hamming), le coût est donc proportionnel à la longueur de la plage et non à la taille du message.
+ * \n La plage est tronquée à la fin du message. Pour un fichier, le suffixe d'extension ne fait pas partie du message.
+ *
+ * @param lecteur Le lecteur de bits initialisé sur l'image.
+ * @param tailleMsgBit Taille du message caché en bits (suffixe compris).
+ * @param estFichier 1 si le message est un fichier (suffixe d'extension présent), 0 si c'est un texte.
+ * @param offset Position du premier octet à extraire.
+ * @param longueur Nombre d'octets à extraire.
+ * @param sortie Tableau d'au moins longueur octets qui recevra la plage extraite.
+ * @param octetsLus Passage par adresse du nombre d'octets réellement extraits.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @warning Le mode MODE_CHIFFRE nécessite la table complète du parcours, et un message permuté par permuterTableau ne peut pas être lu par plage: utiliser MODE_CHIFFRE_CALCULABLE.
+ */
+int decryptPlageOctets(lecteurBits_t* lecteur, long int tailleMsgBit, int estFichier, long int offset, long int longueur, unsigned char* sortie, long int* octetsLus);
+
+
+
+
+
+
+
+/************************************************
+ *  Fonctions conteneur
+ ***********************************************/
+
+/**
+ * @fn int serialiserEnteteConteneur(const enteteConteneur_t* entete, unsigned char* octets, int* taille)
+ * @brief Convertit un entête de conteneur en tableau d'octets.
+ *
+ * @param entete L'entête à convertir.
+ * @param octets Tableau d'au moins TAILLE_ENTETE_MAX octets qui recevra l'entête.
+ * @param taille Passage par adresse du nombre d'octets écrits.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @see lireEnteteConteneur
+ */
+int serialiserEnteteConteneur(const enteteConteneur_t* entete, unsigned char* octets, int* taille);
+
+/**
+ * @fn void enteteMessage(const char* nom, unsigned int flags, unsigned long longueur, enteteConteneur_t* entete)
+ * @brief Construit l'entête qui décrit un message indépendamment de son insertion: nom, indicateurs FLAG_CONTENEUR_FICHIER, FLAG_CONTENEUR_COMPRESSE et FLAG_CONTENEUR_CHIFFRE, taille.
+ *
+ * Sert de données associées au chiffrement d'un message réparti sur plusieurs images (voir reconstituerCharge) et des fichiers d'une archive (voir extraireEntreeArchive).
+ *
+ * @param nom Le nom du fichier (au plus TAILLE_NOM_CONTENEUR caractères), chaine vide pour un texte.
+ * @param flags Les indicateurs du message.
+ * @param longueur La taille du message inséré.
+ * @param entete Passage par adresse de l'entête construit.
+ */
+void enteteMessage(const char* nom, unsigned int flags, unsigned long longueur, enteteConteneur_t* entete);
+
+/**
+ * @fn int hideEnteteConteneur(const enteteConteneur_t* entete, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, int* tailleEnteteBit)
+ * @brief Cache l'entête du conteneur de manière classique juste après le prefixe.
+ *
+ * @param entete L'entête à cacher.
+ * @param matriceImage Le tableau de pixels.
+ * @param dimension Taille du tableau de pixels.
+ * @param pixelIntensity Intensité maximale des pixels.
+ * @param lengthDimensionPrefix Taille du prefixe: l'entête commence à cette position.
+ * @param tailleEnteteBit Passage par adresse de la taille de l'entête en bits. Le message commence donc à lengthDimensionPrefix + tailleEnteteBit.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int hideEnteteConteneur(const enteteConteneur_t* entete, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, int* tailleEnteteBit);
+
+/**
+ * @fn int lireEnteteConteneur(sourceImage_t* source, long int lengthDimensionPrefix, long int prefixInt, enteteConteneur_t* entete, int* tailleEnteteBit)
+ * @brief Lit et vérifie l'entête du conteneur situé juste après le prefixe.
+ *
+ * @param source La source de pixels de l'image.
+ * @param lengthDimensionPrefix Taille du prefixe.
+ * @param prefixInt Valeur du prefixe (fin des données cachées), utilisée pour vérifier la cohérence de l'entête.
+ * @param entete Passage par adresse de l'entête lu.
+ * @param tailleEnteteBit Passage par adresse de la taille de l'entête en bits.
+ *
+ * @return ERROR_OK si un entête valide a été trouvé, ERROR_FORMAT si l'image a été créée sans entête (ancien format) ou si l'entête est incohérent.
+ */
+int lireEnteteConteneur(sourceImage_t* source, long int lengthDimensionPrefix, long int prefixInt, enteteConteneur_t* entete, int* tailleEnteteBit);
+
+/**
+ * @fn int analyserEnteteConteneur(const unsigned char* octets, enteteConteneur_t* entete, int* longueurNom)
+ * @brief Décode et vérifie la partie fixe (TAILLE_ENTETE_FIXE octets) d'un entête de conteneur, sans son nom.
+ *
+ * @param octets Les TAILLE_ENTETE_FIXE premiers octets de l'entête.
+ * @param entete Passage par adresse de l'entête décodé (le nom n'est pas rempli).
+ * @param longueurNom Passage par adresse de la longueur du nom qui suit la partie fixe.
+ *
+ * @return ERROR_OK si la partie fixe est valide, ERROR_FORMAT sinon.
+ *
+ * @see lireEnteteConteneur
+ */
+int analyserEnteteConteneur(const unsigned char* octets, enteteConteneur_t* entete, int* longueurNom);
+
+/**
+ * @fn int lireFichierOctets(const char* pathFile, unsigned char** octets, size_t* taille)
+ * @brief Lit tout le contenu d'un fichier dans un tableau d'octets.
+ *
+ * @param pathFile Chemin vers le fichier.
+ * @param octets Passage par adresse du tableau d'octets, alloué dans la fonction.
+ * @param taille Passage par adresse du nombre d'octets lus.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @warning Le tableau est alloué dans la fonction. L'utilisateur doit le libérer après utilisation.
+ */
+int lireFichierOctets(const char* pathFile, unsigned char** octets, size_t* taille);
+
+/**
+ * @fn int octetsVersBinaire(const unsigned char* octets, size_t taille, unsigned char** bits, size_t* tailleBit)
+ * @brief Convertit un tableau d'octets en tableau de bits (un bit, valant 0 ou 1, par case), bit de poids fort en premier.
+ *
+ * @param octets Le tableau d'octets.
+ * @param taille Nombre d'octets.
+ * @param bits Passage par adresse du tableau de bits, alloué dans la fonction.
+ * @param tailleBit Passage par adresse de la taille du tableau de bits.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int octetsVersBinaire(const unsigned char* octets, size_t taille, unsigned char** bits, size_t* tailleBit);
+
+
+
+
+
+
+
+/************************************************
+ *  Fonctions compression
+ ***********************************************/
+
+/**
+ * @fn int compresserLZ(const unsigned char* source, size_t taille, unsigned char* destination, size_t capacite, size_t* tailleDestination)
+ * @brief Compresse un tableau d'octets avec un algorithme LZ77 rapide (table de hachage sur 4 octets, une seule passe).
+ *
+ * Le résultat est une suite de séquences: jeton (4 bits longueur des littéraux | 4 bits longueur de la répétition - LONGUEUR_MIN_LZ) | octets supplémentaires de longueur | littéraux | distance (2 octets, little-endian) | octets supplémentaires de longueur.
+ * \n Une longueur de 15 dans le jeton est complétée par des octets 255 ... 255 n (n < 255). La dernière séquence ne contient que des littéraux.
+ *
+ * @param source Les octets à compresser.
+ * @param taille Nombre d'octets à compresser.
+ * @param destination Tableau qui recevra les octets compressés.
+ * @param capacite Taille du tableau destination. taille + taille / 255 + 16 octets suffisent toujours.
+ * @param tailleDestination Passage par adresse du nombre d'octets compressés.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé, ERROR_NOMEM si la capacité est insuffisante.
+ *
+ * @see decompresserLZ
+ */
+int compresserLZ(const unsigned char* source, size_t taille, unsigned char* destination, size_t capacite, size_t* tailleDestination);
+
+/**
+ * @fn int decompresserLZ(const unsigned char* source, size_t taille, unsigned char* destination, size_t tailleAttendue)
+ * @brief Décompresse des octets produits par compresserLZ.
+ *
+ * @param source Les octets compressés.
+ * @param taille Nombre d'octets compressés.
+ * @param destination Tableau d'au moins tailleAttendue octets qui recevra les octets décompressés.
+ * @param tailleAttendue Nombre exact d'octets décompressés attendus.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé, ERROR_FORMAT si les données sont corrompues.
+ */
+int decompresserLZ(const unsigned char* source, size_t taille, unsigned char* destination, size_t tailleAttendue);
+
+/**
+ * @fn int compresserCharge(unsigned char** charge, size_t* tailleCharge, int* compresse)
+ * @brief Compresse le message si cela réduit sa taille.
+ *
+ * Pour un gros message, les TAILLE_ECHANTILLON_LZ premiers octets sont compressés d'abord: s'ils ne gagnent rien (données déjà compressées, chiffrées...), le message est laissé tel quel sans le compresser en entier.
+ * \n Le message compressé est précédé de sa taille d'origine (4 octets, big-endian).
+ *
+ * @param charge Passage par adresse du message, remplacé par sa version compressée si elle est plus petite.
+ * @param tailleCharge Passage par adresse de la taille du message.
+ * @param compresse Passage par adresse: 1 si le message a été remplacé par sa version compressée, 0 sinon.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int compresserCharge(unsigned char** charge, size_t* tailleCharge, int* compresse);
+
+/**
+ * @fn int decompresserCharge(const unsigned char* charge, size_t tailleCharge, unsigned char** sortie, size_t* tailleSortie)
+ * @brief Décompresse un message produit par compresserCharge.
+ *
+ * @param charge Le message compressé (taille d'origine comprise).
+ * @param tailleCharge Taille du message compressé.
+ * @param sortie Passage par adresse du message décompressé, alloué dans la fonction.
+ * @param tailleSortie Passage par adresse de la taille du message décompressé.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé, ERROR_FORMAT si les données sont corrompues.
+ *
+ * @warning Le tableau est alloué dans la fonction. L'utilisateur doit le libérer après utilisation.
+ */
+int decompresserCharge(const unsigned char* charge, size_t tailleCharge, unsigned char** sortie, size_t* tailleSortie);
+
+
+
+
+
+
+
+/************************************************
+ *  Fonctions chiffrement authentifié
+ ***********************************************/
+
+/**
+ * @fn unsigned int lireMot32LE(const unsigned char* octets)
+ * @brief Lit un mot de 32 bits little-endian.
+ *
+ * @param octets Les 4 octets du mot.
+ *
+ * @return Le mot lu.
+ */
+unsigned int lireMot32LE(const unsigned char* octets);
+
+/**
+ * @fn void ecrireMot32LE(unsigned char* octets, unsigned int mot)
+ * @brief Écrit un mot de 32 bits en little-endian.
+ *
+ * @param octets Tableau d'au moins 4 octets.
+ * @param mot Le mot à écrire.
+ */
+void ecrireMot32LE(unsigned char* octets, unsigned int mot);
+
+/**
+ * @fn void transformerSha256(sha256_t* contexte, const unsigned char* bloc)
+ * @brief Applique la fonction de compression SHA-256 à un bloc de 64 octets.
+ *
+ * @param contexte Le contexte SHA-256.
+ * @param bloc Le bloc de 64 octets.
+ */
+void transformerSha256(sha256_t* contexte, const unsigned char* bloc);
+
+/**
+ * @fn void initSha256(sha256_t* contexte)
+ * @brief Initialise un contexte SHA-256.
+ *
+ * @param contexte Le contexte à initialiser.
+ */
+void initSha256(sha256_t* contexte);
+
+/**
+ * @fn void majSha256(sha256_t* contexte, const unsigned char* donnees, size_t taille)
+ * @brief Ajoute des octets à l'empreinte en cours.
+ *
+ * @param contexte Le contexte SHA-256.
+ * @param donnees Les octets à hacher.
+ * @param taille Nombre d'octets.
+ */
+void majSha256(sha256_t* contexte, const unsigned char* donnees, size_t taille);
+
+/**
+ * @fn void finSha256(sha256_t* contexte, unsigned char empreinte[TAILLE_SHA256])
+ * @brief Termine le calcul de l'empreinte SHA-256.
+ *
+ * @param contexte Le contexte SHA-256 (inutilisable ensuite).
+ * @param empreinte Tableau qui recevra l'empreinte.
+ */
+void finSha256(sha256_t* contexte, unsigned char empreinte[TAILLE_SHA256]);
+
+/**
+ * @fn void deriverCle(const char* motDePasse, const unsigned char* sel, size_t tailleSel, unsigned int iterations, unsigned char cle[TAILLE_CLE_AEAD])
+ * @brief Dérive une clé de chiffrement d'un mot de passe avec PBKDF2-HMAC-SHA256.
+ *
+ * @param motDePasse Le mot de passe fourni par l'utilisateur.
+ * @param sel Le sel aléatoire stocké avec le message.
+ * @param tailleSel Taille du sel en octets.
+ * @param iterations Nombre d'itérations (ITERATIONS_PBKDF2).
+ * @param cle Tableau qui recevra la clé.
+ */
+void deriverCle(const char* motDePasse, const unsigned char* sel, size_t tailleSel, unsigned int iterations, unsigned char cle[TAILLE_CLE_AEAD]);
+
+/**
+ * @fn void initEtatChaCha20(unsigned int etat[16], const unsigned char cle[TAILLE_CLE_AEAD], const unsigned char nonce[TAILLE_NONCE_AEAD], unsigned int compteur)
+ * @brief Prépare l'état ChaCha20 (constantes, clé, compteur de bloc, nonce) selon la RFC 8439.
+ *
+ * @param etat Tableau qui recevra l'état.
+ * @param cle La clé.
+ * @param nonce Le nonce.
+ * @param compteur Numéro du premier bloc.
+ */
+void initEtatChaCha20(unsigned int etat[16], const unsigned char cle[TAILLE_CLE_AEAD], const unsigned char nonce[TAILLE_NONCE_AEAD], unsigned int compteur);
+
+/**
+ * @fn void blocChaCha20(const unsigned int etat[16], unsigned char sortie[64])
+ * @brief Calcule un bloc de 64 octets de flux ChaCha20.
+ *
+ * @param etat L'état ChaCha20 (le compteur désigne le bloc calculé).
+ * @param sortie Tableau qui recevra le bloc.
+ */
+void blocChaCha20(const unsigned int etat[16], unsigned char sortie[64]);
+
+#if defined(__x86_64__)
+/**
+ * @fn void xorChaCha20x4(const unsigned int etat[16], unsigned char* donnees)
+ * @brief Calcule 4 blocs ChaCha20 consécutifs en parallèle avec SSE2 et les applique (XOR) sur 256 octets.
+ *
+ * @param etat L'état ChaCha20 (le compteur désigne le premier des 4 blocs).
+ * @param donnees Les 256 octets à chiffrer ou déchiffrer.
+ */
+void xorChaCha20x4(const unsigned int etat[16], unsigned char* donnees);
+#endif
+
+/**
+ * @fn void xorChaCha20(const unsigned char cle[TAILLE_CLE_AEAD], const unsigned char nonce[TAILLE_NONCE_AEAD], unsigned long long position, unsigned char* donnees, size_t taille)
+ * @brief Chiffre ou déchiffre des octets du message avec le flux ChaCha20 (à partir du bloc 1).
+ *
+ * @param cle La clé.
+ * @param nonce Le nonce.
+ * @param position Position du premier octet dans le message, ce qui permet de ne déchiffrer qu'une portion.
+ * @param donnees Les octets à chiffrer ou déchiffrer, modifiés sur place.
+ * @param taille Nombre d'octets.
+ */
+void xorChaCha20(const unsigned char cle[TAILLE_CLE_AEAD], const unsigned char nonce[TAILLE_NONCE_AEAD], unsigned long long position, unsigned char* donnees, size_t taille);
+
+/**
+ * @fn void initPoly1305(poly1305_t* contexte, const unsigned char cle[32])
+ * @brief Initialise un contexte Poly1305 avec une clé à usage unique.
+ *
+ * @param contexte Le contexte à initialiser.
+ * @param cle La clé (r | s).
+ */
+void initPoly1305(poly1305_t* contexte, const unsigned char cle[32]);
+
+/**
+ * @fn void blocsPoly1305(poly1305_t* contexte, const unsigned char* donnees, size_t taille, unsigned int bitFort)
+ * @brief Ajoute des blocs complets de 16 octets à l'accumulateur Poly1305.
+ *
+ * @param contexte Le contexte Poly1305.
+ * @param donnees Les blocs.
+ * @param taille Nombre d'octets (multiple de 16).
+ * @param bitFort 1 << 24 pour un bloc complet, 0 pour le dernier bloc déjà complété.
+ */
+void blocsPoly1305(poly1305_t* contexte, const unsigned char* donnees, size_t taille, unsigned int bitFort);
+
+/**
+ * @fn void majPoly1305(poly1305_t* contexte, const unsigned char* donnees, size_t taille)
+ * @brief Ajoute des octets au tag en cours.
+ *
+ * @param contexte Le contexte Poly1305.
+ * @param donnees Les octets.
+ * @param taille Nombre d'octets.
+ */
+void majPoly1305(poly1305_t* contexte, const unsigned char* donnees, size_t taille);
+
+/**
+ * @fn void finPoly1305(poly1305_t* contexte, unsigned char tag[TAILLE_TAG_AEAD])
+ * @brief Termine le calcul du tag Poly1305.
+ *
+ * @param contexte Le contexte Poly1305.
+ * @param tag Tableau qui recevra le tag.
+ */
+void finPoly1305(poly1305_t* contexte, unsigned char tag[TAILLE_TAG_AEAD]);
+
+/**
+ * @fn void tagChaCha20Poly1305(const unsigned char cle[TAILLE_CLE_AEAD], const unsigned char nonce[TAILLE_NONCE_AEAD], const unsigned char* aad, size_t tailleAad, const unsigned char* chiffre, size_t taille, unsigned char tag[TAILLE_TAG_AEAD])
+ * @brief Calcule le tag AEAD ChaCha20-Poly1305 (RFC 8439) d'un message chiffré et de ses données associées.
+ *
+ * @param cle La clé.
+ * @param nonce Le nonce.
+ * @param aad Les données associées (authentifiées mais non chiffrées).
+ * @param tailleAad Taille des données associées.
+ * @param chiffre Le message chiffré.
+ * @param taille Taille du message chiffré.
+ * @param tag Tableau qui recevra le tag.
+ */
+void tagChaCha20Poly1305(const unsigned char cle[TAILLE_CLE_AEAD], const unsigned char nonce[TAILLE_NONCE_AEAD], const unsigned char* aad, size_t tailleAad, const unsigned char* chiffre, size_t taille, unsigned char tag[TAILLE_TAG_AEAD]);
+
+/**
+ * @fn int lireAleatoire(unsigned char* octets, size_t taille)
+ * @brief Remplit un tableau d'octets aléatoires cryptographiques (/dev/urandom).
+ *
+ * @param octets Le tableau à remplir.
+ * @param taille Nombre d'octets.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int lireAleatoire(unsigned char* octets, size_t taille);
+
+/**
+ * @fn int chiffrerCharge(unsigned char** charge, size_t* tailleCharge, const char* motDePasse, const unsigned char* aad, size_t tailleAad)
+ * @brief Chiffre et authentifie le message avec ChaCha20-Poly1305.
+ *
+ * La clé est dérivée du mot de passe et d'un sel aléatoire (deriverCle), le nonce est aléatoire. \n
+ * Le message est remplacé par: sel (16) | nonce (12) | message chiffré | tag (16). \n
+ * Les données associées sont l'entête sérialisé du conteneur: le tag authentifie aussi le mode, les indicateurs et les longueurs.
+ *
+ * @param charge Passage par adresse du message, réalloué dans la fonction.
+ * @param tailleCharge Passage par adresse de la taille du message, augmentée de TAILLE_SURCOUT_AEAD.
+ * @param motDePasse Le mot de passe.
+ * @param aad Les données associées.
+ * @param tailleAad Taille des données associées.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @see dechiffrerCharge
+ */
+int chiffrerCharge(unsigned char** charge, size_t* tailleCharge, const char* motDePasse, const unsigned char* aad, size_t tailleAad);
+
+/**
+ * @fn int dechiffrerCharge(const unsigned char* charge, size_t tailleCharge, const char* motDePasse, const unsigned char* aad, size_t tailleAad, unsigned char** sortie, size_t* tailleSortie)
+ * @brief Vérifie le tag puis déchiffre un message produit par chiffrerCharge.
+ *
+ * @param charge Le message chiffré (sel, nonce et tag compris).
+ * @param tailleCharge Taille du message chiffré.
+ * @param motDePasse Le mot de passe.
+ * @param aad Les données associées, identiques à celles passées à chiffrerCharge.
+ * @param tailleAad Taille des données associées.
+ * @param sortie Passage par adresse du message déchiffré, alloué dans la fonction.
+ * @param tailleSortie Passage par adresse de la taille du message déchiffré.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé, ERROR_AUTHENTIFICATION si le tag est invalide (mauvais mot de passe, message ou entête modifié).
+ *
+ * @warning Le tableau est alloué dans la fonction. L'utilisateur doit le libérer après utilisation.
+ */
+int dechiffrerCharge(const unsigned char* charge, size_t tailleCharge, const char* motDePasse, const unsigned char* aad, size_t tailleAad, unsigned char** sortie, size_t* tailleSortie);
+
+/**
+ * @fn int scellerCharge(const enteteConteneur_t* entete, unsigned char** charge, size_t* tailleCharge, const char* motDePasse)
+ * @brief Applique au message compressé les transformations indiquées par l'entête: chiffrement (l'entête sérialisé en données associées) puis table des CRC.
+ *
+ * @param entete L'entête du conteneur, complet: entete->longueurCharge vaut la taille du message chiffré.
+ * @param charge Passage par adresse du message, réalloué dans la fonction.
+ * @param tailleCharge Passage par adresse de la taille du message.
+ * @param motDePasse Le mot de passe si FLAG_CONTENEUR_CHIFFRE est présent, ignoré sinon.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_INVARG si la taille du message ne correspond pas à l'entête.
+ *
+ * @see restaurerCharge
+ */
+int scellerCharge(const enteteConteneur_t* entete, unsigned char** charge, size_t* tailleCharge, const char* motDePasse);
+
+/**
+ * @fn int restaurerCharge(const enteteConteneur_t* entete, unsigned char* charge, size_t tailleCharge, const char* motDePasse, unsigned char** sortie, size_t* tailleSortie)
+ * @brief Annule les transformations appliquées au message avant l'insertion (chiffrement puis compression) selon les indicateurs de l'entête.
+ *
+ * @param entete L'entête du conteneur, authentifié avec le message s'il est chiffré.
+ * @param charge Le message tel qu'il a été extrait de l'image (sans la table des CRC).
+ * @param tailleCharge Taille du message extrait.
+ * @param motDePasse Le mot de passe si le message est chiffré, NULL sinon.
+ * @param sortie Passage par adresse du message d'origine, alloué dans la fonction.
+ * @param tailleSortie Passage par adresse de la taille du message d'origine.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @warning Le tableau est alloué dans la fonction. L'utilisateur doit le libérer après utilisation.
+ */
+int restaurerCharge(const enteteConteneur_t* entete, unsigned char* charge, size_t tailleCharge, const char* motDePasse, unsigned char** sortie, size_t* tailleSortie);
+
+
+
+
+
+
+
+/************************************************
+ *  Fonctions somme de contrôle
+ ***********************************************/
+
+/**
+ * @fn unsigned int crc32c(const unsigned char* octets, size_t taille)
+ * @brief Calcule le CRC32C (polynôme de Castagnoli) d'un tableau d'octets.
+ *
+ * Utilise l'instruction crc32 de SSE4.2 lorsque le processeur la supporte (8 octets par instruction), et une table de 256 valeurs sinon.
+ *
+ * @param octets Le tableau d'octets.
+ * @param taille Nombre d'octets.
+ *
+ * @return Le CRC32C des octets.
+ */
+unsigned int crc32c(const unsigned char* octets, size_t taille);
+
+/**
+ * @fn unsigned int crc32cTable(unsigned int crc, const unsigned char* octets, size_t taille)
+ * @brief Met à jour un CRC32C octet par octet grâce à une table de 256 valeurs (processeurs sans SSE4.2).
+ *
+ * @param crc Le CRC en cours (sans inversion finale).
+ * @param octets Le tableau d'octets.
+ * @param taille Nombre d'octets.
+ *
+ * @return Le CRC mis à jour (sans inversion finale).
+ */
+unsigned int crc32cTable(unsigned int crc, const unsigned char* octets, size_t taille);
+
+#if defined(__x86_64__)
+/**
+ * @fn unsigned int crc32cMateriel(unsigned int crc, const unsigned char* octets, size_t taille)
+ * @brief Met à jour un CRC32C avec l'instruction crc32 de SSE4.2, 8 octets à la fois.
+ *
+ * @param crc Le CRC en cours (sans inversion finale).
+ * @param octets Le tableau d'octets.
+ * @param taille Nombre d'octets.
+ *
+ * @return Le CRC mis à jour (sans inversion finale).
+ *
+ * @warning Ne doit être appelée que si le processeur supporte SSE4.2.
+ */
+unsigned int crc32cMateriel(unsigned int crc, const unsigned char* octets, size_t taille);
+#endif
+
+/**
+ * @fn long int nbBlocsCrc(const enteteConteneur_t* entete)
+ * @brief Calcule le nombre de blocs vérifiés par CRC32C d'un conteneur.
+ *
+ * @param entete L'entête du conteneur.
+ *
+ * @return Le nombre de blocs (0 si FLAG_CONTENEUR_CRC est absent). La table des CRC occupe 4 octets par bloc.
+ */
+long int nbBlocsCrc(const enteteConteneur_t* entete);
+
+/**
+ * @fn int ajouterTableCrc(unsigned char** charge, size_t* tailleCharge, long int tailleBloc)
+ * @brief Calcule le CRC32C de chaque bloc du message et place la table des CRC (big-endian) devant le message.
+ *
+ * @param charge Passage par adresse du message, réalloué dans la fonction.
+ * @param tailleCharge Passage par adresse de la taille du message, la taille de la table y est ajoutée.
+ * @param tailleBloc Taille d'un bloc en octets.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int ajouterTableCrc(unsigned char** charge, size_t* tailleCharge, long int tailleBloc);
+
+/**
+ * @fn unsigned char lireOctetIndexe(lecteurBits_t* lecteur, const int* tableIndex, long int indexOctet)
+ * @brief Lit un octet du flux caché en tenant compte de la permutation des bits.
+ *
+ * @param lecteur Le lecteur de bits initialisé sur l'image.
+ * @param tableIndex Table générée par genererTableDepermutation si le message a été permuté, NULL sinon.
+ * @param indexOctet Numéro de l'octet dans le flux caché.
+ *
+ * @return L'octet lu.
+ */
+unsigned char lireOctetIndexe(lecteurBits_t* lecteur, const int* tableIndex, long int indexOctet);
+
+/**
+ * @fn int lireTableCrc(lecteurBits_t* lecteur, const int* tableIndex, long int nbBlocs, unsigned int** crcAttendus)
+ * @brief Lit la table des CRC32C placée au début du flux caché.
+ *
+ * @param lecteur Le lecteur de bits initialisé sur l'image.
+ * @param tableIndex Table générée par genererTableDepermutation si le message a été permuté, NULL sinon.
+ * @param nbBlocs Nombre de blocs (nbBlocsCrc).
+ * @param crcAttendus Passage par adresse de la table des CRC, allouée dans la fonction.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @warning Le tableau est alloué dans la fonction. L'utilisateur doit le libérer après utilisation.
+ */
+int lireTableCrc(lecteurBits_t* lecteur, const int* tableIndex, long int nbBlocs, unsigned int** crcAttendus);
+
+/**
+ * @fn int verifierBlocsCrc(verificationBlocs_t* travail)
+ * @brief Décode et vérifie les blocs premierBloc, premierBloc + pas, ... du message sans rien écrire. S'arrête au premier bloc invalide.
+ *
+ * @param travail Description des blocs à vérifier. Le premier bloc invalide est placé dans travail->blocInvalide (-1 si aucun).
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé, ERROR_CHECKSUM si un bloc est invalide.
+ */
+int verifierBlocsCrc(verificationBlocs_t* travail);
+
+/**
+ * @fn int verifierChargeParallele(char* pathFile, lecteurBits_t* lecteur, const int* tableIndex, long int debutOctet, long int longueurCharge, const unsigned int* crcAttendus, long int tailleBloc, long int* blocInvalide)
+ * @brief Vérifie tous les blocs du message en les répartissant sur plusieurs threads (un par coeur, au plus NB_THREADS_VERIFICATION_MAX).
+ *
+ * @param pathFile Chemin vers l'image, ré-ouverte par chaque thread (ignoré si la source du lecteur est en mémoire).
+ * @param lecteur Le lecteur de bits initialisé sur l'image, servant de modèle aux threads.
+ * @param tableIndex Table générée par genererTableDepermutation si le message a été permuté, NULL sinon.
+ * @param debutOctet Position du premier octet du message dans le flux caché.
+ * @param longueurCharge Taille du message en octets.
+ * @param crcAttendus CRC32C attendu pour chaque bloc.
+ * @param tailleBloc Taille d'un bloc en octets.
+ * @param blocInvalide Passage par adresse du plus petit numéro de bloc invalide (-1 si tous les blocs sont valides).
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé, ERROR_CHECKSUM si un bloc est invalide.
+ */
+int verifierChargeParallele(char* pathFile, lecteurBits_t* lecteur, const int* tableIndex, long int debutOctet, long int longueurCharge, const unsigned int* crcAttendus, long int tailleBloc, long int* blocInvalide);
+
+
+
+
+
+
+
+/************************************************
+ *  Fonctions Conversion
+ ***********************************************/
+
+/**
+ * @fn int* num_to_bit(long int a, long int *len)
+ * @brief Convertit un entier en un tableau binaire.
+ *
+ * La fonction retourne un tableau binaire en fonction d'un entier passé en paramètre. La fonction retourne aussi en passage par adresse la taille du tableau binaire.
+ *
+ * @param a L'entier que l'on veut convertir
+ * @param len Passage par adresse de la valeur de la taille du tableau binaire
+ * @return Tableau binaire
+ *
+ * @warning Le tableau binaire ne doit pas être initialisé avant d'utiliser la fonction. L'allocation dynamique se fait dans la fonction.
+ */
+int* num_to_bit(long int a, long int *len);
+
+/**
+ * @fn unsigned char* stringToBinary(char* s, size_t *length)
+ * @brief Convertit une chaine de caractère en un tableau binaire de type unsigned char.
+ *
+ * La fonction retourne un pointer vers un unsigned char comportant la chaine de caractère passée en paramètre sous format binaire. La taille de ce tableau est également renvoyé en passage par adresse.
+ * \n L'allocation dynamique du tableau se fait dans la fonction.
+ *
+ * @param s La chaine de caractère (Pointer vers char)
+ * @param length Passage par adresse de la taille du tableau binaire (type size_t)
+ * @return Tableau binaire de type pointeur vers unsigned char
+ *
+ * @warning Le tableau binaire ne doit pas être initialisé avant d'utiliser la fonction. L'allocation dynamique se fait dans la fonction.
+ */
+unsigned char* stringToBinary(char* s, size_t *length);
+
+
+/**
+ * @fn unsigned long hash(unsigned char *str)
+ * @brief Renvoit le hash de type unsigned long d'une chaine de caractère (unsigned également). Le hash est calculé suivant l'algorithme djb2 créé par Dan Bernstein.
+ *
+ * @param str La chaine de caractère que l'on souhaite hasher, de type unsigned char.
+ * @return Renvoit le hash correspondant à la chaine de caractère, de type unsigned long.
+ *
+ * @see http://www.cse.yorku.ca/~oz/hash.html
+ */
+unsigned long hash(unsigned char *str);
+
+/**
+ * @fn int binaryToUChar(long int tailleMsgDecrypt, const unsigned char *messageSecretBitOutput, unsigned char **msgSecret, int* lengthmsgSecret)
+ * @brief Cette fonction prend en entrée un tableau binaire et renvoit un tableau de unsigned char, convertit par groupe d'octets.
+ *
+ * Le tableau de sortie est alloué dans la fonction et sa taille est renvoyé en passage par adresse.
+ *
+ * @param tailleMsgDecrypt La taille du tableau binaire que l'on souhaite convertir, de type long int.
+ * @param messageSecretBitOutput Le tableau binaire que l'on souhaite convertir de type unsigned char. (Mais stocké avec du binaire).
+ * @param msgSecret Passage par adresse du tableau des unsigned char.
+ * @param lengthmsgSecret Passage par adresse de la taille du tableau converti.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @warning Le tableau de sortie msgSecret ne doit pas être alloué avant la fonction, l'allocation dynamique de mémoire ce fait dans la fonction. L'utilisateur doit free ce tableau après utilisation.
+ */
+int binaryToUChar(long int tailleMsgDecrypt, const unsigned char *messageSecretBitOutput, unsigned char **msgSecret, int* lengthmsgSecret);
+
+/**
+ * @fn void printbincharpad(char c, char* tabBit)
+ * @brief Cette fonction convertit un caractère en un tableau de binaire.
+ *
+ * Le tableau passé en passage par adresse contenant le tableau binaire du caractère doit être alloué avant la fonction.
+ *
+ * @param c Le caractère que l'on souhaite convertir en binaire.
+ * @param tabBit Passage par adresse du tableau binaire de taille 8 et de type char.
+ */
+void printbincharpad(char c, char* tabBit);
+
+
+/**
+ * @fn int addExtension(char** fileOutput, const char *extensionPixelMap)
+ * @brief Cette fonction ajoute une chaine de caractère (Une extension dans notre cas) à une autre chaine de caractère (un nom de fichier dans notre cas)
+ *
+ * La réallocation dynamique se fait à l'interieur de la fonction.
+ * \n Nul besoin de passer la taille des deux chaines de caractères.
+ * \n L'extension se rajoute à la toute fin de la chaine de caractère.
+ * \n L'extension doit contenir un '.' en début de chaine.
+ *
+ * @param fileOutput Passage par adresse de la chaine de caractère à laquelle on souhaite ajouter l'extension.
+ * @param extensionPixelMap Chaine de caractère (i.e l'extension) que l'on souhaite ajouter à la fin.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int addExtension(char** fileOutput, const char *extensionPixelMap);
+
+
+
+
+
+
+
+/************************************************
+ *  Fonctions manipulation de fichiers
+ ***********************************************/
+
+/**
+ * @fn int readHeader(char* pathFile, char* typeFile, long int *imageWidth, long int *imageHeight, long int *pixelIntensity, long int *positionCursor)
+ * @brief Cette fonction récupère les informations du header d'un fichier portable pixel map.
+ *
+ * La fonction ouvre un fichier portable pixmap et lit le header qui la compose. Elle récupère les dimensions de l'image, la profondeur des pixels ainsi que le type de fichier. Elle retourne également la position du curseur à laquelle se trouve la fin du header.
+ * \n La fonction fait abstraction des commentaires présents dans le header (lignes commençant par '#')
+ *
+ * @param pathFile Chaine de caractères representant le chemin vers le fichier portable pixmap que l'on souhaite analyser.
+ * @param typeFile Passage par adresse d'une chaine de caractère representant le type de fichier. (Exemple: P5 ou P6)
+ * @param imageWidth Passage par adresse de la largeur de l'image en pixel. Type long int.
+ * @param imageHeight Passage par adresse de la hauteur de l'image en pixel. Type long int.
+ * @param pixelIntensity Passage par adresse de l'intensité des pixels (par exemple 255). Type long int.
+ * @param positionCursor Passage par adresse de la position du curseur de la fin du header, utile afin de savoir à partir de quelle ligne commence la matrice image. Type long int.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int readHeader(char* pathFile, char* typeFile, long int *imageWidth, long int *imageHeight, long int *pixelIntensity, long int *positionCursor);
+
+/**
+ * @fn int readImage(char* pathFile, int* matrice, long int beginningImage, long int dimension)
+ * @brief Cette fonction lit une image portable pixmap et retourne un tableau de 1 dimension contenant la matrice des pixels de l'image.
+ *
+ * La dimension du tableau doit être calculé au préalable (i.e longueur*hauteur ou longueur*hauteur*3 dépendant de si l'image est en noir et blanc ou non).
+ *
+ * @param pathFile Chaine de caractères représentant le chemin vers le fichier portable pixmap que l'on souhaite analyser.
+ * @param matrice Tableau d'entiers qui contiendra la matrice des pixels de l'image.
+ * @param beginningImage Position du curseur à partir de laquelle la matrice de l'image commence. Cette position peut être determinée grâce à la fonction readHeader.
+ * @param dimension Dimension du tableau de la matrice image, à determiner avant d'utiliser la fonction.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @see readHeader
+ * @warning Le tableau qui contiendra la matrice des pixels de l'image doit être alloué avant d'appeller la fonction. Et l'utilisateur est libre de le free après.
+ */
+int readImage(char* pathFile, int* matrice, long int beginningImage, long int dimension);
+
+/**
+ * @fn int writeHeader(char* pathFile, char* typeFile, long int imageWidth, long int imageHeight, long int pixelIntensity, long int *positionCursor)
+ * @brief Cette fonction recrée un header d'un fichier portable pixmap en fonction des données passées en paramètre.
+ *
+ * Cette fonction est la complémentaire de la fonction readHeader.
+ *
+ * @param pathFile Chaine de caractère representant le chemin vers le fichier portable pixmap où l'on souhaite ajouter le header. Si le fichier n'existe pas, il sera créé.
+ * @param typeFile Chaine de caractère representant le type de fichier. (Exemple: P5 ou P6)
+ * @param imageWidth Largeur de l'image en pixel. Type long int.
+ * @param imageHeight Hauteur de l'image en pixel. Type long int.
+ * @param pixelIntensity Intensité des pixels (par exemple 255). Type long int.
+ * @param positionCursor Passage par adresse de la position du curseur de la fin du header, utile afin de savoir à partir de quelle ligne commence la matrice image. Type long int.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @warning Le fichier peut ou ne peut pas exister. Le cas échéant, il sera crée.
+ * @warning Les commentaires ne peuvent pas être ajouté dans ce nouveau header.
+ */
+int writeHeader(char* pathFile, char* typeFile, long int imageWidth, long int imageHeight, long int pixelIntensity, long int *positionCursor);
+
+/**
+ * @fn int writeImage(char* pathFile, int* matrice, long int beginningImage, long int dimension)
+ * @brief Cette fonction ajoute une matrice de pixel passée en paramètre à un fichier portable pixmap.
+ *
+ * Cette fonction est la complémentaire de la fonction readImage.
+ *
+ * @param pathFile Chaine de caractère representant le chemin vers le fichier portable pixmap où l'on souhaite ajouter le header. Le fichier doit être créé au préalable.
+ * @param matrice Matrice de pixel que l'on souhaite ajouter à l'image.
+ * @param beginningImage Position du curseur representant la fin du header de l'image. Peut être determiné grâce à la fonction writeHeader
+ * @param dimension Dimension du tableau de pixel.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @warning Le fichier doit être créé avant d'appeller cette fonction.
+ * @see writeHeader
+ */
+int writeImage(char* pathFile, int* matrice, long int beginningImage, long int dimension);
+
+/**
+ * @fn int readHeaderPAM(char* pathFile, long int *imageWidth, long int *imageHeight, long int *profondeur, long int *pixelIntensity, char* tuplType, long int *positionCursor)
+ * @brief Lit l'entête d'un fichier portable arbitrary map (P7).
+ *
+ * L'entête est une suite de lignes "CLE valeur" (WIDTH, HEIGHT, DEPTH, MAXVAL, TUPLTYPE) terminée par ENDHDR. Les commentaires ('#') et les clés inconnues sont ignorés.
+ * \n Plusieurs lignes TUPLTYPE sont concaténées, séparées par un espace.
+ *
+ * @param pathFile Chemin vers le fichier P7.
+ * @param imageWidth Passage par adresse de la largeur de l'image en pixel.
+ * @param imageHeight Passage par adresse de la hauteur de l'image en pixel.
+ * @param profondeur Passage par adresse du nombre de composantes par pixel (DEPTH).
+ * @param pixelIntensity Passage par adresse de l'intensité maximale des composantes (MAXVAL).
+ * @param tuplType Chaine d'au moins TAILLE_TUPLTYPE_PAM caractères qui recevra le TUPLTYPE (vide s'il est absent).
+ * @param positionCursor Passage par adresse de la position du premier pixel dans le fichier.
+ *
+ * @return Retourne un int correspondant au code d'erreur. ERROR_FORMAT si l'entête est incomplet ou invalide.
+ */
+int readHeaderPAM(char* pathFile, long int *imageWidth, long int *imageHeight, long int *profondeur, long int *pixelIntensity, char* tuplType, long int *positionCursor);
+
+/**
+ * @fn int writeHeaderPAM(char* pathFile, long int imageWidth, long int imageHeight, long int profondeur, long int pixelIntensity, const char* tuplType, long int *positionCursor)
+ * @brief Écrit l'entête d'un fichier P7, complémentaire de readHeaderPAM.
+ *
+ * @param pathFile Chemin vers le fichier P7. Si le fichier n'existe pas, il sera créé.
+ * @param imageWidth Largeur de l'image en pixel.
+ * @param imageHeight Hauteur de l'image en pixel.
+ * @param profondeur Nombre de composantes par pixel.
+ * @param pixelIntensity Intensité maximale des composantes.
+ * @param tuplType TUPLTYPE de l'image (NULL ou vide pour ne pas l'écrire).
+ * @param positionCursor Passage par adresse de la position du premier pixel dans le fichier.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int writeHeaderPAM(char* pathFile, long int imageWidth, long int imageHeight, long int profondeur, long int pixelIntensity, const char* tuplType, long int *positionCursor);
+
+/**
+ * @fn int lireFormatImage(char* pathFile, char* typeFile, long int *imageWidth, long int *imageHeight, long int *profondeur, long int *pixelIntensity, char* tuplType, long int *beginningImage, long int *dimension)
+ * @brief Lit l'entête d'une image P2, P3, P5, P6, P7, BMP ou PNG, ou d'un son WAV, et calcule le nombre d'échantillons de l'image.
+ *
+ * La profondeur vaut 1 pour un P2/P5, 3 pour un P3/P6, DEPTH pour un P7, 3 ou 4 pour un BMP 24 ou 32 bits et 1 à 4 pour un PNG. La dimension vaut largeur * hauteur * profondeur (sans le bourrage des lignes d'un BMP).
+ * \n Un WAV est vu comme une image d'une ligne: une trame par pixel, un canal audio par composante, et une intensité maximale de 2^bits - 1 (voir readImageWAV).
+ *
+ * @param pathFile Chemin vers l'image.
+ * @param typeFile Chaine qui recevra le type de fichier (P2, P3, P5, P6, P7, BMP, PNG ou WAV).
+ * @param imageWidth Passage par adresse de la largeur de l'image en pixel.
+ * @param imageHeight Passage par adresse de la hauteur de l'image en pixel.
+ * @param profondeur Passage par adresse du nombre de composantes par pixel.
+ * @param pixelIntensity Passage par adresse de l'intensité maximale des composantes.
+ * @param tuplType Chaine d'au moins TAILLE_TUPLTYPE_PAM caractères qui recevra le TUPLTYPE d'un P7, les composantes d'un BMP (BGR ou BGRA), d'un PNG (GRAYSCALE ... RGB_ALPHA) ou d'un WAV (MONO, STEREO ou MULTICANAL), vide sinon.
+ * @param beginningImage Passage par adresse de la position du premier pixel dans le fichier.
+ * @param dimension Passage par adresse du nombre d'échantillons de l'image.
+ *
+ * @return Retourne un int correspondant au code d'erreur. ERROR_INVARG pour un autre type de fichier, ERROR_FORMAT si les composantes d'une image ne tiennent pas sur un octet, si le nombre d'échantillons dépasse LONG_MAX ou si le fichier est trop petit pour les contenir.
+ *
+ * @see readHeader
+ * @see readHeaderPAM
+ */
+int lireFormatImage(char* pathFile, char* typeFile, long int *imageWidth, long int *imageHeight, long int *profondeur, long int *pixelIntensity, char* tuplType, long int *beginningImage, long int *dimension);
+
+/**
+ * @fn int estFormatASCII(const char* typeFile)
+ * @brief Indique si les pixels d'une image sont écrits en texte (P2 ou P3).
+ *
+ * @param typeFile Type du fichier.
+ *
+ * @return 1 pour un P2 ou un P3, 0 sinon.
+ */
+int estFormatASCII(const char* typeFile);
+
+/**
+ * @fn long int pasLigneFormat(const char* typeFile, long int imageWidth, long int profondeur)
+ * @brief Calcule le nombre d'octets occupés par une ligne de pixels dans le fichier.
+ *
+ * @param typeFile Type du fichier.
+ * @param imageWidth Largeur de l'image en pixels.
+ * @param profondeur Nombre de composantes par pixel.
+ *
+ * @return imageWidth * profondeur, arrondi au multiple de 4 supérieur pour un BMP.
+ */
+long int pasLigneFormat(const char* typeFile, long int imageWidth, long int profondeur);
+
+/**
+ * @fn int octetsEchantillonFormat(const char* typeFile, long int pixelIntensity)
+ * @brief Calcule le nombre d'octets occupés par un échantillon dans le fichier.
+ *
+ * @param typeFile Type du fichier.
+ * @param pixelIntensity Intensité maximale des échantillons.
+ *
+ * @return 1 pour une image, 1 à 3 pour un WAV 8 à 24 bits.
+ */
+int octetsEchantillonFormat(const char* typeFile, long int pixelIntensity);
+
+/**
+ * @fn int readHeaderBMP(char* pathFile, long int *imageWidth, long int *imageHeight, long int *profondeur, long int *positionCursor)
+ * @brief Lit les entêtes d'un BMP non compressé de 24 ou 32 bits par pixel.
+ *
+ * Les BMP rangés de bas en haut (hauteur positive) comme de haut en bas (hauteur négative) sont acceptés: les pixels sont toujours utilisés dans l'ordre du fichier.
+ *
+ * @param pathFile Chemin vers le BMP.
+ * @param imageWidth Passage par adresse de la largeur de l'image en pixel.
+ * @param imageHeight Passage par adresse de la hauteur de l'image en pixel (toujours positive).
+ * @param profondeur Passage par adresse du nombre d'octets par pixel (3 ou 4).
+ * @param positionCursor Passage par adresse de la position du premier pixel dans le fichier.
+ *
+ * @return Retourne un int correspondant au code d'erreur. ERROR_FORMAT pour un BMP compressé, à palette ou tronqué.
+ */
+int readHeaderBMP(char* pathFile, long int *imageWidth, long int *imageHeight, long int *profondeur, long int *positionCursor);
+
+/**
+ * @fn int readImageBMP(char* pathFile, int* matrice, long int beginningImage, long int largeurLigne, long int nbLignes, long int pasLigne)
+ * @brief Equivalent de readImage pour un BMP: les lignes sont lues dans l'ordre du fichier, sans leurs octets de bourrage.
+ *
+ * @param pathFile Chemin vers le BMP.
+ * @param matrice Tableau d'entiers (alloué par l'appelant) qui contiendra largeurLigne * nbLignes échantillons.
+ * @param beginningImage Position du premier pixel dans le fichier.
+ * @param largeurLigne Nombre d'échantillons par ligne.
+ * @param nbLignes Nombre de lignes.
+ * @param pasLigne Nombre d'octets d'une ligne dans le fichier (voir pasLigneFormat).
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int readImageBMP(char* pathFile, int* matrice, long int beginningImage, long int largeurLigne, long int nbLignes, long int pasLigne);
+
+/**
+ * @fn int writeImageBMP(char* pathFile, int* matrice, long int beginningImage, long int largeurLigne, long int nbLignes, long int pasLigne)
+ * @brief Réécrit dans une copie du BMP d'origine (voir copierFichier) les seuls octets qui diffèrent de la matrice.
+ *
+ * Chaque ligne est relue puis seules les suites d'octets modifiés sont écrites (pwrite): le bourrage, les entêtes et les pixels inchangés ne sont pas touchés.
+ *
+ * @param pathFile Chemin vers la copie du BMP.
+ * @param matrice Les échantillons, rangés comme par readImageBMP.
+ * @param beginningImage Position du premier pixel dans le fichier.
+ * @param largeurLigne Nombre d'échantillons par ligne.
+ * @param nbLignes Nombre de lignes.
+ * @param pasLigne Nombre d'octets d'une ligne dans le fichier.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int writeImageBMP(char* pathFile, int* matrice, long int beginningImage, long int largeurLigne, long int nbLignes, long int pasLigne);
+
+/**
+ * @fn int copierFichier(char* pathSource, char* pathDestination)
+ * @brief Recopie un fichier octet pour octet.
+ *
+ * @param pathSource Chemin vers le fichier à copier.
+ * @param pathDestination Chemin vers la copie. Si le fichier existe, il est écrasé.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int copierFichier(char* pathSource, char* pathDestination);
+
+/**
+ * @fn int readHeaderWAV(char* pathFile, long int *nbTrames, long int *nbCanaux, long int *bitsParEchantillon, long int *positionCursor)
+ * @brief Parcourt les chunks d'un WAV jusqu'au chunk data.
+ *
+ * Seul le PCM entier (WAVE_FORMAT_PCM, ou WAVE_FORMAT_EXTENSIBLE de sous-format PCM) de 8, 16 ou 24 bits est accepté. Si le chunk data est tronqué, seules les trames présentes dans le fichier sont comptées.
+ *
+ * @param pathFile Chemin vers le WAV.
+ * @param nbTrames Passage par adresse du nombre de trames (un échantillon par canal).
+ * @param nbCanaux Passage par adresse du nombre de canaux.
+ * @param bitsParEchantillon Passage par adresse du nombre de bits par échantillon (8, 16 ou 24).
+ * @param positionCursor Passage par adresse de la position du premier échantillon dans le fichier.
+ *
+ * @return Retourne un int correspondant au code d'erreur. ERROR_FORMAT pour un WAV compressé, flottant ou sans chunk data.
+ */
+int readHeaderWAV(char* pathFile, long int *nbTrames, long int *nbCanaux, long int *bitsParEchantillon, long int *positionCursor);
+
+/**
+ * @fn int readImageWAV(char* pathFile, int* matrice, long int beginningImage, long int dimension, int octetsEchantillon)
+ * @brief Equivalent de readImage pour un WAV: les échantillons little-endian sont lus par blocs de TAILLE_TAMPON_FLUX octets.
+ *
+ * Les échantillons 16 et 24 bits (signés) sont rendus en binaire décalé (bit de signe inversé): ils vont de 0 à 2^bits - 1 comme les pixels d'une image, et leurs bits de poids faible sont ceux du fichier.
+ *
+ * @param pathFile Chemin vers le WAV.
+ * @param matrice Tableau d'entiers (alloué par l'appelant) qui contiendra dimension échantillons.
+ * @param beginningImage Position du premier échantillon dans le fichier.
+ * @param dimension Nombre d'échantillons (trames * canaux).
+ * @param octetsEchantillon Octets par échantillon (voir octetsEchantillonFormat).
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int readImageWAV(char* pathFile, int* matrice, long int beginningImage, long int dimension, int octetsEchantillon);
+
+/**
+ * @fn int writeImageWAV(char* pathFile, int* matrice, long int beginningImage, long int dimension, int octetsEchantillon)
+ * @brief Réécrit dans une copie du WAV d'origine (voir copierFichier) les seuls échantillons qui diffèrent de la matrice.
+ *
+ * Comme writeImageBMP, le chunk data est relu par blocs et seules les suites d'échantillons modifiés sont écrites (pwrite).
+ *
+ * @param pathFile Chemin vers la copie du WAV.
+ * @param matrice Les échantillons, en binaire décalé comme par readImageWAV.
+ * @param beginningImage Position du premier échantillon dans le fichier.
+ * @param dimension Nombre d'échantillons.
+ * @param octetsEchantillon Octets par échantillon.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int writeImageWAV(char* pathFile, int* matrice, long int beginningImage, long int dimension, int octetsEchantillon);
+
+/**
+ * @fn unsigned int crc32PNG(unsigned int crc, const unsigned char* octets, size_t taille)
+ * @brief Calcule le CRC-32 (polynôme 0xEDB88320) des chunks PNG.
+ *
+ * @param crc CRC des octets précédents (0 au départ).
+ * @param octets Les octets.
+ * @param taille Nombre d'octets.
+ *
+ * @return Le CRC mis à jour.
+ */
+unsigned int crc32PNG(unsigned int crc, const unsigned char* octets, size_t taille);
+
+/**
+ * @fn unsigned int adler32(unsigned int adler, const unsigned char* octets, size_t taille)
+ * @brief Calcule la somme Adler-32 qui termine un flux zlib.
+ *
+ * @param adler Somme des octets précédents (1 au départ).
+ * @param octets Les octets.
+ * @param taille Nombre d'octets.
+ *
+ * @return La somme mise à jour.
+ */
+unsigned int adler32(unsigned int adler, const unsigned char* octets, size_t taille);
+
+/**
+ * @fn int construireHuffman(huffman_t* huffman, const unsigned char* longueurs, int nbSymboles)
+ * @brief Construit un code de Huffman canonique à partir des longueurs de ses codes (0 pour un symbole absent).
+ *
+ * @param huffman Le code à construire.
+ * @param longueurs Longueur du code de chaque symbole (au plus LONGUEUR_MAX_HUFFMAN).
+ * @param nbSymboles Nombre de symboles (au plus NB_LITTERAUX_DEFLATE).
+ *
+ * @return Retourne un int correspondant au code d'erreur. ERROR_FORMAT si les longueurs décrivent trop de codes.
+ */
+int construireHuffman(huffman_t* huffman, const unsigned char* longueurs, int nbSymboles);
+
+/**
+ * @fn void longueursHuffman(const unsigned long* frequences, int nbSymboles, int longueurMax, unsigned char* longueurs)
+ * @brief Calcule les longueurs des codes de Huffman de fréquences données, sans dépasser longueurMax.
+ *
+ * Si l'arbre est trop profond, les fréquences sont divisées par 2 et l'arbre reconstruit. Deux symboles au moins reçoivent un code, pour que le code soit complet.
+ *
+ * @param frequences Fréquence de chaque symbole.
+ * @param nbSymboles Nombre de symboles (au plus NB_LITTERAUX_DEFLATE).
+ * @param longueurMax Longueur maximale d'un code.
+ * @param longueurs Tableau qui recevra la longueur du code de chaque symbole.
+ */
+void longueursHuffman(const unsigned long* frequences, int nbSymboles, int longueurMax, unsigned char* longueurs);
+
+/**
+ * @fn int readHeaderPNG(char* pathFile, long int *imageWidth, long int *imageHeight, long int *profondeur)
+ * @brief Lit le chunk IHDR d'un PNG.
+ *
+ * Seuls les PNG de 8 bits par composante, sans palette et non entrelacés sont acceptés.
+ *
+ * @param pathFile Chemin vers le PNG.
+ * @param imageWidth Passage par adresse de la largeur de l'image en pixel.
+ * @param imageHeight Passage par adresse de la hauteur de l'image en pixel.
+ * @param profondeur Passage par adresse du nombre de composantes par pixel (1 gris, 2 gris et alpha, 3 RGB, 4 RGBA).
+ *
+ * @return Retourne un int correspondant au code d'erreur. ERROR_FORMAT pour un autre type de PNG.
+ */
+int readHeaderPNG(char* pathFile, long int *imageWidth, long int *imageHeight, long int *profondeur);
+
+/**
+ * @fn int readImagePNG(char* pathFile, int* matrice, long int imageWidth, long int imageHeight, long int profondeur)
+ * @brief Décompresse les chunks IDAT d'un PNG et range les échantillons dans la matrice, sans fichier intermédiaire.
+ *
+ * Le flux zlib est décompressé au fil de la lecture (blocs stockés, fixes et dynamiques) et chaque ligne est défiltrée dès qu'elle est complète (voir decodeurPNG_t). La somme Adler-32 est vérifiée. \n
+ * Les méthodes d'insertion travaillent sur l'image entière: la matrice occupe sizeof(int) octets par échantillon, seule la décompression est bornée par lignes.
+ *
+ * @param pathFile Chemin vers le PNG.
+ * @param matrice Tableau d'entiers (alloué par l'appelant) qui recevra imageWidth * imageHeight * profondeur échantillons.
+ * @param imageWidth Largeur de l'image en pixel.
+ * @param imageHeight Hauteur de l'image en pixel.
+ * @param profondeur Nombre de composantes par pixel.
+ *
+ * @return Retourne un int correspondant au code d'erreur. ERROR_FORMAT si les données sont corrompues ou incomplètes.
+ */
+int readImagePNG(char* pathFile, int* matrice, long int imageWidth, long int imageHeight, long int profondeur);
+
+/**
+ * @fn int readImagePNGOctets(char* pathFile, unsigned char* octets, long int imageWidth, long int imageHeight, long int profondeur)
+ * @brief Comme readImagePNG, mais range les échantillons (8 bits) dans un tableau d'octets: quatre fois moins de mémoire pour une image qui n'est que lue.
+ *
+ * @param pathFile Chemin vers le PNG.
+ * @param octets Tableau (alloué par l'appelant) qui recevra imageWidth * imageHeight * profondeur octets.
+ * @param imageWidth Largeur de l'image en pixel.
+ * @param imageHeight Hauteur de l'image en pixel.
+ * @param profondeur Nombre de composantes par pixel.
+ *
+ * @return Retourne un int correspondant au code d'erreur. ERROR_FORMAT si les données sont corrompues ou incomplètes.
+ *
+ * @see ouvrirSourceFormat
+ */
+int readImagePNGOctets(char* pathFile, unsigned char* octets, long int imageWidth, long int imageHeight, long int profondeur);
+
+/**
+ * @fn int writeImagePNG(char* pathFile, const int* matrice, long int imageWidth, long int imageHeight, long int profondeur)
+ * @brief Écrit un PNG (IHDR, IDAT, IEND) à partir des échantillons.
+ *
+ * Chaque ligne reçoit le filtre qui minimise la somme des écarts, puis est transmise au compresseur deflate (LZ77 à chaînes de hachage et codes de Huffman dynamiques, voir encodeurPNG_t).
+ * \n Les chunks auxiliaires de l'image d'origine ne sont pas recopiés.
+ *
+ * @param pathFile Chemin vers le PNG à créer.
+ * @param matrice Les échantillons (entre 0 et 255).
+ * @param imageWidth Largeur de l'image en pixel.
+ * @param imageHeight Hauteur de l'image en pixel.
+ * @param profondeur Nombre de composantes par pixel (1 à 4).
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int writeImagePNG(char* pathFile, const int* matrice, long int imageWidth, long int imageHeight, long int profondeur);
+
+/**
+ * @fn int analyserEntiersASCII(const unsigned char* texte, long int taille, int* valeurs, long int nbValeurs, long int maxval)
+ * @brief Découpe un texte en nombres décimaux séparés par des espaces (pixels d'un P2/P3).
+ *
+ * Le texte est classé 16 octets à la fois avec SSE2 (masques des chiffres et des séparateurs), puis les suites de chiffres sont repérées sur ces masques: les blocs sans chiffre sont sautés en une opération.
+ * \n Les commentaires ('#' jusqu'à la fin de la ligne) sont ignorés, tout autre caractère est une erreur.
+ *
+ * @param texte Le texte à découper.
+ * @param taille Taille du texte en octets.
+ * @param valeurs Tableau qui recevra les nombres.
+ * @param nbValeurs Nombre de valeurs attendues, le reste du texte est ignoré.
+ * @param maxval Valeur maximale autorisée.
+ *
+ * @return Retourne un int correspondant au code d'erreur. ERROR_FORMAT si le texte contient moins de nbValeurs nombres, un nombre supérieur à maxval ou un caractère invalide.
+ */
+int analyserEntiersASCII(const unsigned char* texte, long int taille, int* valeurs, long int nbValeurs, long int maxval);
+
+/**
+ * @fn int readImageASCII(char* pathFile, int* matrice, long int beginningImage, long int dimension, long int pixelIntensity)
+ * @brief Equivalent de readImage pour un P2/P3: les pixels sont lus d'un bloc puis découpés par analyserEntiersASCII.
+ *
+ * @param pathFile Chemin vers l'image.
+ * @param matrice Tableau d'entiers (alloué par l'appelant) qui contiendra les pixels.
+ * @param beginningImage Position du premier pixel dans le fichier (voir readHeader).
+ * @param dimension Nombre de pixels à lire.
+ * @param pixelIntensity Intensité maximale des pixels.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int readImageASCII(char* pathFile, int* matrice, long int beginningImage, long int dimension, long int pixelIntensity);
+
+/**
+ * @fn int writeImageASCII(char* pathFile, int* matrice, long int beginningImage, long int dimension)
+ * @brief Equivalent de writeImage pour un P2/P3: les pixels sont écrits en décimal, en lignes d'au plus LONGUEUR_LIGNE_ASCII caractères.
+ *
+ * @param pathFile Chemin vers l'image, dont l'entête a été écrit par writeHeader.
+ * @param matrice Les pixels (entre 0 et 255).
+ * @param beginningImage Position de la fin de l'entête.
+ * @param dimension Nombre de pixels.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int writeImageASCII(char* pathFile, int* matrice, long int beginningImage, long int dimension);
+
+/**
+ * @fn int fileToBinary(char* fileToCrypt,unsigned char** msgSecretBit, size_t *length)
+ * @brief Cette fonction lit un fichier et le convertit en un tableau binaire.
+ *
+ * Cette fonction prend un chemin vers un fichier en paramètre d'entrée et convertit le contenu de ce fichier en tableau binaire.
+ * \n Une étape intermediaire est utilisée pour ce faire: d'abord la fonction lit le fichier char par char, puis grâce à la fonction printbincharpad, la fonction convertit les char en tableau binaire.
+ *
+ * @param fileToCrypt Chaine de caractères correspondant au chemin vers le fichier que l'on veut convertir.
+ * @param msgSecretBit Passage par adresse d'un tableau 1D contenant le tableau binaire correspondant au fichier.
+ * @param length Passage par adresse de la taille du tableau binaire généré. De type size_t.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @warning Le tableau binaire est alloué dans la fonction. L'user doit le free après utilisation.
+ * @see printbincharpad
+ */
+int fileToBinary(char* fileToCrypt,unsigned char** msgSecretBit, size_t *length);
 
 /**
  * @fn int createFileFromByte(const char* fileToCrypt, const unsigned char* msgSecret, long int tailleMsgDecrypt)
  * @brief Crée un fichier à partir d'un tableau d'octet (unsigned char)
  *
- * Le fichier est créé par la fonction.
+ * Le fichier est créé par la fonction.
+ *
+ * @param fileToCrypt Chemin vers le fichier à créer.
+ * @param msgSecret Tableau d'octet correspondant au fichier (type unsigned char)
+ * @param tailleMsgDecrypt Taille du tableau BINAIRE correspondant au tableau d'octet.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ * @warning La taille passée doit être la taille du tableau binaire et non la taille du tableau d'octet, puisque la fonction calcul automatiquement la division par 8.
+ */
+int createFileFromByte(const char* fileToCrypt, const unsigned char* msgSecret, long int tailleMsgDecrypt);
+
+/**
+ * @fn int getExtension(const char* pathToFile, char** extensionPixelMap)
+ * @brief Cette fonction renvoit l'extension d'un fichier ('.' inclus)
+ *
+ * L'allocation de la mémoire de la chaine de caractère correspondant à l'extension se fait dans la fonction. C'est à l'utilisateur de la libérer après utilisation.
+ *
+ * @param pathToFile Chemin vers le fichier que l'on souhaite récuperer l'extension.
+ * @param extensionPixelMap Passage par adresse de la chaine de caractères qui contient l'extension du fichier.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @note Cette fonction correspond à une fonction "split"
+ */
+int getExtension(const char* pathToFile, char** extensionPixelMap);
+
+
+
+
+
+/************************************************
+ *  Fonctions Hamming
+ ***********************************************/
+
+/**
+ * @fn int determineBestHammingSize(unsigned int tailleImg, unsigned int tailleMsg, unsigned int* rows, unsigned int* columns)
+ * @brief Cette fonction determine la taille la plus adaptée pour une matrice de hamming en fonction de la taille d'une image et d'un message.
+ *
+ * Cette fonction calcule la capacité de chaque matrice de hamming jusqu'à trouver celle qui correspond le mieux à la taille du message.
+ *
+ * @param tailleImg Taille de l'image.
+ * @param tailleMsg Taille du message.
+ * @param rows Passage par adresse du nombre de lignes de la matrice de hamming.
+ * @param columns Passage par adresse du nombre de colonnes de la matrice de hamming.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int determineBestHammingSize(unsigned int tailleImg, unsigned int tailleMsg, unsigned int* rows, unsigned int* columns);
+
+/**
+ * @fn int isVectorNull(unsigned int **vector, unsigned int columns)
+ * @brief Cette fonction determine si un vecteur possède des composantes toutes égales à 0 ou non.
+ *
+ * Un vecteur est codé de cette manière: tableau 2D dont la première case est égale à 0.
+ * \n Pour un vecteur de 5 composantes on a donc: vect[0][5];
+ *
+ * @param vector Tableau 2D vers le vecteur que l'on souhaite tester.
+ * @param columns Nombre de composantes du vecteur.
+ *
+ * @return 1 si le vecteur est le vecteur NULL, 0 sinon.
+ *
+ * @warning Le vecteur doit être bien formaté selon ce format: tableau 2D dont la première case est égale à 0. Pour un vecteur de 5 composantes on a donc: vect[0][5];
+ */
+int isVectorNull(unsigned int **vector, unsigned int columns);
+
+/**
+ * @fn int findInHamming(unsigned int **matriceHamming, unsigned int columns, unsigned int rows, unsigned int **matriceRes, unsigned int *position)
+ * @brief Cette fonction permet de faire une correspondance dans une matrice de Hamming.
+ *
+ * Un vecteur est donné en paramètre et la fonction permet de dire si ce vecteur correspond à l'une des colonnes de la matrice de Hamming.
+ *
+ * @param matriceHamming Tableau 2D correspondant à la matrice de Hamming.
+ * @param columns Nombre de colonnes de la matrice de Hamming
+ * @param rows Nombre de lignes de la matrice de Hamming
+ * @param matriceRes Vecteur que l'on souhaite faire correspondre. Ce vecteur ne doit pas être nul. Tableau 2D codé suivant la manière vu dans le warning.
+ * @param position Passage par adresse de la position dans la matrice de hamming dont la colonne correspond au vecteur passé en paramètre.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int findInHamming(unsigned int **matriceHamming, unsigned int columns, unsigned int rows, unsigned int **matriceRes, unsigned int *position);
+
+/**
+ * @fn void additionMatrice(unsigned int m, unsigned int n, unsigned int** mat1, unsigned int** mat2, unsigned int*** res)
+ * @brief Additionne deux matrices en modulo 2.
+ *
+ * Cette fonction prend deux tableau 2D en paramètre (de même dimension) et renvoit le résultat de l'addition en passage par adresse.
+ *
+ * @param m Nombre de colonnes des matrices.
+ * @param n Nombre de ligne des matrices.
+ * @param mat1 Tableau 2D correspondant à la matrice 1.
+ * @param mat2 Tableau 2D correspondnat à la matrice 2.
+ * @param res Passage par adresse de la matrice contenant le résultat de l'addition.
+ *
+ * @warning Les deux matrices doivent avoir les mêmes dimensions.
+ * @warning Les matrices doivent être codées de la sorte que les colonnes soient le premier indice.
+ * @warning Les calculs sont effectué en base 2 (modulo 2)
+ */
+void additionMatrice(unsigned int m, unsigned int n, unsigned int** mat1, unsigned int** mat2, unsigned int*** res);
+
+/**
+ * @fn void multiplyMatrice(unsigned int m2, unsigned int** mat1, unsigned int n1, unsigned int n2, unsigned int** mat2, unsigned int*** res)
+ * @brief Multiplie deux matrices en modulo 2.
+ *
+ * Cette fonction prend deux tableau 2D en paramètre (avec leurs dimensions respectives) et renvoit le résultat de la multiplication en passage par adresse.
+ *
+ * @param m2 Nombre de ligne de la matrice 1
+ * @param mat1 Tableau 2D correspondant à la matrice 1
+ * @param n1 Nombre de colonnes des deux matrices.
+ * @param n2 Nombre de ligne de la matrice 2.
+ * @param mat2 Tableau 2D correspondant à la matrice 2
+ * @param res Passage par adresse d'un tableau 2D correspondnat à la matrice contenant le résultat de la multiplication.
+ *
+ * @warning Les matrices doivent être codées de la sorte que les colonnes soient le premier indice.
+ * @warning Les matrices doivent avoir le même nombre de colonnes.
+ * @warning Les calculs sont effectué en base 2 (modulo 2)
+ */
+void multiplyMatrice(unsigned int m2, unsigned int** mat1, unsigned int n1, unsigned int n2, unsigned int** mat2, unsigned int*** res);
+
+
+/**
+ * @fn int genererHamming(unsigned int*** hamming, unsigned int r, unsigned int c)
+ * @brief Génère une matrice de hamming en fonction des dimensions passées en paramètre.
+ *
+ * @param hamming Passage par adresse d'un tableau 2D correspondant à la matrice de hamming.
+ * @param r Nombre de lignes de la matrice de Hamming
+ * @param c Nombre de colonnes de la matrice de Hamming
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @note La matrice de hamming est un tableau 2D codé de manière à ce que les colonnes sont les premiers indices du tableau.
+ */
+int genererHamming(unsigned int*** hamming, unsigned int r, unsigned int c);
+
+
+
+/**
+ * @fn int hideMessageHamming(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, unsigned int rows, unsigned int columns, unsigned int* compteurNbBitsModif)
+ * @brief Cette fonction cache un message (tableau binaire) dans un tableau de pixel en utilisant la méthode de Hamming.
+ *
+ * On utilise une matrice de hamming de taille donnée en paramètre. La matrice sera de taille par exemple (N,M).
+ * Pour crypter, on récupère une séquence de N LSB de notre image que l'on multiplie à la matrice de hamming. On additionne le résultat (XOR) avec une séquence de M bits du message à cacher. On aura un output de taille (1, M) qui correspondra à l'unes des N colonnes de la matrice de hamming. On a plus qu'à reporter sur la matrice de hamming pour savoir à quelle numéro de colonne cela correspond. Si notre résultat est égal à la 2eme colonne de la matrice de hamming on va modifier notre 2eme/M bits LSB de notre image de départ.
+ *
+ * @param messageBinary Le tableau binaire du message que l'on souhaite cacher.
+ * @param tailleMsgBit La taille du tableau binaire du message.
+ * @param matriceImage Le tableau 1D de pixel de l'image dans laquelle on va cacher le message.
+ * @param dimension La taille de la matrice de pixel de l'image.
+ * @param pixelIntensity L'intensité maximale des pixels de l'image.
+ * @param lengthDimensionPrefix La taille du prefixe de l'image.
+ * @param rows Le nombre de lignes de la matrice de Hamming.
+ * @param columns Le nombre de colonnes de la matrice de Hamming
+ * @param compteurNbBitsModif Passage par adresse du nombre de bits modifié par cette méthode.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @note Les dimensions de la matrice de Hamming doivent être determinées avant d'appeller cette fonction.
+ *
+ * @see hideDimMsg
+ * @see decryptMessageHamming
+ */
+int hideMessageHamming(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, unsigned int rows, unsigned int columns, unsigned int* compteurNbBitsModif);
+
+/**
+ * @fn int determineSegmentsHamming(long int tailleImg, long int tailleMsgBit, unsigned int* rows, long int* nbBlocsGrands)
+ * @brief Découpe l'insertion de Hamming en deux segments: nbBlocsGrands blocs à rows + 1 lignes, puis des blocs à rows lignes jusqu'à la fin du message.
+ *
+ * rows est le plus grand nombre de lignes pour lequel tout le message tient dans l'image, puis nbBlocsGrands est le plus grand nombre de blocs à rows + 1 lignes qui laisse assez de pixels au second segment. \n
+ * Le découpage ne dépend que des deux tailles: seul rows est enregistré dans l'entête (avec HAMMING_SEGMENTE), le décodeur recalcule nbBlocsGrands. \n
+ * Des blocs d'une seule ligne (1 pixel par bit, équivalent à l'insertion classique) sont utilisés si même rows = 2 ne tient pas.
+ *
+ * @param tailleImg Nombre de pixels disponibles pour le message.
+ * @param tailleMsgBit Taille du message en bits.
+ * @param rows Passage par adresse du nombre de lignes du second segment (de 1 à LIGNES_MAX_HAMMING - 1).
+ * @param nbBlocsGrands Passage par adresse du nombre de blocs du premier segment.
+ *
+ * @return Retourne un int correspondant au code d'erreur. ERROR_NOMEM si le message est plus grand que l'image.
+ */
+int determineSegmentsHamming(long int tailleImg, long int tailleMsgBit, unsigned int* rows, long int* nbBlocsGrands);
+
+/**
+ * @fn long long pixelsSegmentsHamming(long int tailleMsgBit, unsigned int rows, long int nbBlocsGrands)
+ * @brief Nombre de pixels utilisés par nbBlocsGrands blocs à rows + 1 lignes suivis de blocs à rows lignes pour le reste du message.
+ *
+ * @param tailleMsgBit Taille du message en bits.
+ * @param rows Nombre de lignes du second segment.
+ * @param nbBlocsGrands Nombre de blocs du premier segment.
+ *
+ * @return Le nombre de pixels à partir du début du message.
+ *
+ * @see determineSegmentsHamming
+ */
+long long pixelsSegmentsHamming(long int tailleMsgBit, unsigned int rows, long int nbBlocsGrands);
+
+/**
+ * @fn int hideMessageHammingSegmente(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, long int debut, unsigned int rows, long int nbBlocsGrands, unsigned int* compteurNbBitsModif)
+ * @brief Cache un message avec le découpage en deux segments calculé par determineSegmentsHamming.
+ *
+ * Les blocs des deux segments se suivent à partir de debut, le syndrome de chaque bloc est le XOR des numéros de colonne des pixels dont le LSB vaut 1. Avec rows = 1, le bit est directement le LSB du pixel.
+ *
+ * @param messageBinary Le tableau binaire du message que l'on souhaite cacher.
+ * @param tailleMsgBit La taille du tableau binaire du message.
+ * @param matriceImage Le tableau 1D de pixel de l'image.
+ * @param dimension La taille de la matrice de pixel de l'image.
+ * @param pixelIntensity L'intensité maximale des pixels de l'image.
+ * @param debut Position du premier pixel du message.
+ * @param rows Nombre de lignes du second segment.
+ * @param nbBlocsGrands Nombre de blocs à rows + 1 lignes du premier segment.
+ * @param compteurNbBitsModif Passage par adresse du nombre de pixels modifiés.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @see determineSegmentsHamming
+ */
+int hideMessageHammingSegmente(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, long int debut, unsigned int rows, long int nbBlocsGrands, unsigned int* compteurNbBitsModif);
+
+/**
+ * @fn int hideMessageHammingChiffre(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, long int debut, char* keyCrypt, unsigned int rows, long int nbBlocsGrands, unsigned int* compteurNbBitsModif)
+ * @brief Cache un message par syndrome de Hamming, les colonnes de chaque bloc étant les pixels suivants du parcours calculable de la clé.
+ *
+ * Les blocs ont le découpage de determineSegmentsHamming, mais le pixel j du parcours est positionParcoursCalculable(j) au lieu de debut + j: aucune table de la taille de l'image n'est construite. \n
+ * Les bits du dernier bloc situés après la fin du message gardent leur valeur, ce qui évite des modifications inutiles.
+ *
+ * @param messageBinary Le tableau binaire du message que l'on souhaite cacher.
+ * @param tailleMsgBit La taille du tableau binaire du message.
+ * @param matriceImage Le tableau 1D de pixel de l'image.
+ * @param dimension La taille de la matrice de pixel de l'image.
+ * @param pixelIntensity L'intensité maximale des pixels de l'image.
+ * @param debut Position du premier pixel du message.
+ * @param keyCrypt La clé secrète du parcours.
+ * @param rows Nombre de lignes du second segment.
+ * @param nbBlocsGrands Nombre de blocs à rows + 1 lignes du premier segment.
+ * @param compteurNbBitsModif Passage par adresse du nombre de pixels modifiés.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @see determineSegmentsHamming
+ * @see positionParcoursCalculable
+ */
+int hideMessageHammingChiffre(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, long int debut, char* keyCrypt, unsigned int rows, long int nbBlocsGrands, unsigned int* compteurNbBitsModif);
+
+
+/**
+ * @fn int decryptMessageHamming(const int *matriceImage, long int dimension, long int prefixInt, long int lengthDimensionPrefix, unsigned int rows, unsigned int columns, long int *tailleMsgDecrypt, unsigned char **messageSecretBitOutput)
+ * @brief Cette fonction décode un message caché dans une image en utilisant la méthode de Hamming.
+ *
+ * Méthode pour décrypter: On reprend notre matrice de hamming de (N,M) taille que l'on multiplie par des séquences de N LSB de l'image. On a à chaque fois une matrice output de taille M qui est notre message décodé si on les met toutes côte à côte.
+ *
+ * @param matriceImage Tableau 1D de pixels de l'image dans laquelle le message est caché.
+ * @param dimension Dimension du tableau de pixels.
+ * @param prefixInt Valeur du prefixe de l'image, ce qui correspond à la taille de notre message secret.
+ * @param lengthDimensionPrefix Longueur du prefixe, ce qui correspond à l'endroit où commence notre message secret.
+ * @param rows Nombre de lignes de la matrice de Hamming
+ * @param columns Nombre de colonnes de la matrice de Hamming.
+ * @param tailleMsgDecrypt Passage par adresse de la taille du message secret.
+ * @param messageSecretBitOutput Passage par adresse du tableau 1D contenant le message secret.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @note Les dimensions de la matrice de Hamming doivent être determinées avant d'appeller cette fonction.
+ *
+ * @warning Le tableau de sortie contenant le message secret ne doit pas être alloué avant la fonction. L'utilisateur est libre de le libérer après utilisation.
+ *
+ * @see hideMessageHamming
+ *
+ */
+int decryptMessageHamming(const int *matriceImage, long int dimension, long int prefixInt, long int lengthDimensionPrefix, unsigned int rows, unsigned int columns, long int *tailleMsgDecrypt, unsigned char **messageSecretBitOutput);
+
+
+/************************************************
+ *  Fonctions k-LSB
+ ***********************************************/
+
+/**
+ * @fn unsigned char encoderBitsParCanal(const int bitsParCanal[3])
+ * @brief Regroupe le nombre de bits de chaque canal dans le paramètre de l'entête: (kR - 1) | (kG - 1) << 2 | (kB - 1) << 4.
+ *
+ * @param bitsParCanal Nombre de bits cachés dans les canaux R, G et B (de 1 à K_MAX_KLSB). Pour une image en niveaux de gris, les 3 valeurs sont égales.
+ *
+ * @return Le paramètre de l'entête.
+ *
+ * @see decoderBitsParCanal
+ */
+unsigned char encoderBitsParCanal(const int bitsParCanal[3]);
+
+/**
+ * @fn void decoderBitsParCanal(unsigned char parametre, int bitsParCanal[3])
+ * @brief Retrouve le nombre de bits de chaque canal à partir du paramètre de l'entête.
+ *
+ * @param parametre Le paramètre de l'entête.
+ * @param bitsParCanal Tableau qui recevra le nombre de bits des canaux R, G et B.
+ */
+void decoderBitsParCanal(unsigned char parametre, int bitsParCanal[3]);
+
+/**
+ * @fn long int capaciteKLSB(long int debut, long int dimension, const int bitsParCanal[3])
+ * @brief Calcule le nombre de bits qui peuvent être cachés en k-LSB dans les pixels [debut, dimension[.
+ *
+ * Le canal d'un pixel est sa position modulo 3 (R, G, B entrelacés dans un P6).
+ *
+ * @param debut Position du premier pixel utilisé.
+ * @param dimension Taille du tableau de pixels.
+ * @param bitsParCanal Nombre de bits cachés dans chaque canal.
+ *
+ * @return La capacité en bits.
+ */
+long int capaciteKLSB(long int debut, long int dimension, const int bitsParCanal[3]);
+
+/**
+ * @fn long int unitesPrefixe(const enteteConteneur_t* entete)
+ * @brief Calcule la valeur à ajouter au prefixe pour le flux caché après l'entête (table des CRC et message).
+ *
+ * C'est le nombre de bits du flux, sauf en MODE_KLSB où il est compté en unités de BITS_UNITE_PREFIXE_KLSB bits pour que le prefixe reste inférieur à la taille de l'image.
+ *
+ * @param entete L'entête du conteneur.
+ *
+ * @return Le nombre d'unités du flux caché.
+ */
+long int unitesPrefixe(const enteteConteneur_t* entete);
+
+/**
+ * @fn void fusionnerKLSB(int* echantillons, const int* valeurs, long int nombre, long int position, const int bitsParCanal[3], long int pixelIntensity)
+ * @brief Remplace les bits de poids faible de pixels consécutifs par les valeurs à cacher.
+ *
+ * Après remplacement, on ajoute ou retire 2^k au pixel si cela le rapproche de sa valeur d'origine sans changer ses k bits de poids faible (ajustement optimal), ce qui limite l'écart à 2^(k-1). \n
+ * Le calcul est fait 4 pixels à la fois avec SSE2 (les masques des 3 canaux se répètent tous les 12 pixels), sans branchement.
+ *
+ * @param echantillons Les pixels à modifier.
+ * @param valeurs Les valeurs (k bits) à cacher dans chaque pixel.
+ * @param nombre Nombre de pixels.
+ * @param position Position du premier pixel dans l'image (pour connaitre son canal).
+ * @param bitsParCanal Nombre de bits cachés dans chaque canal.
+ * @param pixelIntensity Intensité maximale des pixels.
+ */
+void fusionnerKLSB(int* echantillons, const int* valeurs, long int nombre, long int position, const int bitsParCanal[3], long int pixelIntensity);
+
+/**
+ * @fn int hideMessageKLSB(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, const int bitsParCanal[3])
+ * @brief Cache le message en k-LSB: chaque pixel reçoit les k bits suivants du message (bit de poids fort en premier).
+ *
+ * @param messageBinary Le message binaire (un bit par case).
+ * @param tailleMsgBit Taille du message en bits.
+ * @param matriceImage Le tableau de pixels.
+ * @param dimension Taille du tableau de pixels.
+ * @param pixelIntensity Intensité maximale des pixels.
+ * @param lengthDimensionPrefix Position du premier pixel utilisé.
+ * @param bitsParCanal Nombre de bits cachés dans chaque canal.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé, ERROR_NOMEM si le message ne tient pas dans l'image.
+ *
+ * @see capaciteKLSB
+ */
+int hideMessageKLSB(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, const int bitsParCanal[3]);
+
+
+
+
+
+
+
+/************************************************
+ *  Fonctions STC
+ ***********************************************/
+
+/**
+ * @fn unsigned int colonneSTC(long int k, int hauteur)
+ * @brief Renvoit la colonne k de la sous-matrice du code syndrome-treillis (STC).
+ *
+ * Les colonnes sont pseudo aléatoires mais fixes, avec le premier et le dernier bit à 1 (condition pour une bonne efficacité du code).
+ *
+ * @param k Numéro de la colonne dans son bloc.
+ * @param hauteur Hauteur de la sous-matrice (nombre de lignes, de HAUTEUR_STC_MIN à HAUTEUR_STC_MAX).
+ *
+ * @return La colonne, bit i = ligne i.
+ */
+unsigned int colonneSTC(long int k, int hauteur);
+
+/**
+ * @fn long int debutBlocSTC(long int bloc, long int nbPixels, long int tailleMsgBit)
+ * @brief Calcule la position du premier pixel d'un bloc STC (relative au début du message).
+ *
+ * Chaque bit du message correspond à un bloc de nbPixels / tailleMsgBit pixels, arrondi pour que les blocs recouvrent exactement nbPixels: tous les débits sont possibles.
+ *
+ * @param bloc Numéro du bloc (i.e du bit du message), de 0 à tailleMsgBit.
+ * @param nbPixels Nombre de pixels utilisés par le message.
+ * @param tailleMsgBit Taille du message en bits.
+ *
+ * @return La position du premier pixel du bloc.
+ */
+long int debutBlocSTC(long int bloc, long int nbPixels, long int tailleMsgBit);
+
+/**
+ * @fn void etapeViterbiSTC(const float* ancien, float* nouveau, unsigned int* decisions, int nbEtats, unsigned int colonne, float coutZero, float coutUn)
+ * @brief Avance le treillis de Viterbi d'un pixel.
+ *
+ * Pour chaque état s: nouveau[s] = min(ancien[s] + coutZero, ancien[s ^ colonne] + coutUn), la décision (1 si le LSB du pixel vaut 1) est gardée pour le retour en arrière. \n
+ * Le calcul est fait 4 états à la fois avec SSE2: s ^ colonne échange les registres selon les bits de poids fort de la colonne, et les valeurs d'un même registre selon ses 2 bits de poids faible.
+ *
+ * @param ancien Coût minimal de chaque état avant le pixel.
+ * @param nouveau Coût minimal de chaque état après le pixel.
+ * @param decisions Bits de décision (un par état, (nbEtats + 31) / 32 mots).
+ * @param nbEtats Nombre d'états (2^hauteur).
+ * @param colonne Colonne de la sous-matrice associée au pixel.
+ * @param coutZero Coût pour que le LSB du pixel vaille 0.
+ * @param coutUn Coût pour que le LSB du pixel vaille 1.
+ */
+void etapeViterbiSTC(const float* ancien, float* nouveau, unsigned int* decisions, int nbEtats, unsigned int colonne, float coutZero, float coutUn);
+
+/**
+ * @fn int hideMessageSTC(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, int hauteur, const float* couts, unsigned int* compteurNbBitsModif)
+ * @brief Cache le message avec un code syndrome-treillis: le message est le syndrome des LSB de l'image, et l'algorithme de Viterbi choisit les LSB de coût total minimal qui le produisent.
+ *
+ * Tous les pixels de lengthDimensionPrefix à dimension sont utilisés, ce qui donne le moins de modifications possible pour la taille du message. \n
+ * Les pixels dont le LSB change sont modifiés de +1 ou -1 comme pour l'insertion classique.
+ *
+ * @param messageBinary Le message binaire (un bit par case).
+ * @param tailleMsgBit Taille du message en bits.
+ * @param matriceImage Le tableau de pixels.
+ * @param dimension Taille du tableau de pixels.
+ * @param pixelIntensity Intensité maximale des pixels.
+ * @param lengthDimensionPrefix Position du premier pixel utilisé.
+ * @param hauteur Hauteur de la sous-matrice (HAUTEUR_STC par défaut).
+ * @param couts Coût de modification de chaque pixel du tableau (NULL pour un coût de 1 partout).
+ * @param compteurNbBitsModif Pointeur qui recevra le nombre de pixels modifiés.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé, ERROR_NOMEM si le message ne tient pas dans l'image.
+ *
+ * @see lireBitSTC
+ */
+int hideMessageSTC(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, int hauteur, const float* couts, unsigned int* compteurNbBitsModif);
+
+/**
+ * @fn unsigned int lireBitSTC(lecteurBits_t* lecteur, long int position)
+ * @brief Calcule le bit position du syndrome STC des LSB de l'image.
+ *
+ * Le bit i ne dépend que des blocs i - hauteur + 1 à i: une lecture séquentielle réutilise le syndrome en cours (blocCache, syndromeCache), une lecture ailleurs repart de hauteur - 1 blocs avant.
+ *
+ * @param lecteur Le lecteur initialisé en MODE_STC.
+ * @param position Position du bit dans le message.
+ *
+ * @return Le bit (0 ou 1).
+ */
+unsigned int lireBitSTC(lecteurBits_t* lecteur, long int position);
+
+
+/************************************************
+ *  Fonctions Hamming ternaire
+ ***********************************************/
+
+/**
+ * @fn void ajouterTrits(unsigned int* un, unsigned int* deux, unsigned int b1, unsigned int b2)
+ * @brief Additionne trit à trit (modulo 3) deux vecteurs de trits, sans branchement.
+ *
+ * Un vecteur de trits est représenté par 2 masques: le bit i de un vaut 1 si le trit i vaut 1, le bit i de deux vaut 1 si le trit i vaut 2.
+ *
+ * @param un Masque des trits à 1 du premier vecteur, qui reçoit le résultat.
+ * @param deux Masque des trits à 2 du premier vecteur, qui reçoit le résultat.
+ * @param b1 Masque des trits à 1 du second vecteur.
+ * @param b2 Masque des trits à 2 du second vecteur.
+ */
+void ajouterTrits(unsigned int* un, unsigned int* deux, unsigned int b1, unsigned int b2);
+
+/**
+ * @fn unsigned int tritsVersEntier(unsigned int un, unsigned int deux, int nbTrits)
+ * @brief Convertit un vecteur de trits en entier (trit i = chiffre de poids 3^i).
+ *
+ * @param un Masque des trits à 1.
+ * @param deux Masque des trits à 2.
+ * @param nbTrits Nombre de trits du vecteur.
+ *
+ * @return L'entier, entre 0 et 3^nbTrits - 1.
+ */
+unsigned int tritsVersEntier(unsigned int un, unsigned int deux, int nbTrits);
+
+/**
+ * @fn int genererTableTernaire(int nbTrits, unsigned int** table, long int* nbColonnes)
+ * @brief Génère la table du code de Hamming ternaire à nbTrits lignes.
+ *
+ * Les colonnes de la matrice de vérification sont tous les vecteurs de trits non nuls dont le premier trit non nul vaut 1, soit (3^nbTrits - 1) / 2 colonnes. \n
+ * Pour chaque colonne j et chaque reste r du pixel modulo 3, la table contient la contribution r * colonne au syndrome (masques un et deux): table[2 * (3 * j + r)] et table[2 * (3 * j + r) + 1].
+ *
+ * @param nbTrits Nombre de trits par bloc (de TRITS_MIN_TERNAIRE à TRITS_MAX_TERNAIRE).
+ * @param table Pointeur qui recevra la table (à libérer).
+ * @param nbColonnes Pointeur qui recevra le nombre de pixels par bloc.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int genererTableTernaire(int nbTrits, unsigned int** table, long int* nbColonnes);
+
+/**
+ * @fn int determineTailleTernaire(long int tailleImg, size_t tailleMsgBit, int* nbTrits, long int* nbColonnes)
+ * @brief Choisit le plus grand code ternaire (le plus efficace) dont les blocs tiennent dans l'image.
+ *
+ * Le message est découpé en groupes de BITS_GROUPE_TERNAIRE bits, chacun représenté par TRITS_GROUPE_TERNAIRE trits.
+ *
+ * @param tailleImg Nombre de pixels disponibles.
+ * @param tailleMsgBit Taille du message en bits.
+ * @param nbTrits Pointeur qui recevra le nombre de trits par bloc.
+ * @param nbColonnes Pointeur qui recevra le nombre de pixels par bloc.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé, ERROR_NOMEM si même le plus petit code ne tient pas dans l'image.
+ */
+int determineTailleTernaire(long int tailleImg, size_t tailleMsgBit, int* nbTrits, long int* nbColonnes);
+
+/**
+ * @fn int hideMessageTernaire(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, int nbTrits, unsigned int* compteurNbBitsModif)
+ * @brief Cache le message avec un code de Hamming ternaire: chaque bloc de (3^nbTrits - 1) / 2 pixels porte nbTrits trits avec au plus une modification de +1 ou -1.
+ *
+ * Le syndrome d'un bloc est la somme (modulo 3, trit à trit) des colonnes multipliées par les pixels modulo 3. Pour obtenir les trits du message, on ajoute +1 au pixel dont la colonne vaut la différence, ou -1 à celui dont la colonne vaut son opposé: le sens de la modification porte donc de l'information. \n
+ * La colonne et le sens sont lus dans une table indexée par la différence.
+ *
+ * @param messageBinary Le message binaire (un bit par case).
+ * @param tailleMsgBit Taille du message en bits.
+ * @param matriceImage Le tableau de pixels.
+ * @param dimension Taille du tableau de pixels.
+ * @param pixelIntensity Intensité maximale des pixels.
+ * @param lengthDimensionPrefix Position du premier pixel utilisé.
+ * @param nbTrits Nombre de trits par bloc.
+ * @param compteurNbBitsModif Pointeur qui recevra le nombre de pixels modifiés.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé, ERROR_NOMEM si le message ne tient pas dans l'image.
+ *
+ * @see lireBitTernaire
+ */
+int hideMessageTernaire(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, int nbTrits, unsigned int* compteurNbBitsModif);
+
+/**
+ * @fn unsigned int lireBitTernaire(lecteurBits_t* lecteur, long int position)
+ * @brief Retrouve le bit position d'un message caché avec hideMessageTernaire.
+ *
+ * Le syndrome du dernier bloc lu (blocCache) et la valeur du dernier groupe de bits (groupeCache) sont gardés: une lecture séquentielle calcule chaque syndrome une seule fois.
+ *
+ * @param lecteur Le lecteur initialisé en MODE_TERNAIRE.
+ * @param position Position du bit dans le message.
+ *
+ * @return Le bit (0 ou 1).
+ */
+unsigned int lireBitTernaire(lecteurBits_t* lecteur, long int position);
+
+
+/************************************************
+ *  Fonctions LSB matching revisited
+ ***********************************************/
+
+/**
+ * @fn int hideMessageLSBMR(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, unsigned int* compteurNbBitsModif)
+ * @brief Cache le message par LSB matching revisited: chaque paire de pixels (x1, x2) porte 2 bits, le premier dans le LSB de x1, le second dans le LSB de x1 / 2 + x2.
+ *
+ * Quand x1 doit changer, le choix entre +1 et -1 règle aussi le second bit, x2 n'est alors jamais modifié: 0,375 modification par bit en moyenne au lieu de 0,5 pour l'insertion classique. \n
+ * Chaque paire est traitée sans branchement (les choix sont faits par masques), aux bornes 0 et pixelIntensity le sens imposé est corrigé sur x2 si nécessaire.
+ *
+ * @param messageBinary Le message binaire (un bit par case).
+ * @param tailleMsgBit Taille du message en bits.
+ * @param matriceImage Le tableau de pixels.
+ * @param dimension Taille du tableau de pixels.
+ * @param pixelIntensity Intensité maximale des pixels.
+ * @param lengthDimensionPrefix Position du premier pixel utilisé.
+ * @param compteurNbBitsModif Pointeur qui recevra le nombre de pixels modifiés.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé, ERROR_NOMEM si le message ne tient pas dans l'image.
+ */
+int hideMessageLSBMR(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, unsigned int* compteurNbBitsModif);
+
+
+/************************************************
+ *  Fonctions adaptatives
+ ***********************************************/
+
+/**
+ * @fn void geometrieSource(sourceImage_t* source, long int largeur, int nbCanaux)
+ * @brief Renseigne la largeur de l'image d'une source, nécessaire au calcul des coûts en mode MODE_ADAPTATIF.
+ *
+ * @param source La source.
+ * @param largeur Largeur de l'image en pixels.
+ * @param nbCanaux Nombre d'échantillons par pixel (1 ou 3).
+ */
+void geometrieSource(sourceImage_t* source, long int largeur, int nbCanaux);
+
+/**
+ * @fn void calculerCoutsLigne(const int* haut, const int* ligne, const int* bas, long int largeur, int nbCanaux, unsigned char* couts)
+ * @brief Calcule le coût de modification de chaque échantillon d'une ligne à partir de ses voisins du même canal.
+ *
+ * L'activité d'un échantillon est |g - d| + |h - b| sur les voisins gauche, droit, haut et bas privés de leur LSB: elle ne change pas quand on inverse des LSB. \n
+ * Le coût vaut COUT_MAX_ADAPTATIF - min(activité, COUT_MAX_ADAPTATIF), et COUT_MAX_ADAPTATIF sur les bords gauche et droit. Le calcul est fait 8 échantillons à la fois avec SSE2.
+ *
+ * @param haut La ligne précédente.
+ * @param ligne La ligne dont on calcule les coûts.
+ * @param bas La ligne suivante.
+ * @param largeur Nombre d'échantillons par ligne.
+ * @param nbCanaux Nombre d'échantillons par pixel (distance entre deux voisins horizontaux).
+ * @param couts Tableau de largeur coûts.
+ */
+void calculerCoutsLigne(const int* haut, const int* ligne, const int* bas, long int largeur, int nbCanaux, unsigned char* couts);
+
+/**
+ * @fn int calculerCoutsAdaptatifs(sourceImage_t* source, long int debut, unsigned int seuil, int** table, long int* nbPositions, long int* histogramme)
+ * @brief Parcourt l'image ligne par ligne et sélectionne, dans l'ordre de l'image, les échantillons dont le coût ne dépasse pas le seuil.
+ *
+ * Les coûts sont calculés au fur et à mesure de la lecture des lignes (3 lignes en mémoire pour une image lue dans le fichier): aucune carte des coûts de la taille de l'image n'est construite. \n
+ * Seuls les échantillons situés au moins une ligne après debut sont sélectionnables, pour qu'aucun voisin ne soit dans le prefixe ou l'entête.
  *
- * @param fileToCrypt Chemin vers le fichier à créer.
- * @param msgSecret Tableau d'octet correspondant au fichier (type unsigned char)
- * @param tailleMsgDecrypt Taille du tableau BINAIRE correspondant au tableau d'octet.
+ * @param source La source (sans vue des canaux), dont la géométrie a été renseignée par geometrieSource.
+ * @param debut Position du premier pixel du message.
+ * @param seuil Coût maximal des échantillons sélectionnés (de 0 à COUT_MAX_ADAPTATIF).
+ * @param table Pointeur qui recevra la table des positions sélectionnées (à libérer), NULL pour seulement les compter.
+ * @param nbPositions Pointeur qui recevra le nombre de positions sélectionnées.
+ * @param histogramme Tableau de NB_COUTS_ADAPTATIFS cases qui recevra le nombre d'échantillons sélectionnables de chaque coût, ou NULL.
  *
  * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
- * @warning La taille passée doit être la taille du tableau binaire et non la taille du tableau d'octet, puisque la fonction calcul automatiquement la division par 8.
  */
-int createFileFromByte(const char* fileToCrypt, const unsigned char* msgSecret, long int tailleMsgDecrypt);
+int calculerCoutsAdaptatifs(sourceImage_t* source, long int debut, unsigned int seuil, int** table, long int* nbPositions, long int* histogramme);
 
 /**
- * @fn int getExtension(const char* pathToFile, char** extensionPixelMap)
- * @brief Cette fonction renvoit l'extension d'un fichier ('.' inclus)
+ * @fn int choisirSeuilAdaptatif(const long int* histogramme, long int tailleMsgBit, int hamming, unsigned int* seuil)
+ * @brief Choisit le plus petit seuil de coût qui sélectionne assez d'échantillons pour le message.
  *
- * L'allocation de la mémoire de la chaine de caractère correspondant à l'extension se fait dans la fonction. C'est à l'utilisateur de la libérer après utilisation.
+ * En Hamming, le seuil vise 1,5 pixel par bit (matrice à 2 lignes), puis 1 pixel par bit si l'image ne le permet pas.
  *
- * @param pathToFile Chemin vers le fichier que l'on souhaite récuperer l'extension.
- * @param extensionPixelMap Passage par adresse de la chaine de caractères qui contient l'extension du fichier.
+ * @param histogramme L'histogramme calculé par calculerCoutsAdaptatifs.
+ * @param tailleMsgBit Taille du message en bits.
+ * @param hamming 1 pour l'insertion de Hamming, 0 pour l'insertion classique.
+ * @param seuil Passage par adresse du seuil choisi.
+ *
+ * @return Retourne un int correspondant au code d'erreur. ERROR_NOMEM si même le seuil maximal ne suffit pas.
+ */
+int choisirSeuilAdaptatif(const long int* histogramme, long int tailleMsgBit, int hamming, unsigned int* seuil);
+
+/**
+ * @fn int hideMessageAdaptatif(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, const int* table, long int nbPositions, int hamming, unsigned int* compteurNbBitsModif)
+ * @brief Cache un message dans les échantillons sélectionnés par calculerCoutsAdaptatifs.
+ *
+ * Les modifications inversent le LSB (au lieu de +1 ou -1) pour que les coûts, et donc la sélection, soient identiques au décodage. \n
+ * En Hamming, les blocs ont le découpage de determineSegmentsHamming sur les nbPositions échantillons sélectionnés.
+ *
+ * @param messageBinary Le tableau binaire du message que l'on souhaite cacher.
+ * @param tailleMsgBit La taille du tableau binaire du message.
+ * @param matriceImage Le tableau 1D de pixel de l'image.
+ * @param table Les positions sélectionnées.
+ * @param nbPositions Nombre de positions sélectionnées.
+ * @param hamming 1 pour l'insertion de Hamming, 0 pour l'insertion classique.
+ * @param compteurNbBitsModif Passage par adresse du nombre de pixels modifiés.
  *
  * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
  *
- * @note Cette fonction correspond à une fonction "split"
+ * @warning L'intensité maximale de l'image doit être impaire.
  */
-int getExtension(const char* pathToFile, char** extensionPixelMap);
+int hideMessageAdaptatif(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, const int* table, long int nbPositions, int hamming, unsigned int* compteurNbBitsModif);
+
+
+
+/************************************************
+ *  Fonctions canaux
+ ***********************************************/
+
+/**
+ * @fn int listerCanaux(unsigned int masque, int profondeur, int canaux[CANAUX_MAX])
+ * @brief Liste les canaux d'un masque de canaux (bit c pour la composante c, soit bit 0 rouge, bit 1 vert, bit 2 bleu pour un P6).
+ *
+ * @param masque Le masque des canaux. 0 (ou tous les bits) désigne tous les canaux.
+ * @param profondeur Nombre de composantes par pixel (au plus CANAUX_MAX).
+ * @param canaux Tableau qui recevra les numéros des canaux sélectionnés dans l'ordre croissant.
+ *
+ * @return Le nombre de canaux sélectionnés (profondeur si tous les canaux sont utilisés).
+ */
+int listerCanaux(unsigned int masque, int profondeur, int canaux[CANAUX_MAX]);
+
+/**
+ * @fn long int positionVueCanaux(long int position, unsigned int masque, int profondeur)
+ * @brief Calcule le nombre d'échantillons des canaux sélectionnés situés avant une position de l'image.
+ *
+ * Permet de convertir une position de l'image (début du message, taille de l'image) en position dans la vue des canaux.
+ *
+ * @param position Position dans le tableau de pixels entrelacés.
+ * @param masque Le masque des canaux.
+ * @param profondeur Nombre de composantes par pixel.
+ *
+ * @return La position correspondante dans la vue.
+ */
+long int positionVueCanaux(long int position, unsigned int masque, int profondeur);
+
+/**
+ * @fn int lireMasqueComposantes(const char* saisie, int profondeur, unsigned int* masque)
+ * @brief Construit un masque de canaux à partir des numéros de composantes saisis (par exemple "012" ou "0,1,2").
+ *
+ * @param saisie Les numéros des composantes, les espaces et les virgules sont ignorés.
+ * @param profondeur Nombre de composantes par pixel.
+ * @param masque Pointeur qui recevra le masque (0 si toutes les composantes sont sélectionnées).
+ *
+ * @return Retourne un int correspondant au code d'erreur. ERROR_INVARG si un numéro n'existe pas ou si aucune composante n'est sélectionnée.
+ */
+int lireMasqueComposantes(const char* saisie, int profondeur, unsigned int* masque);
+
+/**
+ * @fn void desentrelacerRGB(const int* rgb, long int nbPixels, int* rouge, int* vert, int* bleu)
+ * @brief Sépare des pixels RGB entrelacés en 3 plans.
+ *
+ * Le calcul est fait 4 pixels (3 registres) à la fois avec SSE2.
+ *
+ * @param rgb Les pixels entrelacés (3 * nbPixels valeurs).
+ * @param nbPixels Nombre de pixels RGB.
+ * @param rouge Plan rouge (nbPixels valeurs).
+ * @param vert Plan vert (nbPixels valeurs).
+ * @param bleu Plan bleu (nbPixels valeurs).
+ *
+ * @see entrelacerRGB
+ */
+void desentrelacerRGB(const int* rgb, long int nbPixels, int* rouge, int* vert, int* bleu);
+
+/**
+ * @fn void entrelacerRGB(const int* rouge, const int* vert, const int* bleu, long int nbPixels, int* rgb)
+ * @brief Opération inverse de desentrelacerRGB: regroupe 3 plans en pixels RGB entrelacés.
+ *
+ * @param rouge Plan rouge.
+ * @param vert Plan vert.
+ * @param bleu Plan bleu.
+ * @param nbPixels Nombre de pixels RGB.
+ * @param rgb Les pixels entrelacés (3 * nbPixels valeurs).
+ */
+void entrelacerRGB(const int* rouge, const int* vert, const int* bleu, long int nbPixels, int* rgb);
+
+/**
+ * @fn int extraireVueCanaux(const int* matriceImage, long int dimension, int profondeur, unsigned int masque, int** vue, long int* dimensionVue)
+ * @brief Construit la vue des canaux sélectionnés d'un P6 ou d'un P7: le tableau des seuls échantillons de ces canaux, dans l'ordre de l'image.
+ *
+ * L'échantillon i de la vue est le pixel (i / n) * profondeur + canaux[i % n] de l'image, où n est le nombre de canaux sélectionnés. \n
+ * Toutes les méthodes d'insertion peuvent ensuite travailler sur la vue comme sur une image complète. Le cas RGB (profondeur 3) utilise desentrelacerRGB.
+ *
+ * @param matriceImage Le tableau de pixels entrelacés.
+ * @param dimension Taille du tableau de pixels (multiple de profondeur).
+ * @param profondeur Nombre de composantes par pixel.
+ * @param masque Le masque des canaux.
+ * @param vue Pointeur qui recevra la vue (à libérer).
+ * @param dimensionVue Pointeur qui recevra la taille de la vue.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @see reinsererVueCanaux
+ */
+int extraireVueCanaux(const int* matriceImage, long int dimension, int profondeur, unsigned int masque, int** vue, long int* dimensionVue);
+
+/**
+ * @fn int reinsererVueCanaux(int* matriceImage, long int dimension, int profondeur, unsigned int masque, const int* vue)
+ * @brief Recopie une vue (modifiée) dans les canaux sélectionnés de l'image, les autres canaux sont inchangés.
+ *
+ * @param matriceImage Le tableau de pixels entrelacés.
+ * @param dimension Taille du tableau de pixels (multiple de profondeur).
+ * @param profondeur Nombre de composantes par pixel.
+ * @param masque Le masque des canaux.
+ * @param vue La vue construite par extraireVueCanaux.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ */
+int reinsererVueCanaux(int* matriceImage, long int dimension, int profondeur, unsigned int masque, const int* vue);
+
+/**
+ * @fn void vueCanauxSource(sourceImage_t* source, unsigned int masque)
+ * @brief Restreint les lectures suivantes de la source aux canaux sélectionnés.
+ *
+ * lireEchantillon interprète ensuite les positions comme des positions dans la vue (voir extraireVueCanaux) et initLecteurBits convertit le début du message et la taille de l'image.
+ *
+ * @param source La source.
+ * @param masque Le masque des canaux (0 pour revenir à l'image complète).
+ */
+void vueCanauxSource(sourceImage_t* source, unsigned int masque);
+
+
 
 
 
 
 
 /************************************************
- *  Fonctions Hamming
+ *  Fonctions flux de trames
  ***********************************************/
 
 /**
- * @fn int determineBestHammingSize(unsigned int tailleImg, unsigned int tailleMsg, unsigned int* rows, unsigned int* columns)
- * @brief Cette fonction determine la taille la plus adaptée pour une matrice de hamming en fonction de la taille d'une image et d'un message.
+ * @fn int ouvrirFlux(char* pathFile, FILE** flux, formatFlux_t* format)
+ * @brief Ouvre un flux de trames et lit son format: ligne d'entête pour un Y4M, rien pour des PNM concaténés.
  *
- * Cette fonction calcule la capacité de chaque matrice de hamming jusqu'à trouver celle qui correspond le mieux à la taille du message.
+ * Le flux est lu séquentiellement, ce qui permet de lire un tube nommé.
  *
- * @param tailleImg Taille de l'image.
- * @param tailleMsg Taille du message.
- * @param rows Passage par adresse du nombre de lignes de la matrice de hamming.
- * @param columns Passage par adresse du nombre de colonnes de la matrice de hamming.
+ * @param pathFile Chemin du flux.
+ * @param flux Passage par adresse du flux ouvert, placé sur la première trame (NULL en cas d'erreur).
+ * @param format Passage par adresse du format du flux.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_FORMAT si l'entête Y4M est invalide ou décrit des échantillons de plus de 8 bits.
+ */
+int ouvrirFlux(char* pathFile, FILE** flux, formatFlux_t* format);
+
+/**
+ * @fn int lireTrame(FILE* flux, const formatFlux_t* format, trameFlux_t* trame, int* finFlux)
+ * @brief Lit la trame suivante d'un flux ouvert par ouvrirFlux.
+ *
+ * Pour des PNM concaténés, chaque trame est un P5 ou un P6 d'intensité au plus 255 dont les commentaires sont ignorés. Pour un Y4M, les paramètres de la ligne FRAME sont ignorés.
+ *
+ * @param flux Le flux.
+ * @param format Le format du flux.
+ * @param trame La trame lue. Son tableau de pixels est agrandi si nécessaire.
+ * @param finFlux Passage par adresse: vaut 1 si le flux se termine avant une nouvelle trame.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_FORMAT si la trame est incomplète ou invalide.
+ */
+int lireTrame(FILE* flux, const formatFlux_t* format, trameFlux_t* trame, int* finFlux);
+
+/**
+ * @fn int ecrireTrame(FILE* flux, const formatFlux_t* format, const trameFlux_t* trame)
+ * @brief Écrit une trame (entête minimal sans commentaire ni paramètre, puis pixels) dans un flux.
+ *
+ * @param flux Le flux.
+ * @param format Le format du flux.
+ * @param trame La trame.
  *
  * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
  */
-int determineBestHammingSize(unsigned int tailleImg, unsigned int tailleMsg, unsigned int* rows, unsigned int* columns);
+int ecrireTrame(FILE* flux, const formatFlux_t* format, const trameFlux_t* trame);
 
 /**
- * @fn int isVectorNull(unsigned int **vector, unsigned int columns)
- * @brief Cette fonction determine si un vecteur possède des composantes toutes égales à 0 ou non.
+ * @fn long int dimensionVueTrame(const trameFlux_t* trame, unsigned int masque)
+ * @brief Nombre d'échantillons des plans sélectionnés d'une trame.
  *
- * Un vecteur est codé de cette manière: tableau 2D dont la première case est égale à 0.
- * \n Pour un vecteur de 5 composantes on a donc: vect[0][5];
+ * @param trame La trame.
+ * @param masque Les plans sélectionnés (bit 0 pour Y, 1 pour Cb, 2 pour Cr), 0 pour tous les plans.
  *
- * @param vector Tableau 2D vers le vecteur que l'on souhaite tester.
- * @param columns Nombre de composantes du vecteur.
+ * @return Le nombre d'échantillons de la vue.
+ */
+long int dimensionVueTrame(const trameFlux_t* trame, unsigned int masque);
+
+/**
+ * @fn void copierVueTrame(trameFlux_t* trame, unsigned int masque, int* matrice, long int nb, int versTrame)
+ * @brief Copie les nb premiers échantillons de la vue des plans sélectionnés, de la trame vers matrice ou de matrice vers la trame.
  *
- * @return 1 si le vecteur est le vecteur NULL, 0 sinon.
+ * Les plans sont parcourus en place dans le tampon de la trame: seuls les échantillons utilisés par l'insertion sont convertis.
  *
- * @warning Le vecteur doit être bien formaté selon ce format: tableau 2D dont la première case est égale à 0. Pour un vecteur de 5 composantes on a donc: vect[0][5];
+ * @param trame La trame.
+ * @param masque Les plans sélectionnés, 0 pour tous les plans.
+ * @param matrice Le tableau de travail (au moins nb éléments).
+ * @param nb Nombre d'échantillons à copier depuis le début de la vue.
+ * @param versTrame 0 pour lire la trame, 1 pour y réécrire matrice.
  */
-int isVectorNull(unsigned int **vector, unsigned int columns);
+void copierVueTrame(trameFlux_t* trame, unsigned int masque, int* matrice, long int nb, int versTrame);
 
 /**
- * @fn int findInHamming(unsigned int **matriceHamming, unsigned int columns, unsigned int rows, unsigned int **matriceRes, unsigned int *position)
- * @brief Cette fonction permet de faire une correspondance dans une matrice de Hamming.
+ * @fn int cacherDansFlux(FILE* entree, const formatFlux_t* format, char* pathSortie, unsigned int masque, unsigned int lignes, const unsigned char* messageBinary, size_t tailleMsgBit, long int* nbTrames, long int* nbTramesUtilisees)
+ * @brief Cache un message dans un flux de trames en le répartissant sur les trames successives.
+ *
+ * Chaque trame porte son propre prefixe (fin des bits de la trame) suivi de sa part du message. Les trames suivantes sont recopiées telles quelles. \n
+ * Des PNM concaténés sont remplis de manière classique. Dans un Y4M, seuls les plans de masque sont utilisés et chaque trame reçoit lignes bits par bloc de 2^lignes - 1 échantillons, insérés avec le découpage de determineSegmentsHamming (lignes = 1: 1 bit par échantillon). \n
+ * La lecture, l'insertion et l'écriture sont faites par trois étapes parallèles reliées par une file de NB_TRAMES_FILE trames (voir fileTrames_t).
+ *
+ * @param entree Le flux d'origine, ouvert par ouvrirFlux (il n'est pas fermé).
+ * @param format Le format du flux d'origine.
+ * @param pathSortie Chemin du flux à créer.
+ * @param masque Les plans utilisés pour un Y4M (0 pour tous), 0 pour des PNM.
+ * @param lignes Nombre de bits par bloc de Hamming pour un Y4M (de 1 à LIGNES_MAX_HAMMING - 1), 0 pour des PNM.
+ * @param messageBinary Le message en binaire (entête du conteneur compris).
+ * @param tailleMsgBit Taille du message en bits.
+ * @param nbTrames Passage par adresse du nombre de trames écrites.
+ * @param nbTramesUtilisees Passage par adresse du nombre de trames qui contiennent une partie du message.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_NOMEM si le flux est trop court pour le message.
+ *
+ * @see extraireDuFlux
+ */
+int cacherDansFlux(FILE* entree, const formatFlux_t* format, char* pathSortie, unsigned int masque, unsigned int lignes, const unsigned char* messageBinary, size_t tailleMsgBit, long int* nbTrames, long int* nbTramesUtilisees);
+
+/**
+ * @fn int extraireDuFlux(char* pathEntree, enteteConteneur_t* entete, unsigned char** charge, size_t* tailleCharge, long int* nbTrames)
+ * @brief Extrait le conteneur caché par cacherDansFlux.
  *
- * Un vecteur est donné en paramètre et la fonction permet de dire si ce vecteur correspond à l'une des colonnes de la matrice de Hamming.
+ * Les trames sont lues une à une et la lecture s'arrête à la fin du conteneur. Les blocs CRC32C sont vérifiés dès qu'ils sont complets. \n
+ * Pour un Y4M, les plans utilisés sont retrouvés sur la première trame: chaque combinaison est essayée jusqu'à lire un entête de conteneur qui l'annonce.
  *
- * @param matriceHamming Tableau 2D correspondant à la matrice de Hamming.
- * @param columns Nombre de colonnes de la matrice de Hamming
- * @param rows Nombre de lignes de la matrice de Hamming
- * @param matriceRes Vecteur que l'on souhaite faire correspondre. Ce vecteur ne doit pas être nul. Tableau 2D codé suivant la manière vu dans le warning.
- * @param position Passage par adresse de la position dans la matrice de hamming dont la colonne correspond au vecteur passé en paramètre.
+ * @param pathEntree Chemin du flux.
+ * @param entete Passage par adresse de l'entête du conteneur.
+ * @param charge Passage par adresse du message, sans l'entête ni la table des CRC (ni déchiffré ni décompressé, voir restaurerCharge).
+ * @param tailleCharge Passage par adresse de la taille du message.
+ * @param nbTrames Passage par adresse du nombre de trames lues.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_CHECKSUM si un bloc est invalide et ERROR_FORMAT si le flux ne contient pas de conteneur complet.
+ */
+int extraireDuFlux(char* pathEntree, enteteConteneur_t* entete, unsigned char** charge, size_t* tailleCharge, long int* nbTrames);
+
+
+
+/************************************************
+ *  Fonctions répartition et copies d'images
+ ***********************************************/
+
+/**
+ * @fn int chargerImage(char* pathFile, imageChargee_t* image)
+ * @brief Lit le format puis tous les échantillons d'une image (ppm/pgm/pam/bmp/png/wav).
+ *
+ * @param pathFile Chemin de l'image.
+ * @param image Passage par adresse de l'image chargée.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ *
+ * @warning image->matriceImage est alloué dans la fonction. L'utilisateur doit le libérer après utilisation.
+ */
+int chargerImage(char* pathFile, imageChargee_t* image);
+
+/**
+ * @fn int ecrireImageChargee(char* pathSource, char* pathSortie, imageChargee_t* image)
+ * @brief Écrit une image chargée par chargerImage dans un nouveau fichier, dans le format de l'image d'origine.
+ *
+ * Un BMP ou un WAV est d'abord recopié depuis pathSource pour conserver ses entêtes et métadonnées.
+ *
+ * @param pathSource Chemin de l'image d'origine.
+ * @param pathSortie Chemin de l'image à créer.
+ * @param image L'image.
  *
  * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
  */
-int findInHamming(unsigned int **matriceHamming, unsigned int columns, unsigned int rows, unsigned int **matriceRes, unsigned int *position);
+int ecrireImageChargee(char* pathSource, char* pathSortie, imageChargee_t* image);
 
 /**
- * @fn void additionMatrice(unsigned int m, unsigned int n, unsigned int** mat1, unsigned int** mat2, unsigned int*** res)
- * @brief Additionne deux matrices en modulo 2.
+ * @fn long int capaciteFragment(long int dimension, int tailleEntete)
+ * @brief Taille maximale d'un fragment (en octets, table des CRC non comprise) qu'une image peut accueillir.
  *
- * Cette fonction prend deux tableau 2D en paramètre (de même dimension) et renvoit le résultat de l'addition en passage par adresse.
+ * Un fragment utilise au moins un bit par échantillon après le prefixe et l'entête (insertion de Hamming en segments).
  *
- * @param m Nombre de colonnes des matrices.
- * @param n Nombre de ligne des matrices.
- * @param mat1 Tableau 2D correspondant à la matrice 1.
- * @param mat2 Tableau 2D correspondnat à la matrice 2.
- * @param res Passage par adresse de la matrice contenant le résultat de l'addition.
+ * @param dimension Nombre d'échantillons de l'image.
+ * @param tailleEntete Taille de l'entête du fragment en octets (voir serialiserEnteteConteneur).
  *
- * @warning Les deux matrices doivent avoir les mêmes dimensions.
- * @warning Les matrices doivent être codées de la sorte que les colonnes soient le premier indice.
- * @warning Les calculs sont effectué en base 2 (modulo 2)
+ * @return La capacité en octets, 0 si l'image est trop petite.
  */
-void additionMatrice(unsigned int m, unsigned int n, unsigned int** mat1, unsigned int** mat2, unsigned int*** res);
+long int capaciteFragment(long int dimension, int tailleEntete);
 
 /**
- * @fn void multiplyMatrice(unsigned int m2, unsigned int** mat1, unsigned int n1, unsigned int n2, unsigned int** mat2, unsigned int*** res)
- * @brief Multiplie deux matrices en modulo 2.
+ * @fn int preparerEnteteSegmente(const enteteConteneur_t* entete, long int dimension, enteteConteneur_t* enteteInsere, long int* debut, unsigned int* rows, long int* nbBlocsGrands)
+ * @brief Calcule l'entête inséré par cacherConteneurSegmente et le découpage de Hamming du message, sans rien insérer.
  *
- * Cette fonction prend deux tableau 2D en paramètre (avec leurs dimensions respectives) et renvoit le résultat de la multiplication en passage par adresse.
+ * Permet de chiffrer le message avec l'entête exact qui sera inséré.
  *
- * @param m2 Nombre de ligne de la matrice 1
- * @param mat1 Tableau 2D correspondant à la matrice 1
- * @param n1 Nombre de colonnes des deux matrices.
- * @param n2 Nombre de ligne de la matrice 2.
- * @param mat2 Tableau 2D correspondant à la matrice 2
- * @param res Passage par adresse d'un tableau 2D correspondnat à la matrice contenant le résultat de la multiplication.
+ * @param entete Entête du message (longueurCharge vaut la taille du message).
+ * @param dimension Nombre d'échantillons de l'image.
+ * @param enteteInsere Passage par adresse de l'entête inséré (table des CRC, mode et paramètre de Hamming).
+ * @param debut Passage par adresse de la position du message, après le prefixe et l'entête.
+ * @param rows Passage par adresse du nombre de lignes des segments de Hamming.
+ * @param nbBlocsGrands Passage par adresse du nombre de blocs à rows + 1 lignes.
  *
- * @warning Les matrices doivent être codées de la sorte que les colonnes soient le premier indice.
- * @warning Les matrices doivent avoir le même nombre de colonnes.
- * @warning Les calculs sont effectué en base 2 (modulo 2)
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_NOMEM si le message ne tient pas dans l'image.
  */
-void multiplyMatrice(unsigned int m2, unsigned int** mat1, unsigned int n1, unsigned int n2, unsigned int** mat2, unsigned int*** res);
+int preparerEnteteSegmente(const enteteConteneur_t* entete, long int dimension, enteteConteneur_t* enteteInsere, long int* debut, unsigned int* rows, long int* nbBlocsGrands);
 
+/**
+ * @fn int cacherConteneurSegmente(const enteteConteneur_t* entete, const unsigned char* message, int* matriceImage, long int dimension, long int pixelIntensity, long int* finModifications)
+ * @brief Cache le prefixe, l'entête et un message avec sa table de CRC32C dans un tableau d'échantillons.
+ *
+ * Le message est inséré par syndrome de Hamming en segments (voir determineSegmentsHamming) sur tout le reste de l'image: le mode et le paramètre de l'entête sont choisis dans la fonction (voir preparerEnteteSegmente).
+ *
+ * @param entete Entête du message (longueurCharge vaut la taille du message).
+ * @param message Les entete->longueurCharge octets du message.
+ * @param matriceImage Les échantillons de l'image.
+ * @param dimension Nombre d'échantillons.
+ * @param pixelIntensity Intensité maximale des échantillons.
+ * @param finModifications Passage par adresse de la fin de la zone modifiée: aucun échantillon après n'est modifié.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_NOMEM si le message ne tient pas dans l'image.
+ */
+int cacherConteneurSegmente(const enteteConteneur_t* entete, const unsigned char* message, int* matriceImage, long int dimension, long int pixelIntensity, long int* finModifications);
 
 /**
- * @fn int genererHamming(unsigned int*** hamming, unsigned int r, unsigned int c)
- * @brief Génère une matrice de hamming en fonction des dimensions passées en paramètre.
+ * @fn int cacherFragment(char* pathEntree, char* pathSortie, const enteteConteneur_t* entete, const unsigned char* fragment)
+ * @brief Cache un fragment de message dans une copie d'une image, avec sa table de CRC32C (voir cacherConteneurSegmente).
  *
- * @param hamming Passage par adresse d'un tableau 2D correspondant à la matrice de hamming.
- * @param r Nombre de lignes de la matrice de Hamming
- * @param c Nombre de colonnes de la matrice de Hamming
- * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ * @param pathEntree Chemin de l'image d'origine.
+ * @param pathSortie Chemin de l'image à créer.
+ * @param entete Entête du fragment (FLAG_CONTENEUR_FRAGMENT, longueurCharge vaut la taille du fragment).
+ * @param fragment Les entete->longueurCharge octets du fragment.
  *
- * @note La matrice de hamming est un tableau 2D codé de manière à ce que les colonnes sont les premiers indices du tableau.
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_NOMEM si le fragment ne tient pas dans l'image.
  */
-int genererHamming(unsigned int*** hamming, unsigned int r, unsigned int c);
+int cacherFragment(char* pathEntree, char* pathSortie, const enteteConteneur_t* entete, const unsigned char* fragment);
 
+/**
+ * @fn int extraireFragment(char* pathFile, enteteConteneur_t* entete, unsigned char** fragment)
+ * @brief Lit l'entête et extrait le fragment caché par cacherFragment, en vérifiant ses blocs CRC32C.
+ *
+ * @param pathFile Chemin de l'image.
+ * @param entete Passage par adresse de l'entête du fragment.
+ * @param fragment Passage par adresse du fragment (entete->longueurCharge octets).
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_FORMAT si l'image ne contient pas de fragment et ERROR_CHECKSUM si un bloc est invalide.
+ *
+ * @warning Le fragment est alloué dans la fonction. L'utilisateur doit le libérer après utilisation.
+ */
+int extraireFragment(char* pathFile, enteteConteneur_t* entete, unsigned char** fragment);
 
+/**
+ * @fn int repartirCharge(char** pathsEntree, char** pathsSortie, int nbImages, const enteteConteneur_t* modele, const unsigned char* charge, size_t tailleCharge, long int* taillesFragments)
+ * @brief Répartit un message sur plusieurs images, proportionnellement à leurs capacités, et crée les images en parallèle.
+ *
+ * Chaque image reçoit un fragment contigu du message, son numéro, le nombre de fragments et le CRC32C du message complet (voir FLAG_CONTENEUR_FRAGMENT). Les images sont traitées par plusieurs threads (un par coeur, au plus NB_THREADS_REPARTITION_MAX).
+ *
+ * @param pathsEntree Chemins des images d'origine.
+ * @param pathsSortie Chemins des images à créer.
+ * @param nbImages Nombre d'images (de 1 à NB_FRAGMENTS_MAX).
+ * @param modele Entête commun (nom et indicateurs FICHIER, COMPRESSE et CHIFFRE).
+ * @param charge Le message, déjà compressé et chiffré si nécessaire.
+ * @param tailleCharge Taille du message.
+ * @param taillesFragments Tableau de nbImages cases qui reçoit la taille du fragment de chaque image.
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_NOMEM si le message dépasse la capacité totale des images.
+ *
+ * @see reconstituerCharge
+ */
+int repartirCharge(char** pathsEntree, char** pathsSortie, int nbImages, const enteteConteneur_t* modele, const unsigned char* charge, size_t tailleCharge, long int* taillesFragments);
 
 /**
- * @fn int hideMessageHamming(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, unsigned int rows, unsigned int columns, unsigned int* compteurNbBitsModif)
- * @brief Cette fonction cache un message (tableau binaire) dans un tableau de pixel en utilisant la méthode de Hamming.
+ * @fn int reconstituerCharge(char** paths, int nbImages, enteteConteneur_t* entete, unsigned char** charge, size_t* tailleCharge, int* imageInvalide, int* fragmentInvalide, int* nbFragments)
+ * @brief Extrait en parallèle les fragments d'un message réparti par repartirCharge et les réassemble, quel que soit l'ordre des images.
  *
- * On utilise une matrice de hamming de taille donnée en paramètre. La matrice sera de taille par exemple (N,M).
- * Pour crypter, on récupère une séquence de N LSB de notre image que l'on multiplie à la matrice de hamming. On additionne le résultat (XOR) avec une séquence de M bits du message à cacher. On aura un output de taille (1, M) qui correspondra à l'unes des N colonnes de la matrice de hamming. On a plus qu'à reporter sur la matrice de hamming pour savoir à quelle numéro de colonne cela correspond. Si notre résultat est égal à la 2eme colonne de la matrice de hamming on va modifier notre 2eme/M bits LSB de notre image de départ.
+ * Tous les fragments doivent être présents une seule fois et annoncer le même message. Le message assemblé est vérifié par son CRC32C.
  *
- * @param messageBinary Le tableau binaire du message que l'on souhaite cacher.
- * @param tailleMsgBit La taille du tableau binaire du message.
- * @param matriceImage Le tableau 1D de pixel de l'image dans laquelle on va cacher le message.
- * @param dimension La taille de la matrice de pixel de l'image.
- * @param pixelIntensity L'intensité maximale des pixels de l'image.
- * @param lengthDimensionPrefix La taille du prefixe de l'image.
- * @param rows Le nombre de lignes de la matrice de Hamming.
- * @param columns Le nombre de colonnes de la matrice de Hamming
- * @param compteurNbBitsModif Passage par adresse du nombre de bits modifié par cette méthode.
+ * @param paths Chemins des images.
+ * @param nbImages Nombre d'images.
+ * @param entete Passage par adresse de l'entête du message complet (longueurCharge vaut sa taille, FLAG_CONTENEUR_FRAGMENT est retiré).
+ * @param charge Passage par adresse du message (ni déchiffré ni décompressé, voir restaurerCharge).
+ * @param tailleCharge Passage par adresse de la taille du message.
+ * @param imageInvalide Passage par adresse de la première image en erreur (-1 si l'erreur ne concerne pas une image en particulier).
+ * @param fragmentInvalide Passage par adresse du numéro (à partir de 0) du fragment en double, porté par l'image imageInvalide, ou du premier fragment manquant, imageInvalide valant alors -1. Vaut -1 pour une autre erreur.
+ * @param nbFragments Passage par adresse du nombre de fragments annoncé par les entêtes (0 s'ils n'ont pas pu être lus ou ne correspondent pas).
  *
- * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_FORMAT s'il manque un fragment, si un fragment est en double ou si les fragments ne correspondent pas et ERROR_CHECKSUM si un bloc ou le message assemblé est invalide.
  *
- * @note Les dimensions de la matrice de Hamming doivent être determinées avant d'appeller cette fonction.
+ * @warning Le message est alloué dans la fonction. L'utilisateur doit le libérer après utilisation.
+ */
+int reconstituerCharge(char** paths, int nbImages, enteteConteneur_t* entete, unsigned char** charge, size_t* tailleCharge, int* imageInvalide, int* fragmentInvalide, int* nbFragments);
+
+/**
+ * @fn int cacherDansCopies(char* pathCouverture, const imageChargee_t* couverture, char** pathsSortie, int nbSorties, const enteteConteneur_t* entetes, unsigned char** charges, long int* finsModifications, int* sortieInvalide)
+ * @brief Cache un message différent dans chaque copie d'une même image, les copies étant créées en parallèle.
  *
- * @see hideDimMsg
- * @see decryptMessageHamming
+ * L'image, lue une seule fois par chargerImage, n'est pas modifiée. Chaque thread (un par coeur, au plus NB_THREADS_REPARTITION_MAX) en garde une copie entière: il y insère le message d'une copie (voir cacherConteneurSegmente), écrit la copie, puis restaure la zone modifiée depuis l'image d'origine avant de passer à la copie suivante. La mémoire utilisée est d'une image par thread, et non par copie.
+ *
+ * @param pathCouverture Chemin de l'image d'origine (recopiée pour un BMP ou un WAV).
+ * @param couverture L'image d'origine.
+ * @param pathsSortie Chemins des copies à créer.
+ * @param nbSorties Nombre de copies.
+ * @param entetes Entête du message de chaque copie (longueurCharge vaut la taille du message).
+ * @param charges Message de chaque copie, déjà compressé et chiffré si nécessaire.
+ * @param finsModifications Tableau de nbSorties cases qui reçoit la fin de la zone modifiée de chaque copie, en échantillons.
+ * @param sortieInvalide Passage par adresse de la première copie en erreur (-1 si aucune).
+ *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_NOMEM si un message ne tient pas dans l'image.
  */
-int hideMessageHamming(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, unsigned int rows, unsigned int columns, unsigned int* compteurNbBitsModif);
+int cacherDansCopies(char* pathCouverture, const imageChargee_t* couverture, char** pathsSortie, int nbSorties, const enteteConteneur_t* entetes, unsigned char** charges, long int* finsModifications, int* sortieInvalide);
 
 
+
+
+/************************************************
+ *  Fonctions archive
+ ************************************************/
+
 /**
- * @fn int decryptMessageHamming(const int *matriceImage, long int dimension, int prefixInt, int lengthDimensionPrefix, unsigned int rows, unsigned int columns, long int *tailleMsgDecrypt, unsigned char **messageSecretBitOutput)
- * @brief Cette fonction décode un message caché dans une image en utilisant la méthode de Hamming.
+ * @fn int construireArchive(char** paths, int nbEntrees, int compresser, const char* motDePasse, unsigned char** archive, size_t* tailleArchive)
+ * @brief Regroupe plusieurs fichiers dans une archive précédée de son index (voir FLAG_CONTENEUR_ARCHIVE).
  *
- * Méthode pour décrypter: On reprend notre matrice de hamming de (N,M) taille que l'on multiplie par des séquences de N LSB de l'image. On a à chaque fois une matrice output de taille M qui est notre message décodé si on les met toutes côte à côte.
+ * Chaque fichier est compressé puis chiffré séparément, pour pouvoir être extrait et authentifié sans lire les autres.
  *
- * @param matriceImage Tableau 1D de pixels de l'image dans laquelle le message est caché.
- * @param dimension Dimension du tableau de pixels.
- * @param prefixInt Valeur du prefixe de l'image, ce qui correspond à la taille de notre message secret.
- * @param lengthDimensionPrefix Longueur du prefixe, ce qui correspond à l'endroit où commence notre message secret.
- * @param rows Nombre de lignes de la matrice de Hamming
- * @param columns Nombre de colonnes de la matrice de Hamming.
- * @param tailleMsgDecrypt Passage par adresse de la taille du message secret.
- * @param messageSecretBitOutput Passage par adresse du tableau 1D contenant le message secret.
+ * @param paths Chemins des fichiers, le nom enregistré est celui du fichier sans son dossier.
+ * @param nbEntrees Nombre de fichiers (de 1 à NB_ENTREES_ARCHIVE_MAX).
+ * @param compresser Vaut 1 pour compresser chaque fichier (conservé tel quel si la compression ne réduit pas sa taille).
+ * @param motDePasse Mot de passe de chiffrement de chaque fichier, NULL pour ne pas chiffrer.
+ * @param archive Passage par adresse de l'archive allouée.
+ * @param tailleArchive Passage par adresse de la taille de l'archive.
  *
- * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_OK si tout s'est bien passé.
+ * @return Retourne un int correspondant au code d'erreur.
+ */
+int construireArchive(char** paths, int nbEntrees, int compresser, const char* motDePasse, unsigned char** archive, size_t* tailleArchive);
+
+/**
+ * @fn int lireIndexArchive(lecteurBits_t* lecteur, long int debutOctet, long int longueurCharge, entreeArchive_t** entrees, int* nbEntrees)
+ * @brief Lit l'index d'une archive directement dans l'image, sans extraire les fichiers.
  *
- * @note Les dimensions de la matrice de Hamming doivent être determinées avant d'appeller cette fonction.
+ * @param lecteur Le lecteur de bits initialisé par initLecteurBits.
+ * @param debutOctet Position de l'archive dans le flux caché, en octets (après la table des CRC32C).
+ * @param longueurCharge Taille de l'archive.
+ * @param entrees Passage par adresse du tableau alloué des entrées.
+ * @param nbEntrees Passage par adresse du nombre d'entrées.
  *
- * @warning Le tableau de sortie contenant le message secret ne doit pas être alloué avant la fonction. L'utilisateur est libre de le libérer après utilisation.
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_FORMAT si l'index est incohérent.
+ */
+int lireIndexArchive(lecteurBits_t* lecteur, long int debutOctet, long int longueurCharge, entreeArchive_t** entrees, int* nbEntrees);
+
+/**
+ * @fn int extraireEntreeArchive(lecteurBits_t* lecteur, long int debutOctet, const entreeArchive_t* entree, const char* motDePasse, unsigned char** donnees, size_t* taille)
+ * @brief Extrait un seul fichier d'une archive en ne lisant que ses octets, puis le vérifie, le déchiffre et le décompresse.
  *
- * @see hideMessageHamming
+ * @param lecteur Le lecteur de bits initialisé par initLecteurBits.
+ * @param debutOctet Position de l'archive dans le flux caché, en octets.
+ * @param entree Entrée du fichier, lue par lireIndexArchive.
+ * @param motDePasse Mot de passe du fichier (ignoré s'il n'est pas chiffré).
+ * @param donnees Passage par adresse du fichier alloué.
+ * @param taille Passage par adresse de la taille du fichier.
  *
+ * @return Retourne un int correspondant au code d'erreur. Celui-ci vaut ERROR_CHECKSUM si le fichier a été altéré.
  */
-int decryptMessageHamming(const int *matriceImage, long int dimension, int prefixInt, int lengthDimensionPrefix, unsigned int rows, unsigned int columns, long int *tailleMsgDecrypt, unsigned char **messageSecretBitOutput);
+int extraireEntreeArchive(lecteurBits_t* lecteur, long int debutOctet, const entreeArchive_t* entree, const char* motDePasse, unsigned char** donnees, size_t* taille);
+
+
+
+
+
 
 
 /************************************************
@@ -695,6 +3707,43 @@ void li(int position, char* text);
  */
 long reponseMenu(int choixMax);
 
+/**
+ * @fn long reponseNombre()
+ * @brief Cette fonction renvoit un entier positif ou nul saisi par l'utilisateur.
+ *
+ * @return L'entier saisi, -1 si la saisie n'est pas un entier positif ou nul.
+ */
+long reponseNombre();
+
+/**
+ * @fn int choisirModeDecryptage(long int dimension, long int prefixInt, long int lengthDimensionPrefix, int portion, char** cryptKey, unsigned int* rows, unsigned int* columns)
+ * @brief Demande à l'utilisateur la méthode utilisée pour cacher le message, ainsi que la clé ou la taille de la matrice de Hamming correspondante.
+ *
+ * @param dimension Taille du tableau de pixels.
+ * @param prefixInt Valeur du prefixe lu dans l'image.
+ * @param lengthDimensionPrefix Taille du prefixe.
+ * @param portion Vaut 1 pour une extraction partielle: le mode MODE_CHIFFRE est alors refusé avant la saisie de la clé.
+ * @param cryptKey Passage par adresse de la clé saisie (modes chiffrés uniquement).
+ * @param rows Passage par adresse du nombre de lignes de la matrice de Hamming (mode Hamming uniquement).
+ * @param columns Passage par adresse du nombre de colonnes de la matrice de Hamming (mode Hamming uniquement).
+ *
+ * @return Le mode choisi (modeInsertion_t), -1 si le choix est invalide.
+ */
+int choisirModeDecryptage(long int dimension, long int prefixInt, long int lengthDimensionPrefix, int portion, char** cryptKey, unsigned int* rows, unsigned int* columns);
+
+/**
+ * @fn int parametresLecture(const enteteConteneur_t* entete, char** cleChiffrement, unsigned int* rows, unsigned int* columns)
+ * @brief Déduit de l'entête du conteneur les paramètres de initLecteurBits, et demande la clé de chiffrement si le mode en utilise une.
+ *
+ * @param entete Entête lu par lireEnteteConteneur.
+ * @param cleChiffrement Passage par adresse de la clé saisie (modes MODE_CHIFFRE, MODE_CHIFFRE_CALCULABLE et MODE_HAMMING_CHIFFRE uniquement).
+ * @param rows Passage par adresse du paramètre rows de initLecteurBits.
+ * @param columns Passage par adresse du paramètre columns de initLecteurBits.
+ *
+ * @return Retourne un int correspondant au code d'erreur.
+ */
+int parametresLecture(const enteteConteneur_t* entete, char** cleChiffrement, unsigned int* rows, unsigned int* columns);
+
 /**
  * @fn char *inputString(FILE* fp, size_t size)
  * @brief Cette fonction récupère une chaine de caractères rentrée par l'utilisateur de taille quelconque.
@@ -709,6 +3758,18 @@ long reponseMenu(int choixMax);
  */
 char *inputString(FILE* fp, size_t size);
 
+/**
+ * @fn char** inputChemins(FILE* fp, int* nbChemins)
+ * @brief Récupère des chemins saisis un par ligne, jusqu'à une ligne vide.
+ *
+ * @param fp Le buffer d'entrée des chemins.
+ * @param nbChemins Passage par adresse du nombre de chemins saisis.
+ * @return Tableau des chemins, NULL si la mémoire manque.
+ *
+ * @warning Le tableau et chacun des chemins doivent être libérés par l'utilisateur après utilisation.
+ */
+char** inputChemins(FILE* fp, int* nbChemins);
+
 /**
  * @fn void viderBuffer()
  * @brief Vide le buffer du clavier en absorbant tous les caractères jusqu'a trouver '\0' ou EOF
@@ -8,7 +8,7 @@
  * -# Insertion classique du message pixel par pixel.
  * -# Insertion crypté du message en changeant l'ordre de parcour des pixels en fonction d'une clé secrete fournit par l'utilisateur.
  * -# Insertion en utilisant la méthode de Hamming et la matrice de vérification pour ne modifier qu'une portion de bits et augmenter l'imperceptibilité
- * -# Possibilité également de mélanger son message secret en utilisant une clé secrete fournit par l'utilisateur.
+ * -# Possibilité également de chiffrer et d'authentifier son message secret (ChaCha20-Poly1305) avec une clé secrete fournit par l'utilisateur.
  *
  * \n Une fois ces opérations effectuées sur le message, celui-ci est caché dans une copie de l'image d'origine, avec un nom spécifié par l'utilisateur.
  *
@@ -20,21 +20,32 @@
  *
  */
 
+// open_memstream, pread et pwrite (POSIX.1-2008) restent déclarés quand le compilateur est en C strict (-std=c99)
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <math.h>
 #include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
 #include "header.h"
 
 int main() {
 
     /* --------- DEFINITION DES VARIABLES --------- */
     error_t error;
-    char typeFile[50];
-    long int imageWidth, imageHeight, pixelIntensity, beginningImage, beginningNewImage, dimension, i, tailleMsgDecrypt;
-    int *matriceImage = NULL, userMenu, longueurExtensionPixelMap, lengthDimensionPrefix, prefixInt, lengthmsgSecret;
+    char typeFile[50], tuplType[TAILLE_TUPLTYPE_PAM];
+    long int imageWidth, imageHeight, profondeur, pixelIntensity, beginningImage, beginningNewImage, dimension, i;
+    int *matriceImage = NULL, userMenu, longueurExtensionPixelMap;
+    long int lengthDimensionPrefix, prefixInt;
     unsigned char* messageSecretBit = NULL;
     unsigned char *messageSecretBitOutput = NULL;
     size_t tailleMsgBit, longueurExtensionFileToCryptBinary;
@@ -42,11 +53,98 @@ int main() {
     unsigned char* msgSecret = NULL;
 
     // Partie cryptage
-    char* messageSecret = NULL, *pathToFile = NULL, *fileOutput, *fileToCrypt, *cryptKey, *extensionPixelMap = NULL, *extensionFileToCrypt = NULL;
+    char* messageSecret = NULL, *pathToFile = NULL, *fileOutput, *fileToCrypt, *cryptKey = NULL, *extensionPixelMap = NULL;
 
 
     // Hamming
-    unsigned int **matriceHamming,columns, rows;
+    unsigned int **matriceHamming,columns = 0, rows = 0;
+
+    // Décodage fusionné
+    sourceImage_t source;
+    lecteurBits_t lecteur;
+    int modeDecryptage, estFichier;
+    char *permutationKey = NULL;
+
+    // Extraction partielle
+    long int offsetPlage, longueurPlage;
+    FILE *fichierPlage;
+    struct stat infoPlage;
+    int plageReguliere;
+
+    // Conteneur
+    enteteConteneur_t entete = {VERSION_CONTENEUR, MODE_CLASSIQUE, 0, PERMUTATION_AUCUNE, 0, 0, 0, "", 0, 0, 0, 0, 0};
+    unsigned char *charge = NULL, octetsEntete[TAILLE_ENTETE_MAX];
+    size_t tailleCharge = 0;
+    int tailleEnteteBit;
+    long int debutMessage;
+    char *nomFichier;
+    int *tableIndex = NULL;
+
+    // Sommes de contrôle
+    unsigned int *crcAttendus = NULL;
+    long int nbBlocs, blocInvalide;
+    verificationBlocs_t travail;
+
+    // Compression
+    int compresse;
+    size_t longueurOrigine;
+    unsigned char *chargeCompressee = NULL;
+    FILE *fichierCompresse;
+
+    // Chiffrement authentifié
+    char *motDePasse = NULL;
+    enteteConteneur_t enteteAuthentifie;
+    unsigned char cleMessage[TAILLE_CLE_AEAD], selNonce[TAILLE_SEL_AEAD + TAILLE_NONCE_AEAD];
+    long int decalageChiffre = 0;
+
+    // k-LSB
+    int bitsParCanal[3];
+    long int tailleFluxBit;
+
+    // Hamming en segments
+    long int nbBlocsGrands;
+    int erreurHamming;
+
+    // Insertion adaptative
+    long int histogrammeCouts[NB_COUTS_ADAPTATIFS], nbPositionsAdaptatives;
+    unsigned int seuilAdaptatif;
+    int *tableAdaptative = NULL, hammingAdaptatif = 0;
+
+    // Hamming ternaire
+    int nbTrits;
+    long int nbColonnesTernaire;
+
+    // Vue des canaux
+    char *saisieComposantes;
+    const unsigned int masquesCanauxMenu[7] = {0, 1u, 2u, 4u, 3u, 5u, 6u};
+    unsigned int masqueCanaux = 0;
+    int *matriceVue = NULL;
+    long int dimensionVue, debutVue;
+
+    // Flux de trames
+    int fluxTrames = 0;
+    long int nbTrames, nbTramesUtilisees;
+    FILE *fluxEntree = NULL;
+    formatFlux_t formatFlux;
+    unsigned int lignesFlux = 0;
+
+    // Répartition sur plusieurs images
+    int repartition = 0, nbImages = 0, imageInvalide, fragmentInvalide, nbFragments;
+    char **pathsImages = NULL, **pathsSorties = NULL, *extensionImage;
+    long int *taillesFragments = NULL;
+
+    // Copies d'une image
+    imageChargee_t couverture;
+    enteteConteneur_t *entetesCopies = NULL;
+    unsigned char **chargesCopies = NULL;
+    char **pathsMessages = NULL;
+    long int *finsModifications = NULL;
+    int nbMessages = 0, compresserCopies, chiffrerCopies;
+
+    // Archive de plusieurs fichiers
+    int archive = 0, compresserEntrees = 0, nbEntrees = 0;
+    long int entreeChoisie;
+    entreeArchive_t *entreesArchive = NULL;
 
     unsigned int compteurNbBitsModif;
 
@@ -58,18 +156,35 @@ int main() {
 
     li(1, "Crypter un message dans une image");
     li(2, "Décrypter un message depuis une image");
-
-    switch(reponseMenu(2)) {
+    li(3, "Extraire une portion d'un message caché dans une image");
+    li(4, "Vérifier l'intégrité d'un message caché dans une image");
+    li(5, "Crypter un message dans un flux d'images (PPM/PGM concaténés ou vidéo Y4M)");
+    li(6, "Décrypter un message depuis un flux d'images");
+    li(7, "Répartir un message sur plusieurs images");
+    li(8, "Reconstituer un message réparti sur plusieurs images");
+    li(9, "Cacher un fichier différent dans chaque copie d'une image");
+    li(10, "Lister ou extraire un fichier d'une archive cachée dans une image");
+
+    userMenu = (int) reponseMenu(10);
+    switch(userMenu) {
+        case 5:
+        case 7:
+            // Même saisie du message que pour une image, le support est ensuite un flux de trames ou plusieurs images
+            fluxTrames = userMenu == 5;
+            repartition = userMenu == 7;
+            /* fall through */
         case 1:
 
-            h1("Cryptage");
+            h1(fluxTrames ? "Cryptage dans un flux" : (repartition ? "Répartition sur plusieurs images" : "Cryptage"));
 
             p("Que souhaitez-vous faire ?");
 
-            li(1, "Crypter un texte dans un ppm/pgm");
-            li(2, "Crypter un fichier dans un ppm/pgm");
+            li(1, "Crypter un texte dans un ppm/pgm/pam/bmp/png/wav");
+            li(2, "Crypter un fichier dans un ppm/pgm/pam/bmp/png/wav");
+            if(!fluxTrames && !repartition)
+                li(3, "Crypter plusieurs fichiers dans un ppm/pgm/pam/bmp/png/wav (archive avec index, chaque fichier s'extrait séparément)");
 
-            switch(reponseMenu(2)) {
+            switch(reponseMenu(fluxTrames || repartition ? 2 : 3)) {
                 case 1:
 
                     /* -----------------------------------------------------------
@@ -80,7 +195,9 @@ int main() {
                     printf("> ");
                     messageSecret = inputString(stdin, 5);
 
-                    messageSecretBit = stringToBinary(messageSecret, &tailleMsgBit);
+                    charge = (unsigned char*) messageSecret;
+                    tailleCharge = strlen(messageSecret);
+                    messageSecret = NULL;
 
                     break;
                 case 2:
@@ -93,23 +210,33 @@ int main() {
                     printf("> ");
                     fileToCrypt = inputString(stdin, 5);
 
-                    error = fileToBinary(fileToCrypt, &messageSecretBit, &tailleMsgBit);
+                    error = lireFichierOctets(fileToCrypt, &charge, &tailleCharge);
                     if(error != ERROR_OK) {
-                        error_str(error);
+                        printf("Erreur: %s", error_str(error));
                         return 0;
                     }
 
-                    error = getExtension(fileToCrypt, &extensionFileToCrypt);
-                    if(error != ERROR_OK) {
-                        error_str(error);
+                    // Le nom du fichier (sans les dossiers) est enregistré dans l'entête du conteneur
+                    nomFichier = strrchr(fileToCrypt, '/');
+                    nomFichier = nomFichier != NULL ? nomFichier + 1 : fileToCrypt;
+                    if(strlen(nomFichier) > TAILLE_NOM_CONTENEUR) {
+                        printf("Erreur: %s", error_str(ERROR_INVARG));
                         return 0;
                     }
+                    strcpy(entete.nom, nomFichier);
+                    entete.flags |= FLAG_CONTENEUR_FICHIER;
 
-                    error = addExtensionSuffix(extensionFileToCrypt, &messageSecretBit, &tailleMsgBit);
-                    if(error != ERROR_OK) {
-                        error_str(error);
+                    break;
+                case 3:
+
+                    // Les fichiers sont lus une fois les options de compression et de chiffrement connues (voir construireArchive)
+                    p("Entrez les chemins vers les fichiers que vous voulez cacher (avec l'extension), un par ligne. Terminez par une ligne vide.");
+                    pathsMessages = inputChemins(stdin, &nbMessages);
+                    if(pathsMessages == NULL || nbMessages < 1 || nbMessages > NB_ENTREES_ARCHIVE_MAX) {
+                        printf("Erreur: %s", error_str(pathsMessages == NULL ? ERROR_NOMEM : ERROR_INVARG));
                         return 0;
                     }
+                    archive = 1;
 
                     break;
                 default:
@@ -118,91 +245,153 @@ int main() {
             }
 
 
-            /* -----------------------------------------------------------
-            * ---------------- PARTIE RECUPERATION DU FICHIER ------------
-            * -----------------------------------------------------------
-            */
-            p("Message secret enregistré. Entrez maintenant le chemin vers le fichier image qui accueillera votre fichier (Un fichier .PPM ou .PGM) (avec l'extension). ");
-            printf("> ");
-            pathToFile = inputString(stdin, 5);
+            if(fluxTrames) {
+                // Un flux peut être un tube nommé: les chemins sont pris tels quels, sans deviner d'extension
+                p("Message secret enregistré. Entrez maintenant le chemin vers le flux d'images (PPM/PGM binaires concaténés ou vidéo Y4M, fichier ou tube nommé).");
+                printf("> ");
+                pathToFile = inputString(stdin, 5);
 
-            /* On récupère l'extension : */
+                // Le format est lu dès maintenant: il détermine les choix proposés ensuite
+                error = ouvrirFlux(pathToFile, &fluxEntree, &formatFlux);
+                if(error != ERROR_OK) {
+                    printf("Erreur: %s", error_str(error));
+                    return 0;
+                }
 
+                p("Entrez le chemin du flux à créer (avec l'extension).");
+                printf("> ");
+                fileOutput = inputString(stdin, 5);
+            } else if(repartition) {
+                p("Message secret enregistré. Entrez maintenant les chemins vers les images qui accueilleront votre message (ppm/pgm/pam/bmp/png/wav, avec l'extension), un par ligne. Terminez par une ligne vide.");
+                pathsImages = inputChemins(stdin, &nbImages);
+                if(pathsImages == NULL || nbImages < 1 || nbImages > NB_FRAGMENTS_MAX) {
+                    printf("Erreur: %s", error_str(pathsImages == NULL ? ERROR_NOMEM : ERROR_INVARG));
+                    return 0;
+                }
 
+                p("Entrez maintenant le nom commun des images que vous voulez créer (SANS l'extension). Chaque image reçoit son numéro et l'extension de l'image d'origine (nom_1.ppm, nom_2.png, etc.).");
+                printf("> ");
+                fileOutput = inputString(stdin, 1);
 
-            error = getExtension(pathToFile, &extensionPixelMap);
-            if(error != ERROR_OK) {
-                error_str(error);
-                return 0;
-            }
+                pathsSorties = (char**) malloc((size_t) nbImages * sizeof(char*));
+                if(pathsSorties == NULL) {
+                    printf("Erreur: %s", error_str(ERROR_NOMEM));
+                    return 0;
+                }
+                for(i = 0; i < nbImages; i++) {
+                    extensionImage = strrchr(pathsImages[i], '.');
+                    if(extensionImage == NULL || strchr(extensionImage, '/') != NULL) {
+                        printf("Erreur: %s", error_str(ERROR_INVARG));
+                        return 0;
+                    }
+                    pathsSorties[i] = (char*) malloc(strlen(fileOutput) + strlen(extensionImage) + 16);
+                    if(pathsSorties[i] == NULL) {
+                        printf("Erreur: %s", error_str(ERROR_NOMEM));
+                        return 0;
+                    }
+                    sprintf(pathsSorties[i], "%s_%ld%s", fileOutput, i + 1, extensionImage);
+                }
+            } else {
+                /* -----------------------------------------------------------
+                * ---------------- PARTIE RECUPERATION DU FICHIER ------------
+                * -----------------------------------------------------------
+                */
+                p("Message secret enregistré. Entrez maintenant le chemin vers le fichier image qui accueillera votre fichier (Un fichier .PPM ou .PGM) (avec l'extension). ");
+                printf("> ");
+                pathToFile = inputString(stdin, 5);
 
+                /* On récupère l'extension : */
 
-            /* -----------------------------------------------------------
-            * ----------- PARTIE RECUPERATION DU FICHIER DE SORTIE -------
-            * -----------------------------------------------------------
-            */
-            p("Chemin vers le fichier image enregistré. Entrez maintenant le nom de l'image que vous voulez créer, qui contiendra votre message secret (SANS l'extension, juste le nom). Vous pouvez spécifier un chemin afin de placer votre nouveau fichier où vous voulez (toujours SANS l'extension)");
-            printf("> ");
-            fileOutput = inputString(stdin, 1);
 
-            // On ajouté la même extension que le fichier source
-            error = addExtension(&fileOutput, extensionPixelMap);
-            if(error != ERROR_OK) {
-                error_str(error);
-                return 0;
-            }
 
-            p("Chemin vers le fichier image cible enregistré.");
+                error = getExtension(pathToFile, &extensionPixelMap);
+                if(error != ERROR_OK) {
+                    error_str(error);
+                    return 0;
+                }
 
 
-            /* ===========================================================
-             * ------------------ PARTIE CRYPTAGE ----------------------
-             * ===========================================================
-             */
+                /* -----------------------------------------------------------
+                * ----------- PARTIE RECUPERATION DU FICHIER DE SORTIE -------
+                * -----------------------------------------------------------
+                */
+                p("Chemin vers le fichier image enregistré. Entrez maintenant le nom de l'image que vous voulez créer, qui contiendra votre message secret (SANS l'extension, juste le nom). Vous pouvez spécifier un chemin afin de placer votre nouveau fichier où vous voulez (toujours SANS l'extension)");
+                printf("> ");
+                fileOutput = inputString(stdin, 1);
 
+                // On ajouté la même extension que le fichier source
+                error = addExtension(&fileOutput, extensionPixelMap);
+                if(error != ERROR_OK) {
+                    error_str(error);
+                    return 0;
+                }
 
-            /* -----------------------------------------------------------
-             * ---------------- PARTIE LECTURE DU FICHIER ----------------
-             * -----------------------------------------------------------
-             */
+                p("Chemin vers le fichier image cible enregistré.");
 
-            // On appelle la fonction pour lire les headers du fichier et on stock l'erreur de retour dans la variable error
-            error = readHeader(pathToFile, typeFile, &imageWidth, &imageHeight, &pixelIntensity, &beginningImage);
-            if(error != ERROR_OK) {
-                error_str(error);
-                return 0;
-            }
 
-            if(strcmp(typeFile, "P6") == 0) {
-                dimension = imageWidth*imageHeight*3;
-            } else if(strcmp(typeFile, "P5") == 0) {
-                dimension = imageWidth*imageHeight;
-            } else {
-                error = ERROR_INVARG;
-                error_str(error);
-                return 0;
-            }
+                /* ===========================================================
+                 * ------------------ PARTIE CRYPTAGE ----------------------
+                 * ===========================================================
+                 */
 
-            //On affiche les différents paramètres.
-            //printf("Type du fichier: %s\nLargeur de l'image: %ld\nHauteur de l'image: %ld\nIntensité des pixels: %ld", typeFile, imageWidth, imageHeight, pixelIntensity);
 
+                /* -----------------------------------------------------------
+                 * ---------------- PARTIE LECTURE DU FICHIER ----------------
+                 * -----------------------------------------------------------
+                 */
 
-            /* Maintenant on va récuperer la valeur de la matrice de l'image dans un tableau
-             * Pour ça, on va crée un tableau dynamique de taille imageWidth*imageHeight
-             */
+                // On lit l'entête du fichier (P5, P6 ou P7) et on en déduit la dimension de l'image
+                error = lireFormatImage(pathToFile, typeFile, &imageWidth, &imageHeight, &profondeur, &pixelIntensity, tuplType, &beginningImage, &dimension);
+                if(error != ERROR_OK) {
+                    printf("Erreur: %s", error_str(error));
+                    return 0;
+                }
 
+                // Les méthodes d'insertion modifient un tableau d'entiers: un PNG y est décompressé entièrement, seule la lecture en est bornée par lignes
+                if(strcmp(typeFile, "PNG") == 0)
+                    printf("\nLe PNG est décompressé entièrement en mémoire pour l'insertion: %ld Ko.\n", dimension / (1024 / (long int) sizeof(int)));
 
-            matriceImage = (int*) malloc(dimension * sizeof(int*));
-            if(matriceImage == NULL) { // On test s'il y a une erreur
-                error = ERROR_NOMEM;
-                error_str(error);
-                return 0;
-            }
+                //On affiche les différents paramètres.
+                //printf("Type du fichier: %s\nLargeur de l'image: %ld\nHauteur de l'image: %ld\nIntensité des pixels: %ld", typeFile, imageWidth, imageHeight, pixelIntensity);
 
-            error = readImage(pathToFile, matriceImage, beginningImage, dimension);
-            if(error != ERROR_OK) {
-                error_str(error);
-                return 0;
+
+                /* Maintenant on va récuperer la valeur de la matrice de l'image dans un tableau
+                 * Pour ça, on va crée un tableau dynamique de taille imageWidth*imageHeight
+                 */
+
+
+                matriceImage = (int*) malloc(dimension * sizeof(int));
+                if(matriceImage == NULL) { // On test s'il y a une erreur
+                    error = ERROR_NOMEM;
+                    error_str(error);
+                    return 0;
+                }
+
+                // Un P2/P3 est découpé en nombres, les autres formats sont lus octet par octet
+                if(estFormatASCII(typeFile))
+                    error = readImageASCII(pathToFile, matriceImage, beginningImage, dimension, pixelIntensity);
+                else if(strcmp(typeFile, "BMP") == 0)
+                    error = readImageBMP(pathToFile, matriceImage, beginningImage, imageWidth * profondeur, imageHeight, pasLigneFormat(typeFile, imageWidth, profondeur));
+                else if(strcmp(typeFile, "PNG") == 0)
+                    error = readImagePNG(pathToFile, matriceImage, imageWidth, imageHeight, profondeur);
+                else if(strcmp(typeFile, "WAV") == 0)
+                    error = readImageWAV(pathToFile, matriceImage, beginningImage, dimension, octetsEchantillonFormat(typeFile, pixelIntensity));
+                else
+                    error = readImage(pathToFile, matriceImage, beginningImage, dimension);
+                if(error != ERROR_OK) {
+                    printf("Erreur: %s", error_str(error));
+                    return 0;
+                }
+
+                if(estFormatASCII(typeFile)) {
+                    p("Votre image est au format texte. Dans quel format souhaitez vous enregistrer l'image finale ?");
+
+                    li(1, "Binaire (P5/P6), plus compact et plus rapide à décoder.");
+                    li(2, "Texte (P2/P3), comme l'image d'origine.");
+
+                    if(reponseMenu(2) == 1)
+                        strcpy(typeFile, strcmp(typeFile, "P2") == 0 ? "P5" : "P6");
+                }
             }
 
 
@@ -213,23 +402,53 @@ int main() {
              * ---------------- PARTIE CRYPTAGE DU MSG ---------------
              * -----------------------------------------------------------
              */
-            p("Souhaitez vous crypter votre message en utilisant une table de permutation liée à une clé ?");
+            p("Souhaitez vous compresser votre message avant de le cacher ? (moins de pixels modifiés, ignoré si le message n'est pas compressible)");
 
             li(1, "Oui.");
             li(2, "Non.");
 
             switch(reponseMenu(2)) {
                 case 1:
-                    p("Entrez la clé de chiffrement.");
-                    printf("> ");
-                    cryptKey = inputString(stdin, 5);
-
-
-                    error = permuterTableau(cryptKey,tailleMsgBit, &messageSecretBit);
+                    if(archive) {
+                        compresserEntrees = 1;
+                        break;
+                    }
+                    longueurOrigine = tailleCharge;
+                    error = compresserCharge(&charge, &tailleCharge, &compresse);
                     if(error != ERROR_OK) {
-                        error_str(error);
+                        printf("Erreur: %s", error_str(error));
                         return 0;
                     }
+                    if(compresse) {
+                        entete.flags |= FLAG_CONTENEUR_COMPRESSE;
+                        printf("\nMessage compressé: %zu octets au lieu de %zu.\n", tailleCharge, longueurOrigine);
+                    } else {
+                        p("Votre message n'est pas compressible, il sera caché tel quel.");
+                    }
+                    break;
+                case 2:
+                    break;
+                default:
+                    printf("Erreur: %s", error_str(ERROR_INVARG));
+                    return 0;
+            }
+
+            // Le chiffrement authentifié remplace l'ancienne table de permutation des bits (qui reste lisible au décodage)
+            p("Souhaitez vous chiffrer votre message avec une clé (ChaCha20-Poly1305) ?");
+
+            li(1, "Oui.");
+            li(2, "Non.");
+
+            switch(reponseMenu(2)) {
+                case 1:
+                    p("Entrez la clé de chiffrement du message.");
+                    printf("> ");
+                    motDePasse = inputString(stdin, 5);
+                    if(archive)
+                        break;
+
+                    // Le message n'est chiffré qu'une fois son entête complet: le tag authentifie aussi l'entête (voir scellerCharge)
+                    entete.flags |= FLAG_CONTENEUR_CHIFFRE;
 
                     break;
                 case 2:
@@ -239,178 +458,533 @@ int main() {
                     return 0;
             }
 
+            if(archive) {
+                // Chaque fichier est compressé et chiffré séparément, l'archive est ensuite cachée comme un seul message
+                error = construireArchive(pathsMessages, nbMessages, compresserEntrees, motDePasse, &charge, &tailleCharge);
+                for(i = 0; i < nbMessages; i++)
+                    free(pathsMessages[i]);
+                free(pathsMessages);
+                if(error != ERROR_OK) {
+                    printf("Erreur: %s", error_str(error));
+                    return 0;
+                }
+                entete.flags |= FLAG_CONTENEUR_ARCHIVE;
+                printf("\nArchive de %d fichiers: %zu octets.\n", nbMessages, tailleCharge);
+            }
+
+            if(repartition) {
+                // Chaque fragment a son propre entête: le tag authentifie l'entête du message réassemblé (voir reconstituerCharge)
+                if(entete.flags & FLAG_CONTENEUR_CHIFFRE) {
+                    enteteMessage(entete.nom, entete.flags, (unsigned long) (tailleCharge + TAILLE_SURCOUT_AEAD), &enteteAuthentifie);
+                    error = serialiserEnteteConteneur(&enteteAuthentifie, octetsEntete, &tailleEnteteBit);
+                    if(error == ERROR_OK)
+                        error = chiffrerCharge(&charge, &tailleCharge, motDePasse, octetsEntete, (size_t) tailleEnteteBit);
+                    if(error != ERROR_OK) {
+                        printf("Erreur: %s", error_str(error));
+                        return 0;
+                    }
+                }
+
+                // Chaque image reçoit une part du message proportionnelle à sa capacité, avec sa propre table de CRC
+                taillesFragments = (long int*) malloc((size_t) nbImages * sizeof(long int));
+                error = taillesFragments == NULL ? ERROR_NOMEM : repartirCharge(pathsImages, pathsSorties, nbImages, &entete, charge, tailleCharge, taillesFragments);
+                if(error != ERROR_OK) {
+                    printf("Erreur: %s", error_str(error));
+                    return 0;
+                }
+
+                printf("\nMessage de %zu octets réparti sur %d images:\n", tailleCharge, nbImages);
+                for(i = 0; i < nbImages; i++)
+                    printf("    %s: %ld octets\n", pathsSorties[i], taillesFragments[i]);
+                freeAllVar(taillesFragments, charge, NULL, NULL, NULL, NULL, NULL);
+                charge = NULL;
+
+                p("Vos images ont été créées avec succès !");
+                p("Appuyez sur <Entrée> pour quitter le programme");
+                getchar();
+
+                break;
+            }
+
+            // Un CRC32C par bloc du message permet de vérifier l'extraction bloc par bloc. La table et le chiffrement sont ajoutés par scellerCharge
+            entete.longueurCharge = tailleCharge + ((entete.flags & FLAG_CONTENEUR_CHIFFRE) ? TAILLE_SURCOUT_AEAD : 0);
+            entete.flags |= FLAG_CONTENEUR_CRC;
+            entete.blocCrc = LOG2_BLOC_CRC;
+
+            if(fluxTrames && formatFlux.y4m) {
+                printf("\n    Dans quels plans (0 pour Y, 1 pour Cb, 2 pour Cr, de 0 à %d) souhaitez vous cacher le message ?\n\n", formatFlux.nbPlans - 1);
+                p("Entrez leurs numéros (par exemple 0 pour la luminance seule), ou rien pour tous les plans.");
+                printf("> ");
+                saisieComposantes = inputString(stdin, 5);
+                error = lireMasqueComposantes(saisieComposantes, formatFlux.nbPlans, &masqueCanaux);
+                free(saisieComposantes);
+                if(error != ERROR_OK) {
+                    printf("Erreur: %s", error_str(error));
+                    return 0;
+                }
+                entete.flags |= masqueCanaux << DECALAGE_CANAUX_CONTENEUR;
+
+                printf("\n    Combien de bits souhaitez vous cacher par bloc de Hamming (de 1 à %d) ? r bits sont cachés dans 2^r - 1 échantillons: 1 donne la plus grande capacité, une valeur plus grande modifie moins d'échantillons.\n\n", LIGNES_MAX_HAMMING - 1);
+                userMenu = (int) reponseMenu(LIGNES_MAX_HAMMING - 1);
+                if(userMenu < 1) {
+                    printf("Erreur: %s", error_str(ERROR_INVARG));
+                    return 0;
+                }
+                lignesFlux = (unsigned int) userMenu;
+                if(lignesFlux > 1) {
+                    entete.mode = MODE_HAMMING;
+                    entete.parametre = (unsigned char) (lignesFlux | HAMMING_SEGMENTE);
+                }
+            }
+
+            if(fluxTrames) {
+                // L'entête et le message forment un seul flux de bits, réparti sur autant de trames que nécessaire
+                error = serialiserEnteteConteneur(&entete, octetsEntete, &tailleEnteteBit);
+                if(error == ERROR_OK)
+                    error = scellerCharge(&entete, &charge, &tailleCharge, motDePasse);
+                if(error == ERROR_OK) {
+                    chargeCompressee = (unsigned char*) malloc((size_t) tailleEnteteBit + tailleCharge);
+                    if(chargeCompressee == NULL)
+                        error = ERROR_NOMEM;
+                }
+                if(error == ERROR_OK) {
+                    memcpy(chargeCompressee, octetsEntete, (size_t) tailleEnteteBit);
+                    memcpy(chargeCompressee + tailleEnteteBit, charge, tailleCharge);
+                    error = octetsVersBinaire(chargeCompressee, (size_t) tailleEnteteBit + tailleCharge, &messageSecretBit, &tailleMsgBit);
+                }
+                freeAllVar(chargeCompressee, charge, NULL, NULL, NULL, NULL, NULL);
+                charge = NULL;
+                if(error == ERROR_OK)
+                    error = cacherDansFlux(fluxEntree, &formatFlux, fileOutput, masqueCanaux, lignesFlux, messageSecretBit, tailleMsgBit, &nbTrames, &nbTramesUtilisees);
+                fclose(fluxEntree);
+                if(error != ERROR_OK) {
+                    printf("Erreur: %s", error_str(error));
+                    return 0;
+                }
+
+                printf("\nMessage caché dans %ld trames sur %ld.", nbTramesUtilisees, nbTrames);
+                p("Votre flux a été créé avec succès !");
+                p("Appuyez sur <Entrée> pour quitter le programme");
+                getchar();
+
+                break;
+            }
+
+            // Taille du flux inséré, table des CRC comprise: le message n'est scellé qu'une fois la méthode choisie
+            tailleMsgBit = (size_t) (entete.longueurCharge + 4 * (unsigned long) nbBlocsCrc(&entete)) * 8;
+
+            // Pour un P6 (ou un P3), le message peut n'être caché que dans certains canaux (le prefixe et l'entête utilisent toujours tous les canaux)
+            if(strcmp(typeFile, "P6") == 0 || strcmp(typeFile, "P3") == 0) {
+                p("Dans quels canaux souhaitez vous cacher le message ?");
+
+                li(1, "Tous les canaux.");
+                li(2, "Rouge.");
+                li(3, "Vert.");
+                li(4, "Bleu.");
+                li(5, "Rouge et vert.");
+                li(6, "Rouge et bleu.");
+                li(7, "Vert et bleu.");
+
+                userMenu = (int) reponseMenu(7);
+                if(userMenu < 1) {
+                    printf("Erreur: %s", error_str(ERROR_INVARG));
+                    return 0;
+                }
+                masqueCanaux = masquesCanauxMenu[userMenu - 1];
+                entete.flags |= masqueCanaux << DECALAGE_CANAUX_CONTENEUR;
+            } else if((strcmp(typeFile, "P7") == 0 || strcmp(typeFile, "BMP") == 0 || strcmp(typeFile, "PNG") == 0 || strcmp(typeFile, "WAV") == 0) && profondeur > 1) {
+                printf("\n    Dans quelles composantes (TUPLTYPE %s, de 0 à %ld) souhaitez vous cacher le message ?\n\n", tuplType[0] != '\0' ? tuplType : "inconnu", profondeur - 1);
+                p("Entrez leurs numéros (par exemple 012), ou rien pour toutes les composantes.");
+                printf("> ");
+                saisieComposantes = inputString(stdin, 5);
+                error = lireMasqueComposantes(saisieComposantes, (int) profondeur, &masqueCanaux);
+                free(saisieComposantes);
+                if(error != ERROR_OK) {
+                    printf("Erreur: %s", error_str(error));
+                    return 0;
+                }
+                entete.flags |= masqueCanaux << DECALAGE_CANAUX_CONTENEUR;
+            }
+
 
-            int* dimMaxBinary = num_to_bit(dimension, &lengthDimensionPrefix);
+            free(num_to_bit(dimension, &lengthDimensionPrefix));
 
-            error = determineBestHammingSize(dimension-lengthDimensionPrefix, tailleMsgBit, &rows, &columns);
+            // L'entête du conteneur est placé juste après le prefixe, le message commence après l'entête
+            error = serialiserEnteteConteneur(&entete, octetsEntete, &tailleEnteteBit);
             if(error != ERROR_OK) {
-                error_str(error);
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+            tailleEnteteBit *= 8;
+            debutMessage = lengthDimensionPrefix + tailleEnteteBit;
+
+            // Les méthodes d'insertion travaillent sur la vue des canaux choisis (l'image entière si masqueCanaux vaut 0)
+            debutVue = positionVueCanaux(debutMessage, masqueCanaux, (int) profondeur);
+            dimensionVue = positionVueCanaux(dimension, masqueCanaux, (int) profondeur);
+
+            // Capacités annoncées avant le choix de la méthode: 1 bit par pixel, ou jusqu'à K_MAX_KLSB bits par pixel en k-LSB
+            bitsParCanal[0] = bitsParCanal[1] = bitsParCanal[2] = K_MAX_KLSB;
+            printf("\nCapacité de l'image: %ld octets (1 bit par pixel), %ld octets en k-LSB (%d bits par pixel). Taille à cacher: %zu octets.\n", (dimensionVue - debutVue) / 8, capaciteKLSB(debutVue, dimensionVue, bitsParCanal) / 8, K_MAX_KLSB, tailleMsgBit / 8);
+            if((long int) tailleMsgBit > capaciteKLSB(debutVue, dimensionVue, bitsParCanal)) {
+                printf("Erreur: %s", error_str(ERROR_NOMEM));
                 return 0;
             }
 
+            // Hamming ne peut plus échouer sur la taille: les derniers blocs passent à une ligne (1 bit par pixel) si nécessaire
+            erreurHamming = determineSegmentsHamming(dimensionVue - debutVue, (long int) tailleMsgBit, &rows, &nbBlocsGrands);
+
 
             p("Quel type de cryptage souhaitez vous utiliser ?");
 
             li(1, "Classique: insertion un par un.");
             li(2, "Chiffré: modifier le sens de parcours grâce à une clé de chiffrement.");
-            if(columns > 1)
+            if(erreurHamming == ERROR_OK)
                 li(3, "Hamming: insertion par syndrome.");
             else
                 li(3, "Votre message est trop grand pour utiliser l'insertion de Hamming.");
+            li(4, "Chiffré à accès direct: parcours calculé grâce à une clé de chiffrement (permet d'extraire une portion du message).");
+            li(5, "k-LSB: k bits de poids faible par pixel (capacité multipliée par k, moins discret).");
+            li(6, "STC: codes syndrome-treillis, le moins de pixels modifiés possible quelle que soit la taille du message.");
+            if(determineTailleTernaire(dimensionVue - debutVue, tailleMsgBit, &nbTrits, &nbColonnesTernaire) == ERROR_OK)
+                li(7, "Hamming ternaire: insertion par syndrome modulo 3, le sens de la modification (+1 ou -1) porte aussi le message.");
+            else
+                li(7, "Votre message est trop grand pour utiliser l'insertion de Hamming ternaire.");
+            li(8, "LSB matching revisited: 2 bits par paire de pixels, moins de pixels modifiés que l'insertion classique.");
+            if(erreurHamming == ERROR_OK)
+                li(9, "Hamming chiffré: insertion par syndrome dans un parcours calculé grâce à une clé de chiffrement.");
+            else
+                li(9, "Votre message est trop grand pour utiliser l'insertion de Hamming chiffrée.");
+            li(10, "Adaptatif: insertion classique ou de Hamming limitée aux zones texturées de l'image.");
 
-            error = hideDimMsg(tailleMsgBit, matriceImage, dimension, pixelIntensity, &lengthDimensionPrefix);
-            if(error != ERROR_OK) {
-                error_str(error);
-                return 0;
-            }
+            entete.mode = (unsigned char) reponseMenu(10);
+            switch(entete.mode) {
+                case MODE_CLASSIQUE:
+                    break;
+                case MODE_CHIFFRE:
+                case MODE_CHIFFRE_CALCULABLE:
 
+                    p("Entrez la clé de chiffrement.");
+                    printf("> ");
+                    cryptKey = inputString(stdin, 5);
 
+                    break;
+                case MODE_HAMMING:
 
-            switch(reponseMenu(3)) {
-                case 1:
+                    if(erreurHamming == ERROR_OK) {
+                        entete.parametre = (unsigned char) (HAMMING_SEGMENTE | rows);
+                    } else {
+                        p("Votre message est trop grand pour utiliser l'insertion de Hamming, nous procedons à l'insertion classique.");
+                        entete.mode = MODE_CLASSIQUE;
+                    }
 
-                    //printf("\nNombre de bits: %zu\n", tailleMsgBit);
-                    error = hideMessage(messageSecretBit, tailleMsgBit, matriceImage, dimension, pixelIntensity, lengthDimensionPrefix,0,NULL);
-                    if(error != ERROR_OK) {
-                        error_str(error);
+                    break;
+                case MODE_KLSB:
+
+                    p("Combien de bits de poids faible par pixel souhaitez vous utiliser (1 à 4) ?");
+                    bitsParCanal[0] = (int) reponseMenu(K_MAX_KLSB);
+                    bitsParCanal[1] = bitsParCanal[2] = bitsParCanal[0];
+
+                    // Avec un masque, les canaux de la vue ne correspondent plus aux positions modulo 3: même nombre de bits partout
+                    if(profondeur == 3 && masqueCanaux == 0 && strcmp(typeFile, "BMP") != 0 && strcmp(typeFile, "WAV") != 0) {
+                        p("Souhaitez vous choisir un nombre de bits différent pour chaque canal (R, G, B) ?");
+
+                        li(1, "Oui.");
+                        li(2, "Non.");
+
+                        if(reponseMenu(2) == 1) {
+                            p("Nombre de bits du canal rouge (1 à 4).");
+                            bitsParCanal[0] = (int) reponseMenu(K_MAX_KLSB);
+                            p("Nombre de bits du canal vert (1 à 4).");
+                            bitsParCanal[1] = (int) reponseMenu(K_MAX_KLSB);
+                            p("Nombre de bits du canal bleu (1 à 4).");
+                            bitsParCanal[2] = (int) reponseMenu(K_MAX_KLSB);
+                        }
+                    }
+
+                    if(bitsParCanal[0] < 1 || bitsParCanal[1] < 1 || bitsParCanal[2] < 1) {
+                        printf("Erreur: %s", error_str(ERROR_INVARG));
                         return 0;
                     }
 
+                    printf("\nCapacité avec ces paramètres: %ld octets.\n", capaciteKLSB(debutVue, dimensionVue, bitsParCanal) / 8);
+                    entete.parametre = encoderBitsParCanal(bitsParCanal);
 
                     break;
-                case 2:
+                case MODE_STC:
 
-                    p("Entrez la clé de chiffrement.");
-                    printf("> ");
-                    cryptKey = inputString(stdin, 5);
-                    //printf("\ntailleMsgBit: %zu dans dimension: %zu", tailleMsgBit, dimension);
-                    error = hideMessage(messageSecretBit, tailleMsgBit, matriceImage, dimension, pixelIntensity, lengthDimensionPrefix,1,cryptKey);
+                    entete.parametre = HAUTEUR_STC;
+
+                    break;
+                case MODE_ADAPTATIF:
+
+                    // Les modifications inversent le LSB: il faut pouvoir passer de maxval - 1 à maxval. Les coûts sont calculés avec les lignes voisines
+                    if(masqueCanaux != 0 || pixelIntensity % 2 == 0 || imageHeight < 3) {
+                        p("L'insertion adaptative utilise tous les canaux, une intensité maximale impaire et une image d'au moins 3 lignes.");
+                        printf("Erreur: %s", error_str(ERROR_INVARG));
+                        return 0;
+                    }
+
+                    p("Quelle insertion souhaitez vous utiliser dans les zones texturées ?");
+
+                    li(1, "Classique.");
+                    li(2, "Hamming.");
+
+                    hammingAdaptatif = reponseMenu(2) == 2;
+
+                    sourceMemoire(&source, matriceImage, dimension);
+                    geometrieSource(&source, imageWidth, (int) profondeur);
+                    error = calculerCoutsAdaptatifs(&source, debutMessage, COUT_MAX_ADAPTATIF, NULL, &nbPositionsAdaptatives, histogrammeCouts);
+                    if(error == ERROR_OK)
+                        error = choisirSeuilAdaptatif(histogrammeCouts, (long int) tailleMsgBit, hammingAdaptatif, &seuilAdaptatif);
                     if(error != ERROR_OK) {
-                        error_str(error);
+                        printf("Erreur: %s", error_str(error));
                         return 0;
                     }
+                    entete.parametre = (unsigned char) (seuilAdaptatif | (hammingAdaptatif ? HAMMING_SEGMENTE : 0));
 
                     break;
-                case 3:
+                case MODE_HAMMING_CHIFFRE:
 
-                    if(columns > 2) {
-
-                        error = hideMessageHamming(messageSecretBit, tailleMsgBit, matriceImage, dimension, pixelIntensity, lengthDimensionPrefix, rows, columns, &compteurNbBitsModif);
-                        if(error != ERROR_OK) {
-                            error_str(error);
-                            return 0;
-                        }
+                    if(erreurHamming != ERROR_OK) {
+                        printf("Erreur: %s", error_str(erreurHamming));
+                        return 0;
+                    }
+                    entete.parametre = (unsigned char) rows;
 
-                        printf("Taille de la matrice de vérification optimale: (%d, %d). Nombre de bits modifiés: %d sur %zu (%lu%%)\n", columns, rows, compteurNbBitsModif, tailleMsgBit, (compteurNbBitsModif*100)/tailleMsgBit);
+                    p("Entrez la clé de chiffrement.");
+                    printf("> ");
+                    cryptKey = inputString(stdin, 5);
 
+                    break;
+                case MODE_LSBMR:
+                    break;
+                case MODE_TERNAIRE:
 
+                    if(determineTailleTernaire(dimensionVue - debutVue, tailleMsgBit, &nbTrits, &nbColonnesTernaire) == ERROR_OK) {
+                        entete.parametre = (unsigned char) nbTrits;
                     } else {
-                        p("Votre message est trop grand pour utiliser l'insertion de Hamming, nous procedons à l'insertion classique.");
-
-                        error = hideMessage(messageSecretBit, tailleMsgBit, matriceImage, dimension, pixelIntensity, lengthDimensionPrefix, 0, NULL);
-                        if(error != ERROR_OK) {
-                            error_str(error);
-                            return 0;
-                        }
+                        p("Votre message est trop grand pour utiliser l'insertion de Hamming ternaire, nous procedons à l'insertion classique.");
+                        entete.mode = MODE_CLASSIQUE;
                     }
 
-
                     break;
                 default:
                     printf("Erreur: %s", error_str(ERROR_INVARG));
                     return 0;
             }
 
+            if(entete.mode == MODE_KLSB ? (long int) tailleMsgBit > capaciteKLSB(debutVue, dimensionVue, bitsParCanal) : debutVue + (long int) tailleMsgBit > dimensionVue) {
+                printf("Erreur: %s", error_str(ERROR_NOMEM));
+                return 0;
+            }
 
-
-
-
-
-
-            /* -----------------------------------------------------------
-             * ------------ PARTIE ECRITURE DE LA NVL IMG ----------------
-             * -----------------------------------------------------------
-             */
-
-            error = writeHeader(fileOutput, typeFile, imageWidth, imageHeight, pixelIntensity, &beginningNewImage);
+            // L'entête est complet: le message est chiffré (avec l'entête comme données associées) et précédé de sa table de CRC
+            error = scellerCharge(&entete, &charge, &tailleCharge, motDePasse);
+            if(error == ERROR_OK)
+                error = octetsVersBinaire(charge, tailleCharge, &messageSecretBit, &tailleMsgBit);
             if(error != ERROR_OK) {
-                error_str(error);
+                printf("Erreur: %s", error_str(error));
                 return 0;
             }
 
-
-            error = writeImage(fileOutput, matriceImage, beginningNewImage, dimension);
+            error = hideDimMsg(tailleEnteteBit + unitesPrefixe(&entete), matriceImage, dimension, pixelIntensity, &lengthDimensionPrefix);
             if(error != ERROR_OK) {
                 error_str(error);
                 return 0;
             }
 
-
-            p("Votre message a bien été ajouté à votre image !");
-            p("Appuyez sur <Entrée> pour quitter le programme");
-            getchar();
-
-            break;
-
-        case 2:
-            h1("Décryptage");
-
-            /* -----------------------------------------------------------
-            * ---------------- PARTIE RECUPERATION DU FICHIER ------------
-            * -----------------------------------------------------------
-            */
-            p("Entrez le chemin vers le fichier image (avec l'extension).");
-            printf("> ");
-            pathToFile = inputString(stdin, 5);
-
-            /* ===========================================================
-             * ------------------ PARTIE DECRYPTAGE ----------------------
-             * ===========================================================
-             */
-
-            /* -----------------------------------------------------------
-             * ---------------- PARTIE LECTURE DU FICHIER ----------------
-             * -----------------------------------------------------------
-             */
-
-            // On appelle la fonction pour lire les headers du fichier et on stock l'erreur de retour dans la variable error
-            error = readHeader(pathToFile, typeFile, &imageWidth, &imageHeight, &pixelIntensity, &beginningImage);
+            error = hideEnteteConteneur(&entete, matriceImage, dimension, pixelIntensity, lengthDimensionPrefix, &tailleEnteteBit);
             if(error != ERROR_OK) {
-                error_str(error);
+                printf("Erreur: %s", error_str(error));
                 return 0;
             }
 
-
-            // Calcul de la dimension de l'image
-            if(strcmp(typeFile, "P6") == 0) {
-                dimension = imageWidth*imageHeight*3;
-            } else if(strcmp(typeFile, "P5") == 0) {
-                dimension = imageWidth*imageHeight;
+            // La vue est extraite après l'insertion du prefixe et de l'entête pour que sa réinsertion les conserve
+            if(masqueCanaux != 0) {
+                error = extraireVueCanaux(matriceImage, dimension, (int) profondeur, masqueCanaux, &matriceVue, &dimensionVue);
+                if(error != ERROR_OK) {
+                    printf("Erreur: %s", error_str(error));
+                    return 0;
+                }
             } else {
-                error = ERROR_INVARG;
-                error_str(error);
-                return 0;
+                matriceVue = matriceImage;
             }
 
-            //On affiche les différents paramètres.
-            // printf("Type du fichier: %s\nLargeur de l'image: %ld\nHauteur de l'image: %ld\nIntensité des pixels: %ld", typeFile, imageWidth, imageHeight, pixelIntensity);
 
+            switch(entete.mode) {
+                case MODE_CLASSIQUE:
 
-            /* Maintenant on va récuperer la valeur de la matrice de l'image dans un tableau
-             * Pour ça, on va crée un tableau dynamique de taille imageWidth*imageHeight
-             */
+                    //printf("\nNombre de bits: %zu\n", tailleMsgBit);
+                    error = hideMessage(messageSecretBit, tailleMsgBit, matriceVue, dimensionVue, pixelIntensity, debutVue,0,NULL);
 
+                    break;
+                case MODE_CHIFFRE:
 
-            matriceImage = (int*)malloc(dimension * sizeof(int*));
-            if(matriceImage == NULL) { // On test s'il y a une erreur
-                error = ERROR_NOMEM;
-                error_str(error);
+                    error = hideMessage(messageSecretBit, tailleMsgBit, matriceVue, dimensionVue, pixelIntensity, debutVue,1,cryptKey);
+
+                    break;
+                case MODE_HAMMING:
+
+                    error = hideMessageHammingSegmente(messageSecretBit, tailleMsgBit, matriceVue, dimensionVue, pixelIntensity, debutVue, rows, nbBlocsGrands, &compteurNbBitsModif);
+                    if(error == ERROR_OK)
+                        printf("Matrices de vérification: %ld blocs de (%u, %u) puis (%u, %u). Nombre de bits modifiés: %d sur %zu (%lu%%)\n", nbBlocsGrands, (2u << rows) - 1, rows + 1, (1u << rows) - 1, rows, compteurNbBitsModif, tailleMsgBit, (compteurNbBitsModif*100)/tailleMsgBit);
+
+                    break;
+                case MODE_CHIFFRE_CALCULABLE:
+
+                    error = hideMessage(messageSecretBit, tailleMsgBit, matriceVue, dimensionVue, pixelIntensity, debutVue,2,cryptKey);
+
+                    break;
+                case MODE_KLSB:
+
+                    error = hideMessageKLSB(messageSecretBit, tailleMsgBit, matriceVue, dimensionVue, pixelIntensity, debutVue, bitsParCanal);
+
+                    break;
+                case MODE_STC:
+
+                    error = hideMessageSTC(messageSecretBit, tailleMsgBit, matriceVue, dimensionVue, pixelIntensity, debutVue, HAUTEUR_STC, NULL, &compteurNbBitsModif);
+                    if(error == ERROR_OK)
+                        printf("Nombre de bits modifiés: %d sur %zu (%lu%%)\n", compteurNbBitsModif, tailleMsgBit, (compteurNbBitsModif*100)/tailleMsgBit);
+
+                    break;
+                case MODE_TERNAIRE:
+
+                    error = hideMessageTernaire(messageSecretBit, tailleMsgBit, matriceVue, dimensionVue, pixelIntensity, debutVue, nbTrits, &compteurNbBitsModif);
+                    if(error == ERROR_OK)
+                        printf("Code ternaire: %d trits pour %ld pixels. Nombre de pixels modifiés: %d pour %zu bits (%lu%%)\n", nbTrits, nbColonnesTernaire, compteurNbBitsModif, tailleMsgBit, (compteurNbBitsModif*100)/tailleMsgBit);
+
+                    break;
+                case MODE_LSBMR:
+
+                    error = hideMessageLSBMR(messageSecretBit, tailleMsgBit, matriceVue, dimensionVue, pixelIntensity, debutVue, &compteurNbBitsModif);
+                    if(error == ERROR_OK)
+                        printf("Nombre de pixels modifiés: %d pour %zu bits (%lu%%)\n", compteurNbBitsModif, tailleMsgBit, (compteurNbBitsModif*100)/tailleMsgBit);
+
+                    break;
+                case MODE_ADAPTATIF:
+
+                    // Les pixels modifiés par l'entête ne sont voisins d'aucun pixel sélectionnable: la sélection ne change pas
+                    error = calculerCoutsAdaptatifs(&source, debutMessage, seuilAdaptatif, &tableAdaptative, &nbPositionsAdaptatives, NULL);
+                    if(error == ERROR_OK)
+                        error = hideMessageAdaptatif(messageSecretBit, tailleMsgBit, matriceImage, tableAdaptative, nbPositionsAdaptatives, hammingAdaptatif, &compteurNbBitsModif);
+                    if(error == ERROR_OK)
+                        printf("Seuil de coût: %u (%ld pixels sélectionnés). Nombre de pixels modifiés: %d pour %zu bits (%lu%%)\n", seuilAdaptatif, nbPositionsAdaptatives, compteurNbBitsModif, tailleMsgBit, (compteurNbBitsModif*100)/tailleMsgBit);
+                    free(tableAdaptative);
+
+                    break;
+                case MODE_HAMMING_CHIFFRE:
+
+                    error = hideMessageHammingChiffre(messageSecretBit, tailleMsgBit, matriceVue, dimensionVue, pixelIntensity, debutVue, cryptKey, rows, nbBlocsGrands, &compteurNbBitsModif);
+                    if(error == ERROR_OK)
+                        printf("Matrices de vérification: %ld blocs de (%u, %u) puis (%u, %u). Nombre de bits modifiés: %d sur %zu (%lu%%)\n", nbBlocsGrands, (2u << rows) - 1, rows + 1, (1u << rows) - 1, rows, compteurNbBitsModif, tailleMsgBit, (compteurNbBitsModif*100)/tailleMsgBit);
+
+                    break;
+                default:
+                    error = ERROR_HANDLE;
+            }
+
+            if(masqueCanaux != 0) {
+                if(error == ERROR_OK)
+                    error = reinsererVueCanaux(matriceImage, dimension, (int) profondeur, masqueCanaux, matriceVue);
+                free(matriceVue);
+            }
+
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+
+
+
+
+
+
+
+            /* -----------------------------------------------------------
+             * ------------ PARTIE ECRITURE DE LA NVL IMG ----------------
+             * -----------------------------------------------------------
+             */
+
+            if(strcmp(typeFile, "PNG") == 0) {
+                // Un PNG est réencodé ligne par ligne, entête compris
+                error = writeImagePNG(fileOutput, matriceImage, imageWidth, imageHeight, profondeur);
+                if(error != ERROR_OK) {
+                    printf("Erreur: %s", error_str(error));
+                    return 0;
+                }
+            } else {
+                // Un BMP ou un WAV est recopié tel quel (entêtes, masques, profil de couleur, métadonnées) puis seuls ses octets modifiés sont réécrits
+                if(strcmp(typeFile, "BMP") == 0 || strcmp(typeFile, "WAV") == 0)
+                    error = copierFichier(pathToFile, fileOutput);
+                else if(strcmp(typeFile, "P7") == 0)
+                    error = writeHeaderPAM(fileOutput, imageWidth, imageHeight, profondeur, pixelIntensity, tuplType, &beginningNewImage);
+                else
+                    error = writeHeader(fileOutput, typeFile, imageWidth, imageHeight, pixelIntensity, &beginningNewImage);
+                if(error != ERROR_OK) {
+                    error_str(error);
+                    return 0;
+                }
+
+
+                if(strcmp(typeFile, "BMP") == 0)
+                    error = writeImageBMP(fileOutput, matriceImage, beginningImage, imageWidth * profondeur, imageHeight, pasLigneFormat(typeFile, imageWidth, profondeur));
+                else if(strcmp(typeFile, "WAV") == 0)
+                    error = writeImageWAV(fileOutput, matriceImage, beginningImage, dimension, octetsEchantillonFormat(typeFile, pixelIntensity));
+                else if(estFormatASCII(typeFile))
+                    error = writeImageASCII(fileOutput, matriceImage, beginningNewImage, dimension);
+                else
+                    error = writeImage(fileOutput, matriceImage, beginningNewImage, dimension);
+                if(error != ERROR_OK) {
+                    error_str(error);
+                    return 0;
+                }
+            }
+
+
+            p("Votre message a bien été ajouté à votre image !");
+            p("Appuyez sur <Entrée> pour quitter le programme");
+            getchar();
+
+            break;
+
+        case 2:
+            h1("Décryptage");
+
+            /* -----------------------------------------------------------
+            * ---------------- PARTIE RECUPERATION DU FICHIER ------------
+            * -----------------------------------------------------------
+            */
+            p("Entrez le chemin vers le fichier image (avec l'extension).");
+            printf("> ");
+            pathToFile = inputString(stdin, 5);
+
+            /* ===========================================================
+             * ------------------ PARTIE DECRYPTAGE ----------------------
+             * ===========================================================
+             */
+
+            /* -----------------------------------------------------------
+             * ---------------- PARTIE LECTURE DU FICHIER ----------------
+             * -----------------------------------------------------------
+             */
+
+            // On lit l'entête du fichier (P5, P6 ou P7) et on en déduit la dimension de l'image
+            error = lireFormatImage(pathToFile, typeFile, &imageWidth, &imageHeight, &profondeur, &pixelIntensity, tuplType, &beginningImage, &dimension);
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
                 return 0;
             }
 
-            error = readImage(pathToFile, matriceImage, beginningImage, dimension);
+            //On affiche les différents paramètres.
+            // printf("Type du fichier: %s\nLargeur de l'image: %ld\nHauteur de l'image: %ld\nIntensité des pixels: %ld", typeFile, imageWidth, imageHeight, pixelIntensity);
+
+
+            /* On ne charge pas l'image en mémoire: les pixels sont lus dans le fichier à la demande,
+             * ce qui permet de ne lire que le prefixe puis les pixels qui contiennent réellement le message.
+             */
+            error = ouvrirSourceFormat(&source, pathToFile, typeFile, imageWidth, profondeur, pixelIntensity, beginningImage, dimension);
             if(error != ERROR_OK) {
-                error_str(error);
+                printf("Erreur: %s", error_str(error));
                 return 0;
             }
 
@@ -421,70 +995,161 @@ int main() {
              * -----------------------------------------------------------
              */
 
-            error = decryptPrefix(matriceImage, dimension, &prefixInt, &lengthDimensionPrefix);
-            if(error != ERROR_OK) {
-                error_str(error);
+            error = decryptPrefixSource(&source, &prefixInt, &lengthDimensionPrefix);
+            if(error != ERROR_OK || prefixInt < lengthDimensionPrefix || prefixInt > dimension) {
+                printf("Erreur: %s", error_str(error != ERROR_OK ? error : ERROR_INVARG));
                 return 0;
             }
 
-            p("Quel type de decryptage souhaitez vous utiliser ?");
+            /* -----------------------------------------------------------
+             * ------------ PARTIE LECTURE DE L'ENTETE DU CONTENEUR ------
+             * -----------------------------------------------------------
+             */
 
-            li(1, "Classique: récupération un par un.");
-            li(2, "Chiffré: modifier le sens de parcour grâce à une clé de chiffrement.");
-            li(3, "Hamming: Vecteur de syndrome.");
+            // Si l'image contient un entête, toutes les informations nécessaires y sont: on décode directement
+            if(lireEnteteConteneur(&source, lengthDimensionPrefix, prefixInt, &entete, &tailleEnteteBit) == ERROR_OK) {
 
-            // A modifier
-            switch(reponseMenu(3)) {
-                case 1:
-                    error = decryptMessage(matriceImage, dimension, prefixInt, lengthDimensionPrefix,0,NULL, &tailleMsgDecrypt, &messageSecretBitOutput);
-                    if(error != ERROR_OK) {
-                        error_str(error);
-                        return 0;
-                    }
+                // Le flux n'est lu que dans les canaux qui le contiennent (le prefixe et l'entête sont déjà lus)
+                vueCanauxSource(&source, (entete.flags & MASQUE_CANAUX_CONTENEUR) >> DECALAGE_CANAUX_CONTENEUR);
 
-                    break;
-                case 2:
+                printf("\nConteneur version %d: méthode %d, %lu octets%s%s", entete.version, entete.mode, entete.longueurCharge, (entete.flags & FLAG_CONTENEUR_COMPRESSE) ? " compressés" : "", (entete.flags & FLAG_CONTENEUR_CHIFFRE) ? " chiffrés" : "");
+                if(entete.flags & FLAG_CONTENEUR_FICHIER)
+                    printf(", fichier \"%s\"", entete.nom);
+                printf("\n");
 
-                    p("Entrez la clé de chiffrement.");
-                    printf("> ");
-                    cryptKey = inputString(stdin, 5);
+                // Un fragment seul n'est pas décodable: le message complet est réassemblé par le menu 8
+                if(entete.flags & FLAG_CONTENEUR_FRAGMENT) {
+                    printf("\nCette image contient le fragment %u sur %u d'un message de %lu octets.\n", entete.indexFragment + 1, entete.nbFragments, entete.longueurTotale);
+                    p("Utilisez le menu 8 avec toutes les images du message pour le reconstituer.");
+                    fermerSourceImage(&source);
+                    return 0;
+                }
 
-                    error = decryptMessage(matriceImage, dimension, prefixInt, lengthDimensionPrefix,1,cryptKey, &tailleMsgDecrypt, &messageSecretBitOutput);
-                    if(error != ERROR_OK) {
-                        error_str(error);
-                        return 0;
-                    }
-                    break;
-                case 3:
+                // Une archive est lue fichier par fichier depuis son index
+                if(entete.flags & FLAG_CONTENEUR_ARCHIVE) {
+                    p("Cette image contient une archive de plusieurs fichiers. Utilisez le menu 10 pour lister son contenu et en extraire un fichier.");
+                    fermerSourceImage(&source);
+                    return 0;
+                }
+
+                error = parametresLecture(&entete, &cryptKey, &rows, &columns);
+                if(error != ERROR_OK) {
+                    printf("Erreur: %s", error_str(error));
+                    return 0;
+                }
 
-                    determineBestHammingSize(dimension, prefixInt-lengthDimensionPrefix, &rows, &columns);
+                if(entete.permutation == PERMUTATION_TABLEAU) {
+                    p("Entrez la clé de la table de permutation.");
+                    printf("> ");
+                    permutationKey = inputString(stdin, 5);
+                }
 
-                    if(columns>2 && rows > 1) {
+                if(entete.flags & FLAG_CONTENEUR_CHIFFRE) {
+                    p("Entrez la clé de chiffrement du message.");
+                    printf("> ");
+                    motDePasse = inputString(stdin, 5);
+                }
 
-                        error = decryptMessageHamming(matriceImage, dimension, prefixInt, lengthDimensionPrefix, rows, columns, &tailleMsgDecrypt, &messageSecretBitOutput);
-                        if(error != ERROR_OK) {
-                            error_str(error);
+                if(entete.flags & FLAG_CONTENEUR_FICHIER) {
+                    printf("\n    Entrez le chemin du fichier à créer (laissez vide pour utiliser le nom d'origine: %s).\n\n", entete.nom);
+                    printf("> ");
+                    fileToCrypt = inputString(stdin, 5);
+                    if(fileToCrypt == NULL || fileToCrypt[0] == '\0') {
+                        free(fileToCrypt);
+                        fileToCrypt = (char*) malloc(strlen(entete.nom) + 1);
+                        if(fileToCrypt == NULL) {
+                            printf("Erreur: %s", error_str(ERROR_NOMEM));
                             return 0;
                         }
+                        strcpy(fileToCrypt, entete.nom);
+                    }
+                }
 
-                    } else {
+                error = initLecteurBits(&lecteur, &source, lengthDimensionPrefix + tailleEnteteBit, entete.mode, cryptKey, rows, columns);
+                if(error != ERROR_OK) {
+                    printf("Erreur: %s", error_str(error));
+                    return 0;
+                }
 
-                        error = decryptMessage(matriceImage, dimension, prefixInt, lengthDimensionPrefix,0,NULL, &tailleMsgDecrypt, &messageSecretBitOutput);
-                        if(error != ERROR_OK) {
-                            error_str(error);
-                            return 0;
-                        }
+                nbBlocs = nbBlocsCrc(&entete);
 
-                        p("Votre message secret était trop volumineux pour avoir été inséré avec la méthode de Hamming, nous l'avons donc décrypté classiquement.");
+                if(permutationKey != NULL) {
+                    error = genererTableDepermutation(permutationKey, (int) ((entete.longueurCharge + nbBlocs * 4) * 8), &tableIndex);
+                    if(error != ERROR_OK) {
+                        printf("Erreur: %s", error_str(error));
+                        return 0;
                     }
+                }
 
-                    break;
-                default:
-                    printf("Erreur: %s", error_str(ERROR_INVARG));
+                if(nbBlocs > 0) {
+                    error = lireTableCrc(&lecteur, tableIndex, nbBlocs, &crcAttendus);
+                    if(error != ERROR_OK) {
+                        printf("Erreur: %s", error_str(error));
+                        return 0;
+                    }
+                }
+
+                if(entete.flags & FLAG_CONTENEUR_FICHIER) {
+                    fichierPlage = fopen(fileToCrypt, "wb");
+                    if(fichierPlage == NULL) {
+                        printf("Erreur: %s", error_str(ERROR_OPEN));
+                        return 0;
+                    }
+                } else {
+                    p("Votre message secret est:");
+                    fichierPlage = stdout;
+                }
+
+                if(entete.flags & (FLAG_CONTENEUR_COMPRESSE | FLAG_CONTENEUR_CHIFFRE)) {
+                    // Le message est d'abord décodé (et vérifié) en mémoire, puis authentifié, déchiffré et décompressé vers la sortie
+                    fichierCompresse = open_memstream((char**) &chargeCompressee, &tailleCharge);
+                    if(fichierCompresse == NULL) {
+                        error = ERROR_NOMEM;
+                    } else {
+                        error = decryptMessageVersFichier(&lecteur, tableIndex, nbBlocs * 4, fichierCompresse, (long int) entete.longueurCharge, crcAttendus, nbBlocs > 0 ? 1L << entete.blocCrc : 0);
+                        fclose(fichierCompresse);
+                    }
+                    if(error == ERROR_OK)
+                        error = restaurerCharge(&entete, chargeCompressee, tailleCharge, motDePasse, &charge, &longueurOrigine);
+                    if(error == ERROR_OK && fwrite(charge, 1, longueurOrigine, fichierPlage) != longueurOrigine)
+                        error = ERROR_OPEN;
+                    freeAllVar(chargeCompressee, charge, NULL, NULL, NULL, NULL, NULL);
+                    charge = NULL;
+                } else {
+                    error = decryptMessageVersFichier(&lecteur, tableIndex, nbBlocs * 4, fichierPlage, (long int) entete.longueurCharge, crcAttendus, nbBlocs > 0 ? 1L << entete.blocCrc : 0);
+                }
+                if(fichierPlage != stdout) {
+                    fclose(fichierPlage);
+                    if(error != ERROR_OK) // On ne laisse pas un fichier incomplet ou corrompu
+                        remove(fileToCrypt);
+                }
+                libererLecteurBits(&lecteur);
+                fermerSourceImage(&source);
+                freeAllVar(tableIndex, crcAttendus, NULL, NULL, NULL, NULL, NULL);
+                if(error != ERROR_OK) {
+                    printf("Erreur: %s", error_str(error));
                     return 0;
-            }
+                }
+
+                if(entete.flags & FLAG_CONTENEUR_FICHIER) {
+                    printf("\nVotre fichier: %s", fileToCrypt);
+                    p("Votre fichier a été créé avec succès !");
+                } else {
+                    printf("\n");
+                }
+
+                p("Appuyez sur <Entrée> pour quitter le programme");
+                getchar();
 
+                break;
+            }
 
+            // Image créée sans entête (ancien format): on demande tous les choix à l'utilisateur avant de décoder, afin de tout faire en une seule passe
+            modeDecryptage = choisirModeDecryptage(dimension, prefixInt, lengthDimensionPrefix, 0, &cryptKey, &rows, &columns);
+            if(modeDecryptage < 0) {
+                printf("Erreur: %s", error_str(ERROR_INVARG));
+                return 0;
+            }
 
 
             // On vérifie si le message a été permuté avec une clé
@@ -498,13 +1163,7 @@ int main() {
                 case 1:
                     p("Entrez la clé de chiffrement.");
                     printf("> ");
-                    cryptKey = inputString(stdin, 5);
-
-                    error = depermuterTableau(cryptKey, tailleMsgDecrypt, &messageSecretBitOutput);
-                    if(error != ERROR_OK) {
-                        error_str(error);
-                        return 0;
-                    }
+                    permutationKey = inputString(stdin, 5);
 
                     break;
                 case 2:
@@ -514,72 +1173,24 @@ int main() {
                     return 0;
             }
 
-            // On converti le message de bits en unsigned char (octet)
-            error = binaryToUChar(tailleMsgDecrypt, messageSecretBitOutput, &msgSecret, &lengthmsgSecret);
-            if(error != ERROR_OK) {
-                error_str(error);
-                return 0;
-            }
-
 
             p("Que souhaitez-vous faire ?");
 
             li(1, "Décrypter un texte.");
             li(2, "Décrypter un fichier.");
 
-            switch(reponseMenu(2)) {
+            estFichier = (int) reponseMenu(2);
+            switch(estFichier) {
                 case 1:
-
-                    /* -----------------------------------------------------------
-                     * -------------- PARTIE TRADUCTION DU MSG CRYPTE ------------
-                     * -----------------------------------------------------------
-                     */
-                    //printf("\nBits de votre message secret décrypté: ");
-
-                    msgSecret[lengthmsgSecret] = '\0';
-
-                    p("Votre message secret est:");
-                    p((const char*)msgSecret);
-
-                    p("Appuyez sur <Entrée> pour quitter le programme");
-                    getchar();
-
+                    estFichier = 0;
                     break;
                 case 2:
+                    estFichier = 1;
 
-                    /* -----------------------------------------------------------
-                    * ---------------- PARTIE CREATION DU FICHIER DEPUIS MSG -----
-                    * -----------------------------------------------------------
-                    */
                     p("Entrez le nom du fichier à créer (SANS l'extension).");
                     printf("> ");
                     fileToCrypt = inputString(stdin, 5);
 
-                    error = readExtensionSuffix(msgSecret, lengthmsgSecret, &extensionPixelMap);
-                    if(error != ERROR_OK) {
-                        error_str(error);
-                        return 0;
-                    }
-
-
-                    error = addExtension(&fileToCrypt, extensionPixelMap);
-                    if(error != ERROR_OK) {
-                        error_str(error);
-                        return 0;
-                    }
-
-                    error = createFileFromByte(fileToCrypt, msgSecret, tailleMsgDecrypt);
-                    if(error != ERROR_OK) {
-                        error_str(error);
-                        return 0;
-                    }
-
-                    printf("\nExtension de votre fichier: %s", extensionPixelMap);
-                    p("Votre fichier a été créé avec succès !");
-
-                    p("Appuyez sur <Entrée> pour quitter le programme");
-                    getchar();
-
                     break;
                 default:
                     printf("Erreur: %s", error_str(ERROR_INVARG));
@@ -587,1398 +1198,9057 @@ int main() {
             }
 
 
-            break;
+            /* -----------------------------------------------------------
+             * ------------ PARTIE DECODAGE FUSIONNE DU MSG --------------
+             * -----------------------------------------------------------
+             */
 
-        default:
-            printf("Erreur: %s", error_str(ERROR_INVARG));
-            return 0;
+            error = initLecteurBits(&lecteur, &source, lengthDimensionPrefix, modeDecryptage, cryptKey, rows, columns);
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
 
+            if(!estFichier)
+                p("Votre message secret est:");
 
-    }
+            error = decryptMessageStream(&lecteur, prefixInt - lengthDimensionPrefix, permutationKey, estFichier, &fileToCrypt);
+            libererLecteurBits(&lecteur);
+            fermerSourceImage(&source);
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
 
+            if(estFichier) {
+                printf("\nVotre fichier: %s", fileToCrypt);
+                p("Votre fichier a été créé avec succès !");
+            } else {
+                printf("\n");
+            }
 
-    freeAllVar(msgSecret, messageSecretBitOutput, pathToFile, matriceImage, messageSecretBit, messageSecret, extensionPixelMap);
+            p("Appuyez sur <Entrée> pour quitter le programme");
+            getchar();
 
-    return 0;
-}
 
+            break;
 
-int addExtensionSuffix(char* extensionFileToCrypt, unsigned char** messageSecretBit, size_t *tailleMsgBit) {
+        case 3:
+            h1("Extraction partielle");
 
-    unsigned char* extensionBinary = NULL;
-    size_t longueurExtensionFileToCryptBinary;
+            /* -----------------------------------------------------------
+            * ---------------- PARTIE RECUPERATION DU FICHIER ------------
+            * -----------------------------------------------------------
+            */
+            p("Entrez le chemin vers le fichier image (avec l'extension).");
+            printf("> ");
+            pathToFile = inputString(stdin, 5);
 
-    extensionBinary = stringToBinary(extensionFileToCrypt, &longueurExtensionFileToCryptBinary);
-    if(extensionBinary == NULL)
-        return ERROR_NOMEM;
+            error = lireFormatImage(pathToFile, typeFile, &imageWidth, &imageHeight, &profondeur, &pixelIntensity, tuplType, &beginningImage, &dimension);
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
 
-    (*messageSecretBit) = realloc((*messageSecretBit), (*tailleMsgBit)+40);
-    if((*messageSecretBit) == NULL)
-        return ERROR_NOMEM;
+            error = ouvrirSourceFormat(&source, pathToFile, typeFile, imageWidth, profondeur, pixelIntensity, beginningImage, dimension);
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
 
-    int q = 8; // On initialise q à 8 car on ne veut pas le point initial de l'extension
-    for(int s = (*tailleMsgBit); s<(*tailleMsgBit)+longueurExtensionFileToCryptBinary-8; s++) {
-        (*messageSecretBit)[s] = extensionBinary[q]-'0';
+            error = decryptPrefixSource(&source, &prefixInt, &lengthDimensionPrefix);
+            if(error != ERROR_OK || prefixInt < lengthDimensionPrefix || prefixInt > dimension) {
+                printf("Erreur: %s", error_str(error != ERROR_OK ? error : ERROR_INVARG));
+                return 0;
+            }
 
-        q++;
-    }
+            if(lireEnteteConteneur(&source, lengthDimensionPrefix, prefixInt, &entete, &tailleEnteteBit) == ERROR_OK) {
 
-    if(longueurExtensionFileToCryptBinary<40) {
-        for(int s = (int)((*tailleMsgBit)+longueurExtensionFileToCryptBinary); s<(*tailleMsgBit)+40; s++) {
+                vueCanauxSource(&source, (entete.flags & MASQUE_CANAUX_CONTENEUR) >> DECALAGE_CANAUX_CONTENEUR);
+
+                // Le message commence après l'entête et ne contient pas de suffixe d'extension
+                if(entete.permutation != PERMUTATION_AUCUNE || (entete.flags & FLAG_CONTENEUR_COMPRESSE)) {
+                    p("Un message permuté ou compressé ne permet pas d'extraire une portion du message.");
+                    printf("Erreur: %s", error_str(ERROR_INVARG));
+                    return 0;
+                }
+
+                // Refusé avant de demander la clé
+                modeDecryptage = entete.mode;
+                if(modeDecryptage == MODE_CHIFFRE) {
+                    p("Cette méthode ne permet pas d'extraire une portion du message.");
+                    printf("Erreur: %s", error_str(ERROR_INVARG));
+                    return 0;
+                }
+
+                error = parametresLecture(&entete, &cryptKey, &rows, &columns);
+                if(error != ERROR_OK) {
+                    printf("Erreur: %s", error_str(error));
+                    return 0;
+                }
+
+                // Le flux ChaCha20 permet de ne déchiffrer que la portion demandée (sans vérifier le tag, qui porte sur tout le message)
+                if(entete.flags & FLAG_CONTENEUR_CHIFFRE) {
+                    p("Entrez la clé de chiffrement du message.");
+                    printf("> ");
+                    motDePasse = inputString(stdin, 5);
+                    decalageChiffre = TAILLE_SEL_AEAD + TAILLE_NONCE_AEAD;
+                }
+
+                lengthDimensionPrefix += tailleEnteteBit;
+                estFichier = 0;
+                nbBlocs = nbBlocsCrc(&entete);
+                tailleFluxBit = ((long int) entete.longueurCharge + nbBlocs * 4) * 8;
+
+            } else {
+
+                nbBlocs = 0;
+                tailleFluxBit = prefixInt - lengthDimensionPrefix;
+
+                modeDecryptage = choisirModeDecryptage(dimension, prefixInt, lengthDimensionPrefix, 1, &cryptKey, &rows, &columns);
+                if(modeDecryptage < 0) {
+                    printf("Erreur: %s", error_str(ERROR_INVARG));
+                    return 0;
+                }
+
+                p("Le message caché est-il un texte ou un fichier ?");
+
+                li(1, "Un texte.");
+                li(2, "Un fichier.");
+
+                estFichier = (int) reponseMenu(2);
+                if(estFichier < 0) {
+                    printf("Erreur: %s", error_str(ERROR_INVARG));
+                    return 0;
+                }
+                estFichier = estFichier == 2;
+            }
+
+            p("Entrez la position du premier octet à extraire.");
+            offsetPlage = reponseNombre();
+            p("Entrez le nombre d'octets à extraire.");
+            longueurPlage = reponseNombre();
+            if(offsetPlage < 0 || longueurPlage < 0) {
+                printf("Erreur: %s", error_str(ERROR_INVARG));
+                return 0;
+            }
+
+            p("Entrez le chemin du fichier qui contiendra la portion extraite (avec l'extension).");
+            printf("> ");
+            fileOutput = inputString(stdin, 5);
+
+            /* -----------------------------------------------------------
+             * ------------- PARTIE EXTRACTION DE LA PORTION -------------
+             * -----------------------------------------------------------
+             */
+
+            // On ne garde jamais plus d'octets que le message n'en contient (tag d'authentification exclu)
+            if(longueurPlage > tailleFluxBit / 8)
+                longueurPlage = tailleFluxBit / 8;
+            if(decalageChiffre > 0 && longueurPlage > (long int) entete.longueurCharge - TAILLE_SURCOUT_AEAD - offsetPlage)
+                longueurPlage = (long int) entete.longueurCharge - TAILLE_SURCOUT_AEAD - offsetPlage > 0 ? (long int) entete.longueurCharge - TAILLE_SURCOUT_AEAD - offsetPlage : 0;
+
+            msgSecret = (unsigned char*) malloc(longueurPlage + 1);
+            if(msgSecret == NULL) {
+                printf("Erreur: %s", error_str(ERROR_NOMEM));
+                return 0;
+            }
+
+            // La table des CRC précède le message: la plage est décalée, puis seuls les blocs qui la recouvrent sont vérifiés
+            error = initLecteurBits(&lecteur, &source, lengthDimensionPrefix, modeDecryptage, cryptKey, rows, columns);
+            if(error == ERROR_OK)
+                error = decryptPlageOctets(&lecteur, tailleFluxBit, estFichier, offsetPlage + decalageChiffre + nbBlocs * 4, longueurPlage, msgSecret, &longueurPlage);
+            if(error == ERROR_OK && decalageChiffre > 0) {
+                for(i = 0; i < decalageChiffre; i++) {
+                    selNonce[i] = lireOctetExtrait(&lecteur, nbBlocs * 4 + i);
+                }
+                deriverCle(motDePasse, selNonce, TAILLE_SEL_AEAD, ITERATIONS_PBKDF2, cleMessage);
+                xorChaCha20(cleMessage, selNonce + TAILLE_SEL_AEAD, (unsigned long long) offsetPlage, msgSecret, (size_t) longueurPlage);
+                memset(cleMessage, 0, sizeof(cleMessage));
+            }
+            if(error == ERROR_OK && nbBlocs > 0 && longueurPlage > 0) {
+                error = lireTableCrc(&lecteur, NULL, nbBlocs, &crcAttendus);
+                if(error == ERROR_OK) {
+                    travail.lecteur = lecteur;
+                    travail.tableIndex = NULL;
+                    travail.debutOctet = nbBlocs * 4;
+                    travail.tailleBloc = 1L << entete.blocCrc;
+                    travail.crcAttendus = crcAttendus;
+                    travail.premierBloc = (offsetPlage + decalageChiffre) / travail.tailleBloc;
+                    travail.pas = 1;
+                    // Le dernier bloc vérifié est celui qui contient la fin de la plage
+                    travail.longueurCharge = ((offsetPlage + decalageChiffre + longueurPlage - 1) / travail.tailleBloc + 1) * travail.tailleBloc;
+                    if(travail.longueurCharge > (long int) entete.longueurCharge)
+                        travail.longueurCharge = (long int) entete.longueurCharge;
+                    error = verifierBlocsCrc(&travail);
+                    if(error == ERROR_CHECKSUM)
+                        printf("\nBloc %ld invalide.", travail.blocInvalide);
+                }
+                free(crcAttendus);
+            }
+            libererLecteurBits(&lecteur);
+            fermerSourceImage(&source);
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+
+            fichierPlage = fopen(fileOutput, "wb");
+            if(fichierPlage == NULL) {
+                printf("Erreur: %s", error_str(ERROR_OPEN));
+                return 0;
+            }
+            // Une écriture incomplète (disque plein) ne doit pas laisser un fichier tronqué (un tube nommé ou un périphérique n'est pas supprimé)
+            error = fwrite(msgSecret, 1, (size_t) longueurPlage, fichierPlage) != (size_t) longueurPlage ? ERROR_OPEN : ERROR_OK;
+            plageReguliere = fstat(fileno(fichierPlage), &infoPlage) == 0 && S_ISREG(infoPlage.st_mode);
+            if(fclose(fichierPlage) != 0)
+                error = ERROR_OPEN;
+            if(error != ERROR_OK) {
+                if(plageReguliere)
+                    remove(fileOutput);
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+
+            printf("\n%ld octets extraits dans %s", longueurPlage, fileOutput);
+            p("Appuyez sur <Entrée> pour quitter le programme");
+            getchar();
+
+            break;
+
+        case 4:
+            h1("Vérification");
+
+            p("Entrez le chemin vers le fichier image (avec l'extension).");
+            printf("> ");
+            pathToFile = inputString(stdin, 5);
+
+            error = lireFormatImage(pathToFile, typeFile, &imageWidth, &imageHeight, &profondeur, &pixelIntensity, tuplType, &beginningImage, &dimension);
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+
+            error = ouvrirSourceFormat(&source, pathToFile, typeFile, imageWidth, profondeur, pixelIntensity, beginningImage, dimension);
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+
+            error = decryptPrefixSource(&source, &prefixInt, &lengthDimensionPrefix);
+            if(error != ERROR_OK || prefixInt < lengthDimensionPrefix || prefixInt > dimension) {
+                printf("Erreur: %s", error_str(error != ERROR_OK ? error : ERROR_INVARG));
+                return 0;
+            }
+
+            // Seuls les conteneurs qui embarquent une table de CRC peuvent être vérifiés
+            error = lireEnteteConteneur(&source, lengthDimensionPrefix, prefixInt, &entete, &tailleEnteteBit);
+            if(error != ERROR_OK || !(entete.flags & FLAG_CONTENEUR_CRC)) {
+                p("Cette image ne contient pas de sommes de contrôle.");
+                printf("Erreur: %s", error_str(ERROR_FORMAT));
+                return 0;
+            }
+            vueCanauxSource(&source, (entete.flags & MASQUE_CANAUX_CONTENEUR) >> DECALAGE_CANAUX_CONTENEUR);
+
+            error = parametresLecture(&entete, &cryptKey, &rows, &columns);
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+
+            if(entete.permutation == PERMUTATION_TABLEAU) {
+                p("Entrez la clé de la table de permutation.");
+                printf("> ");
+                permutationKey = inputString(stdin, 5);
+            }
+
+            nbBlocs = nbBlocsCrc(&entete);
+
+            error = initLecteurBits(&lecteur, &source, lengthDimensionPrefix + tailleEnteteBit, entete.mode, cryptKey, rows, columns);
+            if(error == ERROR_OK && permutationKey != NULL)
+                error = genererTableDepermutation(permutationKey, (int) ((entete.longueurCharge + nbBlocs * 4) * 8), &tableIndex);
+            if(error == ERROR_OK)
+                error = lireTableCrc(&lecteur, tableIndex, nbBlocs, &crcAttendus);
+            if(error == ERROR_OK)
+                error = verifierChargeParallele(pathToFile, &lecteur, tableIndex, nbBlocs * 4, (long int) entete.longueurCharge, crcAttendus, 1L << entete.blocCrc, &blocInvalide);
+
+            libererLecteurBits(&lecteur);
+            fermerSourceImage(&source);
+            freeAllVar(tableIndex, crcAttendus, NULL, NULL, NULL, NULL, NULL);
+
+            if(error == ERROR_CHECKSUM) {
+                printf("\nLe bloc %ld (octets %ld à %ld) est invalide.", blocInvalide, blocInvalide << entete.blocCrc, ((blocInvalide + 1) << entete.blocCrc) - 1);
+            } else if(error == ERROR_OK) {
+                printf("\n%ld blocs vérifiés.", nbBlocs);
+                p("Le message est intact !");
+            }
+            if(error != ERROR_OK) {
+                printf("\nErreur: %s", error_str(error));
+                return 0;
+            }
+
+            p("Appuyez sur <Entrée> pour quitter le programme");
+            getchar();
+
+            break;
+
+        case 6:
+        case 8:
+            // Le message est lu d'un flux ou réassemblé depuis plusieurs images, la suite est commune
+            repartition = userMenu == 8;
+            h1(repartition ? "Reconstitution d'un message réparti" : "Décryptage d'un flux");
+
+            if(repartition) {
+                p("Entrez les chemins vers les images qui contiennent le message (avec l'extension, dans n'importe quel ordre), un par ligne. Terminez par une ligne vide.");
+                pathsImages = inputChemins(stdin, &nbImages);
+                if(pathsImages == NULL || nbImages < 1) {
+                    printf("Erreur: %s", error_str(pathsImages == NULL ? ERROR_NOMEM : ERROR_INVARG));
+                    return 0;
+                }
+
+                // Les fragments sont extraits en parallèle et vérifiés bloc par bloc, puis le message assemblé par son CRC32C
+                error = reconstituerCharge(pathsImages, nbImages, &entete, &chargeCompressee, &tailleCharge, &imageInvalide, &fragmentInvalide, &nbFragments);
+                if(error != ERROR_OK) {
+                    // Un fragment en double désigne l'image qui le répète, un fragment manquant aucune image (les numéros sont ceux des images créées, à partir de 1)
+                    if(fragmentInvalide >= 0 && imageInvalide >= 0)
+                        printf("\nImage %s: le fragment %d est en double (message réparti sur %d images, %d données).\n", pathsImages[imageInvalide], fragmentInvalide + 1, nbFragments, nbImages);
+                    else if(fragmentInvalide >= 0)
+                        printf("\nLe fragment %d est manquant (message réparti sur %d images, %d données: il en manque %d).\n", fragmentInvalide + 1, nbFragments, nbImages, nbFragments - nbImages);
+                    else if(imageInvalide >= 0)
+                        printf("\nImage %s: ", pathsImages[imageInvalide]);
+                    printf("Erreur: %s", error_str(error));
+                    return 0;
+                }
+                printf("\nMessage de %lu octets reconstitué à partir de %d images.\n", entete.longueurCharge, nbImages);
+            } else {
+                p("Entrez le chemin vers le flux d'images (fichier ou tube nommé).");
+                printf("> ");
+                pathToFile = inputString(stdin, 5);
+
+                // Le flux n'est lu que jusqu'à la fin du message, les CRC sont vérifiés au fil des trames
+                error = extraireDuFlux(pathToFile, &entete, &chargeCompressee, &tailleCharge, &nbTrames);
+                if(error != ERROR_OK) {
+                    printf("Erreur: %s", error_str(error));
+                    return 0;
+                }
+                printf("\nMessage de %lu octets lu dans %ld trames.\n", entete.longueurCharge, nbTrames);
+            }
+
+            if(entete.flags & FLAG_CONTENEUR_CHIFFRE) {
+                p("Entrez la clé de chiffrement du message.");
+                printf("> ");
+                motDePasse = inputString(stdin, 5);
+            }
+
+            if(entete.flags & FLAG_CONTENEUR_FICHIER) {
+                printf("\n    Entrez le chemin du fichier à créer (laissez vide pour utiliser le nom d'origine: %s).\n\n", entete.nom);
+                printf("> ");
+                fileToCrypt = inputString(stdin, 5);
+                if(fileToCrypt == NULL || fileToCrypt[0] == '\0') {
+                    free(fileToCrypt);
+                    fileToCrypt = (char*) malloc(strlen(entete.nom) + 1);
+                    if(fileToCrypt == NULL) {
+                        printf("Erreur: %s", error_str(ERROR_NOMEM));
+                        return 0;
+                    }
+                    strcpy(fileToCrypt, entete.nom);
+                }
+            }
+
+            error = restaurerCharge(&entete, chargeCompressee, tailleCharge, motDePasse, &charge, &longueurOrigine);
+            free(chargeCompressee);
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+
+            if(entete.flags & FLAG_CONTENEUR_FICHIER) {
+                fichierPlage = fopen(fileToCrypt, "wb");
+                if(fichierPlage == NULL) {
+                    printf("Erreur: %s", error_str(ERROR_OPEN));
+                    return 0;
+                }
+            } else {
+                p("Votre message secret est:");
+                fichierPlage = stdout;
+            }
+            if(fwrite(charge, 1, longueurOrigine, fichierPlage) != longueurOrigine)
+                error = ERROR_OPEN;
+            free(charge);
+            if(fichierPlage != stdout) {
+                fclose(fichierPlage);
+                if(error != ERROR_OK)
+                    remove(fileToCrypt);
+            }
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+
+            if(entete.flags & FLAG_CONTENEUR_FICHIER) {
+                printf("\nVotre fichier: %s", fileToCrypt);
+                p("Votre fichier a été créé avec succès !");
+            } else {
+                printf("\n");
+            }
+
+            p("Appuyez sur <Entrée> pour quitter le programme");
+            getchar();
+
+            break;
+
+        case 9:
+            h1("Copies d'une image");
+
+            p("Entrez le chemin vers l'image d'origine (ppm/pgm/pam/bmp/png/wav, avec l'extension).");
+            printf("> ");
+            pathToFile = inputString(stdin, 5);
+
+            // L'image est lue et analysée une seule fois: toutes les copies partent de ces échantillons
+            error = chargerImage(pathToFile, &couverture);
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+
+            p("Entrez les chemins des fichiers à cacher (un fichier par copie, avec l'extension), un par ligne. Terminez par une ligne vide.");
+            pathsMessages = inputChemins(stdin, &nbMessages);
+            if(pathsMessages == NULL || nbMessages < 1) {
+                printf("Erreur: %s", error_str(pathsMessages == NULL ? ERROR_NOMEM : ERROR_INVARG));
+                return 0;
+            }
+
+            p("Entrez le nom commun des copies à créer (SANS l'extension). Chaque copie reçoit son numéro et l'extension de l'image d'origine (nom_1.ppm, nom_2.ppm, etc.).");
+            printf("> ");
+            fileOutput = inputString(stdin, 1);
+
+            extensionImage = strrchr(pathToFile, '.');
+            if(extensionImage == NULL || strchr(extensionImage, '/') != NULL) {
+                printf("Erreur: %s", error_str(ERROR_INVARG));
+                return 0;
+            }
+
+            p("Souhaitez vous compresser les fichiers avant de les cacher ?");
+
+            li(1, "Oui.");
+            li(2, "Non.");
+
+            compresserCopies = reponseMenu(2) == 1;
+
+            p("Souhaitez vous chiffrer les fichiers (ChaCha20-Poly1305, une clé par fichier) ?");
+
+            li(1, "Oui.");
+            li(2, "Non.");
+
+            chiffrerCopies = reponseMenu(2) == 1;
+
+            pathsSorties = (char**) malloc((size_t) nbMessages * sizeof(char*));
+            entetesCopies = (enteteConteneur_t*) malloc((size_t) nbMessages * sizeof(enteteConteneur_t));
+            chargesCopies = (unsigned char**) malloc((size_t) nbMessages * sizeof(unsigned char*));
+            finsModifications = (long int*) malloc((size_t) nbMessages * sizeof(long int));
+            if(pathsSorties == NULL || entetesCopies == NULL || chargesCopies == NULL || finsModifications == NULL) {
+                printf("Erreur: %s", error_str(ERROR_NOMEM));
+                return 0;
+            }
+
+            // Chaque fichier est préparé (nom, compression, chiffrement) avant de lancer les insertions en parallèle
+            for(i = 0; i < nbMessages; i++) {
+
+                pathsSorties[i] = (char*) malloc(strlen(fileOutput) + strlen(extensionImage) + 16);
+                if(pathsSorties[i] == NULL) {
+                    printf("Erreur: %s", error_str(ERROR_NOMEM));
+                    return 0;
+                }
+                sprintf(pathsSorties[i], "%s_%ld%s", fileOutput, i + 1, extensionImage);
+
+                error = lireFichierOctets(pathsMessages[i], &chargesCopies[i], &tailleCharge);
+                if(error != ERROR_OK) {
+                    printf("\nFichier %s: Erreur: %s", pathsMessages[i], error_str(error));
+                    return 0;
+                }
+
+                entetesCopies[i] = entete;
+                nomFichier = strrchr(pathsMessages[i], '/');
+                nomFichier = nomFichier != NULL ? nomFichier + 1 : pathsMessages[i];
+                if(strlen(nomFichier) > TAILLE_NOM_CONTENEUR) {
+                    printf("\nFichier %s: Erreur: %s", pathsMessages[i], error_str(ERROR_INVARG));
+                    return 0;
+                }
+                strcpy(entetesCopies[i].nom, nomFichier);
+                entetesCopies[i].flags |= FLAG_CONTENEUR_FICHIER;
+
+                if(compresserCopies) {
+                    error = compresserCharge(&chargesCopies[i], &tailleCharge, &compresse);
+                    if(error != ERROR_OK) {
+                        printf("Erreur: %s", error_str(error));
+                        return 0;
+                    }
+                    if(compresse)
+                        entetesCopies[i].flags |= FLAG_CONTENEUR_COMPRESSE;
+                }
+
+                if(chiffrerCopies) {
+                    printf("\n    Entrez la clé de chiffrement de %s.\n\n", nomFichier);
+                    printf("> ");
+                    motDePasse = inputString(stdin, 5);
+
+                    // Le tag couvre l'entête tel qu'il sera inséré dans la copie (voir cacherConteneurSegmente)
+                    entetesCopies[i].flags |= FLAG_CONTENEUR_CHIFFRE;
+                    entetesCopies[i].longueurCharge = tailleCharge + TAILLE_SURCOUT_AEAD;
+                    error = preparerEnteteSegmente(&entetesCopies[i], couverture.dimension, &enteteAuthentifie, &debutMessage, &rows, &nbBlocsGrands);
+                    if(error == ERROR_OK)
+                        error = serialiserEnteteConteneur(&enteteAuthentifie, octetsEntete, &tailleEnteteBit);
+                    if(error == ERROR_OK)
+                        error = chiffrerCharge(&chargesCopies[i], &tailleCharge, motDePasse, octetsEntete, (size_t) tailleEnteteBit);
+                    free(motDePasse);
+                    motDePasse = NULL;
+                    if(error != ERROR_OK) {
+                        printf("Erreur: %s", error_str(error));
+                        return 0;
+                    }
+                }
+
+                entetesCopies[i].longueurCharge = tailleCharge;
+            }
+
+            error = cacherDansCopies(pathToFile, &couverture, pathsSorties, nbMessages, entetesCopies, chargesCopies, finsModifications, &imageInvalide);
+            if(error != ERROR_OK) {
+                if(imageInvalide >= 0)
+                    printf("\nCopie %s: ", pathsSorties[imageInvalide]);
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+
+            printf("\n%d copies créées à partir de %s:\n", nbMessages, pathToFile);
+            for(i = 0; i < nbMessages; i++) {
+                printf("    %s: %s, %lu octets\n", pathsSorties[i], entetesCopies[i].nom, entetesCopies[i].longueurCharge);
+                free(chargesCopies[i]);
+            }
+            freeAllVar(couverture.matriceImage, entetesCopies, chargesCopies, finsModifications, NULL, NULL, NULL);
+
+            p("Vos copies ont été créées avec succès !");
+            p("Appuyez sur <Entrée> pour quitter le programme");
+            getchar();
+
+            break;
+
+        case 10:
+            h1("Archive");
+
+            p("Entrez le chemin vers le fichier image (avec l'extension).");
+            printf("> ");
+            pathToFile = inputString(stdin, 5);
+
+            error = lireFormatImage(pathToFile, typeFile, &imageWidth, &imageHeight, &profondeur, &pixelIntensity, tuplType, &beginningImage, &dimension);
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+
+            error = ouvrirSourceFormat(&source, pathToFile, typeFile, imageWidth, profondeur, pixelIntensity, beginningImage, dimension);
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+
+            error = decryptPrefixSource(&source, &prefixInt, &lengthDimensionPrefix);
+            if(error != ERROR_OK || prefixInt < lengthDimensionPrefix || prefixInt > dimension) {
+                printf("Erreur: %s", error_str(error != ERROR_OK ? error : ERROR_INVARG));
+                return 0;
+            }
+
+            error = lireEnteteConteneur(&source, lengthDimensionPrefix, prefixInt, &entete, &tailleEnteteBit);
+            if(error != ERROR_OK || !(entete.flags & FLAG_CONTENEUR_ARCHIVE)) {
+                p("Cette image ne contient pas d'archive.");
+                printf("Erreur: %s", error_str(ERROR_FORMAT));
+                return 0;
+            }
+            vueCanauxSource(&source, (entete.flags & MASQUE_CANAUX_CONTENEUR) >> DECALAGE_CANAUX_CONTENEUR);
+
+            error = parametresLecture(&entete, &cryptKey, &rows, &columns);
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+
+            // L'archive suit la table des CRC32C: seuls l'index puis les octets du fichier choisi sont lus dans l'image
+            nbBlocs = nbBlocsCrc(&entete);
+            error = initLecteurBits(&lecteur, &source, lengthDimensionPrefix + tailleEnteteBit, entete.mode, cryptKey, rows, columns);
+            if(error == ERROR_OK)
+                error = lireIndexArchive(&lecteur, nbBlocs * 4, (long int) entete.longueurCharge, &entreesArchive, &nbEntrees);
+            if(error != ERROR_OK) {
+                libererLecteurBits(&lecteur);
+                fermerSourceImage(&source);
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+
+            printf("\nArchive de %d fichiers:\n", nbEntrees);
+            for(i = 0; i < nbEntrees; i++) {
+                printf("    %ld. %s: %lu octets%s%s", i + 1, entreesArchive[i].nom, entreesArchive[i].longueur, (entreesArchive[i].flags & FLAG_CONTENEUR_COMPRESSE) ? " compressés" : "", (entreesArchive[i].flags & FLAG_CONTENEUR_CHIFFRE) ? " chiffrés" : "");
+                if(plageEchantillonsBits(&lecteur, (nbBlocs * 4 + (long int) entreesArchive[i].position) * 8, (long int) entreesArchive[i].longueur * 8, &offsetPlage, &longueurPlage) == ERROR_OK)
+                    printf(", échantillons %ld à %ld", offsetPlage, longueurPlage - 1);
+                printf("\n");
+            }
+
+            printf("\n    Quel fichier souhaitez vous extraire (de 1 à %d, 0 pour aucun) ?\n\n", nbEntrees);
+            entreeChoisie = reponseNombre();
+            if(entreeChoisie < 0 || entreeChoisie > nbEntrees) {
+                error = ERROR_INVARG;
+            } else if(entreeChoisie > 0) {
+                i = entreeChoisie - 1;
+                if(entreesArchive[i].flags & FLAG_CONTENEUR_CHIFFRE) {
+                    p("Entrez la clé de chiffrement du fichier.");
+                    printf("> ");
+                    motDePasse = inputString(stdin, 5);
+                }
+
+                printf("\n    Entrez le chemin du fichier à créer (laissez vide pour utiliser le nom d'origine: %s).\n\n", entreesArchive[i].nom);
+                printf("> ");
+                fileToCrypt = inputString(stdin, 5);
+                if(fileToCrypt == NULL || fileToCrypt[0] == '\0') {
+                    free(fileToCrypt);
+                    fileToCrypt = (char*) malloc(strlen(entreesArchive[i].nom) + 1);
+                    if(fileToCrypt == NULL)
+                        error = ERROR_NOMEM;
+                    else
+                        strcpy(fileToCrypt, entreesArchive[i].nom);
+                }
+
+                // Le fichier est vérifié et restauré en mémoire avant d'être écrit
+                if(error == ERROR_OK)
+                    error = extraireEntreeArchive(&lecteur, nbBlocs * 4, &entreesArchive[i], motDePasse, &charge, &longueurOrigine);
+                if(error == ERROR_OK) {
+                    fichierPlage = fopen(fileToCrypt, "wb");
+                    if(fichierPlage == NULL) {
+                        error = ERROR_OPEN;
+                    } else {
+                        if(fwrite(charge, 1, longueurOrigine, fichierPlage) != longueurOrigine)
+                            error = ERROR_OPEN;
+                        fclose(fichierPlage);
+                        if(error != ERROR_OK)
+                            remove(fileToCrypt);
+                    }
+                }
+                freeAllVar(charge, NULL, NULL, NULL, NULL, NULL, NULL);
+                charge = NULL;
+            }
+
+            libererLecteurBits(&lecteur);
+            fermerSourceImage(&source);
+            free(entreesArchive);
+            if(error != ERROR_OK) {
+                printf("Erreur: %s", error_str(error));
+                return 0;
+            }
+
+            // 0: liste seule, aucun fichier n'a été extrait
+            if(entreeChoisie > 0) {
+                printf("\nVotre fichier: %s", fileToCrypt);
+                p("Votre fichier a été créé avec succès !");
+            }
+
+            p("Appuyez sur <Entrée> pour quitter le programme");
+            getchar();
+
+            break;
+
+        default:
+            printf("Erreur: %s", error_str(ERROR_INVARG));
+            return 0;
+
+
+    }
+
+
+    freeAllVar(msgSecret, messageSecretBitOutput, pathToFile, matriceImage, messageSecretBit, messageSecret, extensionPixelMap);
+
+    return 0;
+}
+
+
+int addExtensionSuffix(char* extensionFileToCrypt, unsigned char** messageSecretBit, size_t *tailleMsgBit) {
+
+    unsigned char* extensionBinary = NULL;
+    size_t longueurExtensionFileToCryptBinary;
+
+    extensionBinary = stringToBinary(extensionFileToCrypt, &longueurExtensionFileToCryptBinary);
+    if(extensionBinary == NULL)
+        return ERROR_NOMEM;
+
+    (*messageSecretBit) = realloc((*messageSecretBit), (*tailleMsgBit)+40);
+    if((*messageSecretBit) == NULL)
+        return ERROR_NOMEM;
+
+    int q = 8; // On initialise q à 8 car on ne veut pas le point initial de l'extension
+    for(int s = (*tailleMsgBit); s<(*tailleMsgBit)+longueurExtensionFileToCryptBinary-8; s++) {
+        (*messageSecretBit)[s] = extensionBinary[q]-'0';
+
+        q++;
+    }
+
+    // On complète avec des zéros (le point de l'extension n'étant pas copié, le bourrage commence 8 bits plus tôt)
+    if(longueurExtensionFileToCryptBinary-8<40) {
+        for(int s = (int)((*tailleMsgBit)+longueurExtensionFileToCryptBinary-8); s<(*tailleMsgBit)+40; s++) {
             (*messageSecretBit)[s] = 0;
         }
     }
 
-    (*tailleMsgBit) = (*tailleMsgBit)+40;
+    (*tailleMsgBit) = (*tailleMsgBit)+40;
+
+    if(extensionBinary != NULL)
+        free(extensionBinary);
+
+    if(extensionFileToCrypt != NULL)
+        free(extensionFileToCrypt);
+
+    return ERROR_OK;
+}
+
+int createFileFromByte(const char* fileToCrypt, const unsigned char* msgSecret, long int tailleMsgDecrypt) {
+
+    FILE *newFile = fopen(fileToCrypt, "w");
+    if(newFile == NULL)
+        return ERROR_OPEN;
+
+    fwrite(msgSecret, 1, (tailleMsgDecrypt/8)-6, newFile);
+    fclose(newFile);
+
+    return ERROR_OK;
+}
+
+int readExtensionSuffix(const unsigned char* msgSecret, int lengthmsgSecret, char** extensionPixelMap) {
+
+    int y;
+
+    (*extensionPixelMap) = malloc(sizeof(char)*5);
+    if((*extensionPixelMap) == NULL)
+        return ERROR_NOMEM;
+
+    (*extensionPixelMap)[0] = '.';
+    for(y = 1;y<6;y++) {
+        (*extensionPixelMap)[y] = (char)msgSecret[lengthmsgSecret-6+y];
+    }
+
+    return ERROR_OK;
+}
+
+
+
+
+
+
+int binaryToUChar(long int tailleMsgDecrypt, const unsigned char *messageSecretBitOutput, unsigned char **msgSecret, int* lengthmsgSecret) {
+
+    int i,j;
+    unsigned char* data;
+    data = (unsigned char*) malloc(sizeof(unsigned char)*9);
+    if(data== NULL)
+        return ERROR_NOMEM;
+
+    (*msgSecret) = (unsigned char*) malloc(sizeof(unsigned char) * (tailleMsgDecrypt / 8) + 1);
+    if((*msgSecret)== NULL)
+        return ERROR_NOMEM;
+
+    j = 0;
+    for(i = 0; i<tailleMsgDecrypt; i++) {
+
+        data[i%8] = messageSecretBitOutput[i] + '0';
+        if(i%8 == 7) {
+            (*msgSecret)[j] = strtol((const char*)data, 0, 2);
+            j = j+1;
+        }
+    }
+
+    (*lengthmsgSecret) = j;
+
+    free(data);
+
+    return ERROR_OK;
+}
+
+
+int depermuterTableau(char* key,int tailleTable, unsigned char** table) {
+
+    unsigned long keyHash;
+    int *tablepermutation,i;
+    int temp;
+
+    keyHash = hash((unsigned char *) key);
+    srand(keyHash);
+
+    tablepermutation = (int *) malloc(sizeof(int) * tailleTable);
+    if(tablepermutation == NULL)
+        return ERROR_NOMEM;
+
+    for (i = tailleTable - 1; i >= 0; --i) {
+        tablepermutation[i] = rand() % (i + 1);// NOLINT(cert-msc30-c, cert-msc50-cpp)
+    }
+
+    for (i = 0; i < tailleTable; i++) {
+        temp = (*table)[i];
+        (*table)[i] = (*table)[tablepermutation[i]];
+        (*table)[tablepermutation[i]] = temp;
+    }
+
+    free(tablepermutation);
+
+
+    return ERROR_OK;
+}
+
+
+
+int permuterTableau(char* key,int tailleTable, unsigned char** table) {
+
+    unsigned long keyHash;
+    int i,j;
+    int temp;
+
+    keyHash = hash((unsigned char *) key);
+    srand(keyHash);
+
+    for (i = tailleTable - 1; i >= 0; --i) {
+        //generate a random number [0, n-1]
+        j = rand() % (i + 1);// NOLINT(cert-msc30-c, cert-msc50-cpp)
+
+        //swap the last element with element at random index
+        temp = (*table)[i];
+        (*table)[i] = (*table)[j];
+        (*table)[j] = temp;
+    }
+
+
+    return ERROR_OK;
+}
+
+
+// Cette fonction ajoute une extension à la fin d'un string, les deux se terminant par '\0'
+int addExtension(char** fileOutput, const char *extensionPixelMap) {
+
+    int longueurfileOutput = 0, longueurExtensionPixelMap = 0;
+
+    while((*fileOutput)[longueurfileOutput] != '\0') {
+        longueurfileOutput++;
+    }
+
+    while(extensionPixelMap[longueurExtensionPixelMap] != '\0') {
+        longueurExtensionPixelMap++;
+    }
+
+
+    (*fileOutput) = realloc((*fileOutput), longueurfileOutput+longueurExtensionPixelMap+2);
+    if((*fileOutput) == NULL)
+        return ERROR_NOMEM;
+
+    strcat((*fileOutput), extensionPixelMap);
+
+    return ERROR_OK;
+}
+
+
+// Fonction qui renvoit la taille (en place mémoire, donc en incluant le . et le \0) et un string correspond à l'extension d'un fichier.
+int getExtension(const char* pathToFile, char** extensionPixelMap) {
+
+    int longueurPathToFile = 0;
+    int i, positionExt;
+
+    while(pathToFile[longueurPathToFile] != '\0') {
+        if(pathToFile[longueurPathToFile] == '.') {
+            positionExt = longueurPathToFile;
+        }
+        longueurPathToFile++;
+    }
+
+
+    *extensionPixelMap = (char*) malloc(sizeof(char)*(longueurPathToFile-positionExt)+1);
+    if(*extensionPixelMap == NULL)
+        return ERROR_NOMEM;
+
+    (*extensionPixelMap)[0] = '.';
+
+    for(i = 1; i<(longueurPathToFile-positionExt); i++) {
+        (*extensionPixelMap)[i] = pathToFile[longueurPathToFile-((longueurPathToFile-positionExt)-i)];
+    }
+
+    (*extensionPixelMap)[(longueurPathToFile-positionExt)] = '\0';
+
+    return ERROR_OK;
+}
+
+
+
+void freeAllVar(void* pointer1, void* pointer2, void* pointer3, void* pointer4, void* pointer5, void* pointer6, void* pointer7) {
+
+    if(pointer1 != NULL)
+        free(pointer1);
+
+    if(pointer2 != NULL)
+        free(pointer2);
+
+    if(pointer3 != NULL)
+        free(pointer3);
+
+    if(pointer4 != NULL)
+        free(pointer4);
+
+    if(pointer5 != NULL)
+        free(pointer5);
+
+    if(pointer6 != NULL)
+        free(pointer6);
+
+    if(pointer7 != NULL)
+        free(pointer7);
+
+
+}
+
+
+
+
+
+
+// http://www.cse.yorku.ca/~oz/hash.html
+unsigned long hash(unsigned char *str)
+{
+    unsigned long hash = 5381;
+    int c;
+
+    while ((c = *str++))
+        hash = ((hash << 5) + hash) + c; /* hash * 33 + c */
+
+    return hash;
+}
+
+
+// Convert char to binary table
+void printbincharpad(char c, char* tabBit)
+{
+
+    for(int n = 0; n < 8; n++)
+        tabBit[7-n] = (char) ((c >> n) & 1);
+
+}
+
+/* Copié collé depuis https://stackoverflow.com/questions/16870485/how-can-i-read-an-input-string-of-unknown-length */
+char *inputString(FILE* fp, size_t size){
+//The size is extended by the input with the value of the provisional
+    char *str;
+    int ch;
+    size_t len = 0;
+    str = realloc(NULL, sizeof(char)*size);//size is start size
+    if(!str)return str;
+    while(EOF!=(ch=fgetc(fp)) && ch != '\n'){
+        str[len++]=(char)ch;
+        if(len==size){
+            str = realloc(str, sizeof(char)*(size+=16));
+            if(!str)return str;
+        }
+    }
+    str[len++]='\0';
+
+    return realloc(str, sizeof(char)*len);
+}
+
+
+char** inputChemins(FILE* fp, int* nbChemins) {
+
+    char **chemins = NULL, **agrandis, *saisie;
+
+    *nbChemins = 0;
+
+    // Une ligne vide (ou la fin de l'entrée) termine la liste
+    while(1) {
+        printf("> ");
+        saisie = inputString(fp, 16);
+        if(saisie == NULL || saisie[0] == '\0')
+            break;
+
+        agrandis = (char**) realloc(chemins, ((size_t) *nbChemins + 1) * sizeof(char*));
+        if(agrandis == NULL) {
+            free(saisie);
+            saisie = NULL;
+            break;
+        }
+        chemins = agrandis;
+        chemins[(*nbChemins)++] = saisie;
+    }
+
+    if(saisie == NULL) {
+        while(*nbChemins > 0)
+            free(chemins[--(*nbChemins)]);
+        free(chemins);
+        return NULL;
+    }
+    free(saisie);
+
+    // Un tableau vide est tout de même alloué pour distinguer une liste vide d'un manque de mémoire
+    if(chemins == NULL)
+        chemins = (char**) malloc(sizeof(char*));
+
+    return chemins;
+}
+
+
+
+
+
+
+
+
+
+
+unsigned char* stringToBinary(char* s, size_t *length) {
+    if(s == NULL) return 0; /* no input string */
+    size_t len = strlen(s);
+    unsigned char *binary = malloc(len*8 + 1); // each char is one byte (8 bits) and + 1 at the end for null terminator
+    binary[0] = '\0';
+    for(size_t i = 0; i < len; ++i) {
+        char ch = s[i];
+        for(int j = 7; j >= 0; --j){
+            if(ch & (1 << j)) {
+                strcat((char*)binary,"1");
+            } else {
+                strcat((char*)binary,"0");
+            }
+        }
+    }
+    *length = len*8;
+    return binary;
+}
+
+int* num_to_bit(long int a, long int *len){
+    long int arrayLen=0;
+    int *bits;
+    // Nombre de bits de a, sans dépasser la capacité d'un long
+    while(arrayLen < (long int) (sizeof(long int) * CHAR_BIT) - 1 && (a >> arrayLen) > 0)
+        arrayLen++;
+    *len=arrayLen;
+    bits=(int*)malloc((arrayLen > 0 ? arrayLen : 1)*sizeof(int));
+    if(bits == NULL)
+        return NULL;
+    arrayLen--;
+    while(a>0){
+        bits[arrayLen--]=a&1;
+        a>>=1;
+    }
+    return bits;
+}
+
+int decryptPrefix(const int *matriceImage, long int dimension, long int* prefixInt, long int* lengthDimensionPrefix) {
+    long int i,j;
+    int *prefixBinary, *dimMaxBinary;
+    //printf("Dimension: %zd", dimension);
+
+    if(dimension < 1)
+        return ERROR_INVARG;
+
+    dimMaxBinary = num_to_bit(dimension, lengthDimensionPrefix);
+    free(dimMaxBinary);
+
+
+    //printf("\nTaille en bits de la dimension max: %d", lengthDimensionPrefix);
+    /*printf("\nTaille en bits de la dimension max en binaire: ");
+    for(i = 0; i<lengthDimensionPrefix; i++) {
+        printf("%d", dimMaxBinary[i]);
+    }*/
+
+    prefixBinary = (int*) malloc((*lengthDimensionPrefix) * sizeof(int));
+    if(prefixBinary == NULL)
+        return ERROR_NOMEM;
+    for(i=0; i<(*lengthDimensionPrefix); i++) {
+        prefixBinary[i] = (matriceImage[i] & ( 1 << 0)) >> 0;
+    }
+
+    /*printf("\nBits du prefixe (%d premiers bits): ", lengthDimensionPrefix);
+    for(i=0; i<lengthDimensionPrefix; i++) {
+        printf("%d", prefixBinary[i]);
+    }*/
+    (*prefixInt) = 0;
+    j=0;
+    for(i=(*lengthDimensionPrefix)-1; i>=0; i--) {
+        (*prefixInt) += (long int) prefixBinary[j] << i;
+        j +=1;
+    }
+    free(prefixBinary);
+    return ERROR_OK;
+}
+
+int decryptMessageHamming(const int *matriceImage, long int dimension, long int prefixInt, long int lengthDimensionPrefix, unsigned int rows, unsigned int columns, long int *tailleMsgDecrypt, unsigned char **messageSecretBitOutput) {
+
+
+
+    if(columns>2 && rows>1) {
+
+        unsigned int **matriceHamming, j, k, o, i, **matriceResMul = NULL, **matriceResAdd = NULL, position, randomNumber;
+        unsigned int **bufferImage, **bufferMsg;
+
+
+        genererHamming(&matriceHamming, rows, columns);
+
+
+
+        bufferImage = (unsigned int **) malloc(sizeof(unsigned int) * 1);
+        if (bufferImage == NULL)
+            return ERROR_NOMEM;
+
+        for (i = 0; i < 1; i++) {
+            bufferImage[i] = (unsigned int *) malloc(sizeof(unsigned int) * columns);
+            if (bufferImage[i] == NULL)
+                return ERROR_NOMEM;
+        }
+
+        matriceResMul = NULL;
+
+        (*messageSecretBitOutput) = malloc(sizeof(unsigned int) * (prefixInt - lengthDimensionPrefix));
+        if ((*messageSecretBitOutput) == NULL)
+            return ERROR_NOMEM;
+
+        for (i = 0; i < dimension / columns; i++) {
+            for (j = 0; j < columns; j++) {
+
+                // On crée une matrice bufferImage qui va contenir columns fois le nombre de bits de la matrice image (pour la séparé en séquence)
+                if (j + (i + (i * (columns - 1))) < dimension)
+                    (*bufferImage)[j] = matriceImage[lengthDimensionPrefix + j + (i + (i * (columns - 1)))];
+                else
+                    (*bufferImage)[j] = 1;
+
+            }
+
+            // On crée la matrice en mémoire qui va accueillir le résultat de la multiplication
+            if (matriceResMul != NULL)
+                free(matriceResMul);
+
+            matriceResMul = (unsigned int **) malloc(sizeof(unsigned int) * 1);
+            if (matriceResMul == NULL)
+                return ERROR_NOMEM;
+
+            for (k = 0; k < 1; k++) {
+                matriceResMul[k] = (unsigned int *) malloc(sizeof(unsigned int) * rows);
+                if (matriceResMul[k] == NULL)
+                    return ERROR_NOMEM;
+            }
+
+            // On effectue la multiplication (Pas besoin de passer toutes les dimensions de la matrice 1 car n1=m1
+            multiplyMatrice(rows, matriceHamming, 1, columns, bufferImage, &matriceResMul);
+
+            for (o = 0; o < rows; o++) {
+
+                if (o + (i + (i * (rows - 1))) < (prefixInt - lengthDimensionPrefix)) {
+                    (*messageSecretBitOutput)[o + (i + (i * (rows - 1)))] = (*matriceResMul)[o];
+
+                }
+
+            }
+
+
+        }
+
+        (*tailleMsgDecrypt) = prefixInt - lengthDimensionPrefix;
+
+        for(i = 0; i < 1; i++) {
+            free(bufferImage[i]);
+        }
+        free(bufferImage);
+
+
+        for(k = 0; k < 1; k++) {
+            free(matriceResMul[k]);
+        }
+        free(matriceResMul);
+
+
+        for (i = 0; i < columns; i++) {
+            free(matriceHamming[i]);
+        }
+
+        free(matriceHamming);
+
+
+        return ERROR_OK;
+    } else {
+        return ERROR_INVARG;
+    }
+}
+
+int decryptMessage(const int *matriceImage, long int dimension, long int prefixInt, long int lengthDimensionPrefix,int crypt, char* keyCript, long int *tailleMsgDecrypt, unsigned char **messageSecretBitOutput) {
+
+    int i,j,error;
+    int *tablepermuteIndex = NULL;
+    //printf("\nPosition du message: %d", prefixInt);
+
+    //printf("\nBits du message: ");
+    *messageSecretBitOutput = (unsigned char *) malloc(prefixInt * sizeof(unsigned char));
+    if(messageSecretBitOutput == NULL)
+        return ERROR_NOMEM;
+
+    if(crypt == 1) {
+
+        error = genererTableParcours(keyCript, dimension, lengthDimensionPrefix, &tablepermuteIndex);
+        if(error != ERROR_OK)
+            return error;
+
+    }
+
+j=0;
+    for(i=lengthDimensionPrefix; i<prefixInt; i++) {
+        if(crypt == 0)
+            (*messageSecretBitOutput)[j] = (matriceImage[i] & ( 1 << 0)) >> 0;
+        else
+            (*messageSecretBitOutput)[j] = (matriceImage[tablepermuteIndex[i]] & (1 << 0)) >> 0;
+
+        j += 1;
+    }
+
+    *tailleMsgDecrypt = prefixInt - lengthDimensionPrefix;
+
+    if(crypt == 1)
+        free(tablepermuteIndex);
+
+    return ERROR_OK;
+}
+
+
+int genererTableParcours(char* keyCrypt, long int dimension, int lengthDimensionPrefix, int** tablePermuteIndex) {
+
+    long int i, j;
+    int temp;
+
+    (*tablePermuteIndex) = (int*) malloc(sizeof(int) * dimension);
+    if((*tablePermuteIndex) == NULL)
+        return ERROR_NOMEM;
+
+    for(i = 0; i<dimension; i++) {
+        (*tablePermuteIndex)[i] = (int) i;
+    }
+
+    srand(hash((unsigned char *) keyCrypt));
+    for (i = dimension - 1; i > lengthDimensionPrefix; --i) {
+        // On tire une position dans [lengthDimensionPrefix, i] pour ne jamais sortir du tableau ni toucher au prefixe
+        j = lengthDimensionPrefix + ( rand() % (i - lengthDimensionPrefix + 1));// NOLINT(cert-msc30-c, cert-msc50-cpp)
+
+        temp = (*tablePermuteIndex)[i];
+        (*tablePermuteIndex)[i] = (*tablePermuteIndex)[j];
+        (*tablePermuteIndex)[j] = temp;
+    }
+
+    return ERROR_OK;
+}
+
+
+int genererTableDepermutation(char* key, int tailleTable, int** tableIndex) {
+
+    int *tablepermutation, i, temp;
+
+    (*tableIndex) = (int *) malloc(sizeof(int) * tailleTable);
+    tablepermutation = (int *) malloc(sizeof(int) * tailleTable);
+    if((*tableIndex) == NULL || tablepermutation == NULL) {
+        freeAllVar(*tableIndex, tablepermutation, NULL, NULL, NULL, NULL, NULL);
+        return ERROR_NOMEM;
+    }
+
+    // Même tirage que depermuterTableau
+    srand(hash((unsigned char *) key));
+    for (i = tailleTable - 1; i >= 0; --i) {
+        tablepermutation[i] = rand() % (i + 1);// NOLINT(cert-msc30-c, cert-msc50-cpp)
+    }
+
+    // On applique les échanges sur les indices plutôt que sur les bits
+    for (i = 0; i < tailleTable; i++) {
+        (*tableIndex)[i] = i;
+    }
+    for (i = 0; i < tailleTable; i++) {
+        temp = (*tableIndex)[i];
+        (*tableIndex)[i] = (*tableIndex)[tablepermutation[i]];
+        (*tableIndex)[tablepermutation[i]] = temp;
+    }
+
+    free(tablepermutation);
+
+    return ERROR_OK;
+}
+
+
+// Fonction de mélange de splitmix64, utilisée comme fonction de tour du réseau de Feistel
+static unsigned long long melangerBits(unsigned long long x) {
+
+    x ^= x >> 30u;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27u;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31u;
+
+    return x;
+}
+
+
+void initParcoursCalculable(parcoursCalculable_t* parcours, char* keyCrypt, long int dimension, int lengthDimensionPrefix) {
+
+    unsigned int nbBits = 0, i;
+    unsigned long long graine;
+
+    parcours->debut = lengthDimensionPrefix;
+    parcours->taille = dimension - lengthDimensionPrefix;
+
+    // On cherche le plus petit nombre pair de bits qui couvre toutes les positions
+    while(nbBits < 62 && (1ULL << nbBits) < (unsigned long long) parcours->taille) {
+        nbBits++;
+    }
+    parcours->demiBits = (nbBits + 1) / 2;
+    if(parcours->demiBits == 0)
+        parcours->demiBits = 1;
+    parcours->masque = (1ULL << parcours->demiBits) - 1;
+
+    graine = hash((unsigned char *) keyCrypt);
+    for(i = 0; i < NB_TOURS_FEISTEL; i++) {
+        graine += 0x9e3779b97f4a7c15ULL;
+        parcours->clesTour[i] = melangerBits(graine);
+    }
+}
+
+
+long int positionParcoursCalculable(const parcoursCalculable_t* parcours, long int index) {
+
+    unsigned long long x = (unsigned long long) index, gauche, droite, temp;
+    unsigned int i;
+
+    if(parcours->taille <= 1)
+        return parcours->debut + index;
+
+    // Le domaine du réseau de Feistel est au plus 4 fois plus grand que le parcours: on re-chiffre jusqu'à retomber dedans
+    do {
+        gauche = x >> parcours->demiBits;
+        droite = x & parcours->masque;
+        for(i = 0; i < NB_TOURS_FEISTEL; i++) {
+            temp = droite;
+            droite = gauche ^ (melangerBits(droite ^ parcours->clesTour[i]) & parcours->masque);
+            gauche = temp;
+        }
+        x = (gauche << parcours->demiBits) | droite;
+    } while(x >= (unsigned long long) parcours->taille);
+
+    return parcours->debut + (long int) x;
+}
+
+
+void sourceMemoire(sourceImage_t* source, const int* matriceImage, long int dimension) {
+
+    source->matriceImage = matriceImage;
+    source->descripteur = -1;
+    source->beginningImage = 0;
+    source->dimension = dimension;
+    source->pages = NULL;
+    source->octetsLus = 0;
+    source->masqueCanaux = 0;
+    source->nbCanauxVue = 0;
+    source->largeurLigne = 0;
+    source->nbCanaux = 1;
+    source->matriceAllouee = NULL;
+    source->octetsImage = NULL;
+    source->pasLigne = 0;
+    source->octetsEchantillon = 1;
+}
+
+
+int ouvrirSourceImage(sourceImage_t* source, char* pathFile, long int beginningImage, long int dimension) {
+
+    int i;
+
+    source->matriceImage = NULL;
+    source->beginningImage = beginningImage;
+    source->dimension = dimension;
+    source->octetsLus = 0;
+    source->masqueCanaux = 0;
+    source->nbCanauxVue = 0;
+    source->largeurLigne = 0;
+    source->nbCanaux = 1;
+    source->matriceAllouee = NULL;
+    source->octetsImage = NULL;
+    source->pasLigne = 0;
+    source->octetsEchantillon = 1;
+
+    source->pages = (unsigned char*) malloc(NB_PAGES_CACHE * TAILLE_PAGE_CACHE);
+    if(source->pages == NULL)
+        return ERROR_NOMEM;
+
+    for(i = 0; i < NB_PAGES_CACHE; i++) {
+        source->numeroPage[i] = -1;
+    }
+
+    source->descripteur = open(pathFile, O_RDONLY);
+    if(source->descripteur < 0) {
+        free(source->pages);
+        source->pages = NULL;
+        return ERROR_OPEN;
+    }
+
+    return ERROR_OK;
+}
+
+
+int ouvrirSourceFormat(sourceImage_t* source, char* pathFile, const char* typeFile, long int imageWidth, long int profondeur, long int pixelIntensity, long int beginningImage, long int dimension) {
+
+    unsigned char* octets;
+    int* matrice;
+    int error;
+
+    if(!estFormatASCII(typeFile) && strcmp(typeFile, "PNG") != 0) {
+        error = ouvrirSourceImage(source, pathFile, beginningImage, dimension);
+        geometrieSource(source, imageWidth, (int) profondeur);
+        // Lignes complétées par des octets de bourrage (BMP): lireEchantillon les saute
+        if(pasLigneFormat(typeFile, imageWidth, profondeur) != source->largeurLigne)
+            source->pasLigne = pasLigneFormat(typeFile, imageWidth, profondeur);
+        // Échantillons de plusieurs octets (WAV 16 ou 24 bits): lireEchantillon les réassemble
+        source->octetsEchantillon = octetsEchantillonFormat(typeFile, pixelIntensity);
+        return error;
+    }
+
+    // Les positions d'un P2/P3 ou d'un PNG ne correspondent pas à des octets du fichier: l'image est décodée en mémoire
+    if(strcmp(typeFile, "PNG") == 0) {
+        // Un PNG 8 bits est décodé entièrement, à raison d'un octet par échantillon
+        octets = (unsigned char*) malloc((size_t) dimension);
+        if(octets == NULL)
+            return ERROR_NOMEM;
+        error = readImagePNGOctets(pathFile, octets, imageWidth, dimension / (imageWidth * profondeur), profondeur);
+        if(error != ERROR_OK) {
+            free(octets);
+            return error;
+        }
+        sourceMemoire(source, NULL, dimension);
+        geometrieSource(source, imageWidth, (int) profondeur);
+        source->octetsImage = octets;
+        return ERROR_OK;
+    }
+
+    matrice = (int*) malloc((size_t) dimension * sizeof(int));
+    if(matrice == NULL)
+        return ERROR_NOMEM;
+
+    error = readImageASCII(pathFile, matrice, beginningImage, dimension, pixelIntensity);
+    if(error != ERROR_OK) {
+        free(matrice);
+        return error;
+    }
+
+    sourceMemoire(source, matrice, dimension);
+    geometrieSource(source, imageWidth, (int) profondeur);
+    source->matriceAllouee = matrice;
+
+    return ERROR_OK;
+}
+
+
+/* Octet decalage du fichier (parmi etendue octets), lu à travers le cache de pages */
+static unsigned char octetSource(sourceImage_t* source, long int decalage, long int etendue) {
+
+    long int page, debutPage, taillePage;
+    ssize_t lus;
+    int emplacement;
+
+    page = decalage / TAILLE_PAGE_CACHE;
+    emplacement = (int) (page % NB_PAGES_CACHE);
+
+    // La page n'est pas en cache: on ne lit que cette page dans le fichier
+    if(source->numeroPage[emplacement] != page) {
+
+        debutPage = page * TAILLE_PAGE_CACHE;
+        taillePage = etendue - debutPage;
+        if(taillePage > TAILLE_PAGE_CACHE)
+            taillePage = TAILLE_PAGE_CACHE;
+
+        lus = pread(source->descripteur, source->pages + (long int) emplacement * TAILLE_PAGE_CACHE, (size_t) taillePage, (off_t) (source->beginningImage + debutPage));
+        if(lus < 0)
+            lus = 0;
+        if(lus < taillePage) // Fichier tronqué: on complète avec des zéros
+            memset(source->pages + (long int) emplacement * TAILLE_PAGE_CACHE + lus, 0, (size_t) (taillePage - lus));
+
+        source->octetsLus += lus;
+        source->numeroPage[emplacement] = page;
+    }
+
+    return source->pages[(long int) emplacement * TAILLE_PAGE_CACHE + decalage % TAILLE_PAGE_CACHE];
+}
+
+int lireEchantillon(sourceImage_t* source, long int position) {
+
+    long int etendue;
+    unsigned int valeur = 0;
+    int i;
+
+    // Vue des canaux: l'échantillon position est dans le pixel position / nbCanauxVue (sans division quand nbCanauxVue vaut 1 ou 2)
+    if(source->nbCanauxVue == 1)
+        position = position * source->nbCanaux + source->canauxVue[0];
+    else if(source->nbCanauxVue == 2)
+        position = (position >> 1) * source->nbCanaux + source->canauxVue[position & 1];
+    else if(source->nbCanauxVue > 2)
+        position = (position / source->nbCanauxVue) * source->nbCanaux + source->canauxVue[position % source->nbCanauxVue];
+
+    if(source->matriceImage != NULL)
+        return source->matriceImage[position];
+    if(source->octetsImage != NULL)
+        return source->octetsImage[position];
+
+    // Lignes complétées (BMP): la position est convertie en décalage dans le fichier, le cache porte sur les octets du fichier
+    etendue = source->dimension;
+    if(source->pasLigne != 0) {
+        position = (position / source->largeurLigne) * source->pasLigne + position % source->largeurLigne;
+        etendue = (source->dimension / source->largeurLigne) * source->pasLigne;
+    }
+
+    if(source->octetsEchantillon <= 1)
+        return octetSource(source, position, etendue);
+
+    // Échantillon little-endian de plusieurs octets (WAV), rendu en binaire décalé comme par readImageWAV
+    for(i = source->octetsEchantillon - 1; i >= 0; i--)
+        valeur = (valeur << 8) | octetSource(source, position * source->octetsEchantillon + i, etendue * source->octetsEchantillon);
+
+    return (int) (valeur ^ (1u << (8 * source->octetsEchantillon - 1)));
+}
+
+
+void fermerSourceImage(sourceImage_t* source) {
+
+    if(source->descripteur >= 0)
+        close(source->descripteur);
+
+    if(source->pages != NULL)
+        free(source->pages);
+
+    if(source->matriceAllouee != NULL)
+        free(source->matriceAllouee);
+
+    if(source->octetsImage != NULL)
+        free(source->octetsImage);
+
+    source->descripteur = -1;
+    source->pages = NULL;
+    source->matriceAllouee = NULL;
+    source->octetsImage = NULL;
+}
+
+
+int decryptPrefixSource(sourceImage_t* source, long int* prefixInt, long int* lengthDimensionPrefix) {
+
+    long int i;
+    int *dimMaxBinary;
+
+    if(source->dimension < 1)
+        return ERROR_INVARG;
+
+    dimMaxBinary = num_to_bit(source->dimension, lengthDimensionPrefix);
+    if(dimMaxBinary != NULL)
+        free(dimMaxBinary);
+
+    if((*lengthDimensionPrefix) > source->dimension)
+        return ERROR_INVARG;
+
+    (*prefixInt) = 0;
+    for(i = 0; i < (*lengthDimensionPrefix); i++) {
+        (*prefixInt) = ((*prefixInt) << 1) | (lireEchantillon(source, i) & 1);
+    }
+
+    return ERROR_OK;
+}
+
+
+int initLecteurBits(lecteurBits_t* lecteur, sourceImage_t* source, int lengthDimensionPrefix, int mode, char* keyCrypt, unsigned int rows, unsigned int columns) {
+
+    long int dimension = positionVueCanaux(source->dimension, source->masqueCanaux, source->nbCanaux), debut = positionVueCanaux(lengthDimensionPrefix, source->masqueCanaux, source->nbCanaux), nbColonnes;
+    int error;
+
+    lecteur->source = source;
+    lecteur->dimension = dimension;
+    lecteur->debut = debut;
+    lecteur->mode = mode;
+    lecteur->tablePermuteIndex = NULL;
+    lecteur->rows = rows;
+    lecteur->columns = columns;
+    lecteur->nbBlocsGrands = 0;
+    lecteur->blocCache = -1;
+    lecteur->syndromeCache = 0;
+    lecteur->bitsCycle = 0;
+    lecteur->tableTernaire = NULL;
+    lecteur->groupeCache = -1;
+
+    switch(mode) {
+        case MODE_CLASSIQUE:
+            return ERROR_OK;
+        case MODE_CHIFFRE:
+            if(keyCrypt == NULL)
+                return ERROR_INVARG;
+            return genererTableParcours(keyCrypt, dimension, (int) debut, &lecteur->tablePermuteIndex);
+        case MODE_HAMMING:
+            if(rows & HAMMING_SEGMENTE) {
+                // columns contient la taille du flux en bits: on retrouve le découpage de l'encodeur
+                error = determineSegmentsHamming(dimension - debut, (long int) columns, &lecteur->rows, &lecteur->nbBlocsGrands);
+                if(error != ERROR_OK || lecteur->rows != (rows & ~HAMMING_SEGMENTE))
+                    return ERROR_FORMAT;
+                lecteur->columns = (1u << lecteur->rows) - 1;
+                return ERROR_OK;
+            }
+            if(columns <= 2 || rows <= 1)
+                return ERROR_INVARG;
+            return ERROR_OK;
+        case MODE_ADAPTATIF:
+            // La sélection est refaite sur l'image: le message est ensuite lu dans la table comme dans une image de nbColonnes pixels
+            error = calculerCoutsAdaptatifs(source, debut, rows & ~HAMMING_SEGMENTE, &lecteur->tablePermuteIndex, &nbColonnes, NULL);
+            if(error != ERROR_OK)
+                return error;
+            if((long int) columns > nbColonnes)
+                return ERROR_FORMAT;
+            lecteur->debut = 0;
+            lecteur->dimension = nbColonnes;
+            lecteur->columns = 0;
+            if(rows & HAMMING_SEGMENTE) {
+                error = determineSegmentsHamming(nbColonnes, (long int) columns, &lecteur->rows, &lecteur->nbBlocsGrands);
+                lecteur->columns = (1u << lecteur->rows) - 1;
+            }
+            return error;
+        case MODE_HAMMING_CHIFFRE:
+            if(keyCrypt == NULL)
+                return ERROR_INVARG;
+            error = determineSegmentsHamming(dimension - debut, (long int) columns, &lecteur->rows, &lecteur->nbBlocsGrands);
+            if(error != ERROR_OK || lecteur->rows != rows)
+                return ERROR_FORMAT;
+            lecteur->columns = (1u << lecteur->rows) - 1;
+            initParcoursCalculable(&lecteur->parcours, keyCrypt, dimension, (int) debut);
+            return ERROR_OK;
+        case MODE_CHIFFRE_CALCULABLE:
+            if(keyCrypt == NULL)
+                return ERROR_INVARG;
+            initParcoursCalculable(&lecteur->parcours, keyCrypt, dimension, (int) debut);
+            return ERROR_OK;
+        case MODE_KLSB:
+            decoderBitsParCanal((unsigned char) rows, lecteur->bitsParCanal);
+            lecteur->bitsCycle = lecteur->bitsParCanal[0] + lecteur->bitsParCanal[1] + lecteur->bitsParCanal[2];
+            return ERROR_OK;
+        case MODE_LSBMR:
+            return ERROR_OK;
+        case MODE_TERNAIRE:
+            error = genererTableTernaire((int) rows, &lecteur->tableTernaire, &nbColonnes);
+            lecteur->columns = (unsigned int) nbColonnes;
+            return error;
+        case MODE_STC:
+            if(rows < HAUTEUR_STC_MIN || rows > HAUTEUR_STC_MAX || (long int) columns > dimension - debut)
+                return ERROR_INVARG;
+            return ERROR_OK;
+        default:
+            return ERROR_HANDLE;
+    }
+}
+
+
+unsigned int lireBitExtrait(lecteurBits_t* lecteur, long int position) {
+
+    long int bloc, base, p, limite, rang;
+    unsigned int j, syndrome, nbColonnes;
+
+    switch(lecteur->mode) {
+        case MODE_CHIFFRE:
+            return (unsigned int) lireEchantillon(lecteur->source, lecteur->tablePermuteIndex[lecteur->debut + position]) & 1u;
+        case MODE_CHIFFRE_CALCULABLE:
+            return (unsigned int) lireEchantillon(lecteur->source, positionParcoursCalculable(&lecteur->parcours, position)) & 1u;
+        case MODE_ADAPTATIF:
+            if(lecteur->columns == 0)
+                return (unsigned int) lireEchantillon(lecteur->source, lecteur->tablePermuteIndex[position]) & 1u;
+            // fall through
+        case MODE_HAMMING:
+        case MODE_HAMMING_CHIFFRE:
+            // Les nbBlocsGrands premiers blocs ont rows + 1 lignes et 2 * columns + 1 colonnes, les suivants rows lignes et columns colonnes
+            limite = lecteur->nbBlocsGrands * (lecteur->rows + 1);
+            if(position < limite) {
+                bloc = position / (lecteur->rows + 1);
+                rang = position % (lecteur->rows + 1);
+                nbColonnes = 2 * lecteur->columns + 1;
+                base = lecteur->debut + bloc * nbColonnes;
+            } else {
+                bloc = lecteur->nbBlocsGrands + (position - limite) / lecteur->rows;
+                rang = (position - limite) % lecteur->rows;
+                nbColonnes = lecteur->columns;
+                base = lecteur->debut + lecteur->nbBlocsGrands * (2 * lecteur->columns + 1) + (bloc - lecteur->nbBlocsGrands) * nbColonnes;
+            }
+            if(bloc != lecteur->blocCache) {
+                // Syndrome = XOR des numéros de colonnes dont le LSB vaut 1 (la colonne j de la matrice de Hamming est j+1 en binaire)
+                syndrome = 0;
+                for(j = 0; j < nbColonnes; j++) {
+                    p = base + j;
+                    if(p >= lecteur->dimension) {
+                        syndrome ^= (j + 1);
+                        continue;
+                    }
+                    if(lecteur->mode == MODE_HAMMING_CHIFFRE)
+                        p = positionParcoursCalculable(&lecteur->parcours, p - lecteur->debut);
+                    else if(lecteur->mode == MODE_ADAPTATIF)
+                        p = lecteur->tablePermuteIndex[p];
+                    syndrome ^= (j + 1) & (0u - ((unsigned int) lireEchantillon(lecteur->source, p) & 1u));
+                }
+                lecteur->blocCache = bloc;
+                lecteur->syndromeCache = syndrome;
+            }
+            return (lecteur->syndromeCache >> rang) & 1u;
+        case MODE_KLSB:
+            // 3 pixels consécutifs contiennent toujours bitsCycle bits: on saute directement au bon groupe
+            p = lecteur->debut + (position / lecteur->bitsCycle) * 3;
+            base = position % lecteur->bitsCycle;
+            while(base >= lecteur->bitsParCanal[p % 3]) {
+                base -= lecteur->bitsParCanal[p % 3];
+                p++;
+            }
+            return ((unsigned int) lireEchantillon(lecteur->source, p) >> (lecteur->bitsParCanal[p % 3] - 1 - base)) & 1u;
+        case MODE_STC:
+            return lireBitSTC(lecteur, position);
+        case MODE_TERNAIRE:
+            return lireBitTernaire(lecteur, position);
+        case MODE_LSBMR:
+            // Bit pair: LSB de x1, bit impair: LSB de x1 / 2 + x2
+            p = lecteur->debut + (position & ~1L);
+            if(!(position & 1))
+                return (unsigned int) lireEchantillon(lecteur->source, p) & 1u;
+            if(p + 1 >= lecteur->dimension)
+                return 0;
+            return (unsigned int) ((lireEchantillon(lecteur->source, p) >> 1) + lireEchantillon(lecteur->source, p + 1)) & 1u;
+        default:
+            return (unsigned int) lireEchantillon(lecteur->source, lecteur->debut + position) & 1u;
+    }
+}
+
+
+unsigned char lireOctetExtrait(lecteurBits_t* lecteur, long int indexOctet) {
+
+    unsigned int octet = 0, k;
+
+    for(k = 0; k < 8; k++) {
+        octet = (octet << 1u) | lireBitExtrait(lecteur, indexOctet * 8 + k);
+    }
+
+    return (unsigned char) octet;
+}
+
+
+int plageEchantillonsBits(const lecteurBits_t* lecteur, long int premierBit, long int nbBits, long int* debut, long int* fin) {
+
+    long int limite, dernier, bloc;
+
+    if(nbBits <= 0) {
+        *debut = *fin = lecteur->debut;
+        return ERROR_OK;
+    }
+    dernier = premierBit + nbBits - 1;
+
+    switch(lecteur->mode) {
+        case MODE_CLASSIQUE:
+            *debut = lecteur->debut + premierBit;
+            *fin = lecteur->debut + dernier + 1;
+            return ERROR_OK;
+        case MODE_LSBMR:
+            // Un bit impair dépend aussi du pixel suivant
+            *debut = lecteur->debut + (premierBit & ~1L);
+            *fin = lecteur->debut + (dernier & ~1L) + 2;
+            return ERROR_OK;
+        case MODE_KLSB:
+            // 3 pixels consécutifs contiennent bitsCycle bits
+            *debut = lecteur->debut + (premierBit / lecteur->bitsCycle) * 3;
+            *fin = lecteur->debut + (dernier / lecteur->bitsCycle + 1) * 3;
+            return ERROR_OK;
+        case MODE_HAMMING:
+            // Blocs de 2 * columns + 1 pixels pour les nbBlocsGrands premiers, puis de columns pixels
+            limite = lecteur->nbBlocsGrands * (lecteur->rows + 1);
+            if(premierBit < limite) {
+                bloc = premierBit / (lecteur->rows + 1);
+                *debut = lecteur->debut + bloc * (2 * (long int) lecteur->columns + 1);
+            } else {
+                bloc = (premierBit - limite) / lecteur->rows;
+                *debut = lecteur->debut + lecteur->nbBlocsGrands * (2 * (long int) lecteur->columns + 1) + bloc * (long int) lecteur->columns;
+            }
+            if(dernier < limite) {
+                bloc = dernier / (lecteur->rows + 1);
+                *fin = lecteur->debut + (bloc + 1) * (2 * (long int) lecteur->columns + 1);
+            } else {
+                bloc = (dernier - limite) / lecteur->rows;
+                *fin = lecteur->debut + lecteur->nbBlocsGrands * (2 * (long int) lecteur->columns + 1) + (bloc + 1) * (long int) lecteur->columns;
+            }
+            if(*fin > lecteur->dimension)
+                *fin = lecteur->dimension;
+            return ERROR_OK;
+        default:
+            // Parcours pseudo aléatoire, sélection adaptative ou codes par blocs dépendant des bits précédents: pas de plage contiguë
+            return ERROR_INVARG;
+    }
+}
+
+
+void libererLecteurBits(lecteurBits_t* lecteur) {
+
+    if(lecteur->tablePermuteIndex != NULL)
+        free(lecteur->tablePermuteIndex);
+
+    if(lecteur->tableTernaire != NULL)
+        free(lecteur->tableTernaire);
+
+    lecteur->tablePermuteIndex = NULL;
+    lecteur->tableTernaire = NULL;
+}
+
+
+void ouvrirFluxSortie(fluxSortie_t* flux, FILE* fichier, long int octetsUtiles) {
+
+    flux->fichier = fichier;
+    flux->remplissage = 0;
+    flux->octetCourant = 0;
+    flux->nbBitsCourant = 0;
+    flux->octetsRestants = octetsUtiles;
+    flux->crcAttendus = NULL;
+    flux->tailleBloc = 0;
+    flux->remplissageBloc = 0;
+    flux->blocCourant = 0;
+}
+
+
+void verifierFluxSortie(fluxSortie_t* flux, const unsigned int* crcAttendus, long int tailleBloc) {
+
+    flux->crcAttendus = crcAttendus;
+    flux->tailleBloc = tailleBloc;
+    flux->remplissageBloc = 0;
+    flux->blocCourant = 0;
+}
+
+
+int ecrireBitFlux(fluxSortie_t* flux, unsigned int bit) {
+
+    flux->octetCourant = (flux->octetCourant << 1u) | (bit & 1u);
+    flux->nbBitsCourant++;
+
+    if(flux->nbBitsCourant == 8) {
+
+        if(flux->octetsRestants > 0) {
+            flux->tampon[flux->remplissage++] = (unsigned char) flux->octetCourant;
+            flux->octetsRestants--;
+
+            // Le bloc est vérifié dès qu'il est complet, avant d'être écrit (il est toujours contigu dans le tampon)
+            if(flux->crcAttendus != NULL && ++flux->remplissageBloc == flux->tailleBloc) {
+                if(crc32c(flux->tampon + flux->remplissage - flux->tailleBloc, (size_t) flux->tailleBloc) != flux->crcAttendus[flux->blocCourant])
+                    return ERROR_CHECKSUM;
+                flux->blocCourant++;
+                flux->remplissageBloc = 0;
+            }
+
+            if(flux->remplissage == TAILLE_TAMPON_FLUX) {
+                if(fwrite(flux->tampon, 1, flux->remplissage, flux->fichier) != flux->remplissage)
+                    return ERROR_OPEN;
+                flux->remplissage = 0;
+            }
+        }
+
+        flux->octetCourant = 0;
+        flux->nbBitsCourant = 0;
+    }
+
+    return ERROR_OK;
+}
+
+
+int fermerFluxSortie(fluxSortie_t* flux) {
+
+    // Dernier bloc, plus court que les autres
+    if(flux->crcAttendus != NULL && flux->remplissageBloc > 0) {
+        if(crc32c(flux->tampon + flux->remplissage - flux->remplissageBloc, (size_t) flux->remplissageBloc) != flux->crcAttendus[flux->blocCourant])
+            return ERROR_CHECKSUM;
+        flux->blocCourant++;
+        flux->remplissageBloc = 0;
+    }
+
+    if(flux->remplissage > 0) {
+        if(fwrite(flux->tampon, 1, flux->remplissage, flux->fichier) != flux->remplissage)
+            return ERROR_OPEN;
+        flux->remplissage = 0;
+    }
+
+    fflush(flux->fichier);
+
+    return ERROR_OK;
+}
+
+
+int decryptMessageVersFichier(lecteurBits_t* lecteur, const int* tableIndex, long int debutOctet, FILE* fichier, long int octetsUtiles, const unsigned int* crcAttendus, long int tailleBloc) {
+
+    long int k;
+    int error;
+    fluxSortie_t *flux;
+
+    flux = (fluxSortie_t*) malloc(sizeof(fluxSortie_t));
+    if(flux == NULL)
+        return ERROR_NOMEM;
+    ouvrirFluxSortie(flux, fichier, octetsUtiles);
+    if(crcAttendus != NULL)
+        verifierFluxSortie(flux, crcAttendus, tailleBloc);
+
+    // Une seule passe: lecture du LSB, regroupement en octet, vérification du bloc, écriture
+    error = ERROR_OK;
+    for(k = debutOctet * 8; k < (debutOctet + octetsUtiles) * 8 && error == ERROR_OK; k++) {
+        error = ecrireBitFlux(flux, lireBitExtrait(lecteur, tableIndex != NULL ? tableIndex[k] : k));
+    }
+
+    if(error == ERROR_OK)
+        error = fermerFluxSortie(flux);
+
+    free(flux);
+
+    return error;
+}
+
+
+int decryptMessageStream(lecteurBits_t* lecteur, long int tailleMsgBit, char* keyPermutation, int estFichier, char** fileOutput) {
+
+    long int k, octetsUtiles;
+    int *tableIndex = NULL, error, y;
+    unsigned int octet;
+    char extension[TAILLE_SUFFIXE_EXTENSION + 2];
+    FILE *fichier;
+
+    if(tailleMsgBit < 0 || tailleMsgBit > INT_MAX)
+        return ERROR_INVARG;
+
+    // Si le message a été permuté, on calcule où se trouve chaque bit dans le message permuté (un int par bit, au lieu de 3 tableaux)
+    if(keyPermutation != NULL) {
+        error = genererTableDepermutation(keyPermutation, (int) tailleMsgBit, &tableIndex);
+        if(error != ERROR_OK)
+            return error;
+    }
+
+    if(estFichier) {
+
+        if(tailleMsgBit < TAILLE_SUFFIXE_EXTENSION * 8) {
+            freeAllVar(tableIndex, NULL, NULL, NULL, NULL, NULL, NULL);
+            return ERROR_INVARG;
+        }
+
+        // On lit d'abord le suffixe (les 40 derniers bits) pour connaitre l'extension du fichier à créer
+        extension[0] = '.';
+        for(y = 0; y < TAILLE_SUFFIXE_EXTENSION; y++) {
+            octet = 0;
+            for(k = 0; k < 8; k++) {
+                long int position = tailleMsgBit - TAILLE_SUFFIXE_EXTENSION * 8 + y * 8 + k;
+                octet = (octet << 1u) | lireBitExtrait(lecteur, tableIndex != NULL ? tableIndex[position] : position);
+            }
+            extension[y + 1] = (char) octet;
+        }
+        extension[TAILLE_SUFFIXE_EXTENSION + 1] = '\0';
+
+        error = addExtension(fileOutput, extension);
+        if(error != ERROR_OK) {
+            freeAllVar(tableIndex, NULL, NULL, NULL, NULL, NULL, NULL);
+            return error;
+        }
+
+        fichier = fopen(*fileOutput, "wb");
+        if(fichier == NULL) {
+            freeAllVar(tableIndex, NULL, NULL, NULL, NULL, NULL, NULL);
+            return ERROR_OPEN;
+        }
+
+        octetsUtiles = tailleMsgBit / 8 - TAILLE_SUFFIXE_EXTENSION;
+    } else {
+        fichier = stdout;
+        octetsUtiles = tailleMsgBit / 8;
+    }
+
+    error = decryptMessageVersFichier(lecteur, tableIndex, 0, fichier, octetsUtiles, NULL, 0);
+
+    if(estFichier)
+        fclose(fichier);
+
+    freeAllVar(tableIndex, NULL, NULL, NULL, NULL, NULL, NULL);
+
+    return error;
+}
+
+
+int serialiserEnteteConteneur(const enteteConteneur_t* entete, unsigned char* octets, int* taille) {
+
+    size_t longueurNom = strlen(entete->nom);
+
+    if(longueurNom > TAILLE_NOM_CONTENEUR || entete->longueurCharge > 0xFFFFFFFFUL)
+        return ERROR_INVARG;
+
+    memcpy(octets, MAGIC_CONTENEUR, 3);
+    octets[3] = entete->version;
+    octets[4] = entete->mode;
+    octets[5] = entete->parametre;
+    octets[6] = entete->permutation;
+    octets[7] = (unsigned char) (entete->flags >> 8u);
+    octets[8] = (unsigned char) entete->flags;
+    octets[9] = (unsigned char) (entete->longueurCharge >> 24u);
+    octets[10] = (unsigned char) (entete->longueurCharge >> 16u);
+    octets[11] = (unsigned char) (entete->longueurCharge >> 8u);
+    octets[12] = (unsigned char) entete->longueurCharge;
+    octets[13] = entete->blocCrc;
+    octets[14] = (unsigned char) longueurNom;
+    memcpy(octets + TAILLE_ENTETE_FIXE, entete->nom, longueurNom);
+
+    *taille = TAILLE_ENTETE_FIXE + (int) longueurNom;
+
+    if(!(entete->flags & FLAG_CONTENEUR_FRAGMENT))
+        return ERROR_OK;
+
+    if(entete->nbFragments < 1 || entete->nbFragments > NB_FRAGMENTS_MAX || entete->indexFragment >= entete->nbFragments || entete->longueurTotale > 0xFFFFFFFFUL)
+        return ERROR_INVARG;
+
+    // Description du fragment, à la suite du nom
+    octets += *taille;
+    octets[0] = (unsigned char) (entete->indexFragment >> 8u);
+    octets[1] = (unsigned char) entete->indexFragment;
+    octets[2] = (unsigned char) (entete->nbFragments >> 8u);
+    octets[3] = (unsigned char) entete->nbFragments;
+    octets[4] = (unsigned char) (entete->debutFragment >> 24u);
+    octets[5] = (unsigned char) (entete->debutFragment >> 16u);
+    octets[6] = (unsigned char) (entete->debutFragment >> 8u);
+    octets[7] = (unsigned char) entete->debutFragment;
+    octets[8] = (unsigned char) (entete->longueurTotale >> 24u);
+    octets[9] = (unsigned char) (entete->longueurTotale >> 16u);
+    octets[10] = (unsigned char) (entete->longueurTotale >> 8u);
+    octets[11] = (unsigned char) entete->longueurTotale;
+    octets[12] = (unsigned char) (entete->crcTotal >> 24u);
+    octets[13] = (unsigned char) (entete->crcTotal >> 16u);
+    octets[14] = (unsigned char) (entete->crcTotal >> 8u);
+    octets[15] = (unsigned char) entete->crcTotal;
+
+    *taille += TAILLE_FRAGMENT_CONTENEUR;
+
+    return ERROR_OK;
+}
+
+
+void enteteMessage(const char* nom, unsigned int flags, unsigned long longueur, enteteConteneur_t* entete) {
+
+    // Seuls le nom, les transformations et la taille décrivent le message indépendamment de son insertion
+    memset(entete, 0, sizeof(enteteConteneur_t));
+    entete->version = VERSION_CONTENEUR;
+    entete->mode = MODE_CLASSIQUE;
+    entete->permutation = PERMUTATION_AUCUNE;
+    entete->flags = flags & (FLAG_CONTENEUR_FICHIER | FLAG_CONTENEUR_COMPRESSE | FLAG_CONTENEUR_CHIFFRE);
+    entete->longueurCharge = longueur;
+    memcpy(entete->nom, nom, strlen(nom) < TAILLE_NOM_CONTENEUR ? strlen(nom) : TAILLE_NOM_CONTENEUR);
+}
+
+
+int hideEnteteConteneur(const enteteConteneur_t* entete, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, int* tailleEnteteBit) {
+
+    unsigned char octets[TAILLE_ENTETE_MAX], *bits = NULL;
+    size_t tailleBit;
+    int taille, error;
+
+    error = serialiserEnteteConteneur(entete, octets, &taille);
+    if(error != ERROR_OK)
+        return error;
+
+    error = octetsVersBinaire(octets, (size_t) taille, &bits, &tailleBit);
+    if(error != ERROR_OK)
+        return error;
+
+    // L'entête est toujours inséré pixel par pixel pour pouvoir être lu sans connaitre la méthode
+    error = hideMessage(bits, tailleBit, matriceImage, dimension, pixelIntensity, lengthDimensionPrefix, 0, NULL);
+    free(bits);
+
+    *tailleEnteteBit = (int) tailleBit;
+
+    return error;
+}
+
+
+int analyserEnteteConteneur(const unsigned char* octets, enteteConteneur_t* entete, int* longueurNom) {
+
+    if(memcmp(octets, MAGIC_CONTENEUR, 3) != 0 || octets[3] != VERSION_CONTENEUR)
+        return ERROR_FORMAT;
+
+    entete->version = octets[3];
+    entete->mode = octets[4];
+    entete->parametre = octets[5];
+    entete->permutation = octets[6];
+    entete->flags = ((unsigned int) octets[7] << 8u) | octets[8];
+    entete->longueurCharge = ((unsigned long) octets[9] << 24u) | ((unsigned long) octets[10] << 16u) | ((unsigned long) octets[11] << 8u) | octets[12];
+    entete->blocCrc = octets[13];
+    *longueurNom = octets[14];
+
+    if(entete->mode < MODE_CLASSIQUE || entete->mode > MODE_ADAPTATIF || entete->permutation > PERMUTATION_TABLEAU)
+        return ERROR_FORMAT;
+
+    if(entete->mode == MODE_HAMMING && (entete->parametre & HAMMING_SEGMENTE) && ((entete->parametre & ~HAMMING_SEGMENTE) < 1 || (entete->parametre & ~HAMMING_SEGMENTE) >= LIGNES_MAX_HAMMING))
+        return ERROR_FORMAT;
+
+    if(entete->mode == MODE_HAMMING_CHIFFRE && (entete->parametre < 1 || entete->parametre >= LIGNES_MAX_HAMMING))
+        return ERROR_FORMAT;
+
+    if(entete->mode == MODE_STC && (entete->parametre < HAUTEUR_STC_MIN || entete->parametre > HAUTEUR_STC_MAX))
+        return ERROR_FORMAT;
+
+    if(entete->mode == MODE_TERNAIRE && (entete->parametre < TRITS_MIN_TERNAIRE || entete->parametre > TRITS_MAX_TERNAIRE))
+        return ERROR_FORMAT;
+
+    if((entete->flags & FLAG_CONTENEUR_CRC) ? (entete->blocCrc == 0 || entete->blocCrc > LOG2_BLOC_CRC_MAX) : entete->blocCrc != 0)
+        return ERROR_FORMAT;
+
+    return ERROR_OK;
+}
+
+
+int lireEnteteConteneur(sourceImage_t* source, long int lengthDimensionPrefix, long int prefixInt, enteteConteneur_t* entete, int* tailleEnteteBit) {
+
+    unsigned char octets[TAILLE_ENTETE_FIXE];
+    lecteurBits_t lecteur;
+    int i, longueurNom, error;
+    unsigned int masque;
+    long int debut;
+
+    if(prefixInt - lengthDimensionPrefix < TAILLE_ENTETE_FIXE * 8)
+        return ERROR_FORMAT;
+
+    initLecteurBits(&lecteur, source, lengthDimensionPrefix, MODE_CLASSIQUE, NULL, 0, 0);
+
+    for(i = 0; i < TAILLE_ENTETE_FIXE; i++) {
+        octets[i] = lireOctetExtrait(&lecteur, i);
+    }
+
+    error = analyserEnteteConteneur(octets, entete, &longueurNom);
+    if(error != ERROR_OK)
+        return error;
+
+    // Le masque ne peut désigner que des canaux de l'image, et les coûts adaptatifs sont calculés sur l'image entière
+    masque = (entete->flags & MASQUE_CANAUX_CONTENEUR) >> DECALAGE_CANAUX_CONTENEUR;
+    if(masque != 0 && (source->nbCanaux < 2 || source->dimension % source->nbCanaux != 0 || (source->nbCanaux < CANAUX_MAX && (masque >> source->nbCanaux) != 0) || entete->mode == MODE_ADAPTATIF))
+        return ERROR_FORMAT;
+
+    if(prefixInt - lengthDimensionPrefix < (TAILLE_ENTETE_FIXE + longueurNom) * 8)
+        return ERROR_FORMAT;
+
+    for(i = 0; i < longueurNom; i++) {
+        entete->nom[i] = (char) lireOctetExtrait(&lecteur, TAILLE_ENTETE_FIXE + i);
+    }
+    entete->nom[longueurNom] = '\0';
+
+    *tailleEnteteBit = (TAILLE_ENTETE_FIXE + longueurNom) * 8;
+
+    if(entete->flags & FLAG_CONTENEUR_FRAGMENT) {
+        if(prefixInt - lengthDimensionPrefix < (*tailleEnteteBit) + TAILLE_FRAGMENT_CONTENEUR * 8)
+            return ERROR_FORMAT;
+
+        debut = TAILLE_ENTETE_FIXE + longueurNom;
+        entete->indexFragment = 0;
+        entete->nbFragments = 0;
+        entete->debutFragment = 0;
+        entete->longueurTotale = 0;
+        entete->crcTotal = 0;
+        for(i = 0; i < 2; i++) {
+            entete->indexFragment = (entete->indexFragment << 8u) | lireOctetExtrait(&lecteur, debut + i);
+            entete->nbFragments = (entete->nbFragments << 8u) | lireOctetExtrait(&lecteur, debut + 2 + i);
+        }
+        for(i = 0; i < 4; i++) {
+            entete->debutFragment = (entete->debutFragment << 8u) | lireOctetExtrait(&lecteur, debut + 4 + i);
+            entete->longueurTotale = (entete->longueurTotale << 8u) | lireOctetExtrait(&lecteur, debut + 8 + i);
+            entete->crcTotal = (entete->crcTotal << 8u) | lireOctetExtrait(&lecteur, debut + 12 + i);
+        }
+
+        if(entete->nbFragments < 1 || entete->indexFragment >= entete->nbFragments || entete->debutFragment + entete->longueurCharge > entete->longueurTotale)
+            return ERROR_FORMAT;
+
+        *tailleEnteteBit += TAILLE_FRAGMENT_CONTENEUR * 8;
+    }
+
+    // La taille du message annoncée (table des CRC comprise) doit correspondre à celle du prefixe
+    if(prefixInt - lengthDimensionPrefix - (*tailleEnteteBit) != unitesPrefixe(entete))
+        return ERROR_FORMAT;
+
+    return ERROR_OK;
+}
+
+
+int lireFichierOctets(const char* pathFile, unsigned char** octets, size_t* taille) {
+
+    long fsize;
+    FILE *f = fopen(pathFile, "rb");
+    if(f == NULL)
+        return ERROR_OPEN;
+
+    fseek(f, 0, SEEK_END);
+    fsize = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    if(fsize < 0) {
+        fclose(f);
+        return ERROR_OPEN;
+    }
+
+    *octets = (unsigned char*) malloc((size_t) fsize + 1);
+    if(*octets == NULL) {
+        fclose(f);
+        return ERROR_NOMEM;
+    }
+
+    *taille = fread(*octets, 1, (size_t) fsize, f);
+    fclose(f);
+
+    return ERROR_OK;
+}
+
+
+int octetsVersBinaire(const unsigned char* octets, size_t taille, unsigned char** bits, size_t* tailleBit) {
+
+    size_t i;
+    int j;
+
+    *bits = (unsigned char*) malloc(taille * 8 + 1);
+    if(*bits == NULL)
+        return ERROR_NOMEM;
+
+    for(i = 0; i < taille; i++) {
+        for(j = 0; j < 8; j++) {
+            (*bits)[i * 8 + j] = (unsigned char) ((octets[i] >> (7 - j)) & 1u);
+        }
+    }
+
+    *tailleBit = taille * 8;
+
+    return ERROR_OK;
+}
+
+
+/**
+ * Écrit le complément d'une longueur de 15 ou plus (octets 255 ... 255 n).
+ */
+static size_t ecrireLongueurLZ(unsigned char* destination, size_t longueur) {
+
+    size_t n = 0;
+
+    while(longueur >= 255) {
+        destination[n++] = 255;
+        longueur -= 255;
+    }
+    destination[n++] = (unsigned char) longueur;
+
+    return n;
+}
+
+
+int compresserLZ(const unsigned char* source, size_t taille, unsigned char* destination, size_t capacite, size_t* tailleDestination) {
+
+    unsigned int *table, sequence, candidat;
+    size_t ip = 0, ancre = 0, op = 0, reference, longueur, litteraux, pas;
+    unsigned char *jeton;
+
+    *tailleDestination = 0;
+
+    if(capacite < taille + taille / 255 + 16)
+        return ERROR_NOMEM;
+
+    // Chaque case contient la position + 1 de la dernière séquence de 4 octets ayant ce hachage (0 si vide)
+    table = (unsigned int*) calloc((size_t) 1 << LOG2_TABLE_LZ, sizeof(unsigned int));
+    if(table == NULL)
+        return ERROR_NOMEM;
+
+    while(ip + LONGUEUR_MIN_LZ <= taille) {
+
+        memcpy(&sequence, source + ip, 4);
+        candidat = (sequence * 2654435761u) >> (32 - LOG2_TABLE_LZ);
+        reference = table[candidat];
+        table[candidat] = (unsigned int) (ip + 1);
+
+        if(reference == 0 || ip - (reference - 1) > DISTANCE_MAX_LZ || memcmp(source + reference - 1, source + ip, 4) != 0) {
+            // Plus on avance sans trouver de répétition, plus on saute d'octets: les données incompressibles sont parcourues rapidement
+            pas = 1 + ((ip - ancre) >> 6u);
+            ip += pas;
+            continue;
+        }
+        reference--;
+
+        longueur = LONGUEUR_MIN_LZ;
+        while(ip + longueur < taille && source[reference + longueur] == source[ip + longueur]) {
+            longueur++;
+        }
+
+        // Séquence: jeton, littéraux depuis l'ancre, distance, longueur de la répétition
+        litteraux = ip - ancre;
+        jeton = destination + op++;
+        *jeton = (unsigned char) ((litteraux < 15 ? litteraux : 15) << 4u);
+        if(litteraux >= 15)
+            op += ecrireLongueurLZ(destination + op, litteraux - 15);
+        memcpy(destination + op, source + ancre, litteraux);
+        op += litteraux;
+
+        destination[op++] = (unsigned char) (ip - reference);
+        destination[op++] = (unsigned char) ((ip - reference) >> 8u);
+
+        *jeton |= (unsigned char) (longueur - LONGUEUR_MIN_LZ < 15 ? longueur - LONGUEUR_MIN_LZ : 15);
+        if(longueur - LONGUEUR_MIN_LZ >= 15)
+            op += ecrireLongueurLZ(destination + op, longueur - LONGUEUR_MIN_LZ - 15);
+
+        ip += longueur;
+        ancre = ip;
+    }
+
+    // Dernière séquence: uniquement des littéraux
+    litteraux = taille - ancre;
+    destination[op++] = (unsigned char) ((litteraux < 15 ? litteraux : 15) << 4u);
+    if(litteraux >= 15)
+        op += ecrireLongueurLZ(destination + op, litteraux - 15);
+    memcpy(destination + op, source + ancre, litteraux);
+    op += litteraux;
+
+    free(table);
+    *tailleDestination = op;
+
+    return ERROR_OK;
+}
+
+
+/**
+ * Lit le complément d'une longueur de 15 ou plus. Retourne 0 si les données sont tronquées.
+ */
+static int lireLongueurLZ(const unsigned char* source, size_t taille, size_t* ip, size_t* longueur) {
+
+    unsigned char octet;
+
+    do {
+        if(*ip >= taille)
+            return 0;
+        octet = source[(*ip)++];
+        *longueur += octet;
+    } while(octet == 255);
+
+    return 1;
+}
+
+
+int decompresserLZ(const unsigned char* source, size_t taille, unsigned char* destination, size_t tailleAttendue) {
+
+    size_t ip = 0, op = 0, litteraux, longueur, distance, k;
+    unsigned char jeton;
+
+    while(ip < taille) {
+
+        jeton = source[ip++];
+
+        litteraux = jeton >> 4u;
+        if(litteraux == 15 && !lireLongueurLZ(source, taille, &ip, &litteraux))
+            return ERROR_FORMAT;
+        if(litteraux > taille - ip || litteraux > tailleAttendue - op)
+            return ERROR_FORMAT;
+        memcpy(destination + op, source + ip, litteraux);
+        ip += litteraux;
+        op += litteraux;
+
+        // Dernière séquence
+        if(ip == taille)
+            break;
+
+        if(taille - ip < 2)
+            return ERROR_FORMAT;
+        distance = source[ip] | ((size_t) source[ip + 1] << 8u);
+        ip += 2;
+
+        longueur = jeton & 15u;
+        if(longueur == 15 && !lireLongueurLZ(source, taille, &ip, &longueur))
+            return ERROR_FORMAT;
+        longueur += LONGUEUR_MIN_LZ;
+
+        if(distance == 0 || distance > op || longueur > tailleAttendue - op)
+            return ERROR_FORMAT;
+
+        // Copie octet par octet: la répétition peut chevaucher les octets qu'elle produit
+        for(k = 0; k < longueur; k++) {
+            destination[op + k] = destination[op - distance + k];
+        }
+        op += longueur;
+    }
+
+    return op == tailleAttendue ? ERROR_OK : ERROR_FORMAT;
+}
+
+
+int compresserCharge(unsigned char** charge, size_t* tailleCharge, int* compresse) {
+
+    unsigned char *resultat;
+    size_t capacite, tailleCompressee;
+    int error;
+
+    *compresse = 0;
+
+    if(*tailleCharge > 0xFFFFFFFFUL)
+        return ERROR_INVARG;
+
+    capacite = (*tailleCharge) + (*tailleCharge) / 255 + 16 + 4;
+    resultat = (unsigned char*) malloc(capacite);
+    if(resultat == NULL)
+        return ERROR_NOMEM;
+
+    // Estimation sur un échantillon: inutile de tout compresser si le début du message ne gagne rien
+    if(*tailleCharge > 2 * TAILLE_ECHANTILLON_LZ) {
+        error = compresserLZ(*charge, TAILLE_ECHANTILLON_LZ, resultat + 4, capacite - 4, &tailleCompressee);
+        if(error != ERROR_OK || tailleCompressee >= TAILLE_ECHANTILLON_LZ - TAILLE_ECHANTILLON_LZ / 32) {
+            free(resultat);
+            return error;
+        }
+    }
+
+    error = compresserLZ(*charge, *tailleCharge, resultat + 4, capacite - 4, &tailleCompressee);
+    if(error != ERROR_OK || tailleCompressee + 4 >= (*tailleCharge)) {
+        free(resultat);
+        return error;
+    }
+
+    resultat[0] = (unsigned char) ((*tailleCharge) >> 24u);
+    resultat[1] = (unsigned char) ((*tailleCharge) >> 16u);
+    resultat[2] = (unsigned char) ((*tailleCharge) >> 8u);
+    resultat[3] = (unsigned char) (*tailleCharge);
+
+    free(*charge);
+    *charge = resultat;
+    *tailleCharge = tailleCompressee + 4;
+    *compresse = 1;
+
+    return ERROR_OK;
+}
+
+
+int decompresserCharge(const unsigned char* charge, size_t tailleCharge, unsigned char** sortie, size_t* tailleSortie) {
+
+    int error;
+
+    if(tailleCharge < 4)
+        return ERROR_FORMAT;
+
+    *tailleSortie = ((size_t) charge[0] << 24u) | ((size_t) charge[1] << 16u) | ((size_t) charge[2] << 8u) | charge[3];
+
+    // Chaque octet compressé produit au plus 255 * 255 octets: une taille annoncée plus grande est forcément corrompue
+    if(*tailleSortie > (tailleCharge - 4) * 255 * 255)
+        return ERROR_FORMAT;
+
+    *sortie = (unsigned char*) malloc((*tailleSortie) + 1);
+    if(*sortie == NULL)
+        return ERROR_NOMEM;
+
+    error = decompresserLZ(charge + 4, tailleCharge - 4, *sortie, *tailleSortie);
+    if(error != ERROR_OK) {
+        free(*sortie);
+        *sortie = NULL;
+    }
+
+    return error;
+}
+
+
+unsigned int lireMot32LE(const unsigned char* octets) {
+
+    return (unsigned int) octets[0] | ((unsigned int) octets[1] << 8u) | ((unsigned int) octets[2] << 16u) | ((unsigned int) octets[3] << 24u);
+}
+
+
+void ecrireMot32LE(unsigned char* octets, unsigned int mot) {
+
+    octets[0] = (unsigned char) mot;
+    octets[1] = (unsigned char) (mot >> 8u);
+    octets[2] = (unsigned char) (mot >> 16u);
+    octets[3] = (unsigned char) (mot >> 24u);
+}
+
+
+#define ROTD32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+void transformerSha256(sha256_t* contexte, const unsigned char* bloc) {
+
+    static const unsigned int k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+    unsigned int w[64], a, b, c, d, e, f, g, h, t1, t2;
+    int i;
+
+    for(i = 0; i < 16; i++) {
+        w[i] = ((unsigned int) bloc[i * 4] << 24u) | ((unsigned int) bloc[i * 4 + 1] << 16u) | ((unsigned int) bloc[i * 4 + 2] << 8u) | bloc[i * 4 + 3];
+    }
+    for(i = 16; i < 64; i++) {
+        w[i] = (ROTD32(w[i - 2], 17) ^ ROTD32(w[i - 2], 19) ^ (w[i - 2] >> 10u)) + w[i - 7] + (ROTD32(w[i - 15], 7) ^ ROTD32(w[i - 15], 18) ^ (w[i - 15] >> 3u)) + w[i - 16];
+    }
+
+    a = contexte->etat[0]; b = contexte->etat[1]; c = contexte->etat[2]; d = contexte->etat[3];
+    e = contexte->etat[4]; f = contexte->etat[5]; g = contexte->etat[6]; h = contexte->etat[7];
+
+    for(i = 0; i < 64; i++) {
+        t1 = h + (ROTD32(e, 6) ^ ROTD32(e, 11) ^ ROTD32(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+        t2 = (ROTD32(a, 2) ^ ROTD32(a, 13) ^ ROTD32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+
+    contexte->etat[0] += a; contexte->etat[1] += b; contexte->etat[2] += c; contexte->etat[3] += d;
+    contexte->etat[4] += e; contexte->etat[5] += f; contexte->etat[6] += g; contexte->etat[7] += h;
+}
+
+
+void initSha256(sha256_t* contexte) {
+
+    static const unsigned int initial[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+    memcpy(contexte->etat, initial, sizeof(initial));
+    contexte->remplissage = 0;
+    contexte->taille = 0;
+}
+
+
+void majSha256(sha256_t* contexte, const unsigned char* donnees, size_t taille) {
+
+    size_t n;
+
+    contexte->taille += taille;
+
+    while(taille > 0) {
+        n = 64 - contexte->remplissage < taille ? 64 - contexte->remplissage : taille;
+        memcpy(contexte->bloc + contexte->remplissage, donnees, n);
+        contexte->remplissage += n;
+        donnees += n;
+        taille -= n;
+
+        if(contexte->remplissage == 64) {
+            transformerSha256(contexte, contexte->bloc);
+            contexte->remplissage = 0;
+        }
+    }
+}
+
+
+void finSha256(sha256_t* contexte, unsigned char empreinte[TAILLE_SHA256]) {
+
+    unsigned long long tailleBits = contexte->taille * 8;
+    unsigned char remplissage[72] = {0x80};
+    size_t n;
+    int i;
+
+    // Bourrage: 0x80, des zéros, puis la taille en bits sur 8 octets (big-endian)
+    n = (contexte->remplissage < 56 ? 56 : 120) - contexte->remplissage;
+    for(i = 0; i < 8; i++) {
+        remplissage[n + i] = (unsigned char) (tailleBits >> (56 - 8 * i));
+    }
+    majSha256(contexte, remplissage, n + 8);
+
+    for(i = 0; i < 8; i++) {
+        empreinte[i * 4] = (unsigned char) (contexte->etat[i] >> 24u);
+        empreinte[i * 4 + 1] = (unsigned char) (contexte->etat[i] >> 16u);
+        empreinte[i * 4 + 2] = (unsigned char) (contexte->etat[i] >> 8u);
+        empreinte[i * 4 + 3] = (unsigned char) contexte->etat[i];
+    }
+}
+
+
+void deriverCle(const char* motDePasse, const unsigned char* sel, size_t tailleSel, unsigned int iterations, unsigned char cle[TAILLE_CLE_AEAD]) {
+
+    sha256_t interne, externe, contexte;
+    unsigned char bloc[64], u[TAILLE_SHA256], compteur[4] = {0, 0, 0, 1};
+    size_t tailleMotDePasse = strlen(motDePasse), i;
+    unsigned int n;
+
+    // HMAC-SHA256: une clé plus longue qu'un bloc est d'abord hachée
+    memset(bloc, 0, sizeof(bloc));
+    if(tailleMotDePasse > 64) {
+        initSha256(&contexte);
+        majSha256(&contexte, (const unsigned char*) motDePasse, tailleMotDePasse);
+        finSha256(&contexte, bloc);
+    } else {
+        memcpy(bloc, motDePasse, tailleMotDePasse);
+    }
+
+    // Les états après ipad et opad sont calculés une seule fois pour toutes les itérations
+    for(i = 0; i < 64; i++) bloc[i] ^= 0x36;
+    initSha256(&interne);
+    majSha256(&interne, bloc, 64);
+    for(i = 0; i < 64; i++) bloc[i] ^= 0x36 ^ 0x5c;
+    initSha256(&externe);
+    majSha256(&externe, bloc, 64);
+
+    // PBKDF2: un seul bloc suffit, la clé fait la taille d'une empreinte SHA-256
+    contexte = interne;
+    majSha256(&contexte, sel, tailleSel);
+    majSha256(&contexte, compteur, 4);
+    finSha256(&contexte, u);
+    contexte = externe;
+    majSha256(&contexte, u, TAILLE_SHA256);
+    finSha256(&contexte, u);
+    memcpy(cle, u, TAILLE_CLE_AEAD);
+
+    for(n = 1; n < iterations; n++) {
+        contexte = interne;
+        majSha256(&contexte, u, TAILLE_SHA256);
+        finSha256(&contexte, u);
+        contexte = externe;
+        majSha256(&contexte, u, TAILLE_SHA256);
+        finSha256(&contexte, u);
+        for(i = 0; i < TAILLE_CLE_AEAD; i++) {
+            cle[i] ^= u[i];
+        }
+    }
+}
+
+
+#define ROTG32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define QUART_CHACHA(a, b, c, d) \
+    a += b; d ^= a; d = ROTG32(d, 16); \
+    c += d; b ^= c; b = ROTG32(b, 12); \
+    a += b; d ^= a; d = ROTG32(d, 8); \
+    c += d; b ^= c; b = ROTG32(b, 7);
+
+void initEtatChaCha20(unsigned int etat[16], const unsigned char cle[TAILLE_CLE_AEAD], const unsigned char nonce[TAILLE_NONCE_AEAD], unsigned int compteur) {
+
+    int i;
+
+    // "expand 32-byte k"
+    etat[0] = 0x61707865;
+    etat[1] = 0x3320646e;
+    etat[2] = 0x79622d32;
+    etat[3] = 0x6b206574;
+    for(i = 0; i < 8; i++) {
+        etat[4 + i] = lireMot32LE(cle + i * 4);
+    }
+    etat[12] = compteur;
+    for(i = 0; i < 3; i++) {
+        etat[13 + i] = lireMot32LE(nonce + i * 4);
+    }
+}
+
+
+void blocChaCha20(const unsigned int etat[16], unsigned char sortie[64]) {
+
+    unsigned int x[16];
+    int i;
+
+    memcpy(x, etat, sizeof(x));
+
+    for(i = 0; i < 10; i++) {
+        QUART_CHACHA(x[0], x[4], x[8], x[12])
+        QUART_CHACHA(x[1], x[5], x[9], x[13])
+        QUART_CHACHA(x[2], x[6], x[10], x[14])
+        QUART_CHACHA(x[3], x[7], x[11], x[15])
+        QUART_CHACHA(x[0], x[5], x[10], x[15])
+        QUART_CHACHA(x[1], x[6], x[11], x[12])
+        QUART_CHACHA(x[2], x[7], x[8], x[13])
+        QUART_CHACHA(x[3], x[4], x[9], x[14])
+    }
+
+    for(i = 0; i < 16; i++) {
+        ecrireMot32LE(sortie + i * 4, x[i] + etat[i]);
+    }
+}
+
+
+#if defined(__x86_64__)
+
+#define ROTG128(v, n) _mm_or_si128(_mm_slli_epi32(v, n), _mm_srli_epi32(v, 32 - (n)))
+
+#define QUART_CHACHA128(a, b, c, d) \
+    a = _mm_add_epi32(a, b); d = _mm_xor_si128(d, a); d = ROTG128(d, 16); \
+    c = _mm_add_epi32(c, d); b = _mm_xor_si128(b, c); b = ROTG128(b, 12); \
+    a = _mm_add_epi32(a, b); d = _mm_xor_si128(d, a); d = ROTG128(d, 8); \
+    c = _mm_add_epi32(c, d); b = _mm_xor_si128(b, c); b = ROTG128(b, 7);
+
+void xorChaCha20x4(const unsigned int etat[16], unsigned char* donnees) {
+
+    __m128i x[16], origine[16], t0, t1, t2, t3, *bloc;
+    int i, g;
+
+    // Chaque vecteur contient le même mot de 4 blocs consécutifs: les 4 blocs sont calculés en même temps
+    for(i = 0; i < 16; i++) {
+        origine[i] = _mm_set1_epi32((int) etat[i]);
+    }
+    origine[12] = _mm_add_epi32(origine[12], _mm_set_epi32(3, 2, 1, 0));
+    memcpy(x, origine, sizeof(x));
+
+    for(i = 0; i < 10; i++) {
+        QUART_CHACHA128(x[0], x[4], x[8], x[12])
+        QUART_CHACHA128(x[1], x[5], x[9], x[13])
+        QUART_CHACHA128(x[2], x[6], x[10], x[14])
+        QUART_CHACHA128(x[3], x[7], x[11], x[15])
+        QUART_CHACHA128(x[0], x[5], x[10], x[15])
+        QUART_CHACHA128(x[1], x[6], x[11], x[12])
+        QUART_CHACHA128(x[2], x[7], x[8], x[13])
+        QUART_CHACHA128(x[3], x[4], x[9], x[14])
+    }
+
+    // Transposition 4x4 par groupe de 4 mots pour retrouver l'ordre des blocs, puis XOR avec les données
+    for(g = 0; g < 4; g++) {
+        for(i = 0; i < 4; i++) {
+            x[g * 4 + i] = _mm_add_epi32(x[g * 4 + i], origine[g * 4 + i]);
+        }
+        t0 = _mm_unpacklo_epi32(x[g * 4], x[g * 4 + 1]);
+        t1 = _mm_unpacklo_epi32(x[g * 4 + 2], x[g * 4 + 3]);
+        t2 = _mm_unpackhi_epi32(x[g * 4], x[g * 4 + 1]);
+        t3 = _mm_unpackhi_epi32(x[g * 4 + 2], x[g * 4 + 3]);
+
+        bloc = (__m128i*) (donnees + g * 16);
+        _mm_storeu_si128(bloc, _mm_xor_si128(_mm_loadu_si128(bloc), _mm_unpacklo_epi64(t0, t1)));
+        bloc = (__m128i*) (donnees + 64 + g * 16);
+        _mm_storeu_si128(bloc, _mm_xor_si128(_mm_loadu_si128(bloc), _mm_unpackhi_epi64(t0, t1)));
+        bloc = (__m128i*) (donnees + 128 + g * 16);
+        _mm_storeu_si128(bloc, _mm_xor_si128(_mm_loadu_si128(bloc), _mm_unpacklo_epi64(t2, t3)));
+        bloc = (__m128i*) (donnees + 192 + g * 16);
+        _mm_storeu_si128(bloc, _mm_xor_si128(_mm_loadu_si128(bloc), _mm_unpackhi_epi64(t2, t3)));
+    }
+}
+
+#endif
+
+
+void xorChaCha20(const unsigned char cle[TAILLE_CLE_AEAD], const unsigned char nonce[TAILLE_NONCE_AEAD], unsigned long long position, unsigned char* donnees, size_t taille) {
+
+    unsigned int etat[16];
+    unsigned char flux[64];
+    size_t decalage, n, i;
+
+    // Le message commence au bloc 1, le bloc 0 sert à la clé Poly1305
+    initEtatChaCha20(etat, cle, nonce, (unsigned int) (1 + position / 64));
+    decalage = (size_t) (position % 64);
+
+    // Début du message au milieu d'un bloc (extraction d'une portion)
+    if(decalage > 0 && taille > 0) {
+        blocChaCha20(etat, flux);
+        n = 64 - decalage < taille ? 64 - decalage : taille;
+        for(i = 0; i < n; i++) {
+            donnees[i] ^= flux[decalage + i];
+        }
+        donnees += n;
+        taille -= n;
+        etat[12]++;
+    }
+
+#if defined(__x86_64__)
+    while(taille >= 256) {
+        xorChaCha20x4(etat, donnees);
+        etat[12] += 4;
+        donnees += 256;
+        taille -= 256;
+    }
+#endif
+
+    while(taille > 0) {
+        blocChaCha20(etat, flux);
+        n = taille < 64 ? taille : 64;
+        for(i = 0; i < n; i++) {
+            donnees[i] ^= flux[i];
+        }
+        donnees += n;
+        taille -= n;
+        etat[12]++;
+    }
+}
+
+
+void initPoly1305(poly1305_t* contexte, const unsigned char cle[32]) {
+
+    // r est "clampé" et découpé en 5 morceaux de 26 bits
+    contexte->r[0] = lireMot32LE(cle) & 0x3ffffff;
+    contexte->r[1] = (lireMot32LE(cle + 3) >> 2u) & 0x3ffff03;
+    contexte->r[2] = (lireMot32LE(cle + 6) >> 4u) & 0x3ffc0ff;
+    contexte->r[3] = (lireMot32LE(cle + 9) >> 6u) & 0x3f03fff;
+    contexte->r[4] = (lireMot32LE(cle + 12) >> 8u) & 0x00fffff;
+
+    contexte->s[0] = lireMot32LE(cle + 16);
+    contexte->s[1] = lireMot32LE(cle + 20);
+    contexte->s[2] = lireMot32LE(cle + 24);
+    contexte->s[3] = lireMot32LE(cle + 28);
+
+    memset(contexte->h, 0, sizeof(contexte->h));
+    contexte->remplissage = 0;
+}
+
+
+void blocsPoly1305(poly1305_t* contexte, const unsigned char* donnees, size_t taille, unsigned int bitFort) {
+
+    unsigned int r0 = contexte->r[0], r1 = contexte->r[1], r2 = contexte->r[2], r3 = contexte->r[3], r4 = contexte->r[4];
+    unsigned int s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+    unsigned int h0 = contexte->h[0], h1 = contexte->h[1], h2 = contexte->h[2], h3 = contexte->h[3], h4 = contexte->h[4];
+    unsigned long long d0, d1, d2, d3, d4;
+    unsigned int c;
+
+    while(taille >= 16) {
+
+        // h += bloc
+        h0 += lireMot32LE(donnees) & 0x3ffffff;
+        h1 += (lireMot32LE(donnees + 3) >> 2u) & 0x3ffffff;
+        h2 += (lireMot32LE(donnees + 6) >> 4u) & 0x3ffffff;
+        h3 += (lireMot32LE(donnees + 9) >> 6u) & 0x3ffffff;
+        h4 += (lireMot32LE(donnees + 12) >> 8u) | bitFort;
+
+        // h *= r (mod 2^130 - 5)
+        d0 = (unsigned long long) h0 * r0 + (unsigned long long) h1 * s4 + (unsigned long long) h2 * s3 + (unsigned long long) h3 * s2 + (unsigned long long) h4 * s1;
+        d1 = (unsigned long long) h0 * r1 + (unsigned long long) h1 * r0 + (unsigned long long) h2 * s4 + (unsigned long long) h3 * s3 + (unsigned long long) h4 * s2;
+        d2 = (unsigned long long) h0 * r2 + (unsigned long long) h1 * r1 + (unsigned long long) h2 * r0 + (unsigned long long) h3 * s4 + (unsigned long long) h4 * s3;
+        d3 = (unsigned long long) h0 * r3 + (unsigned long long) h1 * r2 + (unsigned long long) h2 * r1 + (unsigned long long) h3 * r0 + (unsigned long long) h4 * s4;
+        d4 = (unsigned long long) h0 * r4 + (unsigned long long) h1 * r3 + (unsigned long long) h2 * r2 + (unsigned long long) h3 * r1 + (unsigned long long) h4 * r0;
+
+        c = (unsigned int) (d0 >> 26u); h0 = (unsigned int) d0 & 0x3ffffff;
+        d1 += c; c = (unsigned int) (d1 >> 26u); h1 = (unsigned int) d1 & 0x3ffffff;
+        d2 += c; c = (unsigned int) (d2 >> 26u); h2 = (unsigned int) d2 & 0x3ffffff;
+        d3 += c; c = (unsigned int) (d3 >> 26u); h3 = (unsigned int) d3 & 0x3ffffff;
+        d4 += c; c = (unsigned int) (d4 >> 26u); h4 = (unsigned int) d4 & 0x3ffffff;
+        h0 += c * 5; c = h0 >> 26u; h0 &= 0x3ffffff;
+        h1 += c;
+
+        donnees += 16;
+        taille -= 16;
+    }
+
+    contexte->h[0] = h0; contexte->h[1] = h1; contexte->h[2] = h2; contexte->h[3] = h3; contexte->h[4] = h4;
+}
+
+
+void majPoly1305(poly1305_t* contexte, const unsigned char* donnees, size_t taille) {
+
+    size_t n;
+
+    if(contexte->remplissage > 0) {
+        n = 16 - contexte->remplissage < taille ? 16 - contexte->remplissage : taille;
+        memcpy(contexte->bloc + contexte->remplissage, donnees, n);
+        contexte->remplissage += n;
+        donnees += n;
+        taille -= n;
+        if(contexte->remplissage < 16)
+            return;
+        blocsPoly1305(contexte, contexte->bloc, 16, 1u << 24u);
+        contexte->remplissage = 0;
+    }
+
+    n = taille & ~(size_t) 15;
+    blocsPoly1305(contexte, donnees, n, 1u << 24u);
+
+    memcpy(contexte->bloc, donnees + n, taille - n);
+    contexte->remplissage = taille - n;
+}
+
+
+void finPoly1305(poly1305_t* contexte, unsigned char tag[TAILLE_TAG_AEAD]) {
+
+    unsigned int h0, h1, h2, h3, h4, g0, g1, g2, g3, g4, c, masque;
+    unsigned long long f;
+
+    // Dernier bloc incomplet: on ajoute un 1 puis des zéros, sans le bit 2^128
+    if(contexte->remplissage > 0) {
+        contexte->bloc[contexte->remplissage] = 1;
+        memset(contexte->bloc + contexte->remplissage + 1, 0, 16 - contexte->remplissage - 1);
+        blocsPoly1305(contexte, contexte->bloc, 16, 0);
+    }
+
+    h0 = contexte->h[0]; h1 = contexte->h[1]; h2 = contexte->h[2]; h3 = contexte->h[3]; h4 = contexte->h[4];
+
+    c = h1 >> 26u; h1 &= 0x3ffffff;
+    h2 += c; c = h2 >> 26u; h2 &= 0x3ffffff;
+    h3 += c; c = h3 >> 26u; h3 &= 0x3ffffff;
+    h4 += c; c = h4 >> 26u; h4 &= 0x3ffffff;
+    h0 += c * 5; c = h0 >> 26u; h0 &= 0x3ffffff;
+    h1 += c;
+
+    // g = h - (2^130 - 5): on garde g si h >= 2^130 - 5, sans branchement
+    g0 = h0 + 5; c = g0 >> 26u; g0 &= 0x3ffffff;
+    g1 = h1 + c; c = g1 >> 26u; g1 &= 0x3ffffff;
+    g2 = h2 + c; c = g2 >> 26u; g2 &= 0x3ffffff;
+    g3 = h3 + c; c = g3 >> 26u; g3 &= 0x3ffffff;
+    g4 = h4 + c - (1u << 26u);
+
+    masque = (g4 >> 31u) - 1u;
+    h0 = (h0 & ~masque) | (g0 & masque);
+    h1 = (h1 & ~masque) | (g1 & masque);
+    h2 = (h2 & ~masque) | (g2 & masque);
+    h3 = (h3 & ~masque) | (g3 & masque);
+    h4 = (h4 & ~masque) | (g4 & masque);
+
+    // tag = (h + s) mod 2^128
+    h0 = h0 | (h1 << 26u);
+    h1 = (h1 >> 6u) | (h2 << 20u);
+    h2 = (h2 >> 12u) | (h3 << 14u);
+    h3 = (h3 >> 18u) | (h4 << 8u);
+
+    f = (unsigned long long) h0 + contexte->s[0]; ecrireMot32LE(tag, (unsigned int) f);
+    f = (unsigned long long) h1 + contexte->s[1] + (f >> 32u); ecrireMot32LE(tag + 4, (unsigned int) f);
+    f = (unsigned long long) h2 + contexte->s[2] + (f >> 32u); ecrireMot32LE(tag + 8, (unsigned int) f);
+    f = (unsigned long long) h3 + contexte->s[3] + (f >> 32u); ecrireMot32LE(tag + 12, (unsigned int) f);
+}
+
+
+void tagChaCha20Poly1305(const unsigned char cle[TAILLE_CLE_AEAD], const unsigned char nonce[TAILLE_NONCE_AEAD], const unsigned char* aad, size_t tailleAad, const unsigned char* chiffre, size_t taille, unsigned char tag[TAILLE_TAG_AEAD]) {
+
+    unsigned int etat[16];
+    unsigned char bloc0[64], zeros[16] = {0}, longueurs[16];
+    poly1305_t poly;
+
+    // Clé Poly1305 à usage unique: les 32 premiers octets du bloc 0
+    initEtatChaCha20(etat, cle, nonce, 0);
+    blocChaCha20(etat, bloc0);
+    initPoly1305(&poly, bloc0);
+
+    // Données associées puis chiffré, chacun complété à 16 octets, puis leurs longueurs
+    majPoly1305(&poly, aad, tailleAad);
+    if(tailleAad % 16 != 0)
+        majPoly1305(&poly, zeros, 16 - tailleAad % 16);
+    majPoly1305(&poly, chiffre, taille);
+    if(taille % 16 != 0)
+        majPoly1305(&poly, zeros, 16 - taille % 16);
+    ecrireMot32LE(longueurs, (unsigned int) tailleAad);
+    ecrireMot32LE(longueurs + 4, (unsigned int) ((unsigned long long) tailleAad >> 32u));
+    ecrireMot32LE(longueurs + 8, (unsigned int) taille);
+    ecrireMot32LE(longueurs + 12, (unsigned int) ((unsigned long long) taille >> 32u));
+    majPoly1305(&poly, longueurs, 16);
+    finPoly1305(&poly, tag);
+
+    memset(bloc0, 0, sizeof(bloc0));
+}
+
+
+int lireAleatoire(unsigned char* octets, size_t taille) {
+
+    FILE *f = fopen("/dev/urandom", "rb");
+    if(f == NULL)
+        return ERROR_OPEN;
+
+    if(fread(octets, 1, taille, f) != taille) {
+        fclose(f);
+        return ERROR_OPEN;
+    }
+
+    fclose(f);
+
+    return ERROR_OK;
+}
+
+
+int chiffrerCharge(unsigned char** charge, size_t* tailleCharge, const char* motDePasse, const unsigned char* aad, size_t tailleAad) {
+
+    unsigned char *resultat, cle[TAILLE_CLE_AEAD], *sel, *nonce;
+    int error;
+
+    resultat = (unsigned char*) malloc((*tailleCharge) + TAILLE_SURCOUT_AEAD + 1);
+    if(resultat == NULL)
+        return ERROR_NOMEM;
+
+    sel = resultat;
+    nonce = resultat + TAILLE_SEL_AEAD;
+    error = lireAleatoire(resultat, TAILLE_SEL_AEAD + TAILLE_NONCE_AEAD);
+    if(error != ERROR_OK) {
+        free(resultat);
+        return error;
+    }
+
+    deriverCle(motDePasse, sel, TAILLE_SEL_AEAD, ITERATIONS_PBKDF2, cle);
+
+    memcpy(resultat + TAILLE_SEL_AEAD + TAILLE_NONCE_AEAD, *charge, *tailleCharge);
+    xorChaCha20(cle, nonce, 0, resultat + TAILLE_SEL_AEAD + TAILLE_NONCE_AEAD, *tailleCharge);
+    tagChaCha20Poly1305(cle, nonce, aad, tailleAad, resultat + TAILLE_SEL_AEAD + TAILLE_NONCE_AEAD, *tailleCharge, resultat + TAILLE_SEL_AEAD + TAILLE_NONCE_AEAD + (*tailleCharge));
+
+    memset(cle, 0, sizeof(cle));
+    free(*charge);
+    *charge = resultat;
+    *tailleCharge += TAILLE_SURCOUT_AEAD;
+
+    return ERROR_OK;
+}
+
+
+int dechiffrerCharge(const unsigned char* charge, size_t tailleCharge, const char* motDePasse, const unsigned char* aad, size_t tailleAad, unsigned char** sortie, size_t* tailleSortie) {
+
+    unsigned char cle[TAILLE_CLE_AEAD], tag[TAILLE_TAG_AEAD], difference = 0;
+    const unsigned char *nonce, *chiffre;
+    int i;
+
+    if(tailleCharge < TAILLE_SURCOUT_AEAD)
+        return ERROR_FORMAT;
+
+    nonce = charge + TAILLE_SEL_AEAD;
+    chiffre = nonce + TAILLE_NONCE_AEAD;
+    *tailleSortie = tailleCharge - TAILLE_SURCOUT_AEAD;
+
+    deriverCle(motDePasse, charge, TAILLE_SEL_AEAD, ITERATIONS_PBKDF2, cle);
+
+    // Le tag est vérifié (en temps constant) avant de déchiffrer quoi que ce soit
+    tagChaCha20Poly1305(cle, nonce, aad, tailleAad, chiffre, *tailleSortie, tag);
+    for(i = 0; i < TAILLE_TAG_AEAD; i++) {
+        difference |= tag[i] ^ chiffre[*tailleSortie + i];
+    }
+    if(difference != 0) {
+        memset(cle, 0, sizeof(cle));
+        return ERROR_AUTHENTIFICATION;
+    }
+
+    *sortie = (unsigned char*) malloc((*tailleSortie) + 1);
+    if(*sortie == NULL) {
+        memset(cle, 0, sizeof(cle));
+        return ERROR_NOMEM;
+    }
+
+    memcpy(*sortie, chiffre, *tailleSortie);
+    xorChaCha20(cle, nonce, 0, *sortie, *tailleSortie);
+    memset(cle, 0, sizeof(cle));
+
+    return ERROR_OK;
+}
+
+
+int scellerCharge(const enteteConteneur_t* entete, unsigned char** charge, size_t* tailleCharge, const char* motDePasse) {
+
+    unsigned char octetsEntete[TAILLE_ENTETE_MAX];
+    int tailleEntete, error;
+
+    // Chiffrement puis table des CRC: l'entête, déjà complet, est authentifié comme données associées
+    if(entete->flags & FLAG_CONTENEUR_CHIFFRE) {
+        if(motDePasse == NULL)
+            return ERROR_INVARG;
+        error = serialiserEnteteConteneur(entete, octetsEntete, &tailleEntete);
+        if(error != ERROR_OK)
+            return error;
+        error = chiffrerCharge(charge, tailleCharge, motDePasse, octetsEntete, (size_t) tailleEntete);
+        if(error != ERROR_OK)
+            return error;
+    }
+
+    if(*tailleCharge != (size_t) entete->longueurCharge)
+        return ERROR_INVARG;
+
+    if(entete->flags & FLAG_CONTENEUR_CRC)
+        return ajouterTableCrc(charge, tailleCharge, 1L << entete->blocCrc);
+
+    return ERROR_OK;
+}
+
+
+int restaurerCharge(const enteteConteneur_t* entete, unsigned char* charge, size_t tailleCharge, const char* motDePasse, unsigned char** sortie, size_t* tailleSortie) {
+
+    unsigned char *dechiffre = NULL, octetsEntete[TAILLE_ENTETE_MAX];
+    size_t tailleDechiffre;
+    int tailleEntete, error;
+
+    // Les étapes sont annulées dans l'ordre inverse de l'insertion: déchiffrement puis décompression
+    if(entete->flags & FLAG_CONTENEUR_CHIFFRE) {
+        if(motDePasse == NULL)
+            return ERROR_INVARG;
+        // Le tag couvre aussi l'entête: une modification du mode, des indicateurs ou des longueurs fait échouer l'authentification
+        error = serialiserEnteteConteneur(entete, octetsEntete, &tailleEntete);
+        if(error != ERROR_OK)
+            return error;
+        error = dechiffrerCharge(charge, tailleCharge, motDePasse, octetsEntete, (size_t) tailleEntete, &dechiffre, &tailleDechiffre);
+        if(error != ERROR_OK)
+            return error;
+        charge = dechiffre;
+        tailleCharge = tailleDechiffre;
+    }
+
+    if(entete->flags & FLAG_CONTENEUR_COMPRESSE) {
+        error = decompresserCharge(charge, tailleCharge, sortie, tailleSortie);
+        freeAllVar(dechiffre, NULL, NULL, NULL, NULL, NULL, NULL);
+        return error;
+    }
+
+    // Aucune transformation à annuler: on rend une copie du message
+    if(dechiffre == NULL) {
+        dechiffre = (unsigned char*) malloc(tailleCharge + 1);
+        if(dechiffre == NULL)
+            return ERROR_NOMEM;
+        memcpy(dechiffre, charge, tailleCharge);
+    }
+
+    *sortie = dechiffre;
+    *tailleSortie = tailleCharge;
+
+    return ERROR_OK;
+}
+
+
+unsigned int crc32cTable(unsigned int crc, const unsigned char* octets, size_t taille) {
+
+    static unsigned int table[256];
+    static int tableInitialisee = 0;
+    unsigned int i, j, c;
+
+    if(!tableInitialisee) {
+        for(i = 0; i < 256; i++) {
+            c = i;
+            for(j = 0; j < 8; j++) {
+                c = (c >> 1u) ^ (0x82F63B78u & (0u - (c & 1u))); // Polynôme de Castagnoli (réfléchi)
+            }
+            table[i] = c;
+        }
+        tableInitialisee = 1;
+    }
+
+    while(taille--) {
+        crc = table[(crc ^ *octets++) & 0xFFu] ^ (crc >> 8u);
+    }
+
+    return crc;
+}
+
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2")))
+unsigned int crc32cMateriel(unsigned int crc, const unsigned char* octets, size_t taille) {
+
+    unsigned long long c = crc, mot;
+
+    while(taille >= 8) {
+        memcpy(&mot, octets, 8);
+        c = _mm_crc32_u64(c, mot);
+        octets += 8;
+        taille -= 8;
+    }
+
+    while(taille--) {
+        c = _mm_crc32_u8((unsigned int) c, *octets++);
+    }
+
+    return (unsigned int) c;
+}
+#endif
+
+
+unsigned int crc32c(const unsigned char* octets, size_t taille) {
+
+#if defined(__x86_64__)
+    static int materiel = -1;
+
+    if(materiel < 0) {
+        __builtin_cpu_init();
+        materiel = __builtin_cpu_supports("sse4.2") ? 1 : 0;
+    }
+
+    if(materiel)
+        return ~crc32cMateriel(0xFFFFFFFFu, octets, taille);
+#endif
+
+    return ~crc32cTable(0xFFFFFFFFu, octets, taille);
+}
+
+
+long int nbBlocsCrc(const enteteConteneur_t* entete) {
+
+    long int tailleBloc;
+
+    if(!(entete->flags & FLAG_CONTENEUR_CRC))
+        return 0;
+
+    tailleBloc = 1L << entete->blocCrc;
+
+    return ((long int) entete->longueurCharge + tailleBloc - 1) / tailleBloc;
+}
+
+
+int ajouterTableCrc(unsigned char** charge, size_t* tailleCharge, long int tailleBloc) {
+
+    size_t nbBlocs, b, debut, taille;
+    unsigned int crc;
+    unsigned char *resultat;
+
+    nbBlocs = ((*tailleCharge) + (size_t) tailleBloc - 1) / (size_t) tailleBloc;
+
+    resultat = (unsigned char*) malloc(nbBlocs * 4 + (*tailleCharge) + 1);
+    if(resultat == NULL)
+        return ERROR_NOMEM;
+
+    for(b = 0; b < nbBlocs; b++) {
+        debut = b * (size_t) tailleBloc;
+        taille = (*tailleCharge) - debut < (size_t) tailleBloc ? (*tailleCharge) - debut : (size_t) tailleBloc;
+        crc = crc32c((*charge) + debut, taille);
+        resultat[b * 4] = (unsigned char) (crc >> 24u);
+        resultat[b * 4 + 1] = (unsigned char) (crc >> 16u);
+        resultat[b * 4 + 2] = (unsigned char) (crc >> 8u);
+        resultat[b * 4 + 3] = (unsigned char) crc;
+    }
+
+    memcpy(resultat + nbBlocs * 4, *charge, *tailleCharge);
+
+    free(*charge);
+    *charge = resultat;
+    *tailleCharge += nbBlocs * 4;
+
+    return ERROR_OK;
+}
+
+
+unsigned char lireOctetIndexe(lecteurBits_t* lecteur, const int* tableIndex, long int indexOctet) {
+
+    unsigned int octet = 0, k;
+
+    if(tableIndex == NULL)
+        return lireOctetExtrait(lecteur, indexOctet);
+
+    for(k = 0; k < 8; k++) {
+        octet = (octet << 1u) | lireBitExtrait(lecteur, tableIndex[indexOctet * 8 + k]);
+    }
+
+    return (unsigned char) octet;
+}
+
+
+int lireTableCrc(lecteurBits_t* lecteur, const int* tableIndex, long int nbBlocs, unsigned int** crcAttendus) {
+
+    long int b;
+    int k;
+
+    *crcAttendus = (unsigned int*) malloc((size_t) (nbBlocs > 0 ? nbBlocs : 1) * sizeof(unsigned int));
+    if(*crcAttendus == NULL)
+        return ERROR_NOMEM;
+
+    for(b = 0; b < nbBlocs; b++) {
+        (*crcAttendus)[b] = 0;
+        for(k = 0; k < 4; k++) {
+            (*crcAttendus)[b] = ((*crcAttendus)[b] << 8u) | lireOctetIndexe(lecteur, tableIndex, b * 4 + k);
+        }
+    }
+
+    return ERROR_OK;
+}
+
+
+int verifierBlocsCrc(verificationBlocs_t* travail) {
+
+    long int nbBlocs, b, o, debut, taille;
+    unsigned char *bloc;
+
+    travail->blocInvalide = -1;
+    nbBlocs = (travail->longueurCharge + travail->tailleBloc - 1) / travail->tailleBloc;
+
+    bloc = (unsigned char*) malloc((size_t) travail->tailleBloc);
+    if(bloc == NULL)
+        return ERROR_NOMEM;
+
+    for(b = travail->premierBloc; b < nbBlocs; b += travail->pas) {
+
+        debut = b * travail->tailleBloc;
+        taille = travail->longueurCharge - debut < travail->tailleBloc ? travail->longueurCharge - debut : travail->tailleBloc;
+
+        for(o = 0; o < taille; o++) {
+            bloc[o] = lireOctetIndexe(&travail->lecteur, travail->tableIndex, travail->debutOctet + debut + o);
+        }
+
+        if(crc32c(bloc, (size_t) taille) != travail->crcAttendus[b]) {
+            travail->blocInvalide = b;
+            free(bloc);
+            return ERROR_CHECKSUM;
+        }
+    }
+
+    free(bloc);
+
+    return ERROR_OK;
+}
+
+
+/**
+ * Point d'entrée d'un thread de vérification (signature imposée par pthread_create).
+ */
+static void* threadVerification(void* argument) {
+
+    verificationBlocs_t *travail = (verificationBlocs_t*) argument;
+
+    travail->error = verifierBlocsCrc(travail);
+
+    return NULL;
+}
+
+
+int verifierChargeParallele(char* pathFile, lecteurBits_t* lecteur, const int* tableIndex, long int debutOctet, long int longueurCharge, const unsigned int* crcAttendus, long int tailleBloc, long int* blocInvalide) {
+
+    verificationBlocs_t *travaux;
+    pthread_t threads[NB_THREADS_VERIFICATION_MAX];
+    int lance[NB_THREADS_VERIFICATION_MAX];
+    long int nbBlocs, nbThreads, t;
+    int error = ERROR_OK;
+
+    *blocInvalide = -1;
+    nbBlocs = (longueurCharge + tailleBloc - 1) / tailleBloc;
+    if(nbBlocs == 0)
+        return ERROR_OK;
+
+    nbThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    if(nbThreads < 1)
+        nbThreads = 1;
+    if(nbThreads > NB_THREADS_VERIFICATION_MAX)
+        nbThreads = NB_THREADS_VERIFICATION_MAX;
+    if(nbThreads > nbBlocs)
+        nbThreads = nbBlocs;
+
+    travaux = (verificationBlocs_t*) malloc((size_t) nbThreads * sizeof(verificationBlocs_t));
+    if(travaux == NULL)
+        return ERROR_NOMEM;
+
+    // La table du CRC et le choix SSE4.2 sont initialisés avant le lancement des threads
+    crc32c(NULL, 0);
+
+    for(t = 0; t < nbThreads; t++) {
+
+        lance[t] = 0;
+        travaux[t].lecteur = *lecteur;
+        travaux[t].lecteur.blocCache = -1;
+        travaux[t].tableIndex = tableIndex;
+        travaux[t].debutOctet = debutOctet;
+        travaux[t].longueurCharge = longueurCharge;
+        travaux[t].crcAttendus = crcAttendus;
+        travaux[t].tailleBloc = tailleBloc;
+        travaux[t].premierBloc = t;
+        travaux[t].pas = nbThreads;
+        travaux[t].blocInvalide = -1;
+        travaux[t].error = ERROR_OK;
+        travaux[t].source.descripteur = -1;
+        travaux[t].source.pages = NULL;
+
+        // Le cache de pages n'est pas partagé: chaque thread ouvre l'image de son côté
+        if(lecteur->source->matriceImage != NULL || lecteur->source->octetsImage != NULL) {
+            travaux[t].source = *lecteur->source;
+        } else {
+            travaux[t].error = ouvrirSourceImage(&travaux[t].source, pathFile, lecteur->source->beginningImage, lecteur->source->dimension);
+            if(travaux[t].error != ERROR_OK)
+                continue;
+            travaux[t].source.largeurLigne = lecteur->source->largeurLigne;
+            travaux[t].source.nbCanaux = lecteur->source->nbCanaux;
+            travaux[t].source.pasLigne = lecteur->source->pasLigne;
+            travaux[t].source.octetsEchantillon = lecteur->source->octetsEchantillon;
+            vueCanauxSource(&travaux[t].source, lecteur->source->masqueCanaux);
+        }
+        travaux[t].lecteur.source = &travaux[t].source;
+
+        if(pthread_create(&threads[t], NULL, threadVerification, &travaux[t]) == 0)
+            lance[t] = 1;
+        else
+            travaux[t].error = ERROR_HANDLE;
+    }
+
+    for(t = 0; t < nbThreads; t++) {
+
+        if(lance[t])
+            pthread_join(threads[t], NULL);
+
+        if(lecteur->source->matriceImage == NULL && lecteur->source->octetsImage == NULL)
+            fermerSourceImage(&travaux[t].source);
+
+        // On garde le plus petit bloc invalide, une autre erreur est prioritaire
+        if(travaux[t].error == ERROR_CHECKSUM) {
+            if(*blocInvalide < 0 || travaux[t].blocInvalide < *blocInvalide)
+                *blocInvalide = travaux[t].blocInvalide;
+            if(error == ERROR_OK)
+                error = ERROR_CHECKSUM;
+        } else if(travaux[t].error != ERROR_OK) {
+            error = travaux[t].error;
+        }
+    }
+
+    free(travaux);
+
+    return error;
+}
+
+
+int decryptPlageOctets(lecteurBits_t* lecteur, long int tailleMsgBit, int estFichier, long int offset, long int longueur, unsigned char* sortie, long int* octetsLus) {
+
+    long int tailleMsgOctet, o;
+
+    *octetsLus = 0;
+
+    if(offset < 0 || longueur < 0 || sortie == NULL)
+        return ERROR_INVARG;
+
+    // Le parcours MODE_CHIFFRE n'existe que sous forme de table complète: pas d'accès direct possible
+    if(lecteur->mode == MODE_CHIFFRE)
+        return ERROR_INVARG;
+
+    tailleMsgOctet = tailleMsgBit / 8 - (estFichier ? TAILLE_SUFFIXE_EXTENSION : 0);
+    if(offset >= tailleMsgOctet)
+        return ERROR_OK;
+
+    if(longueur > tailleMsgOctet - offset)
+        longueur = tailleMsgOctet - offset;
+
+    for(o = 0; o < longueur; o++) {
+        sortie[o] = lireOctetExtrait(lecteur, offset + o);
+    }
+
+    *octetsLus = longueur;
+
+    return ERROR_OK;
+}
+
+
+int hideDimMsg(size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, long int* lengthDimensionPrefix) {
+    int randomNumber;
+    long int i, j, lengthEndOfMsgBinary, endOfMsg;
+    int *endOfMsgBinary, *dimMaxBinary;
+
+    // Le prefixe code une position dans l'image: il faut au moins un échantillon
+    if(dimension < 1)
+        return ERROR_INVARG;
+
+    //printf("tailleMsgBit: %ld", tailleMsgBit);
+
+    //printf("Dimension: %zd", dimension);
+    dimMaxBinary = num_to_bit(dimension, lengthDimensionPrefix);
+    //printf("\nTaille en bits de la dimension max: %d", lengthDimensionPrefix);
+    //printf("\nTaille en bits de la dimension max en binaire: ");
+    /*for(i = 0; i<lengthDimensionPrefix; i++) {
+        printf("%d", dimMaxBinary[i]);
+    }*/
+
+    if(dimension > (*lengthDimensionPrefix) && tailleMsgBit <= (size_t) (dimension - (*lengthDimensionPrefix))) {
+
+        //printf("\nTest de mémoire passé");
+        endOfMsg = (long int) tailleMsgBit + (*lengthDimensionPrefix);
+        //printf("\nPosition de la fin du message: %d", endOfMsg);
+
+        endOfMsgBinary = num_to_bit(endOfMsg, &lengthEndOfMsgBinary);
+        //printf("\nTaille en bits de la fin du message: %d", lengthEndOfMsgBinary);
+        //printf("\nPosition de la fin du message en binaire: ");
+        /*for(i = 0; i<lengthEndOfMsgBinary; i++) {
+            printf("%d", endOfMsgBinary[i]);
+        }*/
+        //printf("\n");
+
+        if (((*lengthDimensionPrefix) - lengthEndOfMsgBinary) > 0) {
+
+            for (i = 0; i < ((*lengthDimensionPrefix) - lengthEndOfMsgBinary); i++) {
+                randomNumber = rand() % 2; // On génère un nombre aléatoire entre 0 et 1;// NOLINT(cert-msc30-c, cert-msc50-cpp)
+
+                if (0 != ((matriceImage[i] & (1 << 0)) >> 0)) {
+
+                    if (randomNumber == 1) {
+                        if (matriceImage[i] != pixelIntensity) {
+                            matriceImage[i] = matriceImage[i] + 1;
+                        } else {
+                            matriceImage[i] = matriceImage[i] - 1;
+                        }
+                    } else {
+                        if (matriceImage[i] != 0) {
+                            matriceImage[i] = matriceImage[i] - 1;
+                        } else {
+                            matriceImage[i] = matriceImage[i] + 1;
+                        }
+                    }
+
+                }
+            }
+
+        }
+
+        //printf("\n%d zéros ont été ajouté !", (lengthDimensionPrefix - lengthEndOfMsgBinary));
+        //printf("\nOn ajoute la fin du message en binaire: ");
+        j = 0;
+        for (i = ((*lengthDimensionPrefix) - lengthEndOfMsgBinary); i < (*lengthDimensionPrefix); i++) {
+            randomNumber = rand() % 2; // On génère un nombre aléatoire entre 0 et 1;// NOLINT(cert-msc30-c, cert-msc50-cpp)
+            //printf("\n%d avec un i=%d", endOfMsgBinary[j], i);
+            if (endOfMsgBinary[j] != ((matriceImage[i] & (1 << 0)) >> 0)) {
+
+                if (randomNumber == 1) {
+                    if (matriceImage[i] != pixelIntensity) {
+                        matriceImage[i] = matriceImage[i] + 1;
+                    } else {
+                        matriceImage[i] = matriceImage[i] - 1;
+                    }
+                } else {
+                    if (matriceImage[i] != 0) {
+                        matriceImage[i] = matriceImage[i] - 1;
+                    } else {
+                        matriceImage[i] = matriceImage[i] + 1;
+                    }
+                }
+
+            }
+
+            j += 1;
+        }
+
+    }
+
+    return ERROR_OK;
+}
+
+int hideMessageHamming(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, unsigned int rows, unsigned int columns, unsigned int* compteurNbBitsModif) {
+
+    unsigned int **matriceHamming, j,k,o,i, **matriceResMul=NULL, **matriceResAdd = NULL, position, randomNumber;
+    unsigned int** bufferImage, **bufferMsg;
+    int error;
+
+    *compteurNbBitsModif = 0;
+
+    // On génère la matrice de Hamming
+    error = genererHamming(&matriceHamming,rows, columns);
+    if(error != ERROR_OK)
+        return error;
+
+
+
+    // On crée les tableaux bufferImage et bufferMsg et on les initialises. Ces tableaux contiendront les segments de l'image et du message utilisés pour faire les opérations de matrice.
+    bufferImage = (unsigned int**) malloc(sizeof(unsigned int) * 1);
+    if(bufferImage == NULL)
+        return ERROR_NOMEM;
+    for(i = 0; i < 1; i++) {
+        bufferImage[i] = (unsigned int*) malloc(sizeof(unsigned int) * columns);
+        if(bufferImage[i] == NULL)
+            return ERROR_NOMEM;
+    }
+
+    bufferMsg = (unsigned int**) malloc(sizeof(unsigned int) * 1);
+    if(bufferMsg == NULL)
+        return ERROR_NOMEM;
+    for(i = 0; i < 1; i++) {
+        bufferMsg[i] = (unsigned int*) malloc(sizeof(unsigned int) * rows);
+        if(bufferMsg[i] == NULL)
+            return ERROR_NOMEM;
+    }
+
+
+    srand(time(NULL)); // On rend le rank aléatoire pour la modification des bits
+
+    for(i = 0; i<ceil((double)tailleMsgBit/(double)rows); i++) {
+
+        // On Met à jour les segments de l'image et du message afin d'effectuer les calculs de matrice.
+        for(j = 0; j<columns; j++) {
+
+            // On crée une matrice bufferImage qui va contenir columns fois le nombre de bits de la matrice image (pour la séparé en séquence)
+            if(j+(i+(i*(columns-1))) < dimension)
+                (*bufferImage)[j] = matriceImage[lengthDimensionPrefix + j+(i+(i*(columns-1)))];
+            else
+                (*bufferImage)[j] = 1;
+
+        }
+
+        for(o=0; o<rows; o++) {
+            // On crée une matrice bufferMsg qui va contenir rows fois le nombre de bits de la matrice message (pour la séparé en séquence)
+            if(o+(i+(i*(rows-1))) < tailleMsgBit)
+                (*bufferMsg)[o] = messageBinary[o+(i+(i*(rows-1)))];
+            else
+                (*bufferMsg)[o] = 1;
+
+
+        }
+
+        // On crée la matrice en mémoire qui va accueillir le résultat de la multiplication
+        if(matriceResMul != NULL)
+            free(matriceResMul);
+
+        matriceResMul = (unsigned int**) malloc(sizeof(unsigned int) * 1);
+        if(matriceResMul == NULL)
+            return ERROR_NOMEM;
+
+        for(k = 0; k < 1; k++) {
+            matriceResMul[k] = (unsigned int*) malloc(sizeof(unsigned int) * rows);
+            if(matriceResMul[k] == NULL)
+                return ERROR_NOMEM;
+        }
+
+        // On effectue la multiplication (Pas besoin de passer toutes les dimensions de la matrice 1 car n1=m1
+        multiplyMatrice(rows, matriceHamming, 1, columns, bufferImage, &matriceResMul);
+
+
+        // On crée la matrice en mémoire qui va accueillir le résultat de l'addition
+        if(matriceResAdd != NULL)
+            free(matriceResAdd);
+
+        matriceResAdd = (unsigned int**) malloc(sizeof(unsigned int) * 1);
+        if(matriceResAdd == NULL)
+            return ERROR_NOMEM;
+
+        for(k = 0; k < 1; k++) {
+            matriceResAdd[k] = (unsigned int*) malloc(sizeof(unsigned int) * rows);
+            if(matriceResAdd[k] == NULL)
+                return ERROR_NOMEM;
+        }
+
+        // On aditionne le résultat précédent avec la matrice message
+        additionMatrice(1,rows, matriceResMul, bufferMsg, &matriceResAdd);
+
+        // Si le vecteur n'est pas nul, c'est qu'il faut effectuer une modification
+        if(!isVectorNull(matriceResAdd, rows)) {
+
+            // On recherche à quelle ligne on doit effectuer la modification
+            error = findInHamming(matriceHamming, columns, rows, matriceResAdd, &position);
+            if(error != ERROR_OK)
+                return error;
+
+            // On modifie le tableau en utilisant la même méthode du nombre aléatoire que l'insertion classique
+            randomNumber = rand() % 2; // On génère un nombre aléatoire entre 0 et 1;// NOLINT(cert-msc30-c, cert-msc50-cpp)
+            if(randomNumber == 1) {
+                if(matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] != pixelIntensity) {
+                    matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] = matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] + 1;
+                } else {
+                    matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] = matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] - 1;
+                }
+            } else {
+                if(matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] != 0) {
+                    matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] = matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] - 1;
+                } else {
+                    matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] = matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] + 1;
+                }
+            }
+
+            (*compteurNbBitsModif)++;
+
+
+        }
+
+
+    }
+
+    // On free toutes les variables que l'on a utilisées
+    for(i = 0; i < 1; i++) {
+        free(bufferImage[i]);
+    }
+    free(bufferImage);
+
+    for(i = 0; i < 1; i++) {
+        free(bufferMsg[i]);
+    }
+    free(bufferMsg);
+
+
+    for(k = 0; k < 1; k++) {
+        free(matriceResMul[k]);
+    }
+    free(matriceResMul);
+
+
+    for(k = 0; k < 1; k++) {
+        free(matriceResAdd[k]);
+    }
+
+    free(matriceResAdd);
+
+    for (i = 0; i < columns; i++) {
+        free(matriceHamming[i]);
+    }
+
+    free(matriceHamming);
+
+    return ERROR_OK;
+
+}
+
+
+
+int hideMessage(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, int crypt, char* keyCrypt) {
+
+    int i, randomNumber,j;
+    int *tablePermuteIndex = NULL;
+    parcoursCalculable_t parcours;
+
+    // On setup le random
+    if(tailleMsgBit <= (dimension - lengthDimensionPrefix)) {
+
+
+        j = 0;
+        int p = 0;
+        int bufferBitBinary;
+
+
+
+        if(crypt == 1) {
+            int error = genererTableParcours(keyCrypt, dimension, lengthDimensionPrefix, &tablePermuteIndex);
+            if(error != ERROR_OK)
+                return error;
+        } else if(crypt == 2) {
+            initParcoursCalculable(&parcours, keyCrypt, dimension, lengthDimensionPrefix);
+        }
+
+
+        srand(time(NULL)); // NOLINT(cert-msc30-c, cert-msc50-cpp)
+
+        j=0;
+        for(i = lengthDimensionPrefix; i<(tailleMsgBit + lengthDimensionPrefix); i++) {
+
+            randomNumber = rand() % 2; // On génère un nombre aléatoire entre 0 et 1; // NOLINT(cert-msc30-c, cert-msc50-cpp)
+
+
+            /* Petit fix pour choisir si on met une img ou un texte */
+
+            if(((messageBinary[j] - '0') == 0 ) || ((messageBinary[j] - '0') == 1 )) {
+                bufferBitBinary = (messageBinary[j] - '0');
+            } else {
+                bufferBitBinary = messageBinary[j];
+            }
+
+            /* Fin du petit fix */
+            if(crypt == 0) {
+                if (bufferBitBinary != ((matriceImage[i] & (1 << 0)) >> 0)) {
+
+                    if (randomNumber == 1) {
+                        if (matriceImage[i] != pixelIntensity) {
+                            matriceImage[i] = matriceImage[i] + 1;
+                        } else {
+                            matriceImage[i] = matriceImage[i] - 1;
+                        }
+                    } else {
+                        if (matriceImage[i] != 0) {
+                            matriceImage[i] = matriceImage[i] - 1;
+                        } else {
+                            matriceImage[i] = matriceImage[i] + 1;
+                        }
+                    }
+
+
+                }
+            } else if(crypt == 1) {
+                if (bufferBitBinary != ((matriceImage[tablePermuteIndex[i]] & (1 << 0)) >> 0)) {
+
+                    if (randomNumber == 1) {
+                        if (matriceImage[tablePermuteIndex[i]] != pixelIntensity) {
+                            matriceImage[tablePermuteIndex[i]] = matriceImage[tablePermuteIndex[i]] + 1;
+                        } else {
+                            matriceImage[tablePermuteIndex[i]] = matriceImage[tablePermuteIndex[i]] - 1;
+                        }
+                    } else {
+                        if (matriceImage[tablePermuteIndex[i]] != 0) {
+                            matriceImage[tablePermuteIndex[i]] = matriceImage[tablePermuteIndex[i]] - 1;
+                        } else {
+                            matriceImage[tablePermuteIndex[i]] = matriceImage[tablePermuteIndex[i]] + 1;
+                        }
+                    }
+
+
+                }
+            } else if(crypt == 2) {
+                long int position = positionParcoursCalculable(&parcours, i - lengthDimensionPrefix);
+                if (bufferBitBinary != ((matriceImage[position] & (1 << 0)) >> 0)) {
+
+                    if (randomNumber == 1) {
+                        if (matriceImage[position] != pixelIntensity) {
+                            matriceImage[position] = matriceImage[position] + 1;
+                        } else {
+                            matriceImage[position] = matriceImage[position] - 1;
+                        }
+                    } else {
+                        if (matriceImage[position] != 0) {
+                            matriceImage[position] = matriceImage[position] - 1;
+                        } else {
+                            matriceImage[position] = matriceImage[position] + 1;
+                        }
+                    }
+
+
+                }
+            } else {
+                return ERROR_INVARG;
+            }
+
+
+            j += 1;
+            p += 1;
+
+        }
+
+        if(crypt == 1)
+            free(tablePermuteIndex);
+
+        return ERROR_OK;
+    } else {
+        return ERROR_NOMEM;
+    }
+
+}
+
+
+
+
+
+/*
+ *  Nom: error_str
+ *  But: Retourner une chaîne de caractères correspondante à l'erreur fournit en paramètre
+ *
+ *  Paramètres d'entrées:
+ *      err: Le code d'erreur (error_t ou int)
+ *
+ *  Paramètres de sorties (sous forme de pointer):
+ *
+ *  Valeur de retour:
+ *      (const char*) La chaine de caractère puisée dans le tableau ERROR_STRS du fichier header.h correspondant à l'erreur fournit en paramètre.
+ *
+ */
+const char* error_str(error_t err)
+{
+    const char* err_str = NULL;
+
+    // On vérifie que l'erreur fournit en paramètre fait bien parti de la liste des erreurs du type error_t, sinon on rejoint "done" pour retourner NULL;
+    if (err >= ERROR_COUNT) {
+        goto done;
+    }
+
+    err_str = ERROR_STRS[err]; // On va chercher la bonne chaine de caractère correspondant à l'erreur dans le tableau ERROR_STRS initialisé dans header.h. Puisque error_t est un enum alors on peut le passé en indice du tableau car il est considéré comme un int.
+
+    done:
+    return err_str;
+}
+
+
+
+/*
+ *  Nom: writeImage
+ *  But: Ecrire les valeurs de la matrice de la photo dans un nouveau fichier
+ *
+ *  Paramètres d'entrées:
+ *      pathFile:       Le chemin vers le NOUVEAU fichier Portable pixmap (char*)
+ *      matrice:        La matrice (1d) où les données vont être récuperées (int*)
+ *      beginningImage: La position du curseur où commence les données de l'image (long int)
+ *      dimension:      Les dimensions de l'image (longueur*largeur et * 3 si couleur) (long int)
+ *
+ *  Paramètres de sorties (sous forme de pointer):
+ *
+ *  Valeur de retour:
+ *      (int) Le code erreur de type error_t à traduire grâce à la fonction error_str. Si la valeur de retour est égal à 0 (ERROR_OK) alors tout c'est déroulé normalement.
+ *
+ */
+int writeImage(char* pathFile, int* matrice, long int beginningImage, long int dimension) {
+    /* --------- DEFINITION DES VARIABLES --------- */
+    FILE* image = NULL;
+    int i = 0, caractereActuel, error;
+    /* ------- FIN DEFINITION DES VARIABLES ------- */
+
+    // On ouvre l'image
+    image = fopen(pathFile, "r+");
+
+    if(image != NULL) {
+
+        error = fseek(image, beginningImage, SEEK_SET);
+
+        if(error == 0) {
+            for(i=0; i<dimension; i++) {
+                fwrite(&matrice[i], 1, 1, image);
+            }
+
+        } else {
+            return ERROR_INVARG;
+        }
+
+    } else {
+        return ERROR_OPEN;
+    }
+
+    return 0;
+
+}
+
+
+/*
+ *  Nom: writeHeader
+ *  But: Ecrire les valeurs des paramètres du fichier dans un nouveau fichier
+ *
+ *  Paramètres d'entrées:
+ *      pathFile:       Le chemin vers le NOUVEAU fichier Portable pixmap (char*)
+ *      typeFile:       Le type du fichier (exemple "P6") (char*)
+ *      imageWidth:     la largeur de l'image (long int)
+ *      imageHeight:    La hauteur de l'image (long int)
+ *      pixelIntensity: L'intensité des pixels (exemple "255") (long int)
+ *
+ *  Paramètres de sorties (sous forme de pointer):
+ *      positionCursor: La position du curseur à la fin du header (*long int)
+ *
+ *  Valeur de retour:
+ *      (int) Le code erreur de type error_t à traduire grâce à la fonction error_str. Si la valeur de retour est égal à 0 (ERROR_OK) alors tout c'est déroulé normalement.
+ *
+ */
+int writeHeader(char* pathFile, char* typeFile, long int imageWidth, long int imageHeight, long int pixelIntensity, long int *positionCursor) {
+    /* --------- DEFINITION DES VARIABLES --------- */
+    FILE* image = NULL;
+    /* ------- FIN DEFINITION DES VARIABLES ------- */
+
+    // On ouvre l'image
+    image = fopen(pathFile, "w");
+
+    // On vérifie si l'ouverture de l'image s'est passée correctement
+    if (image != NULL) {
+
+        fputs(typeFile, image);
+        fprintf(image, "\n%ld %ld", imageWidth, imageHeight);
+        fprintf(image, "\n%ld\n", pixelIntensity);
+
+        *positionCursor = ftell(image);
+        fclose(image);   // On ferme le fichier
+
+        return ERROR_OK;
+
+    } else {
+        // Le fichier n'a pas pu s'ouvrir donc on retourne une erreur
+        return ERROR_OPEN;
+    }
+}
+
+
+/*
+ *  Nom: readImage
+ *  But: Retourner les valeurs de la matrice de la photo
+ *
+ *  Paramètres d'entrées:
+ *      pathFile:       Le chemin vers le fichier Portable pixmap (char*)
+ *
+ *  Paramètres de sorties (sous forme de pointer):
+ *      matrice:        La matrice (1d) où les données vont être écritent (int*)
+ *      beginningImage: La position du curseur où commence les données de l'image (long int)
+ *      dimension:      Les dimensions de l'image (longueur*largeur et * 3 si couleur) (long int)
+
+ *
+ *  Valeur de retour:
+ *      (int) Le code erreur de type error_t à traduire grâce à la fonction error_str. Si la valeur de retour est égal à 0 (ERROR_OK) alors tout c'est déroulé normalement.
+ *
+ */
+int readImage(char* pathFile, int* matrice, long int beginningImage, long int dimension) {
+    /* --------- DEFINITION DES VARIABLES --------- */
+    FILE* image = NULL;
+    int i = 0, error;
+    /* ------- FIN DEFINITION DES VARIABLES ------- */
+
+    // On ouvre l'image
+    image = fopen(pathFile, "r");
+
+    if(image != NULL) {
+
+        error = fseek(image, beginningImage, SEEK_SET);
+
+        if(error == 0) {
+            for(i=0; i<dimension; i++) {
+                matrice[i] = fgetc(image);
+            }
+
+            fclose(image);
+
+            return ERROR_OK;
+
+        } else {
+            return ERROR_INVARG;
+        }
+
+    } else {
+        return ERROR_OPEN;
+    }
+
+}
+
+
+/*
+ *  Nom: readHeader
+ *  But: Retourner les valeurs des paramètres du header des fichiers Portable pixmap
+ *
+ *  Paramètres d'entrées:
+ *      pathFile:       Le chemin vers le fichier Portable pixmap (char*)
+ *
+ *  Paramètres de sorties (sous forme de pointer):
+ *      typeFile:       Le type du fichier (exemple "P6") (char*)
+ *      imageWidth:     la largeur de l'image (pointer to long int)
+ *      imageHeight:    La hauteur de l'image (pointer to long int)
+ *      pixelIntensity: L'intensité des pixels (exemple "255") (pointer to long int)
+ *      positionCursor: La position du curseur à la fin du header (*long int)
+ *
+ *  Valeur de retour:
+ *      (int) Le code erreur de type error_t à traduire grâce à la fonction error_str. Si la valeur de retour est égal à 0 (ERROR_OK) alors tout c'est déroulé normalement.
+ *
+ */
+int readHeader(char* pathFile, char* typeFile, long int *imageWidth, long int *imageHeight, long int *pixelIntensity, long int *positionCursor) {
+
+    /* --------- DEFINITION DES VARIABLES --------- */
+    FILE* image = NULL;
+    char *ptr;
+    int compteurLigne = 0;
+    char buffer[50];
+
+    /* ------- FIN DEFINITION DES VARIABLES ------- */
+
+    // On ouvre l'image
+    image = fopen(pathFile, "r");
+
+    // On vérifie si l'ouverture de l'image s'est passée correctement
+    if (image != NULL) {
+
+        // Cette boucle va tourner dans le header du fixer Portable pixelmap pour récuperer toutes les informations.
+        while(compteurLigne < 3) {
+
+            // On récupère la neme ligne du header que l'on stock dans buffer
+            fgets(buffer, 50, image);
+            // On supprime le '\n' qui se rajoute automatiquement à cause de la fonction fgets
+            strtok(buffer, "\n");
+
+            // Si la ligne est un commentaire (i.e commençant par '#' alors on saute la boucle)
+            if(buffer[0] == '#')
+                continue;
+
+            /*  Ce switch en fonction de compteurLigne nous aide à determiner si la ligne actuelle correspond au type de fichier, à sa largeur etc.....
+             *  On a:
+             *      case 0: La ligne correspond au type du fichier
+             *      case 1: La ligne correspond aux dimensions de l'image (longueur*hauteur)
+             *      case 2: La ligne correspond à l'intensité des pixels
+             *
+             */
+            switch(compteurLigne) {
+                case 0:
+                    strncpy(typeFile, buffer, 50); // On retourne le type de l'image en copiant le buffer dans typeFile
+                    break;
+                case 1:
+
+                    /* Ici on rencontre un problème: les dimensions de l'image (longueur*hauteur) sont sur la même ligne.
+                     * On doit donc les séparer en deux en utilisant comme séparateur l'espace vide " ".
+                     * La fonction strtok va nous aider à faire cela.
+                     */
+
+
+                    ptr = strtok(buffer, " ");
+
+                    for(int j=0; j<2; j++) {
+                        if(j == 0) {                  // Si on est à la première partie de la ligne alors c'est la longueur donc on retourne la valeur dans imageWidth en convertissant buffer (chaine de caractère) en long int grâce à la fonction strtol
+                            *imageWidth = strtol(ptr, NULL, 10);
+                        } else if(j == 1) {           // Si on est à la deuxème partie de la ligne alors c'est la hauteur donc on retourne la valeur dans imageHeight en convertissant buffer (chaine de caractère) en long int grâce à la fonction strtol
+                            *imageHeight = strtol(ptr, NULL, 10);
+                        }
+                        ptr = strtok(NULL, " ");
+                    }
+                    break;
+                case 2:
+                    *pixelIntensity = strtol(buffer, NULL, 10); // On retourne la valeur de la ligne dans pixelIntensity en convertissant buffer (chaine de caractère) en long int grâce à la fonction strtol
+                    break;
+
+                default: // S'il y a plus de trois paramètres alors il y a une erreur.
+                    return ERROR_HANDLE;
+            }
+
+            compteurLigne++;
+        }
+
+        *positionCursor = ftell(image); // Position du curseur
+        fclose(image);   // On ferme le fichier
+        return ERROR_OK; // Pas d'erreurs on retourne la valeur normal
+
+    } else {
+        // Le fichier n'a pas pu s'ouvrir donc on retourne une erreur
+        return ERROR_OPEN;
+    }
+
+}
+
+
+/* Valeur entière d'une ligne de l'entête PAM, -1 si elle n'est pas valide */
+static long int valeurPAM(const char* valeur) {
+
+    char *fin;
+    long int resultat;
+
+    if(valeur == NULL)
+        return -1;
+
+    resultat = strtol(valeur, &fin, 10);
+    if(fin == valeur || *fin != '\0' || resultat <= 0 || resultat == LONG_MAX)
+        return -1;
+
+    return resultat;
+}
+
+int readHeaderPAM(char* pathFile, long int *imageWidth, long int *imageHeight, long int *profondeur, long int *pixelIntensity, char* tuplType, long int *positionCursor) {
+
+    FILE* image = NULL;
+    char ligne[TAILLE_LIGNE_PAM], *cle, *valeur;
+    int fin = 0;
+
+    *imageWidth = *imageHeight = *profondeur = *pixelIntensity = -1;
+    tuplType[0] = '\0';
+
+    image = fopen(pathFile, "rb");
+    if(image == NULL)
+        return ERROR_OPEN;
+
+    if(fgets(ligne, sizeof(ligne), image) == NULL || strncmp(ligne, "P7", 2) != 0) {
+        fclose(image);
+        return ERROR_FORMAT;
+    }
+
+    // Une ligne "CLE valeur" par paramètre, jusqu'à ENDHDR
+    while(!fin && fgets(ligne, sizeof(ligne), image) != NULL) {
+
+        if(strchr(ligne, '\n') == NULL) {
+            fclose(image);
+            return ERROR_FORMAT;
+        }
+
+        cle = strtok(ligne, " \t\r\n");
+        if(cle == NULL || cle[0] == '#')
+            continue;
+        valeur = strtok(NULL, " \t\r\n");
+
+        if(strcmp(cle, "ENDHDR") == 0)
+            fin = 1;
+        else if(strcmp(cle, "WIDTH") == 0)
+            *imageWidth = valeurPAM(valeur);
+        else if(strcmp(cle, "HEIGHT") == 0)
+            *imageHeight = valeurPAM(valeur);
+        else if(strcmp(cle, "DEPTH") == 0)
+            *profondeur = valeurPAM(valeur);
+        else if(strcmp(cle, "MAXVAL") == 0)
+            *pixelIntensity = valeurPAM(valeur);
+        else if(strcmp(cle, "TUPLTYPE") == 0 && valeur != NULL && strlen(tuplType) + strlen(valeur) + 2 <= TAILLE_TUPLTYPE_PAM) {
+            // Plusieurs lignes TUPLTYPE se concatènent, séparées par un espace
+            if(tuplType[0] != '\0')
+                strcat(tuplType, " ");
+            strcat(tuplType, valeur);
+        }
+    }
+
+    *positionCursor = ftell(image);
+    fclose(image);
+
+    if(!fin || *imageWidth < 0 || *imageHeight < 0 || *profondeur < 0 || *pixelIntensity < 0)
+        return ERROR_FORMAT;
+
+    return ERROR_OK;
+}
+
+
+int writeHeaderPAM(char* pathFile, long int imageWidth, long int imageHeight, long int profondeur, long int pixelIntensity, const char* tuplType, long int *positionCursor) {
+
+    FILE* image = NULL;
+
+    image = fopen(pathFile, "w");
+    if(image == NULL)
+        return ERROR_OPEN;
+
+    fprintf(image, "P7\nWIDTH %ld\nHEIGHT %ld\nDEPTH %ld\nMAXVAL %ld\n", imageWidth, imageHeight, profondeur, pixelIntensity);
+    if(tuplType != NULL && tuplType[0] != '\0')
+        fprintf(image, "TUPLTYPE %s\n", tuplType);
+    fputs("ENDHDR\n", image);
+
+    *positionCursor = ftell(image);
+    fclose(image);
+
+    return ERROR_OK;
+}
+
+
+int lireFormatImage(char* pathFile, char* typeFile, long int *imageWidth, long int *imageHeight, long int *profondeur, long int *pixelIntensity, char* tuplType, long int *beginningImage, long int *dimension) {
+
+    static const char* nomsComposantesPNG[5] = {"", "GRAYSCALE", "GRAYSCALE_ALPHA", "RGB", "RGB_ALPHA"};
+    FILE* image = NULL;
+    char magique[3] = "";
+    long int bitsParEchantillon = 0, tailleFichier;
+    int error;
+
+    image = fopen(pathFile, "rb");
+    if(image == NULL)
+        return ERROR_OPEN;
+    if(fread(magique, 1, 2, image) != 2) {
+        fclose(image);
+        return ERROR_FORMAT;
+    }
+    fclose(image);
+
+    tuplType[0] = '\0';
+
+    if(strcmp(magique, "P7") == 0) {
+        strcpy(typeFile, "P7");
+        error = readHeaderPAM(pathFile, imageWidth, imageHeight, profondeur, pixelIntensity, tuplType, beginningImage);
+    } else if((unsigned char) magique[0] == 0x89 && magique[1] == 'P') {
+        strcpy(typeFile, "PNG");
+        error = readHeaderPNG(pathFile, imageWidth, imageHeight, profondeur);
+        strcpy(tuplType, nomsComposantesPNG[*profondeur > 0 && *profondeur <= 4 ? *profondeur : 0]);
+        *pixelIntensity = 255;
+        *beginningImage = 0;
+    } else if(strcmp(magique, "BM") == 0) {
+        // Les composantes d'un BMP sont rangées dans l'ordre B, G, R (, A)
+        strcpy(typeFile, "BMP");
+        error = readHeaderBMP(pathFile, imageWidth, imageHeight, profondeur, beginningImage);
+        strcpy(tuplType, *profondeur == 4 ? "BGRA" : "BGR");
+        *pixelIntensity = 255;
+    } else if(strcmp(magique, "RI") == 0) {
+        // Un WAV est vu comme une image d'une ligne: une trame par pixel, un canal audio par composante
+        strcpy(typeFile, "WAV");
+        error = readHeaderWAV(pathFile, imageWidth, profondeur, &bitsParEchantillon, beginningImage);
+        strcpy(tuplType, *profondeur == 1 ? "MONO" : (*profondeur == 2 ? "STEREO" : "MULTICANAL"));
+        *imageHeight = 1;
+        *pixelIntensity = (1L << bitsParEchantillon) - 1;
+    } else {
+        error = readHeader(pathFile, typeFile, imageWidth, imageHeight, pixelIntensity, beginningImage);
+        if(strcmp(typeFile, "P6") == 0 || strcmp(typeFile, "P3") == 0)
+            *profondeur = 3;
+        else if(strcmp(typeFile, "P5") == 0 || strcmp(typeFile, "P2") == 0)
+            *profondeur = 1;
+        else if(error == ERROR_OK)
+            error = ERROR_INVARG;
+    }
+    if(error != ERROR_OK)
+        return error;
+
+    // Les échantillons d'une image sont lus octet par octet, ceux d'un WAV sur 1 à 3 octets
+    if(*imageWidth <= 0 || *imageHeight <= 0 || *profondeur <= 0 || *pixelIntensity <= 0 || (*pixelIntensity > 255 && strcmp(typeFile, "WAV") != 0))
+        return ERROR_FORMAT;
+
+    // Chaque produit est vérifié: un entête ne peut pas annoncer plus d'échantillons qu'un long n'en compte
+    if(*imageWidth > LONG_MAX / *imageHeight || (*imageWidth) * (*imageHeight) > LONG_MAX / *profondeur)
+        return ERROR_FORMAT;
+
+    *dimension = (*imageWidth) * (*imageHeight) * (*profondeur);
+
+    // Ni plus d'échantillons que le fichier ne peut en contenir: rien n'est alloué pour une image tronquée ou un entête falsifié
+    image = fopen(pathFile, "rb");
+    if(image == NULL)
+        return ERROR_OPEN;
+    if(fseek(image, 0, SEEK_END) != 0 || (tailleFichier = ftell(image)) < *beginningImage) {
+        fclose(image);
+        return ERROR_FORMAT;
+    }
+    fclose(image);
+    tailleFichier -= *beginningImage;
+
+    if(strcmp(typeFile, "PNG") == 0)
+        // Les lignes décompressées font au moins un octet par échantillon, deflate ne compresse pas plus de TAUX_MAX_DEFLATE fois
+        error = *dimension / TAUX_MAX_DEFLATE > tailleFichier;
+    else if(strcmp(typeFile, "BMP") == 0)
+        error = pasLigneFormat(typeFile, *imageWidth, *profondeur) > tailleFichier / *imageHeight;
+    else if(estFormatASCII(typeFile))
+        // Au moins un caractère par échantillon
+        error = *dimension > tailleFichier;
+    else
+        error = *dimension > tailleFichier / octetsEchantillonFormat(typeFile, *pixelIntensity);
+
+    return error ? ERROR_FORMAT : ERROR_OK;
+}
+
+
+int estFormatASCII(const char* typeFile) {
+
+    return strcmp(typeFile, "P2") == 0 || strcmp(typeFile, "P3") == 0;
+}
+
+
+long int pasLigneFormat(const char* typeFile, long int imageWidth, long int profondeur) {
+
+    // Les lignes d'un BMP sont complétées à un multiple de 4 octets
+    if(strcmp(typeFile, "BMP") == 0)
+        return (imageWidth * profondeur + 3) & ~3L;
+
+    return imageWidth * profondeur;
+}
+
+
+int octetsEchantillonFormat(const char* typeFile, long int pixelIntensity) {
+
+    int octets = 1;
+
+    // Seuls les échantillons d'un WAV occupent plusieurs octets
+    if(strcmp(typeFile, "WAV") == 0) {
+        while(octets < 4 && (pixelIntensity >> (8 * octets)) != 0)
+            octets++;
+    }
+
+    return octets;
+}
+
+
+/* Entiers little-endian des entêtes BMP */
+static unsigned long lireU16LE(const unsigned char* octets) {
+
+    return (unsigned long) octets[0] | ((unsigned long) octets[1] << 8);
+}
+
+static unsigned long lireU32LE(const unsigned char* octets) {
+
+    return lireU16LE(octets) | (lireU16LE(octets + 2) << 16);
+}
+
+
+int readHeaderBMP(char* pathFile, long int *imageWidth, long int *imageHeight, long int *profondeur, long int *positionCursor) {
+
+    FILE* image = NULL;
+    unsigned char entete[TAILLE_ENTETE_BMP];
+    unsigned long tailleDib, bitsParPixel, compression;
+    long int hauteur, tailleFichier;
+
+    image = fopen(pathFile, "rb");
+    if(image == NULL)
+        return ERROR_OPEN;
+
+    // BITMAPFILEHEADER (14 octets) puis au moins un BITMAPINFOHEADER (40 octets)
+    if(fread(entete, 1, TAILLE_ENTETE_BMP, image) != TAILLE_ENTETE_BMP || fseek(image, 0, SEEK_END) != 0) {
+        fclose(image);
+        return ERROR_FORMAT;
+    }
+    tailleFichier = ftell(image);
+    fclose(image);
+
+    tailleDib = lireU32LE(entete + 14);
+    *imageWidth = (long int) (int) lireU32LE(entete + 18);
+    hauteur = (long int) (int) lireU32LE(entete + 22);
+    bitsParPixel = lireU16LE(entete + 28);
+    compression = lireU32LE(entete + 30);
+    *positionCursor = (long int) lireU32LE(entete + 10);
+
+    // Seuls les pixels 24 et 32 bits non compressés sont acceptés (BI_RGB, ou BI_BITFIELDS qui ne change pas la taille des pixels en 32 bits)
+    if(entete[0] != 'B' || entete[1] != 'M' || tailleDib < 40 || lireU16LE(entete + 26) != 1)
+        return ERROR_FORMAT;
+    if((bitsParPixel != 24 && bitsParPixel != 32) || !(compression == 0 || (compression == 3 && bitsParPixel == 32)))
+        return ERROR_FORMAT;
+
+    // Une hauteur négative désigne un BMP rangé de haut en bas: l'ordre des lignes dans le fichier ne change pas la lecture
+    *imageHeight = hauteur < 0 ? -hauteur : hauteur;
+    *profondeur = (long int) bitsParPixel / 8;
+
+    if(*imageWidth <= 0 || *imageHeight <= 0 || *positionCursor < TAILLE_ENTETE_BMP)
+        return ERROR_FORMAT;
+    if(*positionCursor + pasLigneFormat("BMP", *imageWidth, *profondeur) * (*imageHeight) > tailleFichier)
+        return ERROR_FORMAT;
+
+    return ERROR_OK;
+}
+
+
+int readImageBMP(char* pathFile, int* matrice, long int beginningImage, long int largeurLigne, long int nbLignes, long int pasLigne) {
+
+    FILE* image = NULL;
+    unsigned char* ligne;
+    long int y, x;
+    int error = ERROR_OK;
+
+    image = fopen(pathFile, "rb");
+    if(image == NULL)
+        return ERROR_OPEN;
+
+    ligne = (unsigned char*) malloc((size_t) pasLigne);
+    if(ligne == NULL) {
+        fclose(image);
+        return ERROR_NOMEM;
+    }
+
+    // Les lignes sont lues dans l'ordre du fichier, sans les octets de bourrage
+    if(fseek(image, beginningImage, SEEK_SET) != 0)
+        error = ERROR_INVARG;
+
+    for(y = 0; y < nbLignes && error == ERROR_OK; y++) {
+        if((long int) fread(ligne, 1, (size_t) pasLigne, image) != pasLigne) {
+            error = ERROR_FORMAT;
+            break;
+        }
+        for(x = 0; x < largeurLigne; x++)
+            matrice[y * largeurLigne + x] = ligne[x];
+    }
+
+    free(ligne);
+    fclose(image);
+
+    return error;
+}
+
+
+int writeImageBMP(char* pathFile, int* matrice, long int beginningImage, long int largeurLigne, long int nbLignes, long int pasLigne) {
+
+    unsigned char* ligne;
+    long int y, x, debut;
+    off_t position;
+    int descripteur, error = ERROR_OK;
+
+    descripteur = open(pathFile, O_RDWR);
+    if(descripteur < 0)
+        return ERROR_OPEN;
+
+    ligne = (unsigned char*) malloc((size_t) pasLigne);
+    if(ligne == NULL) {
+        close(descripteur);
+        return ERROR_NOMEM;
+    }
+
+    for(y = 0; y < nbLignes && error == ERROR_OK; y++) {
+
+        position = (off_t) (beginningImage + y * pasLigne);
+        if(pread(descripteur, ligne, (size_t) largeurLigne, position) != (ssize_t) largeurLigne) {
+            error = ERROR_FORMAT;
+            break;
+        }
+
+        // Seules les suites d'octets modifiés sont réécrites
+        for(x = 0; x < largeurLigne; x++) {
+
+            if(ligne[x] == (unsigned char) matrice[y * largeurLigne + x])
+                continue;
+
+            debut = x;
+            for(; x < largeurLigne && ligne[x] != (unsigned char) matrice[y * largeurLigne + x]; x++)
+                ligne[x] = (unsigned char) matrice[y * largeurLigne + x];
+
+            if(pwrite(descripteur, ligne + debut, (size_t) (x - debut), position + debut) != (ssize_t) (x - debut)) {
+                error = ERROR_HANDLE;
+                break;
+            }
+        }
+    }
+
+    free(ligne);
+    close(descripteur);
+
+    return error;
+}
+
+
+int copierFichier(char* pathSource, char* pathDestination) {
+
+    FILE *source = NULL, *destination = NULL;
+    char tampon[TAILLE_TAMPON_FLUX];
+    size_t lus;
+    int error = ERROR_OK;
+
+    source = fopen(pathSource, "rb");
+    if(source == NULL)
+        return ERROR_OPEN;
+
+    destination = fopen(pathDestination, "wb");
+    if(destination == NULL) {
+        fclose(source);
+        return ERROR_OPEN;
+    }
+
+    while((lus = fread(tampon, 1, sizeof(tampon), source)) > 0) {
+        if(fwrite(tampon, 1, lus, destination) != lus) {
+            error = ERROR_HANDLE;
+            break;
+        }
+    }
+
+    fclose(source);
+    if(fclose(destination) != 0)
+        error = ERROR_HANDLE;
+
+    return error;
+}
+
+
+/* Échantillon PCM little-endian en binaire décalé: le bit de signe d'un échantillon 16 ou 24 bits est inversé pour obtenir une valeur entre 0 et maxval (un échantillon 8 bits est déjà non signé) */
+static int echantillonWAV(const unsigned char* octets, int octetsEchantillon) {
+
+    switch(octetsEchantillon) {
+        case 2:
+            return (int) (lireU16LE(octets) ^ 0x8000u);
+        case 3:
+            return (int) ((lireU16LE(octets) | ((unsigned long) octets[2] << 16)) ^ 0x800000u);
+        default:
+            return octets[0];
+    }
+}
+
+static void ecrireEchantillonWAV(unsigned char* octets, int valeur, int octetsEchantillon) {
+
+    unsigned int v = (unsigned int) valeur;
+    int i;
+
+    if(octetsEchantillon > 1)
+        v ^= 1u << (8 * octetsEchantillon - 1);
+
+    for(i = 0; i < octetsEchantillon; i++)
+        octets[i] = (unsigned char) (v >> (8 * i));
+}
+
+
+int readHeaderWAV(char* pathFile, long int *nbTrames, long int *nbCanaux, long int *bitsParEchantillon, long int *positionCursor) {
+
+    FILE* son = NULL;
+    unsigned char entete[12], chunk[8], format[TAILLE_FORMAT_WAV];
+    unsigned long tailleChunk, formatAudio = 0;
+    long int position = 12, tailleFichier, tailleDonnees = -1, octetsTrame = 0;
+    size_t lus;
+    int error = ERROR_OK;
+
+    son = fopen(pathFile, "rb");
+    if(son == NULL)
+        return ERROR_OPEN;
+
+    if(fread(entete, 1, 12, son) != 12 || memcmp(entete, "RIFF", 4) != 0 || memcmp(entete + 8, "WAVE", 4) != 0 || fseek(son, 0, SEEK_END) != 0) {
+        fclose(son);
+        return ERROR_FORMAT;
+    }
+    tailleFichier = ftell(son);
+
+    *nbCanaux = 0;
+    *bitsParEchantillon = 0;
+
+    // Les chunks sont parcourus jusqu'au chunk data (LIST, fact... sont ignorés), fmt doit le précéder
+    while(tailleDonnees < 0 && position + 8 <= tailleFichier && error == ERROR_OK) {
+
+        if(fseek(son, position, SEEK_SET) != 0 || fread(chunk, 1, 8, son) != 8) {
+            error = ERROR_FORMAT;
+            break;
+        }
+        tailleChunk = lireU32LE(chunk + 4);
+
+        if(memcmp(chunk, "fmt ", 4) == 0) {
+            lus = fread(format, 1, tailleChunk < TAILLE_FORMAT_WAV ? (size_t) tailleChunk : TAILLE_FORMAT_WAV, son);
+            if(tailleChunk < 16 || lus < 16) {
+                error = ERROR_FORMAT;
+                break;
+            }
+            formatAudio = lireU16LE(format);
+            *nbCanaux = (long int) lireU16LE(format + 2);
+            octetsTrame = (long int) lireU16LE(format + 12);
+            *bitsParEchantillon = (long int) lireU16LE(format + 14);
+
+            // WAVE_FORMAT_EXTENSIBLE: le format réel est au début du GUID du sous-format
+            if(formatAudio == 0xFFFE && lus >= TAILLE_FORMAT_WAV)
+                formatAudio = lireU16LE(format + 24);
+        } else if(memcmp(chunk, "data", 4) == 0) {
+            *positionCursor = position + 8;
+            tailleDonnees = (long int) tailleChunk;
+            // Enregistrement interrompu: le chunk data annonce plus d'octets que le fichier n'en contient
+            if(tailleDonnees > tailleFichier - *positionCursor)
+                tailleDonnees = tailleFichier - *positionCursor;
+        }
+
+        // Les chunks de taille impaire sont suivis d'un octet de bourrage
+        position += 8 + (long int) tailleChunk + (long int) (tailleChunk & 1);
+    }
+
+    fclose(son);
+    if(error != ERROR_OK)
+        return error;
+
+    // Seul le PCM entier 8, 16 ou 24 bits est accepté, avec des trames de nbCanaux échantillons contigus
+    if(tailleDonnees < 0 || formatAudio != 1 || *nbCanaux <= 0)
+        return ERROR_FORMAT;
+    if((*bitsParEchantillon != 8 && *bitsParEchantillon != 16 && *bitsParEchantillon != 24) || octetsTrame != *nbCanaux * (*bitsParEchantillon / 8))
+        return ERROR_FORMAT;
+
+    *nbTrames = tailleDonnees / octetsTrame;
+
+    return ERROR_OK;
+}
+
+
+int readImageWAV(char* pathFile, int* matrice, long int beginningImage, long int dimension, int octetsEchantillon) {
+
+    FILE* son = NULL;
+    unsigned char* tampon;
+    long int i = 0, k, n, tailleTampon = (TAILLE_TAMPON_FLUX / octetsEchantillon) * octetsEchantillon;
+    int error = ERROR_OK;
+
+    son = fopen(pathFile, "rb");
+    if(son == NULL)
+        return ERROR_OPEN;
+
+    tampon = (unsigned char*) malloc((size_t) tailleTampon);
+    if(tampon == NULL) {
+        fclose(son);
+        return ERROR_NOMEM;
+    }
+
+    if(fseek(son, beginningImage, SEEK_SET) != 0)
+        error = ERROR_INVARG;
+
+    // Le chunk data est lu par blocs d'un nombre entier d'échantillons
+    while(i < dimension && error == ERROR_OK) {
+        n = (dimension - i) * octetsEchantillon;
+        if(n > tailleTampon)
+            n = tailleTampon;
+        if((long int) fread(tampon, 1, (size_t) n, son) != n) {
+            error = ERROR_FORMAT;
+            break;
+        }
+        for(k = 0; k < n; k += octetsEchantillon)
+            matrice[i++] = echantillonWAV(tampon + k, octetsEchantillon);
+    }
+
+    free(tampon);
+    fclose(son);
+
+    return error;
+}
+
+
+int writeImageWAV(char* pathFile, int* matrice, long int beginningImage, long int dimension, int octetsEchantillon) {
+
+    unsigned char* tampon;
+    long int i, k, debut, n, tailleTampon = (TAILLE_TAMPON_FLUX / octetsEchantillon) * octetsEchantillon;
+    off_t position;
+    int descripteur, error = ERROR_OK;
+
+    descripteur = open(pathFile, O_RDWR);
+    if(descripteur < 0)
+        return ERROR_OPEN;
+
+    tampon = (unsigned char*) malloc((size_t) tailleTampon);
+    if(tampon == NULL) {
+        close(descripteur);
+        return ERROR_NOMEM;
+    }
+
+    for(i = 0; i < dimension && error == ERROR_OK; i += n / octetsEchantillon) {
+
+        n = (dimension - i) * octetsEchantillon;
+        if(n > tailleTampon)
+            n = tailleTampon;
+        position = (off_t) (beginningImage + i * octetsEchantillon);
+        if(pread(descripteur, tampon, (size_t) n, position) != (ssize_t) n) {
+            error = ERROR_FORMAT;
+            break;
+        }
+
+        // Comme pour un BMP, seules les suites d'échantillons modifiés sont réécrites
+        for(k = 0; k < n; k += octetsEchantillon) {
+
+            if(echantillonWAV(tampon + k, octetsEchantillon) == matrice[i + k / octetsEchantillon])
+                continue;
+
+            debut = k;
+            for(; k < n && echantillonWAV(tampon + k, octetsEchantillon) != matrice[i + k / octetsEchantillon]; k += octetsEchantillon)
+                ecrireEchantillonWAV(tampon + k, matrice[i + k / octetsEchantillon], octetsEchantillon);
+
+            if(pwrite(descripteur, tampon + debut, (size_t) (k - debut), position + debut) != (ssize_t) (k - debut)) {
+                error = ERROR_HANDLE;
+                break;
+            }
+        }
+    }
+
+    free(tampon);
+    close(descripteur);
+
+    return error;
+}
+
+
+/* Blancs de l'entête d'un PNM (espace, \t, \n, \v, \f, \r) */
+static int estBlancPNM(int c) {
+
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/* Vrai si le paramètre C d'un Y4M (longueur caractères) vaut nom */
+static int estCouleurY4M(const char* couleur, size_t longueur, const char* nom) {
+
+    return strlen(nom) == longueur && strncmp(couleur, nom, longueur) == 0;
+}
+
+/* Lit la géométrie (W, H) et le sous-échantillonnage (C) de la ligne d'entête d'un Y4M, les autres paramètres sont ignorés */
+static int analyserEnteteY4M(formatFlux_t* format) {
+
+    const char *parametre = format->enteteY4M + 9, *couleur = "420jpeg";
+    char *fin;
+    size_t longueurCouleur = 7;
+    long int largeurChroma, hauteurChroma;
+
+    while(*parametre == ' ') {
+        parametre++;
+        if(*parametre == 'W') {
+            format->largeur = strtol(parametre + 1, &fin, 10);
+        } else if(*parametre == 'H') {
+            format->hauteur = strtol(parametre + 1, &fin, 10);
+        } else if(*parametre == 'C') {
+            couleur = parametre + 1;
+            longueurCouleur = strcspn(couleur, " ");
+        }
+        parametre += strcspn(parametre, " ");
+    }
+
+    if(*parametre != '\0' || format->largeur <= 0 || format->hauteur <= 0 || format->largeur > DIMENSION_MAX_Y4M || format->hauteur > DIMENSION_MAX_Y4M)
+        return ERROR_FORMAT;
+
+    // Seuls les échantillons 8 bits sont acceptés (pas de 420p10, 444alpha...)
+    if(estCouleurY4M(couleur, longueurCouleur, "420jpeg") || estCouleurY4M(couleur, longueurCouleur, "420paldv") || estCouleurY4M(couleur, longueurCouleur, "420mpeg2") || estCouleurY4M(couleur, longueurCouleur, "420")) {
+        largeurChroma = (format->largeur + 1) / 2;
+        hauteurChroma = (format->hauteur + 1) / 2;
+    } else if(estCouleurY4M(couleur, longueurCouleur, "422")) {
+        largeurChroma = (format->largeur + 1) / 2;
+        hauteurChroma = format->hauteur;
+    } else if(estCouleurY4M(couleur, longueurCouleur, "411")) {
+        largeurChroma = (format->largeur + 3) / 4;
+        hauteurChroma = format->hauteur;
+    } else if(estCouleurY4M(couleur, longueurCouleur, "444")) {
+        largeurChroma = format->largeur;
+        hauteurChroma = format->hauteur;
+    } else if(estCouleurY4M(couleur, longueurCouleur, "mono")) {
+        largeurChroma = 0;
+        hauteurChroma = 0;
+    } else {
+        return ERROR_FORMAT;
+    }
+
+    format->taillePlans[0] = format->largeur * format->hauteur;
+    format->taillePlans[1] = largeurChroma * hauteurChroma;
+    format->taillePlans[2] = largeurChroma * hauteurChroma;
+    format->nbPlans = largeurChroma > 0 ? 3 : 1;
+
+    return ERROR_OK;
+}
+
+int ouvrirFlux(char* pathFile, FILE** flux, formatFlux_t* format) {
+
+    int c, i = 0, error;
+
+    memset(format, 0, sizeof(*format));
+    format->nbPlans = 1;
+
+    *flux = fopen(pathFile, "rb");
+    if(*flux == NULL)
+        return ERROR_OPEN;
+
+    // Un PNM commence par 'P': le caractère est rendu au flux pour lireTrame
+    c = fgetc(*flux);
+    if(c != 'Y') {
+        if(c != EOF)
+            ungetc(c, *flux);
+        return ERROR_OK;
+    }
+
+    format->y4m = 1;
+    format->enteteY4M[i++] = 'Y';
+    for(c = fgetc(*flux); c != '\n'; c = fgetc(*flux)) {
+        if(c == EOF || i >= TAILLE_ENTETE_Y4M - 1) {
+            fclose(*flux);
+            *flux = NULL;
+            return ERROR_FORMAT;
+        }
+        format->enteteY4M[i++] = (char) c;
+    }
+    format->enteteY4M[i] = '\0';
+
+    error = ERROR_FORMAT;
+    if(strncmp(format->enteteY4M, "YUV4MPEG2", 9) == 0 && (format->enteteY4M[9] == ' ' || format->enteteY4M[9] == '\0'))
+        error = analyserEnteteY4M(format);
+    if(error != ERROR_OK) {
+        fclose(*flux);
+        *flux = NULL;
+    }
+
+    return error;
+}
+
+/* Entête d'une trame PNM, dont le premier caractère a déjà été lu */
+static int lireEnteteTramePNM(FILE* flux, int c, trameFlux_t* trame) {
+
+    long int valeurs[3];
+    int i;
+
+    if(c != 'P')
+        return ERROR_FORMAT;
+    c = fgetc(flux);
+    if(c != '5' && c != '6')
+        return ERROR_FORMAT;
+    trame->typeFile[0] = 'P';
+    trame->typeFile[1] = (char) c;
+    trame->typeFile[2] = '\0';
+
+    // Largeur, hauteur et intensité maximale, séparées par des blancs et des commentaires
+    c = fgetc(flux);
+    for(i = 0; i < 3; i++) {
+        while(estBlancPNM(c) || c == '#') {
+            if(c == '#') {
+                while(c != '\n' && c != EOF)
+                    c = fgetc(flux);
+            }
+            c = fgetc(flux);
+        }
+        if(c < '0' || c > '9')
+            return ERROR_FORMAT;
+        for(valeurs[i] = 0; c >= '0' && c <= '9'; c = fgetc(flux)) {
+            if(valeurs[i] > 1000000L)
+                return ERROR_FORMAT;
+            valeurs[i] = valeurs[i] * 10 + (c - '0');
+        }
+    }
+
+    // Un seul blanc sépare l'entête des pixels
+    if(!estBlancPNM(c) || valeurs[0] <= 0 || valeurs[1] <= 0 || valeurs[2] <= 0 || valeurs[2] > 255)
+        return ERROR_FORMAT;
+
+    trame->largeur = valeurs[0];
+    trame->hauteur = valeurs[1];
+    trame->pixelIntensity = valeurs[2];
+    trame->profondeur = trame->typeFile[1] == '6' ? 3 : 1;
+
+    // Les canaux d'un P6 sont entrelacés: la trame forme un seul plan
+    trame->nbPlans = 1;
+    trame->taillePlans[0] = trame->largeur * trame->hauteur * trame->profondeur;
+
+    return ERROR_OK;
+}
+
+/* Entête "FRAME" d'une trame Y4M, dont le premier caractère a déjà été lu. La géométrie vient de l'entête du flux. */
+static int lireEnteteTrameY4M(FILE* flux, int c, const formatFlux_t* format, trameFlux_t* trame) {
+
+    const char* marque = "FRAME";
+    int i;
+
+    for(i = 0; marque[i] != '\0'; i++, c = fgetc(flux)) {
+        if(c != marque[i])
+            return ERROR_FORMAT;
+    }
+
+    // Les paramètres de la trame (entrelacement, X...) sont ignorés
+    for(i = 0; c != '\n'; i++, c = fgetc(flux)) {
+        if(c == EOF || i >= TAILLE_ENTETE_Y4M)
+            return ERROR_FORMAT;
+    }
+
+    trame->typeFile[0] = '\0';
+    trame->largeur = format->largeur;
+    trame->hauteur = format->hauteur;
+    trame->pixelIntensity = 255;
+    trame->profondeur = 1;
+    trame->nbPlans = format->nbPlans;
+    for(i = 0; i < PLANS_MAX_FLUX; i++)
+        trame->taillePlans[i] = format->taillePlans[i];
+
+    return ERROR_OK;
+}
+
+int lireTrame(FILE* flux, const formatFlux_t* format, trameFlux_t* trame, int* finFlux) {
+
+    long int dimension;
+    unsigned char* pixels;
+    int c, i, error;
+
+    *finFlux = 0;
+
+    // Fin du flux entre deux trames: ce n'est pas une erreur
+    c = fgetc(flux);
+    if(c == EOF) {
+        *finFlux = 1;
+        return ERROR_OK;
+    }
+
+    if(format->y4m)
+        error = lireEnteteTrameY4M(flux, c, format, trame);
+    else
+        error = lireEnteteTramePNM(flux, c, trame);
+    if(error != ERROR_OK)
+        return error;
+
+    // Les plans se suivent dans la trame
+    dimension = 0;
+    for(i = 0; i < trame->nbPlans; i++)
+        dimension += trame->taillePlans[i];
+
+    // Le tampon de l'emplacement est réutilisé d'une trame à l'autre
+    if(dimension > trame->capacite) {
+        pixels = (unsigned char*) realloc(trame->pixels, (size_t) dimension);
+        if(pixels == NULL)
+            return ERROR_NOMEM;
+        trame->pixels = pixels;
+        trame->capacite = dimension;
+    }
+    trame->dimension = dimension;
+
+    if((long int) fread(trame->pixels, 1, (size_t) dimension, flux) != dimension)
+        return ERROR_FORMAT;
+
+    return ERROR_OK;
+}
+
+
+int ecrireTrame(FILE* flux, const formatFlux_t* format, const trameFlux_t* trame) {
+
+    if(format->y4m)
+        fputs("FRAME\n", flux);
+    else
+        fprintf(flux, "%s\n%ld %ld\n%ld\n", trame->typeFile, trame->largeur, trame->hauteur, trame->pixelIntensity);
+
+    if((long int) fwrite(trame->pixels, 1, (size_t) trame->dimension, flux) != trame->dimension)
+        return ERROR_HANDLE;
+
+    return ERROR_OK;
+}
+
+
+long int dimensionVueTrame(const trameFlux_t* trame, unsigned int masque) {
+
+    long int dimension = 0;
+    int plan;
+
+    for(plan = 0; plan < trame->nbPlans; plan++) {
+        if(masque == 0 || (masque & (1u << plan)))
+            dimension += trame->taillePlans[plan];
+    }
+
+    return dimension;
+}
+
+
+void copierVueTrame(trameFlux_t* trame, unsigned int masque, int* matrice, long int nb, int versTrame) {
+
+    unsigned char* pixels = trame->pixels;
+    long int k = 0, i, n;
+    int plan;
+
+    // Les plans sont parcourus en place dans le tampon de la trame, sans copie intermédiaire
+    for(plan = 0; plan < trame->nbPlans && k < nb; plan++) {
+        if(masque == 0 || (masque & (1u << plan))) {
+            n = trame->taillePlans[plan] < nb - k ? trame->taillePlans[plan] : nb - k;
+            if(versTrame) {
+                for(i = 0; i < n; i++)
+                    pixels[i] = (unsigned char) matrice[k + i];
+            } else {
+                for(i = 0; i < n; i++)
+                    matrice[k + i] = pixels[i];
+            }
+            k += n;
+        }
+        pixels += trame->taillePlans[plan];
+    }
+}
+
+
+/* Agrandit si nécessaire le tableau de travail partagé par les trames */
+static int agrandirMatriceTrame(int** matrice, long int* capacite, long int dimension) {
+
+    int* agrandie;
+
+    if(dimension <= *capacite)
+        return ERROR_OK;
+
+    agrandie = (int*) realloc(*matrice, (size_t) dimension * sizeof(int));
+    if(agrandie == NULL)
+        return ERROR_NOMEM;
+    *matrice = agrandie;
+    *capacite = dimension;
+
+    return ERROR_OK;
+}
+
+/* Étage de lecture: remplit les emplacements libérés par l'écriture */
+static void* threadLectureTrames(void* argument) {
+
+    fileTrames_t* file = (fileTrames_t*) argument;
+    trameFlux_t* trame;
+    int finFlux = 0, error;
+
+    for(;;) {
+        pthread_mutex_lock(&file->verrou);
+        while(file->error == ERROR_OK && file->nbLues - file->nbEcrites >= NB_TRAMES_FILE)
+            pthread_cond_wait(&file->changement, &file->verrou);
+        if(file->error != ERROR_OK) {
+            pthread_mutex_unlock(&file->verrou);
+            break;
+        }
+        trame = &file->trames[file->nbLues % NB_TRAMES_FILE];
+        pthread_mutex_unlock(&file->verrou);
+
+        error = lireTrame(file->entree, &file->format, trame, &finFlux);
+
+        pthread_mutex_lock(&file->verrou);
+        if(error != ERROR_OK)
+            file->error = error;
+        else if(finFlux)
+            file->finLecture = 1;
+        else
+            file->nbLues++;
+        pthread_cond_broadcast(&file->changement);
+        pthread_mutex_unlock(&file->verrou);
+
+        if(error != ERROR_OK || finFlux)
+            break;
+    }
+
+    return NULL;
+}
+
+/* Étage d'écriture: écrit les trames dans l'ordre dès que leur insertion est terminée */
+static void* threadEcritureTrames(void* argument) {
+
+    fileTrames_t* file = (fileTrames_t*) argument;
+    trameFlux_t* trame;
+    int error;
+
+    for(;;) {
+        pthread_mutex_lock(&file->verrou);
+        while(file->error == ERROR_OK && file->nbEcrites == file->nbTraitees && !file->finTraitement)
+            pthread_cond_wait(&file->changement, &file->verrou);
+        if(file->error != ERROR_OK || file->nbEcrites == file->nbTraitees) {
+            pthread_mutex_unlock(&file->verrou);
+            break;
+        }
+        trame = &file->trames[file->nbEcrites % NB_TRAMES_FILE];
+        pthread_mutex_unlock(&file->verrou);
+
+        error = ecrireTrame(file->sortie, &file->format, trame);
+
+        pthread_mutex_lock(&file->verrou);
+        if(error != ERROR_OK)
+            file->error = error;
+        else
+            file->nbEcrites++;
+        pthread_cond_broadcast(&file->changement);
+        pthread_mutex_unlock(&file->verrou);
+
+        if(error != ERROR_OK)
+            break;
+    }
+
+    return NULL;
+}
+
+/* Cache au plus restants bits dans les plans masque d'une trame: son propre prefixe (fin des données de la trame) puis les bits.
+ * Avec lignes = 0 l'insertion est classique (remplit la trame), sinon lignes bits sont cachés dans chaque bloc de 2^lignes - 1 échantillons et la trame utilise le découpage de determineSegmentsHamming. */
+static int insererDansTrame(trameFlux_t* trame, unsigned int masque, unsigned int lignes, const unsigned char* messageBinary, size_t restants, int** matrice, long int* capaciteMatrice, size_t* nbBits) {
+
+    long int dimension, utilises, nbBlocsGrands = 0;
+    unsigned int rows = 1, compteur;
+    long int longueurPrefixe;
+    int error;
+
+    dimension = dimensionVueTrame(trame, masque);
+    free(num_to_bit(dimension, &longueurPrefixe));
+
+    *nbBits = 0;
+    if(dimension <= longueurPrefixe)
+        return ERROR_OK;
+
+    if(lignes == 0)
+        *nbBits = (size_t) (dimension - longueurPrefixe);
+    else
+        *nbBits = (size_t) ((dimension - longueurPrefixe) / ((1L << lignes) - 1) * lignes);
+    if(*nbBits > restants)
+        *nbBits = restants;
+
+    // Seuls le prefixe et les échantillons qui reçoivent des bits sont convertis
+    utilises = longueurPrefixe + (long int) *nbBits;
+    if(lignes != 0) {
+        error = determineSegmentsHamming(dimension - longueurPrefixe, (long int) *nbBits, &rows, &nbBlocsGrands);
+        if(error != ERROR_OK)
+            return error;
+        utilises = longueurPrefixe + (long int) pixelsSegmentsHamming((long int) *nbBits, rows, nbBlocsGrands);
+    }
+
+    error = agrandirMatriceTrame(matrice, capaciteMatrice, utilises);
+    if(error != ERROR_OK)
+        return error;
+    copierVueTrame(trame, masque, *matrice, utilises, 0);
+
+    error = hideDimMsg(*nbBits, *matrice, dimension, trame->pixelIntensity, &longueurPrefixe);
+    if(error == ERROR_OK && lignes == 0)
+        error = hideMessage(messageBinary, *nbBits, *matrice, dimension, trame->pixelIntensity, longueurPrefixe, 0, NULL);
+    else if(error == ERROR_OK)
+        error = hideMessageHammingSegmente(messageBinary, *nbBits, *matrice, dimension, trame->pixelIntensity, longueurPrefixe, rows, nbBlocsGrands, &compteur);
+
+    copierVueTrame(trame, masque, *matrice, utilises, 1);
+
+    return error;
+}
+
+
+int cacherDansFlux(FILE* entree, const formatFlux_t* format, char* pathSortie, unsigned int masque, unsigned int lignes, const unsigned char* messageBinary, size_t tailleMsgBit, long int* nbTrames, long int* nbTramesUtilisees) {
+
+    fileTrames_t file;
+    pthread_t lecture, ecriture;
+    trameFlux_t* trame;
+    struct stat infoSortie;
+    int *matrice = NULL, error, i, sortieReguliere;
+    long int capaciteMatrice = 0;
+    size_t position = 0, nbBits;
+
+    *nbTrames = 0;
+    *nbTramesUtilisees = 0;
+
+    // Un flux PNM est toujours inséré de manière classique, un Y4M toujours par blocs de Hamming (lignes = 1 revient à 1 bit par échantillon)
+    if(format->y4m ? (lignes < 1 || lignes >= LIGNES_MAX_HAMMING || (masque & ~((1u << format->nbPlans) - 1)) != 0) : (lignes != 0 || masque != 0))
+        return ERROR_INVARG;
+
+    memset(&file, 0, sizeof(file));
+    file.format = *format;
+    file.entree = entree;
+    file.sortie = fopen(pathSortie, "wb");
+    if(file.sortie == NULL)
+        return ERROR_OPEN;
+
+    // L'entête du flux est recopié tel quel, les trames suivent
+    if(format->y4m)
+        fprintf(file.sortie, "%s\n", format->enteteY4M);
+
+    pthread_mutex_init(&file.verrou, NULL);
+    pthread_cond_init(&file.changement, NULL);
+
+    if(pthread_create(&lecture, NULL, threadLectureTrames, &file) != 0) {
+        file.error = ERROR_NOMEM;
+    } else if(pthread_create(&ecriture, NULL, threadEcritureTrames, &file) != 0) {
+        pthread_mutex_lock(&file.verrou);
+        file.error = ERROR_NOMEM;
+        pthread_cond_broadcast(&file.changement);
+        pthread_mutex_unlock(&file.verrou);
+        pthread_join(lecture, NULL);
+    } else {
+
+        // Étage d'insertion: la lecture et l'écriture des trames voisines se font pendant ce temps
+        for(;;) {
+            pthread_mutex_lock(&file.verrou);
+            while(file.error == ERROR_OK && file.nbTraitees == file.nbLues && !file.finLecture)
+                pthread_cond_wait(&file.changement, &file.verrou);
+            if(file.error != ERROR_OK || file.nbTraitees == file.nbLues) {
+                file.finTraitement = 1;
+                pthread_cond_broadcast(&file.changement);
+                pthread_mutex_unlock(&file.verrou);
+                break;
+            }
+            trame = &file.trames[file.nbTraitees % NB_TRAMES_FILE];
+            pthread_mutex_unlock(&file.verrou);
+
+            // Les trames qui suivent la fin du message sont recopiées telles quelles
+            error = ERROR_OK;
+            if(position < tailleMsgBit) {
+                error = insererDansTrame(trame, masque, lignes, messageBinary + position, tailleMsgBit - position, &matrice, &capaciteMatrice, &nbBits);
+                position += nbBits;
+                (*nbTramesUtilisees)++;
+            }
+
+            pthread_mutex_lock(&file.verrou);
+            if(error != ERROR_OK)
+                file.error = error;
+            else
+                file.nbTraitees++;
+            pthread_cond_broadcast(&file.changement);
+            pthread_mutex_unlock(&file.verrou);
+        }
+
+        pthread_join(lecture, NULL);
+        pthread_join(ecriture, NULL);
+    }
+
+    error = file.error;
+    // Flux trop court pour le message
+    if(error == ERROR_OK && position < tailleMsgBit)
+        error = ERROR_NOMEM;
+    *nbTrames = file.nbEcrites;
+
+    for(i = 0; i < NB_TRAMES_FILE; i++)
+        free(file.trames[i].pixels);
+    free(matrice);
+    pthread_mutex_destroy(&file.verrou);
+    pthread_cond_destroy(&file.changement);
+    sortieReguliere = fstat(fileno(file.sortie), &infoSortie) == 0 && S_ISREG(infoSortie.st_mode);
+    if(fclose(file.sortie) != 0 && error == ERROR_OK)
+        error = ERROR_HANDLE;
+
+    // On ne laisse pas un flux qui ne contient qu'une partie du message (un tube nommé n'est pas supprimé)
+    if(error != ERROR_OK && sortieReguliere)
+        remove(pathSortie);
+
+    return error;
+}
+
+
+/* Relit les bits cachés par insererDansTrame dans les plans masque d'une trame (segmente: insertion par blocs de Hamming) */
+static int extraireDeTrame(trameFlux_t* trame, unsigned int masque, int segmente, int** matrice, long int* capaciteMatrice, unsigned char** bits, long int* capaciteBits, long int* nbBits) {
+
+    sourceImage_t source;
+    lecteurBits_t lecteur;
+    unsigned char* agrandis;
+    long int dimension, utilises, nbBlocsGrands = 0, i;
+    unsigned int rows = 1;
+    long int longueurPrefixe, prefixInt;
+    int error;
+
+    *nbBits = 0;
+
+    dimension = dimensionVueTrame(trame, masque);
+    free(num_to_bit(dimension, &longueurPrefixe));
+    if(dimension <= longueurPrefixe)
+        return ERROR_OK;
+
+    error = agrandirMatriceTrame(matrice, capaciteMatrice, longueurPrefixe);
+    if(error != ERROR_OK)
+        return error;
+    copierVueTrame(trame, masque, *matrice, longueurPrefixe, 0);
+
+    error = decryptPrefix(*matrice, dimension, &prefixInt, &longueurPrefixe);
+    if(error != ERROR_OK)
+        return error;
+    if(prefixInt < longueurPrefixe || prefixInt > dimension)
+        return ERROR_FORMAT;
+    *nbBits = prefixInt - longueurPrefixe;
+
+    utilises = prefixInt;
+    if(segmente) {
+        if(determineSegmentsHamming(dimension - longueurPrefixe, *nbBits, &rows, &nbBlocsGrands) != ERROR_OK)
+            return ERROR_FORMAT;
+        utilises = longueurPrefixe + (long int) pixelsSegmentsHamming(*nbBits, rows, nbBlocsGrands);
+    }
+
+    error = agrandirMatriceTrame(matrice, capaciteMatrice, utilises);
+    if(error != ERROR_OK)
+        return error;
+    copierVueTrame(trame, masque, *matrice, utilises, 0);
+
+    if(*nbBits > *capaciteBits) {
+        agrandis = (unsigned char*) realloc(*bits, (size_t) *nbBits);
+        if(agrandis == NULL)
+            return ERROR_NOMEM;
+        *bits = agrandis;
+        *capaciteBits = *nbBits;
+    }
+
+    if(!segmente) {
+        for(i = 0; i < *nbBits; i++)
+            (*bits)[i] = (unsigned char) ((*matrice)[longueurPrefixe + i] & 1);
+        return ERROR_OK;
+    }
+
+    // Le lecteur de bits recalcule le même découpage à partir de la taille de la vue et du nombre de bits
+    sourceMemoire(&source, *matrice, dimension);
+    error = initLecteurBits(&lecteur, &source, longueurPrefixe, MODE_HAMMING, NULL, rows | HAMMING_SEGMENTE, (unsigned int) *nbBits);
+    if(error != ERROR_OK)
+        return error;
+    for(i = 0; i < *nbBits; i++)
+        (*bits)[i] = (unsigned char) lireBitExtrait(&lecteur, i);
+    libererLecteurBits(&lecteur);
+
+    return ERROR_OK;
+}
+
+/* Plans d'un flux Y4M: chaque combinaison est essayée sur la première trame jusqu'à trouver un entête de conteneur valide qui annonce ces plans */
+static int chercherPlansY4M(trameFlux_t* trame, unsigned int* masque, int** matrice, long int* capaciteMatrice, unsigned char** bits, long int* capaciteBits) {
+
+    const unsigned int masquesPlans[7] = {0, 1u, 2u, 4u, 3u, 5u, 6u};
+    unsigned char octets[TAILLE_ENTETE_FIXE];
+    enteteConteneur_t entete;
+    long int nbBits;
+    int k, i, longueurNom;
+
+    for(k = 0; k < 7; k++) {
+        if((masquesPlans[k] & ~((1u << trame->nbPlans) - 1)) != 0)
+            continue;
+        if(extraireDeTrame(trame, masquesPlans[k], 1, matrice, capaciteMatrice, bits, capaciteBits, &nbBits) != ERROR_OK || nbBits < TAILLE_ENTETE_FIXE * 8)
+            continue;
+
+        memset(octets, 0, sizeof(octets));
+        for(i = 0; i < TAILLE_ENTETE_FIXE * 8; i++)
+            octets[i >> 3] = (unsigned char) ((octets[i >> 3] << 1) | (*bits)[i]);
+
+        if(analyserEnteteConteneur(octets, &entete, &longueurNom) == ERROR_OK && ((entete.flags & MASQUE_CANAUX_CONTENEUR) >> DECALAGE_CANAUX_CONTENEUR) == masquesPlans[k]) {
+            *masque = masquesPlans[k];
+            return ERROR_OK;
+        }
+    }
+
+    return ERROR_FORMAT;
+}
+
+
+int extraireDuFlux(char* pathEntree, enteteConteneur_t* entete, unsigned char** charge, size_t* tailleCharge, long int* nbTrames) {
+
+    FILE* flux;
+    formatFlux_t format;
+    trameFlux_t trame;
+    unsigned char *octets = NULL, *agrandis, *bits = NULL;
+    unsigned int crc, masque = 0;
+    int *matrice = NULL, longueurNom = 0, finFlux = 0, error;
+    long int capaciteMatrice = 0, capaciteBits = 0, nbBits, i, total = TAILLE_ENTETE_FIXE, bit = 0, debutCharge = 0, nbBlocs = 0, tailleBloc = 0, blocsVerifies = 0, b, debut, taille;
+
+    memset(&trame, 0, sizeof(trame));
+    *nbTrames = 0;
+
+    error = ouvrirFlux(pathEntree, &flux, &format);
+    if(error != ERROR_OK)
+        return error;
+
+    octets = (unsigned char*) calloc(TAILLE_ENTETE_FIXE, 1);
+    if(octets == NULL) {
+        fclose(flux);
+        return ERROR_NOMEM;
+    }
+
+    // Les trames sont lues une à une jusqu'à la fin du conteneur: le reste du flux n'est pas lu
+    while(bit < total * 8 && error == ERROR_OK) {
+
+        error = lireTrame(flux, &format, &trame, &finFlux);
+        if(error != ERROR_OK)
+            break;
+        if(finFlux) {
+            error = ERROR_FORMAT;
+            break;
+        }
+        (*nbTrames)++;
+
+        if(format.y4m && *nbTrames == 1) {
+            error = chercherPlansY4M(&trame, &masque, &matrice, &capaciteMatrice, &bits, &capaciteBits);
+            if(error != ERROR_OK)
+                break;
+        }
+
+        error = extraireDeTrame(&trame, masque, format.y4m, &matrice, &capaciteMatrice, &bits, &capaciteBits, &nbBits);
+
+        for(i = 0; i < nbBits && bit < total * 8 && error == ERROR_OK; i++, bit++) {
+
+            octets[bit >> 3] = (unsigned char) ((octets[bit >> 3] << 1) | bits[i]);
+
+            // Entête complet: on connait la taille totale du conteneur
+            if(bit + 1 == TAILLE_ENTETE_FIXE * 8) {
+                error = analyserEnteteConteneur(octets, entete, &longueurNom);
+                if(error == ERROR_OK && (entete->flags & FLAG_CONTENEUR_FRAGMENT))
+                    error = ERROR_FORMAT;
+                if(error != ERROR_OK)
+                    break;
+                nbBlocs = nbBlocsCrc(entete);
+                tailleBloc = nbBlocs > 0 ? 1L << entete->blocCrc : 0;
+                debutCharge = TAILLE_ENTETE_FIXE + longueurNom;
+                total = debutCharge + nbBlocs * 4 + (long int) entete->longueurCharge;
+                agrandis = (unsigned char*) realloc(octets, (size_t) total + 1);
+                if(agrandis == NULL) {
+                    error = ERROR_NOMEM;
+                    break;
+                }
+                octets = agrandis;
+                memset(octets + TAILLE_ENTETE_FIXE, 0, (size_t) (total + 1 - TAILLE_ENTETE_FIXE));
+            }
+        }
+
+        // Les blocs complets sont vérifiés au fil du flux: une mauvaise extraction s'arrête au premier bloc invalide
+        if(error == ERROR_OK && nbBlocs > 0) {
+            for(b = blocsVerifies; b < nbBlocs; b++) {
+                debut = b * tailleBloc;
+                taille = (long int) entete->longueurCharge - debut < tailleBloc ? (long int) entete->longueurCharge - debut : tailleBloc;
+                if(debutCharge + nbBlocs * 4 + debut + taille > bit / 8)
+                    break;
+                crc = ((unsigned int) octets[debutCharge + b * 4] << 24) | ((unsigned int) octets[debutCharge + b * 4 + 1] << 16) | ((unsigned int) octets[debutCharge + b * 4 + 2] << 8) | octets[debutCharge + b * 4 + 3];
+                if(crc32c(octets + debutCharge + nbBlocs * 4 + debut, (size_t) taille) != crc) {
+                    error = ERROR_CHECKSUM;
+                    break;
+                }
+            }
+            blocsVerifies = b;
+        }
+    }
+
+    free(trame.pixels);
+    free(matrice);
+    free(bits);
+    fclose(flux);
+
+    if(error != ERROR_OK) {
+        free(octets);
+        return error;
+    }
+
+    memcpy(entete->nom, octets + TAILLE_ENTETE_FIXE, (size_t) longueurNom);
+    entete->nom[longueurNom] = '\0';
+
+    // Le message est rendu sans l'entête ni la table des CRC
+    memmove(octets, octets + debutCharge + nbBlocs * 4, (size_t) entete->longueurCharge);
+    *charge = octets;
+    *tailleCharge = (size_t) entete->longueurCharge;
+
+    return ERROR_OK;
+}
+
+
+int chargerImage(char* pathFile, imageChargee_t* image) {
+
+    int error;
+
+    image->matriceImage = NULL;
+
+    error = lireFormatImage(pathFile, image->typeFile, &image->imageWidth, &image->imageHeight, &image->profondeur, &image->pixelIntensity, image->tuplType, &image->beginningImage, &image->dimension);
+    if(error != ERROR_OK)
+        return error;
+
+    image->matriceImage = (int*) malloc((size_t) image->dimension * sizeof(int));
+    if(image->matriceImage == NULL)
+        return ERROR_NOMEM;
+
+    // Un P2/P3 est découpé en nombres, les autres formats sont lus octet par octet
+    if(estFormatASCII(image->typeFile))
+        error = readImageASCII(pathFile, image->matriceImage, image->beginningImage, image->dimension, image->pixelIntensity);
+    else if(strcmp(image->typeFile, "BMP") == 0)
+        error = readImageBMP(pathFile, image->matriceImage, image->beginningImage, image->imageWidth * image->profondeur, image->imageHeight, pasLigneFormat(image->typeFile, image->imageWidth, image->profondeur));
+    else if(strcmp(image->typeFile, "PNG") == 0)
+        error = readImagePNG(pathFile, image->matriceImage, image->imageWidth, image->imageHeight, image->profondeur);
+    else if(strcmp(image->typeFile, "WAV") == 0)
+        error = readImageWAV(pathFile, image->matriceImage, image->beginningImage, image->dimension, octetsEchantillonFormat(image->typeFile, image->pixelIntensity));
+    else
+        error = readImage(pathFile, image->matriceImage, image->beginningImage, image->dimension);
+
+    if(error != ERROR_OK) {
+        free(image->matriceImage);
+        image->matriceImage = NULL;
+    }
+
+    return error;
+}
+
+
+int ecrireImageChargee(char* pathSource, char* pathSortie, imageChargee_t* image) {
+
+    long int beginningNewImage;
+    int error;
+
+    // Un PNG est réencodé ligne par ligne, entête compris
+    if(strcmp(image->typeFile, "PNG") == 0)
+        return writeImagePNG(pathSortie, image->matriceImage, image->imageWidth, image->imageHeight, image->profondeur);
+
+    // Un BMP ou un WAV est recopié tel quel puis seuls ses octets modifiés sont réécrits
+    if(strcmp(image->typeFile, "BMP") == 0 || strcmp(image->typeFile, "WAV") == 0)
+        error = copierFichier(pathSource, pathSortie);
+    else if(strcmp(image->typeFile, "P7") == 0)
+        error = writeHeaderPAM(pathSortie, image->imageWidth, image->imageHeight, image->profondeur, image->pixelIntensity, image->tuplType, &beginningNewImage);
+    else
+        error = writeHeader(pathSortie, image->typeFile, image->imageWidth, image->imageHeight, image->pixelIntensity, &beginningNewImage);
+    if(error != ERROR_OK)
+        return error;
+
+    if(strcmp(image->typeFile, "BMP") == 0)
+        return writeImageBMP(pathSortie, image->matriceImage, image->beginningImage, image->imageWidth * image->profondeur, image->imageHeight, pasLigneFormat(image->typeFile, image->imageWidth, image->profondeur));
+    if(strcmp(image->typeFile, "WAV") == 0)
+        return writeImageWAV(pathSortie, image->matriceImage, image->beginningImage, image->dimension, octetsEchantillonFormat(image->typeFile, image->pixelIntensity));
+    if(estFormatASCII(image->typeFile))
+        return writeImageASCII(pathSortie, image->matriceImage, beginningNewImage, image->dimension);
+
+    return writeImage(pathSortie, image->matriceImage, beginningNewImage, image->dimension);
+}
+
+
+long int capaciteFragment(long int dimension, int tailleEntete) {
+
+    long int disponible, tailleBloc = 1L << LOG2_BLOC_CRC, nbBlocs, reste;
+    long int lengthDimensionPrefix;
+
+    free(num_to_bit(dimension, &lengthDimensionPrefix));
+
+    disponible = (dimension - lengthDimensionPrefix - tailleEntete * 8L) / 8;
+    if(disponible <= 0)
+        return 0;
+
+    // Un bloc complet occupe tailleBloc octets et son CRC, un dernier bloc partiel occupe aussi les 4 octets de son CRC
+    nbBlocs = disponible / (tailleBloc + 4);
+    reste = disponible - nbBlocs * (tailleBloc + 4);
+
+    return nbBlocs * tailleBloc + (reste > 4 ? reste - 4 : 0);
+}
+
+
+int preparerEnteteSegmente(const enteteConteneur_t* entete, long int dimension, enteteConteneur_t* enteteInsere, long int* debut, unsigned int* rows, long int* nbBlocsGrands) {
+
+    unsigned char octetsEntete[TAILLE_ENTETE_MAX];
+    long int lengthDimensionPrefix, tailleBit;
+    int tailleEntete, error;
+
+    // Le message a sa propre table de CRC, vérifiée à l'extraction
+    *enteteInsere = *entete;
+    enteteInsere->flags |= FLAG_CONTENEUR_CRC;
+    enteteInsere->blocCrc = LOG2_BLOC_CRC;
+    enteteInsere->permutation = PERMUTATION_AUCUNE;
+
+    error = serialiserEnteteConteneur(enteteInsere, octetsEntete, &tailleEntete);
+    if(error != ERROR_OK)
+        return error;
+
+    // Le message occupe au moins un bit par échantillon après le prefixe et l'entête: le découpage de Hamming utilise tout le reste de l'image
+    tailleBit = ((long int) enteteInsere->longueurCharge + 4 * nbBlocsCrc(enteteInsere)) * 8;
+    free(num_to_bit(dimension, &lengthDimensionPrefix));
+    *debut = lengthDimensionPrefix + (long int) tailleEntete * 8;
+    error = determineSegmentsHamming(dimension - *debut, tailleBit, rows, nbBlocsGrands);
+    if(error != ERROR_OK)
+        return error;
+
+    // Un message vide (fragment d'un message réparti sur plus d'images que nécessaire) ne contient que le prefixe et l'entête
+    enteteInsere->mode = tailleBit > 0 ? MODE_HAMMING : MODE_CLASSIQUE;
+    enteteInsere->parametre = tailleBit > 0 ? (unsigned char) (HAMMING_SEGMENTE | *rows) : 0;
+
+    return ERROR_OK;
+}
+
+
+int cacherConteneurSegmente(const enteteConteneur_t* entete, const unsigned char* message, int* matriceImage, long int dimension, long int pixelIntensity, long int* finModifications) {
+
+    enteteConteneur_t enteteInsere;
+    unsigned char *charge = NULL, *bits = NULL;
+    size_t tailleCharge = (size_t) entete->longueurCharge, tailleBit = 0;
+    unsigned int rows, compteurNbBitsModif;
+    long int nbBlocsGrands, debut = 0;
+    long int lengthDimensionPrefix;
+    int tailleEnteteBit, error;
+
+    *finModifications = 0;
+
+    error = preparerEnteteSegmente(entete, dimension, &enteteInsere, &debut, &rows, &nbBlocsGrands);
+
+    if(error == ERROR_OK) {
+        charge = (unsigned char*) malloc(tailleCharge + 1);
+        if(charge == NULL)
+            error = ERROR_NOMEM;
+    }
+    if(error == ERROR_OK) {
+        memcpy(charge, message, tailleCharge);
+        error = ajouterTableCrc(&charge, &tailleCharge, 1L << LOG2_BLOC_CRC);
+    }
+    if(error == ERROR_OK)
+        error = octetsVersBinaire(charge, tailleCharge, &bits, &tailleBit);
+
+    if(error == ERROR_OK) {
+        free(num_to_bit(dimension, &lengthDimensionPrefix));
+        error = hideDimMsg(debut - lengthDimensionPrefix + unitesPrefixe(&enteteInsere), matriceImage, dimension, pixelIntensity, &lengthDimensionPrefix);
+    }
+    if(error == ERROR_OK)
+        error = hideEnteteConteneur(&enteteInsere, matriceImage, dimension, pixelIntensity, lengthDimensionPrefix, &tailleEnteteBit);
+    if(error == ERROR_OK && tailleBit > 0)
+        error = hideMessageHammingSegmente(bits, tailleBit, matriceImage, dimension, pixelIntensity, debut, rows, nbBlocsGrands, &compteurNbBitsModif);
+    if(error == ERROR_OK)
+        *finModifications = debut + (tailleBit > 0 ? (long int) pixelsSegmentsHamming((long int) tailleBit, rows, nbBlocsGrands) : 0);
+
+    freeAllVar(charge, bits, NULL, NULL, NULL, NULL, NULL);
+
+    return error;
+}
+
+
+int cacherFragment(char* pathEntree, char* pathSortie, const enteteConteneur_t* entete, const unsigned char* fragment) {
+
+    imageChargee_t image;
+    long int finModifications;
+    int error;
+
+    error = chargerImage(pathEntree, &image);
+    if(error != ERROR_OK)
+        return error;
+
+    error = cacherConteneurSegmente(entete, fragment, image.matriceImage, image.dimension, image.pixelIntensity, &finModifications);
+    if(error == ERROR_OK)
+        error = ecrireImageChargee(pathEntree, pathSortie, &image);
+
+    free(image.matriceImage);
+
+    return error;
+}
+
+
+int extraireFragment(char* pathFile, enteteConteneur_t* entete, unsigned char** fragment) {
+
+    char typeFile[50], tuplType[TAILLE_TUPLTYPE_PAM];
+    long int imageWidth, imageHeight, profondeur, pixelIntensity, beginningImage, dimension, nbBlocs;
+    sourceImage_t source;
+    lecteurBits_t lecteur;
+    unsigned int *crcAttendus = NULL, rows = 0, columns = 0;
+    long int prefixInt, lengthDimensionPrefix;
+    int tailleEnteteBit, error;
+    size_t taille = 0;
+    FILE *memoire;
+
+    *fragment = NULL;
+
+    error = lireFormatImage(pathFile, typeFile, &imageWidth, &imageHeight, &profondeur, &pixelIntensity, tuplType, &beginningImage, &dimension);
+    if(error != ERROR_OK)
+        return error;
+
+    error = ouvrirSourceFormat(&source, pathFile, typeFile, imageWidth, profondeur, pixelIntensity, beginningImage, dimension);
+    if(error != ERROR_OK)
+        return error;
+
+    error = decryptPrefixSource(&source, &prefixInt, &lengthDimensionPrefix);
+    if(error == ERROR_OK && (prefixInt < lengthDimensionPrefix || prefixInt > dimension))
+        error = ERROR_FORMAT;
+    if(error == ERROR_OK)
+        error = lireEnteteConteneur(&source, lengthDimensionPrefix, prefixInt, entete, &tailleEnteteBit);
+
+    // Seuls les fragments insérés par cacherFragment sont acceptés
+    if(error == ERROR_OK && (!(entete->flags & FLAG_CONTENEUR_FRAGMENT) || entete->permutation != PERMUTATION_AUCUNE || (entete->flags & MASQUE_CANAUX_CONTENEUR) != 0 || !(entete->mode == MODE_CLASSIQUE || (entete->mode == MODE_HAMMING && (entete->parametre & HAMMING_SEGMENTE)))))
+        error = ERROR_FORMAT;
+    if(error != ERROR_OK) {
+        fermerSourceImage(&source);
+        return error;
+    }
+
+    // Découpage en segments: initLecteurBits le recalcule à partir de la taille du flux
+    if(entete->mode == MODE_HAMMING) {
+        rows = entete->parametre;
+        columns = (unsigned int) unitesPrefixe(entete);
+    }
+
+    error = initLecteurBits(&lecteur, &source, lengthDimensionPrefix + tailleEnteteBit, entete->mode, NULL, rows, columns);
+    if(error != ERROR_OK) {
+        fermerSourceImage(&source);
+        return error;
+    }
+
+    nbBlocs = nbBlocsCrc(entete);
+    if(nbBlocs > 0)
+        error = lireTableCrc(&lecteur, NULL, nbBlocs, &crcAttendus);
+
+    if(error == ERROR_OK) {
+        memoire = open_memstream((char**) fragment, &taille);
+        if(memoire == NULL) {
+            error = ERROR_NOMEM;
+        } else {
+            error = decryptMessageVersFichier(&lecteur, NULL, nbBlocs * 4, memoire, (long int) entete->longueurCharge, crcAttendus, nbBlocs > 0 ? 1L << entete->blocCrc : 0);
+            fclose(memoire);
+        }
+    }
+
+    if(error != ERROR_OK) {
+        free(*fragment);
+        *fragment = NULL;
+    }
+
+    libererLecteurBits(&lecteur);
+    fermerSourceImage(&source);
+    free(crcAttendus);
+
+    return error;
+}
+
+
+/**
+ * Point d'entrée d'un thread de répartition (signature imposée par pthread_create): insère ou extrait les fragments de ses images.
+ */
+static void* threadFragments(void* argument) {
+
+    travailFragments_t *travail = (travailFragments_t*) argument;
+    int i;
+
+    for(i = travail->premiereImage; i < travail->nbImages && travail->error == ERROR_OK; i += travail->pas) {
+
+        if(travail->pathsSortie != NULL)
+            travail->error = cacherFragment(travail->pathsEntree[i], travail->pathsSortie[i], &travail->entetes[i], travail->charge + travail->entetes[i].debutFragment);
+        else
+            travail->error = extraireFragment(travail->pathsEntree[i], &travail->entetes[i], &travail->fragments[i]);
+
+        if(travail->error != ERROR_OK)
+            travail->imageInvalide = i;
+    }
+
+    return NULL;
+}
+
+
+/* Répartit les images de modele sur plusieurs threads et renvoie l'erreur de la première image en erreur */
+static int lancerTravailFragments(const travailFragments_t* modele, int* imageInvalide) {
+
+    travailFragments_t travaux[NB_THREADS_REPARTITION_MAX];
+    pthread_t threads[NB_THREADS_REPARTITION_MAX];
+    int lance[NB_THREADS_REPARTITION_MAX];
+    long int nbThreads, t;
+    int error = ERROR_OK;
+
+    *imageInvalide = -1;
+
+    nbThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    if(nbThreads < 1)
+        nbThreads = 1;
+    if(nbThreads > NB_THREADS_REPARTITION_MAX)
+        nbThreads = NB_THREADS_REPARTITION_MAX;
+    if(nbThreads > modele->nbImages)
+        nbThreads = modele->nbImages;
+
+    // Les tables du CRC32C (et le choix SSE4.2) et du CRC des PNG sont initialisées avant le lancement des threads
+    crc32c(NULL, 0);
+    crc32PNG(0, NULL, 0);
+
+    for(t = 0; t < nbThreads; t++) {
+
+        travaux[t] = *modele;
+        travaux[t].premiereImage = (int) t;
+        travaux[t].pas = (int) nbThreads;
+        travaux[t].imageInvalide = -1;
+        travaux[t].error = ERROR_OK;
+
+        lance[t] = pthread_create(&threads[t], NULL, threadFragments, &travaux[t]) == 0;
+        if(!lance[t])
+            travaux[t].error = ERROR_HANDLE;
+    }
+
+    for(t = 0; t < nbThreads; t++) {
+
+        if(lance[t])
+            pthread_join(threads[t], NULL);
+
+        // On garde l'erreur de la première image en erreur
+        if(travaux[t].error != ERROR_OK && (error == ERROR_OK || (travaux[t].imageInvalide >= 0 && (*imageInvalide < 0 || travaux[t].imageInvalide < *imageInvalide)))) {
+            error = travaux[t].error;
+            *imageInvalide = travaux[t].imageInvalide;
+        }
+    }
+
+    return error;
+}
+
+
+int repartirCharge(char** pathsEntree, char** pathsSortie, int nbImages, const enteteConteneur_t* modele, const unsigned char* charge, size_t tailleCharge, long int* taillesFragments) {
+
+    char typeFile[50], tuplType[TAILLE_TUPLTYPE_PAM];
+    long int imageWidth, imageHeight, profondeur, pixelIntensity, beginningImage, dimension, ajout;
+    long int *capacites;
+    unsigned long long capaciteTotale = 0, reste;
+    unsigned long debut = 0;
+    unsigned char octetsEntete[TAILLE_ENTETE_MAX];
+    enteteConteneur_t *entetes;
+    travailFragments_t travail;
+    unsigned int crcTotal;
+    int i, tailleEntete, imageInvalide, error;
+
+    if(nbImages < 1 || nbImages > NB_FRAGMENTS_MAX || tailleCharge > 0xFFFFFFFFUL)
+        return ERROR_INVARG;
+
+    capacites = (long int*) malloc((size_t) nbImages * sizeof(long int));
+    entetes = (enteteConteneur_t*) malloc((size_t) nbImages * sizeof(enteteConteneur_t));
+    if(capacites == NULL || entetes == NULL) {
+        freeAllVar(capacites, entetes, NULL, NULL, NULL, NULL, NULL);
+        return ERROR_NOMEM;
+    }
+
+    crcTotal = crc32c(charge, tailleCharge);
+
+    // Entête commun: seuls le numéro, la position et la taille du fragment changent d'une image à l'autre
+    for(i = 0; i < nbImages; i++) {
+        entetes[i] = *modele;
+        entetes[i].mode = MODE_HAMMING;
+        entetes[i].parametre = HAMMING_SEGMENTE | 1u;
+        entetes[i].permutation = PERMUTATION_AUCUNE;
+        entetes[i].flags = (modele->flags & (FLAG_CONTENEUR_FICHIER | FLAG_CONTENEUR_COMPRESSE | FLAG_CONTENEUR_CHIFFRE)) | FLAG_CONTENEUR_CRC | FLAG_CONTENEUR_FRAGMENT;
+        entetes[i].blocCrc = LOG2_BLOC_CRC;
+        entetes[i].indexFragment = (unsigned int) i;
+        entetes[i].nbFragments = (unsigned int) nbImages;
+        entetes[i].longueurTotale = (unsigned long) tailleCharge;
+        entetes[i].crcTotal = crcTotal;
+        entetes[i].debutFragment = 0;
+        entetes[i].longueurCharge = 0;
+    }
+
+    // La taille de l'entête ne dépend pas de l'image
+    error = serialiserEnteteConteneur(&entetes[0], octetsEntete, &tailleEntete);
+
+    // Seul le format est lu: les images sont chargées par les threads. Le prefixe limite une image à INT_MAX échantillons, les produits tiennent donc sur 64 bits
+    for(i = 0; i < nbImages && error == ERROR_OK; i++) {
+        error = lireFormatImage(pathsEntree[i], typeFile, &imageWidth, &imageHeight, &profondeur, &pixelIntensity, tuplType, &beginningImage, &dimension);
+        if(error == ERROR_OK && dimension > INT_MAX)
+            error = ERROR_INVARG;
+        if(error == ERROR_OK) {
+            capacites[i] = capaciteFragment(dimension, tailleEntete);
+            capaciteTotale += (unsigned long long) capacites[i];
+        }
+    }
+    if(error == ERROR_OK && capaciteTotale < tailleCharge)
+        error = ERROR_NOMEM;
+
+    if(error == ERROR_OK) {
+        // Part proportionnelle à la capacité de chaque image, le reste des arrondis va aux premières images qui ont encore de la place
+        reste = tailleCharge;
+        for(i = 0; i < nbImages; i++) {
+            taillesFragments[i] = capaciteTotale > 0 ? (long int) ((unsigned long long) tailleCharge * (unsigned long long) capacites[i] / capaciteTotale) : 0;
+            reste -= (unsigned long long) taillesFragments[i];
+        }
+        for(i = 0; i < nbImages && reste > 0; i++) {
+            ajout = capacites[i] - taillesFragments[i];
+            if((unsigned long long) ajout > reste)
+                ajout = (long int) reste;
+            taillesFragments[i] += ajout;
+            reste -= (unsigned long long) ajout;
+        }
+
+        for(i = 0; i < nbImages; i++) {
+            entetes[i].debutFragment = debut;
+            entetes[i].longueurCharge = (unsigned long) taillesFragments[i];
+            debut += (unsigned long) taillesFragments[i];
+        }
+
+        travail.pathsEntree = pathsEntree;
+        travail.pathsSortie = pathsSortie;
+        travail.entetes = entetes;
+        travail.charge = charge;
+        travail.fragments = NULL;
+        travail.nbImages = nbImages;
+        error = lancerTravailFragments(&travail, &imageInvalide);
+    }
+
+    freeAllVar(capacites, entetes, NULL, NULL, NULL, NULL, NULL);
+
+    return error;
+}
+
+
+int reconstituerCharge(char** paths, int nbImages, enteteConteneur_t* entete, unsigned char** charge, size_t* tailleCharge, int* imageInvalide, int* fragmentInvalide, int* nbFragments) {
+
+    enteteConteneur_t *entetes;
+    unsigned char **fragments;
+    travailFragments_t travail;
+    unsigned long debut = 0;
+    int *ordre = NULL, i, k, error;
+
+    *charge = NULL;
+    *tailleCharge = 0;
+    *imageInvalide = -1;
+    *fragmentInvalide = -1;
+    *nbFragments = 0;
+
+    if(nbImages < 1 || nbImages > NB_FRAGMENTS_MAX)
+        return ERROR_INVARG;
+
+    entetes = (enteteConteneur_t*) malloc((size_t) nbImages * sizeof(enteteConteneur_t));
+    fragments = (unsigned char**) calloc((size_t) nbImages, sizeof(unsigned char*));
+    if(entetes == NULL || fragments == NULL) {
+        freeAllVar(entetes, fragments, NULL, NULL, NULL, NULL, NULL);
+        return ERROR_NOMEM;
+    }
+
+    travail.pathsEntree = paths;
+    travail.pathsSortie = NULL;
+    travail.entetes = entetes;
+    travail.charge = NULL;
+    travail.fragments = fragments;
+    travail.nbImages = nbImages;
+    error = lancerTravailFragments(&travail, imageInvalide);
+
+    // Tous les fragments doivent annoncer le même message
+    for(i = 1; i < nbImages && error == ERROR_OK; i++) {
+        if(entetes[i].nbFragments != entetes[0].nbFragments || entetes[i].longueurTotale != entetes[0].longueurTotale || entetes[i].crcTotal != entetes[0].crcTotal || entetes[i].flags != entetes[0].flags || strcmp(entetes[i].nom, entetes[0].nom) != 0) {
+            error = ERROR_FORMAT;
+            *imageInvalide = i;
+        }
+    }
+
+    if(error == ERROR_OK) {
+        *nbFragments = (int) entetes[0].nbFragments;
+        ordre = (int*) malloc((size_t) *nbFragments * sizeof(int));
+        if(ordre == NULL)
+            error = ERROR_NOMEM;
+    }
+
+    // Chaque numéro est présent une seule fois: une image en trop porte forcément un numéro déjà vu, une image en moins laisse un numéro libre
+    for(k = 0; k < *nbFragments && error == ERROR_OK; k++)
+        ordre[k] = -1;
+    for(i = 0; i < nbImages && error == ERROR_OK; i++) {
+        if(ordre[entetes[i].indexFragment] >= 0) {
+            error = ERROR_FORMAT;
+            *imageInvalide = i;
+            *fragmentInvalide = (int) entetes[i].indexFragment;
+        } else {
+            ordre[entetes[i].indexFragment] = i;
+        }
+    }
+    for(k = 0; k < *nbFragments && error == ERROR_OK; k++) {
+        if(ordre[k] < 0) {
+            error = ERROR_FORMAT;
+            *fragmentInvalide = k;
+        }
+    }
+
+    // Les fragments se suivent dans l'ordre de leurs numéros
+    for(k = 0; k < nbImages && error == ERROR_OK; k++) {
+        if(entetes[ordre[k]].debutFragment != debut) {
+            error = ERROR_FORMAT;
+            *imageInvalide = ordre[k];
+        }
+        debut += entetes[ordre[k]].longueurCharge;
+    }
+    if(error == ERROR_OK && debut != entetes[0].longueurTotale)
+        error = ERROR_FORMAT;
+
+    if(error == ERROR_OK) {
+        *charge = (unsigned char*) malloc((size_t) debut + 1);
+        if(*charge == NULL)
+            error = ERROR_NOMEM;
+    }
+    if(error == ERROR_OK) {
+        for(i = 0; i < nbImages; i++)
+            memcpy(*charge + entetes[i].debutFragment, fragments[i], (size_t) entetes[i].longueurCharge);
+
+        // Chaque fragment est déjà vérifié par ses blocs: le CRC du message complet vérifie l'assemblage
+        if(crc32c(*charge, (size_t) debut) != entetes[0].crcTotal) {
+            error = ERROR_CHECKSUM;
+            free(*charge);
+            *charge = NULL;
+        }
+    }
+
+    if(error == ERROR_OK) {
+        // Le message réassemblé est décrit par l'entête utilisé pour le chiffrer (voir enteteMessage)
+        enteteMessage(entetes[ordre[0]].nom, entetes[ordre[0]].flags, debut, entete);
+        *tailleCharge = (size_t) debut;
+    }
+
+    for(i = 0; i < nbImages; i++)
+        free(fragments[i]);
+    freeAllVar(entetes, fragments, ordre, NULL, NULL, NULL, NULL);
+
+    return error;
+}
+
+
+/**
+ * Point d'entrée d'un thread de copies (signature imposée par pthread_create): insère les messages de ses copies dans sa propre copie de travail.
+ */
+static void* threadCopies(void* argument) {
+
+    travailCopies_t *travail = (travailCopies_t*) argument;
+    const imageChargee_t *couverture = travail->couverture;
+    imageChargee_t copie = *couverture;
+    long int finModifications;
+    int i;
+
+    // L'image d'origine est partagée en lecture seule. Les fonctions d'écriture prennent un tableau complet: chaque thread garde donc une copie entière de l'image
+    copie.matriceImage = (int*) malloc((size_t) couverture->dimension * sizeof(int));
+    if(copie.matriceImage == NULL) {
+        travail->error = ERROR_NOMEM;
+        travail->sortieInvalide = travail->premiereSortie;
+        return NULL;
+    }
+    memcpy(copie.matriceImage, couverture->matriceImage, (size_t) couverture->dimension * sizeof(int));
+
+    for(i = travail->premiereSortie; i < travail->nbSorties && travail->error == ERROR_OK; i += travail->pas) {
+
+        travail->error = cacherConteneurSegmente(&travail->entetes[i], travail->charges[i], copie.matriceImage, copie.dimension, copie.pixelIntensity, &finModifications);
+        if(travail->error == ERROR_OK)
+            travail->error = ecrireImageChargee(travail->pathCouverture, travail->pathsSortie[i], &copie);
+
+        if(travail->error != ERROR_OK) {
+            travail->sortieInvalide = i;
+            break;
+        }
+
+        // Les modifications d'une copie sont toutes avant finModifications, cette zone est restaurée pour la copie suivante.
+        // Les segments de Hamming occupent toute la capacité de l'image: la zone couvre en général presque toute l'image
+        travail->finsModifications[i] = finModifications;
+        memcpy(copie.matriceImage, couverture->matriceImage, (size_t) finModifications * sizeof(int));
+    }
+
+    free(copie.matriceImage);
+
+    return NULL;
+}
+
+
+int cacherDansCopies(char* pathCouverture, const imageChargee_t* couverture, char** pathsSortie, int nbSorties, const enteteConteneur_t* entetes, unsigned char** charges, long int* finsModifications, int* sortieInvalide) {
+
+    travailCopies_t travaux[NB_THREADS_REPARTITION_MAX];
+    pthread_t threads[NB_THREADS_REPARTITION_MAX];
+    int lance[NB_THREADS_REPARTITION_MAX];
+    long int nbThreads, t;
+    int error = ERROR_OK;
+
+    *sortieInvalide = -1;
+
+    if(nbSorties < 1 || couverture->dimension > INT_MAX)
+        return ERROR_INVARG;
+
+    nbThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    if(nbThreads < 1)
+        nbThreads = 1;
+    if(nbThreads > NB_THREADS_REPARTITION_MAX)
+        nbThreads = NB_THREADS_REPARTITION_MAX;
+    if(nbThreads > nbSorties)
+        nbThreads = nbSorties;
+
+    // Les tables du CRC32C (et le choix SSE4.2) et du CRC des PNG sont initialisées avant le lancement des threads
+    crc32c(NULL, 0);
+    crc32PNG(0, NULL, 0);
+
+    for(t = 0; t < nbThreads; t++) {
+
+        travaux[t].pathCouverture = pathCouverture;
+        travaux[t].couverture = couverture;
+        travaux[t].pathsSortie = pathsSortie;
+        travaux[t].entetes = entetes;
+        travaux[t].charges = charges;
+        travaux[t].finsModifications = finsModifications;
+        travaux[t].nbSorties = nbSorties;
+        travaux[t].premiereSortie = (int) t;
+        travaux[t].pas = (int) nbThreads;
+        travaux[t].sortieInvalide = -1;
+        travaux[t].error = ERROR_OK;
+
+        lance[t] = pthread_create(&threads[t], NULL, threadCopies, &travaux[t]) == 0;
+        if(!lance[t]) {
+            travaux[t].error = ERROR_HANDLE;
+            travaux[t].sortieInvalide = (int) t;
+        }
+    }
+
+    for(t = 0; t < nbThreads; t++) {
+
+        if(lance[t])
+            pthread_join(threads[t], NULL);
+
+        // On garde l'erreur de la première copie en erreur
+        if(travaux[t].error != ERROR_OK && (error == ERROR_OK || travaux[t].sortieInvalide < *sortieInvalide)) {
+            error = travaux[t].error;
+            *sortieInvalide = travaux[t].sortieInvalide;
+        }
+    }
+
+    return error;
+}
+
+
+int construireArchive(char** paths, int nbEntrees, int compresser, const char* motDePasse, unsigned char** archive, size_t* tailleArchive) {
+
+    unsigned char **donnees, *octets, octetsEntete[TAILLE_ENTETE_MAX];
+    size_t *tailles, tailleIndex = 2, position;
+    unsigned int *flags, crc;
+    const char **noms;
+    enteteConteneur_t enteteEntree;
+    int i, compresse, tailleEntete, error = ERROR_OK;
+
+    *archive = NULL;
+    *tailleArchive = 0;
+
+    if(nbEntrees < 1 || nbEntrees > NB_ENTREES_ARCHIVE_MAX)
+        return ERROR_INVARG;
+
+    donnees = (unsigned char**) calloc((size_t) nbEntrees, sizeof(unsigned char*));
+    tailles = (size_t*) calloc((size_t) nbEntrees, sizeof(size_t));
+    flags = (unsigned int*) calloc((size_t) nbEntrees, sizeof(unsigned int));
+    noms = (const char**) calloc((size_t) nbEntrees, sizeof(const char*));
+    if(donnees == NULL || tailles == NULL || flags == NULL || noms == NULL)
+        error = ERROR_NOMEM;
+
+    // Chaque fichier est compressé et chiffré séparément: il peut être extrait et authentifié sans les autres
+    for(i = 0; i < nbEntrees && error == ERROR_OK; i++) {
+
+        noms[i] = strrchr(paths[i], '/');
+        noms[i] = noms[i] != NULL ? noms[i] + 1 : paths[i];
+        if(strlen(noms[i]) > TAILLE_NOM_CONTENEUR) {
+            error = ERROR_INVARG;
+            break;
+        }
+
+        error = lireFichierOctets(paths[i], &donnees[i], &tailles[i]);
+        if(error == ERROR_OK && compresser) {
+            error = compresserCharge(&donnees[i], &tailles[i], &compresse);
+            if(compresse)
+                flags[i] |= FLAG_CONTENEUR_COMPRESSE;
+        }
+        if(error == ERROR_OK && motDePasse != NULL) {
+            // Le tag couvre l'entête de l'entrée tel qu'il sera relu (voir extraireEntreeArchive)
+            flags[i] |= FLAG_CONTENEUR_CHIFFRE;
+            enteteMessage(noms[i], flags[i], (unsigned long) (tailles[i] + TAILLE_SURCOUT_AEAD), &enteteEntree);
+            error = serialiserEnteteConteneur(&enteteEntree, octetsEntete, &tailleEntete);
+            if(error == ERROR_OK)
+                error = chiffrerCharge(&donnees[i], &tailles[i], motDePasse, octetsEntete, (size_t) tailleEntete);
+        }
+        if(error == ERROR_OK && tailles[i] > 0xFFFFFFFFUL)
+            error = ERROR_INVARG;
+
+        tailleIndex += TAILLE_ENTREE_ARCHIVE + strlen(noms[i]);
+    }
+
+    // L'index est suivi des fichiers, dans l'ordre de l'index
+    position = tailleIndex;
+    for(i = 0; i < nbEntrees && error == ERROR_OK; i++)
+        position += tailles[i];
+    if(error == ERROR_OK && position > 0xFFFFFFFFUL)
+        error = ERROR_INVARG;
+
+    if(error == ERROR_OK) {
+        *archive = (unsigned char*) malloc(position + 1);
+        if(*archive == NULL)
+            error = ERROR_NOMEM;
+    }
+
+    if(error == ERROR_OK) {
+        *tailleArchive = position;
+        octets = *archive;
+        octets[0] = (unsigned char) (nbEntrees >> 8);
+        octets[1] = (unsigned char) nbEntrees;
+        octets += 2;
+
+        position = tailleIndex;
+        for(i = 0; i < nbEntrees; i++) {
+            crc = crc32c(donnees[i], tailles[i]);
+            octets[0] = (unsigned char) strlen(noms[i]);
+            memcpy(octets + 1, noms[i], strlen(noms[i]));
+            octets += 1 + strlen(noms[i]);
+            octets[0] = (unsigned char) flags[i];
+            octets[1] = (unsigned char) (position >> 24u);
+            octets[2] = (unsigned char) (position >> 16u);
+            octets[3] = (unsigned char) (position >> 8u);
+            octets[4] = (unsigned char) position;
+            octets[5] = (unsigned char) (tailles[i] >> 24u);
+            octets[6] = (unsigned char) (tailles[i] >> 16u);
+            octets[7] = (unsigned char) (tailles[i] >> 8u);
+            octets[8] = (unsigned char) tailles[i];
+            octets[9] = (unsigned char) (crc >> 24u);
+            octets[10] = (unsigned char) (crc >> 16u);
+            octets[11] = (unsigned char) (crc >> 8u);
+            octets[12] = (unsigned char) crc;
+            octets += TAILLE_ENTREE_ARCHIVE - 1;
+
+            memcpy(*archive + position, donnees[i], tailles[i]);
+            position += tailles[i];
+        }
+    }
+
+    for(i = 0; donnees != NULL && i < nbEntrees; i++)
+        free(donnees[i]);
+    freeAllVar(donnees, tailles, flags, (void*) noms, NULL, NULL, NULL);
+
+    return error;
+}
+
+
+int lireIndexArchive(lecteurBits_t* lecteur, long int debutOctet, long int longueurCharge, entreeArchive_t** entrees, int* nbEntrees) {
+
+    long int position = 0;
+    int i, k, longueurNom;
+
+    *entrees = NULL;
+    *nbEntrees = 0;
+
+    if(longueurCharge < 2)
+        return ERROR_FORMAT;
+
+    *nbEntrees = (lireOctetExtrait(lecteur, debutOctet) << 8) | lireOctetExtrait(lecteur, debutOctet + 1);
+    position = 2;
+    if(*nbEntrees < 1) {
+        *nbEntrees = 0;
+        return ERROR_FORMAT;
+    }
+
+    *entrees = (entreeArchive_t*) malloc((size_t) *nbEntrees * sizeof(entreeArchive_t));
+    if(*entrees == NULL) {
+        *nbEntrees = 0;
+        return ERROR_NOMEM;
+    }
+
+    // Seuls les octets de l'index sont lus, chaque entrée est vérifiée contre la taille du message
+    for(i = 0; i < *nbEntrees; i++) {
+
+        if(position + 1 > longueurCharge)
+            break;
+        longueurNom = lireOctetExtrait(lecteur, debutOctet + position);
+        if(position + TAILLE_ENTREE_ARCHIVE + longueurNom > longueurCharge)
+            break;
+
+        for(k = 0; k < longueurNom; k++)
+            (*entrees)[i].nom[k] = (char) lireOctetExtrait(lecteur, debutOctet + position + 1 + k);
+        (*entrees)[i].nom[longueurNom] = '\0';
+        position += 1 + longueurNom;
+
+        (*entrees)[i].flags = lireOctetExtrait(lecteur, debutOctet + position);
+        (*entrees)[i].position = 0;
+        (*entrees)[i].longueur = 0;
+        (*entrees)[i].crc = 0;
+        for(k = 0; k < 4; k++) {
+            (*entrees)[i].position = ((*entrees)[i].position << 8u) | lireOctetExtrait(lecteur, debutOctet + position + 1 + k);
+            (*entrees)[i].longueur = ((*entrees)[i].longueur << 8u) | lireOctetExtrait(lecteur, debutOctet + position + 5 + k);
+            (*entrees)[i].crc = ((*entrees)[i].crc << 8u) | lireOctetExtrait(lecteur, debutOctet + position + 9 + k);
+        }
+        position += TAILLE_ENTREE_ARCHIVE - 1;
+
+        if(((*entrees)[i].flags & ~(FLAG_CONTENEUR_COMPRESSE | FLAG_CONTENEUR_CHIFFRE)) != 0 || (*entrees)[i].position + (*entrees)[i].longueur > (unsigned long) longueurCharge)
+            break;
+    }
+
+    if(i < *nbEntrees) {
+        free(*entrees);
+        *entrees = NULL;
+        *nbEntrees = 0;
+        return ERROR_FORMAT;
+    }
+
+    // Les fichiers suivent l'index
+    for(i = 0; i < *nbEntrees; i++) {
+        if((*entrees)[i].position < (unsigned long) position) {
+            free(*entrees);
+            *entrees = NULL;
+            *nbEntrees = 0;
+            return ERROR_FORMAT;
+        }
+    }
+
+    return ERROR_OK;
+}
+
+
+int extraireEntreeArchive(lecteurBits_t* lecteur, long int debutOctet, const entreeArchive_t* entree, const char* motDePasse, unsigned char** donnees, size_t* taille) {
+
+    enteteConteneur_t enteteEntree;
+    unsigned char *octets;
+    unsigned long o;
+    int error;
+
+    *donnees = NULL;
+    *taille = 0;
+
+    octets = (unsigned char*) malloc((size_t) entree->longueur + 1);
+    if(octets == NULL)
+        return ERROR_NOMEM;
+
+    // Seuls les échantillons du fichier demandé sont lus: le lecteur calcule leur position à partir du rang de chaque octet
+    for(o = 0; o < entree->longueur; o++)
+        octets[o] = lireOctetExtrait(lecteur, debutOctet + (long int) (entree->position + o));
+
+    if(crc32c(octets, (size_t) entree->longueur) != entree->crc) {
+        free(octets);
+        return ERROR_CHECKSUM;
+    }
+
+    // Déchiffrement et décompression propres au fichier, authentifiés avec son nom, ses indicateurs et sa taille
+    enteteMessage(entree->nom, entree->flags, entree->longueur, &enteteEntree);
+    error = restaurerCharge(&enteteEntree, octets, (size_t) entree->longueur, motDePasse, donnees, taille);
+    free(octets);
+
+    return error;
+}
+
+
+/* Masques des chiffres et des séparateurs (espace, \t, \n, \v, \f, \r) parmi les longueur (au plus 16) octets de texte */
+static void classerOctetsASCII(const unsigned char* texte, int longueur, unsigned int* chiffres, unsigned int* separateurs) {
+
+    int i;
+
+#if defined(__x86_64__)
+    __m128i v, estChiffre, estSeparateur;
+
+    if(longueur == 16) {
+        // Les octets >= 0x80 sont négatifs en comparaison signée: ni chiffres ni séparateurs
+        v = _mm_loadu_si128((const __m128i*) texte);
+        estChiffre = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+        estSeparateur = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('\t' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('\r' + 1))));
+        *chiffres = (unsigned int) _mm_movemask_epi8(estChiffre);
+        *separateurs = (unsigned int) _mm_movemask_epi8(estSeparateur);
+        return;
+    }
+#endif
+
+    *chiffres = *separateurs = 0;
+    for(i = 0; i < longueur; i++) {
+        if(texte[i] >= '0' && texte[i] <= '9')
+            *chiffres |= 1u << i;
+        else if(texte[i] == ' ' || (texte[i] >= '\t' && texte[i] <= '\r'))
+            *separateurs |= 1u << i;
+    }
+}
+
+
+int analyserEntiersASCII(const unsigned char* texte, long int taille, int* valeurs, long int nbValeurs, long int maxval) {
+
+    long int i = 0, n = 0;
+    unsigned int chiffres, separateurs, complet, restant;
+    int longueur, pos, nbChiffres, j, commentaire;
+    long int valeur = 0;
+    int enCours = 0;
+
+    while(i < taille && n < nbValeurs) {
+
+        longueur = taille - i >= 16 ? 16 : (int) (taille - i);
+        classerOctetsASCII(texte + i, longueur, &chiffres, &separateurs);
+        complet = (1u << longueur) - 1;
+
+        // Un autre caractère coupe le bloc: seul un commentaire ('#' jusqu'à la fin de la ligne) est accepté
+        commentaire = 0;
+        if((chiffres | separateurs) != complet) {
+            pos = __builtin_ctz(~(chiffres | separateurs) & complet);
+            if(texte[i + pos] != '#')
+                return ERROR_FORMAT;
+            commentaire = 1;
+            longueur = pos;
+            chiffres &= (1u << pos) - 1;
+        }
+
+        // Bloc sans chiffre ni nombre en cours: rien à faire
+        if(chiffres == 0 && !enCours) {
+            i += longueur;
+        } else {
+            pos = 0;
+            while(pos < longueur && n < nbValeurs) {
+
+                restant = chiffres >> pos;
+
+                if(restant & 1u) {
+                    // Suite de chiffres, éventuellement commencée dans le bloc précédent
+                    nbChiffres = __builtin_ctz(~restant);
+                    if(nbChiffres > longueur - pos)
+                        nbChiffres = longueur - pos;
+                    for(j = 0; j < nbChiffres; j++) {
+                        valeur = valeur * 10 + (texte[i + pos + j] - '0');
+                        if(valeur > maxval) // Évite le dépassement sur les nombres trop longs
+                            valeur = maxval + 1;
+                    }
+                    enCours = 1;
+                    pos += nbChiffres;
+                } else {
+                    // Un séparateur termine le nombre en cours
+                    if(enCours) {
+                        if(valeur > maxval)
+                            return ERROR_FORMAT;
+                        valeurs[n++] = (int) valeur;
+                        valeur = 0;
+                        enCours = 0;
+                    }
+                    pos = restant == 0 ? longueur : pos + __builtin_ctz(restant);
+                }
+            }
+            i += pos;
+        }
+
+        if(commentaire && n < nbValeurs) {
+            if(enCours) {
+                if(valeur > maxval)
+                    return ERROR_FORMAT;
+                valeurs[n++] = (int) valeur;
+                valeur = 0;
+                enCours = 0;
+            }
+            while(i < taille && texte[i] != '\n')
+                i++;
+        }
+    }
+
+    // Dernier nombre en fin de fichier
+    if(enCours && n < nbValeurs) {
+        if(valeur > maxval)
+            return ERROR_FORMAT;
+        valeurs[n++] = (int) valeur;
+    }
+
+    return n == nbValeurs ? ERROR_OK : ERROR_FORMAT;
+}
+
+
+int readImageASCII(char* pathFile, int* matrice, long int beginningImage, long int dimension, long int pixelIntensity) {
+
+    FILE* image = NULL;
+    unsigned char* texte;
+    long int taille;
+    int error;
+
+    image = fopen(pathFile, "rb");
+    if(image == NULL)
+        return ERROR_OPEN;
+
+    // Tout le texte des pixels est lu d'un coup puis découpé en mémoire
+    if(fseek(image, 0, SEEK_END) != 0 || (taille = ftell(image) - beginningImage) < 0 || fseek(image, beginningImage, SEEK_SET) != 0) {
+        fclose(image);
+        return ERROR_INVARG;
+    }
+
+    texte = (unsigned char*) malloc((size_t) (taille > 0 ? taille : 1));
+    if(texte == NULL) {
+        fclose(image);
+        return ERROR_NOMEM;
+    }
+
+    if((long int) fread(texte, 1, (size_t) taille, image) != taille)
+        error = ERROR_FORMAT;
+    else
+        error = analyserEntiersASCII(texte, taille, matrice, dimension, pixelIntensity);
+
+    free(texte);
+    fclose(image);
+
+    return error;
+}
+
+
+int writeImageASCII(char* pathFile, int* matrice, long int beginningImage, long int dimension) {
+
+    FILE* image = NULL;
+    char tampon[TAILLE_TAMPON_FLUX + 8];
+    long int i;
+    int taille = 0, debutLigne = 0, valeur, longueur;
+
+    image = fopen(pathFile, "r+");
+    if(image == NULL)
+        return ERROR_OPEN;
+
+    if(fseek(image, beginningImage, SEEK_SET) != 0) {
+        fclose(image);
+        return ERROR_INVARG;
+    }
+
+    for(i = 0; i < dimension; i++) {
+
+        valeur = matrice[i];
+        longueur = valeur >= 100 ? 3 : (valeur >= 10 ? 2 : 1);
+
+        // Les lignes d'un P2/P3 ne dépassent pas LONGUEUR_LIGNE_ASCII caractères
+        if(taille > debutLigne && taille - debutLigne + 1 + longueur > LONGUEUR_LIGNE_ASCII) {
+            tampon[taille++] = '\n';
+            debutLigne = taille;
+        } else if(taille > debutLigne) {
+            tampon[taille++] = ' ';
+        }
+
+        if(longueur == 3)
+            tampon[taille++] = (char) ('0' + valeur / 100);
+        if(longueur >= 2)
+            tampon[taille++] = (char) ('0' + (valeur / 10) % 10);
+        tampon[taille++] = (char) ('0' + valeur % 10);
+
+        if(taille >= TAILLE_TAMPON_FLUX) {
+            fwrite(tampon, 1, (size_t) debutLigne, image);
+            memmove(tampon, tampon + debutLigne, (size_t) (taille - debutLigne));
+            taille -= debutLigne;
+            debutLigne = 0;
+        }
+    }
+
+    tampon[taille++] = '\n';
+    fwrite(tampon, 1, (size_t) taille, image);
+    fclose(image);
+
+    return ERROR_OK;
+}
+
+
+/* Longueurs et distances des répétitions deflate (RFC 1951): base et nombre de bits supplémentaires de chaque code */
+static const unsigned short baseLongueurDeflate[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const unsigned char extraLongueurDeflate[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const unsigned short baseDistanceDeflate[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const unsigned char extraDistanceDeflate[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+/* Ordre des longueurs du code des longueurs dans l'entête d'un bloc dynamique */
+static const unsigned char ordreLongueursDeflate[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+
+unsigned int crc32PNG(unsigned int crc, const unsigned char* octets, size_t taille) {
+
+    static unsigned int table[256];
+    static int tablePrete = 0;
+    unsigned int c;
+    int n, k;
+    size_t i;
+
+    if(!tablePrete) {
+        for(n = 0; n < 256; n++) {
+            c = (unsigned int) n;
+            for(k = 0; k < 8; k++)
+                c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[n] = c;
+        }
+        tablePrete = 1;
+    }
+
+    crc = ~crc;
+    for(i = 0; i < taille; i++)
+        crc = table[(crc ^ octets[i]) & 0xFFu] ^ (crc >> 8);
+
+    return ~crc;
+}
+
+
+unsigned int adler32(unsigned int adler, const unsigned char* octets, size_t taille) {
+
+    unsigned long a = adler & 0xFFFFu, b = adler >> 16;
+    size_t n;
+
+    while(taille > 0) {
+        // 5552 octets au plus entre deux réductions: b ne peut pas dépasser 32 bits
+        n = taille < 5552 ? taille : 5552;
+        taille -= n;
+        while(n--) {
+            a += *octets++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+
+    return (unsigned int) ((b << 16) | a);
+}
+
+
+static unsigned long lireU32BE(const unsigned char* octets) {
+
+    return ((unsigned long) octets[0] << 24) | ((unsigned long) octets[1] << 16) | ((unsigned long) octets[2] << 8) | octets[3];
+}
+
+static void ecrireU32BE(unsigned char* octets, unsigned long valeur) {
+
+    octets[0] = (unsigned char) (valeur >> 24);
+    octets[1] = (unsigned char) (valeur >> 16);
+    octets[2] = (unsigned char) (valeur >> 8);
+    octets[3] = (unsigned char) valeur;
+}
+
+/* Inverse l'ordre des longueur bits de poids faible de code (les codes de Huffman sont lus bit de poids fort en premier) */
+static unsigned int inverserBits(unsigned int code, int longueur) {
+
+    unsigned int inverse = 0;
+
+    while(longueur-- > 0) {
+        inverse = (inverse << 1) | (code & 1u);
+        code >>= 1;
+    }
+
+    return inverse;
+}
+
+
+int readHeaderPNG(char* pathFile, long int *imageWidth, long int *imageHeight, long int *profondeur) {
+
+    FILE* image = NULL;
+    unsigned char entete[8 + 8 + 13];
+
+    image = fopen(pathFile, "rb");
+    if(image == NULL)
+        return ERROR_OPEN;
+
+    // Signature puis le chunk IHDR, toujours le premier
+    if(fread(entete, 1, sizeof(entete), image) != sizeof(entete)) {
+        fclose(image);
+        return ERROR_FORMAT;
+    }
+    fclose(image);
+
+    if(memcmp(entete, SIGNATURE_PNG, 8) != 0 || lireU32BE(entete + 8) != 13 || memcmp(entete + 12, "IHDR", 4) != 0)
+        return ERROR_FORMAT;
+
+    *imageWidth = (long int) lireU32BE(entete + 16);
+    *imageHeight = (long int) lireU32BE(entete + 20);
+
+    // Seuls les PNG 8 bits non entrelacés sans palette sont acceptés
+    if(entete[24] != 8 || entete[26] != 0 || entete[27] != 0 || entete[28] != 0)
+        return ERROR_FORMAT;
+
+    switch(entete[25]) {
+        case 0:
+            *profondeur = 1;
+            break;
+        case 2:
+            *profondeur = 3;
+            break;
+        case 4:
+            *profondeur = 2;
+            break;
+        case 6:
+            *profondeur = 4;
+            break;
+        default:
+            return ERROR_FORMAT;
+    }
+
+    if(*imageWidth <= 0 || *imageHeight <= 0 || *imageWidth > INT_MAX / 4)
+        return ERROR_FORMAT;
+
+    return ERROR_OK;
+}
+
+
+/* Octet suivant des données IDAT, les chunks IDAT consécutifs forment un seul flux. -1 à la fin du flux */
+static int octetIDAT(decodeurPNG_t* decodeur) {
+
+    unsigned char entete[12];
+
+    while(decodeur->resteChunk == 0) {
+        // CRC du chunk courant puis entête du suivant
+        if(decodeur->finIdat || fread(entete, 1, 12, decodeur->fichier) != 12 || memcmp(entete + 8, "IDAT", 4) != 0) {
+            decodeur->finIdat = 1;
+            return -1;
+        }
+        decodeur->resteChunk = (long int) lireU32BE(entete + 4);
+    }
+
+    decodeur->resteChunk--;
+
+    return fgetc(decodeur->fichier);
+}
+
+/* Complète le réservoir à au moins n bits. Au-delà de la fin du flux, le réservoir est complété par des zéros et epuise est positionné */
+static void besoinBitsPNG(decodeurPNG_t* decodeur, int n) {
+
+    int octet;
+
+    while(decodeur->nbBits < n) {
+        octet = octetIDAT(decodeur);
+        if(octet < 0) {
+            octet = 0;
+            decodeur->epuise = 1;
+        }
+        decodeur->reservoir |= (unsigned long long) octet << decodeur->nbBits;
+        decodeur->nbBits += 8;
+    }
+}
+
+static unsigned int lireBitsPNG(decodeurPNG_t* decodeur, int n) {
+
+    unsigned int valeur;
+
+    if(n == 0)
+        return 0;
+
+    besoinBitsPNG(decodeur, n);
+    valeur = (unsigned int) (decodeur->reservoir & ((1ull << n) - 1));
+    decodeur->reservoir >>= n;
+    decodeur->nbBits -= n;
+
+    return valeur;
+}
+
+
+int construireHuffman(huffman_t* huffman, const unsigned char* longueurs, int nbSymboles) {
+
+    unsigned short positions[LONGUEUR_MAX_HUFFMAN + 2], suivant[LONGUEUR_MAX_HUFFMAN + 1];
+    unsigned int code, k;
+    int longueur, s, restants;
+
+    memset(huffman->nombre, 0, sizeof(huffman->nombre));
+    memset(huffman->rapide, 0, sizeof(huffman->rapide));
+
+    for(s = 0; s < nbSymboles; s++)
+        huffman->nombre[longueurs[s]]++;
+    huffman->nombre[0] = 0;
+
+    // Un code sur-souscrit est invalide, un code incomplet est accepté (les codes absents sont des erreurs au décodage)
+    restants = 1;
+    for(longueur = 1; longueur <= LONGUEUR_MAX_HUFFMAN; longueur++) {
+        restants = (restants << 1) - huffman->nombre[longueur];
+        if(restants < 0)
+            return ERROR_FORMAT;
+    }
+
+    positions[1] = 0;
+    for(longueur = 1; longueur <= LONGUEUR_MAX_HUFFMAN; longueur++)
+        positions[longueur + 1] = (unsigned short) (positions[longueur] + huffman->nombre[longueur]);
+    for(s = 0; s < nbSymboles; s++) {
+        if(longueurs[s] != 0)
+            huffman->symboles[positions[longueurs[s]]++] = (unsigned short) s;
+    }
+
+    // Table rapide: les codes de BITS_TABLE_HUFFMAN bits ou moins sont décodés en une lecture
+    code = 0;
+    suivant[0] = 0;
+    for(longueur = 1; longueur <= LONGUEUR_MAX_HUFFMAN; longueur++) {
+        code = (code + huffman->nombre[longueur - 1]) << 1;
+        suivant[longueur] = (unsigned short) code;
+    }
+    for(s = 0; s < nbSymboles; s++) {
+        longueur = longueurs[s];
+        if(longueur == 0)
+            continue;
+        code = suivant[longueur]++;
+        if(longueur <= BITS_TABLE_HUFFMAN) {
+            for(k = inverserBits(code, longueur); k < (1u << BITS_TABLE_HUFFMAN); k += 1u << longueur)
+                huffman->rapide[k] = (unsigned short) ((s << 4) | longueur);
+        }
+    }
+
+    return ERROR_OK;
+}
+
+/* Décode un symbole, -1 si le code n'existe pas */
+static int decoderSymbolePNG(decodeurPNG_t* decodeur, const huffman_t* huffman) {
+
+    unsigned int bits, entree;
+    int longueur, code = 0, premier = 0, index = 0, nombre;
+
+    besoinBitsPNG(decodeur, LONGUEUR_MAX_HUFFMAN);
+    bits = (unsigned int) decodeur->reservoir;
+
+    entree = huffman->rapide[bits & ((1u << BITS_TABLE_HUFFMAN) - 1)];
+    if(entree != 0) {
+        decodeur->reservoir >>= entree & 15u;
+        decodeur->nbBits -= (int) (entree & 15u);
+        return (int) (entree >> 4);
+    }
+
+    // Code plus long que la table: décodage canonique bit par bit
+    for(longueur = 1; longueur <= LONGUEUR_MAX_HUFFMAN; longueur++) {
+        code |= (int) ((bits >> (longueur - 1)) & 1u);
+        nombre = huffman->nombre[longueur];
+        if(code - nombre < premier) {
+            decodeur->reservoir >>= longueur;
+            decodeur->nbBits -= longueur;
+            return huffman->symboles[index + (code - premier)];
+        }
+        index += nombre;
+        premier = (premier + nombre) << 1;
+        code <<= 1;
+    }
+
+    return -1;
+}
+
+/* Défiltre une ligne complète (octet de filtre puis octetsLigne octets) et la range dans la matrice */
+static int terminerLignePNG(decodeurPNG_t* decodeur) {
+
+    unsigned char *ligne = decodeur->ligne + 1, *precedente = decodeur->precedente + 1, *echange;
+    long int x, bpp = decodeur->profondeur, n = decodeur->octetsLigne;
+    int a, b, c, p, pa, pb, pc;
+
+    switch(decodeur->ligne[0]) {
+        case 0:
+            break;
+        case 1:
+            for(x = bpp; x < n; x++)
+                ligne[x] = (unsigned char) (ligne[x] + ligne[x - bpp]);
+            break;
+        case 2:
+            for(x = 0; x < n; x++)
+                ligne[x] = (unsigned char) (ligne[x] + precedente[x]);
+            break;
+        case 3:
+            for(x = 0; x < n; x++)
+                ligne[x] = (unsigned char) (ligne[x] + (((x >= bpp ? ligne[x - bpp] : 0) + precedente[x]) >> 1));
+            break;
+        case 4:
+            for(x = 0; x < n; x++) {
+                a = x >= bpp ? ligne[x - bpp] : 0;
+                b = precedente[x];
+                c = x >= bpp ? precedente[x - bpp] : 0;
+                p = a + b - c;
+                pa = abs(p - a);
+                pb = abs(p - b);
+                pc = abs(p - c);
+                ligne[x] = (unsigned char) (ligne[x] + (pa <= pb && pa <= pc ? a : (pb <= pc ? b : c)));
+            }
+            break;
+        default:
+            return ERROR_FORMAT;
+    }
+
+    // Un octet par échantillon pour une source en lecture seule, un entier pour une image à modifier
+    if(decodeur->octets != NULL) {
+        memcpy(decodeur->octets + decodeur->numeroLigne * n, ligne, (size_t) n);
+    } else {
+        for(x = 0; x < n; x++)
+            decodeur->matrice[decodeur->numeroLigne * n + x] = ligne[x];
+    }
+
+    echange = decodeur->precedente;
+    decodeur->precedente = decodeur->ligne;
+    decodeur->ligne = echange;
+    decodeur->remplissage = 0;
+    decodeur->numeroLigne++;
+
+    return ERROR_OK;
+}
+
+/* Transmet les octets produits depuis le dernier vidage de la fenêtre aux lignes de l'image */
+static int viderFenetrePNG(decodeurPNG_t* decodeur) {
+
+    const unsigned char* octets = decodeur->fenetre + (decodeur->vide & (TAILLE_FENETRE_DEFLATE - 1));
+    long int n = decodeur->position - decodeur->vide, copie;
+    int error;
+
+    decodeur->adler = adler32(decodeur->adler, octets, (size_t) n);
+    decodeur->vide = decodeur->position;
+
+    while(n > 0) {
+        if(decodeur->numeroLigne >= decodeur->nbLignes)
+            return ERROR_FORMAT;
+
+        copie = decodeur->octetsLigne + 1 - decodeur->remplissage;
+        if(copie > n)
+            copie = n;
+        memcpy(decodeur->ligne + decodeur->remplissage, octets, (size_t) copie);
+        decodeur->remplissage += copie;
+        octets += copie;
+        n -= copie;
+
+        if(decodeur->remplissage == decodeur->octetsLigne + 1) {
+            error = terminerLignePNG(decodeur);
+            if(error != ERROR_OK)
+                return error;
+        }
+    }
+
+    return ERROR_OK;
+}
+
+static int sortirOctetPNG(decodeurPNG_t* decodeur, unsigned char octet) {
+
+    decodeur->fenetre[decodeur->position & (TAILLE_FENETRE_DEFLATE - 1)] = octet;
+    decodeur->position++;
+
+    // La fenêtre est vidée par morceaux qui ne la traversent jamais
+    if((decodeur->position & (TAILLE_VIDAGE_PNG - 1)) == 0)
+        return viderFenetrePNG(decodeur);
+
+    return ERROR_OK;
+}
+
+/* Bloc compressé: littéraux et répétitions jusqu'au symbole de fin de bloc */
+static int inflerBlocPNG(decodeurPNG_t* decodeur, const huffman_t* litteraux, const huffman_t* distances) {
+
+    int symbole, error;
+    long int longueur, distance;
+
+    for(;;) {
+        symbole = decoderSymbolePNG(decodeur, litteraux);
+        if(symbole < 0 || decodeur->epuise)
+            return ERROR_FORMAT;
+
+        if(symbole < 256) {
+            error = sortirOctetPNG(decodeur, (unsigned char) symbole);
+        } else if(symbole == 256) {
+            return ERROR_OK;
+        } else {
+            symbole -= 257;
+            if(symbole >= 29)
+                return ERROR_FORMAT;
+            longueur = baseLongueurDeflate[symbole] + (long int) lireBitsPNG(decodeur, extraLongueurDeflate[symbole]);
+
+            symbole = decoderSymbolePNG(decodeur, distances);
+            if(symbole < 0 || symbole >= 30)
+                return ERROR_FORMAT;
+            distance = baseDistanceDeflate[symbole] + (long int) lireBitsPNG(decodeur, extraDistanceDeflate[symbole]);
+            if(distance > decodeur->position || decodeur->epuise)
+                return ERROR_FORMAT;
+
+            error = ERROR_OK;
+            while(longueur-- > 0 && error == ERROR_OK)
+                error = sortirOctetPNG(decodeur, decodeur->fenetre[(decodeur->position - distance) & (TAILLE_FENETRE_DEFLATE - 1)]);
+        }
+
+        if(error != ERROR_OK)
+            return error;
+    }
+}
+
+/* Lit les codes d'un bloc dynamique */
+static int lireCodesDynamiquesPNG(decodeurPNG_t* decodeur, huffman_t* litteraux, huffman_t* distances) {
+
+    unsigned char longueurs[NB_LITTERAUX_DEFLATE + NB_DISTANCES_DEFLATE], longueursCodes[19];
+    huffman_t codes;
+    int nbLitteraux, nbDistances, nbCodes, i, symbole, repetition, valeur, error;
+
+    nbLitteraux = (int) lireBitsPNG(decodeur, 5) + 257;
+    nbDistances = (int) lireBitsPNG(decodeur, 5) + 1;
+    nbCodes = (int) lireBitsPNG(decodeur, 4) + 4;
+    if(nbLitteraux > NB_LITTERAUX_DEFLATE || nbDistances > NB_DISTANCES_DEFLATE)
+        return ERROR_FORMAT;
+
+    memset(longueursCodes, 0, sizeof(longueursCodes));
+    for(i = 0; i < nbCodes; i++)
+        longueursCodes[ordreLongueursDeflate[i]] = (unsigned char) lireBitsPNG(decodeur, 3);
+    error = construireHuffman(&codes, longueursCodes, 19);
+    if(error != ERROR_OK)
+        return error;
+
+    // Longueurs des deux codes, avec répétitions (16: la précédente 3 à 6 fois, 17 et 18: des zéros)
+    i = 0;
+    while(i < nbLitteraux + nbDistances) {
+        symbole = decoderSymbolePNG(decodeur, &codes);
+        if(symbole < 0 || decodeur->epuise)
+            return ERROR_FORMAT;
+
+        if(symbole < 16) {
+            longueurs[i++] = (unsigned char) symbole;
+            continue;
+        }
+
+        if(symbole == 16) {
+            if(i == 0)
+                return ERROR_FORMAT;
+            valeur = longueurs[i - 1];
+            repetition = 3 + (int) lireBitsPNG(decodeur, 2);
+        } else if(symbole == 17) {
+            valeur = 0;
+            repetition = 3 + (int) lireBitsPNG(decodeur, 3);
+        } else {
+            valeur = 0;
+            repetition = 11 + (int) lireBitsPNG(decodeur, 7);
+        }
+        if(i + repetition > nbLitteraux + nbDistances)
+            return ERROR_FORMAT;
+        while(repetition-- > 0)
+            longueurs[i++] = (unsigned char) valeur;
+    }
+
+    if(longueurs[256] == 0)
+        return ERROR_FORMAT;
+
+    error = construireHuffman(litteraux, longueurs, nbLitteraux);
+    if(error == ERROR_OK)
+        error = construireHuffman(distances, longueurs + nbLitteraux, nbDistances);
+
+    return error;
+}
+
+/* Décompresse le flux zlib des IDAT, les lignes sont défiltrées au fur et à mesure */
+static int inflerPNG(decodeurPNG_t* decodeur) {
+
+    unsigned char longueursFixes[NB_LITTERAUX_DEFLATE + NB_DISTANCES_DEFLATE];
+    huffman_t litteraux, distances;
+    unsigned int cmf, flg, dernier, type, longueur, complement, attendu;
+    int i, error = ERROR_OK;
+
+    cmf = lireBitsPNG(decodeur, 8);
+    flg = lireBitsPNG(decodeur, 8);
+    if((cmf & 15u) != 8 || (cmf >> 4) > 7 || (cmf * 256 + flg) % 31 != 0 || (flg & 0x20u) != 0)
+        return ERROR_FORMAT;
+
+    do {
+        dernier = lireBitsPNG(decodeur, 1);
+        type = lireBitsPNG(decodeur, 2);
+
+        if(type == 0) {
+            // Bloc stocké: aligné sur un octet, longueur et son complément
+            lireBitsPNG(decodeur, decodeur->nbBits & 7);
+            longueur = lireBitsPNG(decodeur, 16);
+            complement = lireBitsPNG(decodeur, 16);
+            if(longueur != (~complement & 0xFFFFu))
+                return ERROR_FORMAT;
+            while(longueur-- > 0 && error == ERROR_OK)
+                error = sortirOctetPNG(decodeur, (unsigned char) lireBitsPNG(decodeur, 8));
+        } else if(type == 1) {
+            // Codes fixes de la RFC 1951
+            for(i = 0; i < NB_LITTERAUX_DEFLATE; i++)
+                longueursFixes[i] = (unsigned char) (i < 144 ? 8 : (i < 256 ? 9 : (i < 280 ? 7 : 8)));
+            for(i = 0; i < NB_DISTANCES_DEFLATE; i++)
+                longueursFixes[NB_LITTERAUX_DEFLATE + i] = 5;
+            construireHuffman(&litteraux, longueursFixes, NB_LITTERAUX_DEFLATE);
+            construireHuffman(&distances, longueursFixes + NB_LITTERAUX_DEFLATE, NB_DISTANCES_DEFLATE);
+            error = inflerBlocPNG(decodeur, &litteraux, &distances);
+        } else if(type == 2) {
+            error = lireCodesDynamiquesPNG(decodeur, &litteraux, &distances);
+            if(error == ERROR_OK)
+                error = inflerBlocPNG(decodeur, &litteraux, &distances);
+        } else {
+            error = ERROR_FORMAT;
+        }
+
+        if(decodeur->epuise)
+            error = ERROR_FORMAT;
+    } while(!dernier && error == ERROR_OK);
+
+    if(error == ERROR_OK)
+        error = viderFenetrePNG(decodeur);
+    if(error != ERROR_OK)
+        return error;
+
+    // Somme Adler-32 des données décompressées, en big-endian après le dernier bloc
+    lireBitsPNG(decodeur, decodeur->nbBits & 7);
+    attendu = lireBitsPNG(decodeur, 8) << 24;
+    attendu |= lireBitsPNG(decodeur, 8) << 16;
+    attendu |= lireBitsPNG(decodeur, 8) << 8;
+    attendu |= lireBitsPNG(decodeur, 8);
+
+    if(decodeur->epuise || attendu != decodeur->adler || decodeur->numeroLigne != decodeur->nbLignes)
+        return ERROR_FORMAT;
+
+    return ERROR_OK;
+}
+
+
+/* Décode le PNG dans matrice (un entier par échantillon) ou dans octets (un octet par échantillon) */
+static int decoderImagePNG(char* pathFile, int* matrice, unsigned char* octets, long int imageWidth, long int imageHeight, long int profondeur) {
+
+    decodeurPNG_t decodeur;
+    unsigned char entete[8];
+    int error = ERROR_FORMAT;
+
+    memset(&decodeur, 0, sizeof(decodeur));
+    decodeur.matrice = matrice;
+    decodeur.octets = octets;
+    decodeur.profondeur = (int) profondeur;
+    decodeur.octetsLigne = imageWidth * profondeur;
+    decodeur.nbLignes = imageHeight;
+    decodeur.adler = 1;
+
+    decodeur.fichier = fopen(pathFile, "rb");
+    if(decodeur.fichier == NULL)
+        return ERROR_OPEN;
+
+    decodeur.fenetre = (unsigned char*) malloc(TAILLE_FENETRE_DEFLATE);
+    decodeur.ligne = (unsigned char*) malloc((size_t) decodeur.octetsLigne + 1);
+    decodeur.precedente = (unsigned char*) calloc((size_t) decodeur.octetsLigne + 1, 1);
+    if(decodeur.fenetre == NULL || decodeur.ligne == NULL || decodeur.precedente == NULL) {
+        error = ERROR_NOMEM;
+    } else if(fseek(decodeur.fichier, 8, SEEK_SET) == 0) {
+        // Les chunks qui précèdent les données (IHDR, métadonnées) sont sautés
+        while(fread(entete, 1, 8, decodeur.fichier) == 8) {
+            if(memcmp(entete + 4, "IDAT", 4) == 0) {
+                decodeur.resteChunk = (long int) lireU32BE(entete);
+                error = inflerPNG(&decodeur);
+                break;
+            }
+            if(memcmp(entete + 4, "IEND", 4) == 0 || fseek(decodeur.fichier, (long int) lireU32BE(entete) + 4, SEEK_CUR) != 0)
+                break;
+        }
+    }
+
+    free(decodeur.fenetre);
+    free(decodeur.ligne);
+    free(decodeur.precedente);
+    fclose(decodeur.fichier);
+
+    return error;
+}
+
+
+int readImagePNG(char* pathFile, int* matrice, long int imageWidth, long int imageHeight, long int profondeur) {
+
+    return decoderImagePNG(pathFile, matrice, NULL, imageWidth, imageHeight, profondeur);
+}
+
+
+int readImagePNGOctets(char* pathFile, unsigned char* octets, long int imageWidth, long int imageHeight, long int profondeur) {
+
+    return decoderImagePNG(pathFile, NULL, octets, imageWidth, imageHeight, profondeur);
+}
+
+
+static int ecrireChunkPNG(FILE* fichier, const char* type, const unsigned char* donnees, long int taille) {
+
+    unsigned char octets[4];
+    unsigned int crc;
+
+    ecrireU32BE(octets, (unsigned long) taille);
+    crc = crc32PNG(crc32PNG(0, (const unsigned char*) type, 4), donnees, (size_t) taille);
+
+    fwrite(octets, 1, 4, fichier);
+    fwrite(type, 1, 4, fichier);
+    if(taille > 0)
+        fwrite(donnees, 1, (size_t) taille, fichier);
+    ecrireU32BE(octets, crc);
+    if(fwrite(octets, 1, 4, fichier) != 4)
+        return ERROR_HANDLE;
+
+    return ERROR_OK;
+}
+
+static void octetSortiePNG(encodeurPNG_t* encodeur, unsigned char octet) {
+
+    encodeur->idat[encodeur->tailleIdat++] = octet;
+    if(encodeur->tailleIdat == TAILLE_IDAT_PNG) {
+        if(ecrireChunkPNG(encodeur->fichier, "IDAT", encodeur->idat, encodeur->tailleIdat) != ERROR_OK)
+            encodeur->error = ERROR_HANDLE;
+        encodeur->tailleIdat = 0;
+    }
+}
+
+/* Écrit les n bits de poids faible de valeur, bit de poids faible en premier */
+static void ecrireBitsPNG(encodeurPNG_t* encodeur, unsigned int valeur, int n) {
+
+    encodeur->reservoir |= (unsigned long long) valeur << encodeur->nbBits;
+    encodeur->nbBits += n;
+
+    while(encodeur->nbBits >= 8) {
+        octetSortiePNG(encodeur, (unsigned char) encodeur->reservoir);
+        encodeur->reservoir >>= 8;
+        encodeur->nbBits -= 8;
+    }
+}
+
+
+void longueursHuffman(const unsigned long* frequences, int nbSymboles, int longueurMax, unsigned char* longueurs) {
+
+    unsigned long base[NB_LITTERAUX_DEFLATE], poids[2 * NB_LITTERAUX_DEFLATE];
+    int parent[2 * NB_LITTERAUX_DEFLATE], actif[2 * NB_LITTERAUX_DEFLATE];
+    int s, n, premier, second, profondeurMax, longueur, noeud, utilises = 0;
+
+    for(s = 0; s < nbSymboles; s++) {
+        base[s] = frequences[s];
+        utilises += base[s] != 0;
+    }
+
+    // Deux symboles au moins, pour que le code soit complet
+    for(s = 0; s < nbSymboles && utilises < 2; s++) {
+        if(base[s] == 0) {
+            base[s] = 1;
+            utilises++;
+        }
+    }
+
+    for(;;) {
+        for(s = 0; s < nbSymboles; s++) {
+            poids[s] = base[s];
+            actif[s] = base[s] != 0;
+            parent[s] = -1;
+        }
+
+        // Réunion des deux noeuds les plus légers jusqu'à la racine
+        n = nbSymboles;
+        for(;;) {
+            premier = second = -1;
+            for(s = 0; s < n; s++) {
+                if(!actif[s])
+                    continue;
+                if(premier < 0 || poids[s] < poids[premier]) {
+                    second = premier;
+                    premier = s;
+                } else if(second < 0 || poids[s] < poids[second]) {
+                    second = s;
+                }
+            }
+            if(second < 0)
+                break;
+            poids[n] = poids[premier] + poids[second];
+            actif[n] = 1;
+            parent[n] = -1;
+            actif[premier] = actif[second] = 0;
+            parent[premier] = parent[second] = n;
+            n++;
+        }
+
+        profondeurMax = 0;
+        for(s = 0; s < nbSymboles; s++) {
+            longueur = 0;
+            if(base[s] != 0) {
+                for(noeud = s; parent[noeud] >= 0; noeud = parent[noeud])
+                    longueur++;
+            }
+            longueurs[s] = (unsigned char) longueur;
+            if(longueur > profondeurMax)
+                profondeurMax = longueur;
+        }
+
+        if(profondeurMax <= longueurMax)
+            return;
+
+        // Code trop long: les fréquences sont divisées par 2 (sans s'annuler), ce qui aplatit l'arbre
+        for(s = 0; s < nbSymboles; s++) {
+            if(base[s] != 0)
+                base[s] = (base[s] + 1) >> 1;
+        }
+    }
+}
+
+/* Codes canoniques correspondant à des longueurs, bits inversés pour l'écriture */
+static void codesHuffman(const unsigned char* longueurs, int nbSymboles, unsigned short* codes) {
 
-    if(extensionBinary != NULL)
-        free(extensionBinary);
+    unsigned short nombre[LONGUEUR_MAX_HUFFMAN + 1], suivant[LONGUEUR_MAX_HUFFMAN + 1];
+    unsigned int code = 0;
+    int s, longueur;
 
-    if(extensionFileToCrypt != NULL)
-        free(extensionFileToCrypt);
+    memset(nombre, 0, sizeof(nombre));
+    for(s = 0; s < nbSymboles; s++)
+        nombre[longueurs[s]]++;
+    nombre[0] = 0;
 
-    return ERROR_OK;
+    for(longueur = 1; longueur <= LONGUEUR_MAX_HUFFMAN; longueur++) {
+        code = (code + nombre[longueur - 1]) << 1;
+        suivant[longueur] = (unsigned short) code;
+    }
+
+    for(s = 0; s < nbSymboles; s++)
+        codes[s] = longueurs[s] != 0 ? (unsigned short) inverserBits(suivant[longueurs[s]]++, longueurs[s]) : 0;
 }
 
-int createFileFromByte(const char* fileToCrypt, const unsigned char* msgSecret, long int tailleMsgDecrypt) {
+static int codeLongueurDeflate(int longueur) {
 
-    FILE *newFile = fopen(fileToCrypt, "w");
-    if(newFile == NULL)
-        return ERROR_OPEN;
+    int code = 28;
 
-    fwrite(msgSecret, 1, (tailleMsgDecrypt/8)-6, newFile);
-    fclose(newFile);
+    while(baseLongueurDeflate[code] > longueur)
+        code--;
 
-    return ERROR_OK;
+    return code;
 }
 
-int readExtensionSuffix(const unsigned char* msgSecret, int lengthmsgSecret, char** extensionPixelMap) {
-
-    int y;
+static int codeDistanceDeflate(int distance) {
 
-    (*extensionPixelMap) = malloc(sizeof(char)*5);
-    if((*extensionPixelMap) == NULL)
-        return ERROR_NOMEM;
+    int code = 29;
 
-    (*extensionPixelMap)[0] = '.';
-    for(y = 1;y<6;y++) {
-        (*extensionPixelMap)[y] = (char)msgSecret[lengthmsgSecret-6+y];
-    }
+    while(baseDistanceDeflate[code] > distance)
+        code--;
 
-    return ERROR_OK;
+    return code;
 }
 
+/* Écrit les symboles du bloc courant dans un bloc deflate à codes dynamiques */
+static void ecrireBlocDynamiquePNG(encodeurPNG_t* encodeur, int dernier) {
 
+    unsigned long frequencesLitteraux[NB_LITTERAUX_DEFLATE], frequencesDistances[NB_DISTANCES_DEFLATE], frequencesCodes[19];
+    unsigned char longueurs[NB_LITTERAUX_DEFLATE + NB_DISTANCES_DEFLATE], longueursCodes[19];
+    unsigned char suite[NB_LITTERAUX_DEFLATE + NB_DISTANCES_DEFLATE], extraSuite[NB_LITTERAUX_DEFLATE + NB_DISTANCES_DEFLATE];
+    unsigned short codesLitteraux[NB_LITTERAUX_DEFLATE], codesDistances[NB_DISTANCES_DEFLATE], codesCodes[19];
+    int nbLitteraux = NB_LITTERAUX_DEFLATE, nbDistances = NB_DISTANCES_DEFLATE, nbCodes = 19, nbSuite = 0, total, i, j, repetition, code;
+    long int k;
+    unsigned int longueur, distance;
+
+    memset(frequencesLitteraux, 0, sizeof(frequencesLitteraux));
+    memset(frequencesDistances, 0, sizeof(frequencesDistances));
+    memset(frequencesCodes, 0, sizeof(frequencesCodes));
+
+    for(k = 0; k < encodeur->nbSymboles; k++) {
+        if(encodeur->distances[k] == 0) {
+            frequencesLitteraux[encodeur->symboles[k]]++;
+        } else {
+            frequencesLitteraux[257 + codeLongueurDeflate(encodeur->symboles[k])]++;
+            frequencesDistances[codeDistanceDeflate(encodeur->distances[k])]++;
+        }
+    }
+    frequencesLitteraux[256] = 1;
+
+    longueursHuffman(frequencesLitteraux, NB_LITTERAUX_DEFLATE, LONGUEUR_MAX_HUFFMAN, longueurs);
+    longueursHuffman(frequencesDistances, NB_DISTANCES_DEFLATE, LONGUEUR_MAX_HUFFMAN, longueurs + NB_LITTERAUX_DEFLATE);
+    codesHuffman(longueurs, NB_LITTERAUX_DEFLATE, codesLitteraux);
+    codesHuffman(longueurs + NB_LITTERAUX_DEFLATE, NB_DISTANCES_DEFLATE, codesDistances);
+
+    while(nbLitteraux > 257 && longueurs[nbLitteraux - 1] == 0)
+        nbLitteraux--;
+    while(nbDistances > 1 && longueurs[NB_LITTERAUX_DEFLATE + nbDistances - 1] == 0)
+        nbDistances--;
+    if(nbLitteraux < NB_LITTERAUX_DEFLATE)
+        memmove(longueurs + nbLitteraux, longueurs + NB_LITTERAUX_DEFLATE, (size_t) nbDistances);
+    total = nbLitteraux + nbDistances;
+
+    // Longueurs des deux codes, les suites de valeurs identiques sont remplacées par les codes 16, 17 et 18
+    for(i = 0; i < total; i += repetition) {
+        for(repetition = 1; i + repetition < total && longueurs[i + repetition] == longueurs[i]; repetition++)
+            ;
+
+        if(longueurs[i] == 0 && repetition >= 3) {
+            if(repetition > 138)
+                repetition = 138;
+            suite[nbSuite] = (unsigned char) (repetition >= 11 ? 18 : 17);
+            extraSuite[nbSuite++] = (unsigned char) (repetition >= 11 ? repetition - 11 : repetition - 3);
+        } else if(longueurs[i] != 0 && repetition >= 4) {
+            // La valeur une fois, puis 3 à 6 répétitions
+            if(repetition > 7)
+                repetition = 7;
+            suite[nbSuite] = longueurs[i];
+            extraSuite[nbSuite++] = 0;
+            suite[nbSuite] = 16;
+            extraSuite[nbSuite++] = (unsigned char) (repetition - 4);
+        } else {
+            repetition = 1;
+            suite[nbSuite] = longueurs[i];
+            extraSuite[nbSuite++] = 0;
+        }
+    }
 
+    for(i = 0; i < nbSuite; i++)
+        frequencesCodes[suite[i]]++;
+    longueursHuffman(frequencesCodes, 19, 7, longueursCodes);
+    codesHuffman(longueursCodes, 19, codesCodes);
+    while(nbCodes > 4 && longueursCodes[ordreLongueursDeflate[nbCodes - 1]] == 0)
+        nbCodes--;
+
+    ecrireBitsPNG(encodeur, dernier ? 1u : 0u, 1);
+    ecrireBitsPNG(encodeur, 2, 2);
+    ecrireBitsPNG(encodeur, (unsigned int) (nbLitteraux - 257), 5);
+    ecrireBitsPNG(encodeur, (unsigned int) (nbDistances - 1), 5);
+    ecrireBitsPNG(encodeur, (unsigned int) (nbCodes - 4), 4);
+    for(i = 0; i < nbCodes; i++)
+        ecrireBitsPNG(encodeur, longueursCodes[ordreLongueursDeflate[i]], 3);
+
+    for(i = 0; i < nbSuite; i++) {
+        ecrireBitsPNG(encodeur, codesCodes[suite[i]], longueursCodes[suite[i]]);
+        if(suite[i] == 16)
+            ecrireBitsPNG(encodeur, extraSuite[i], 2);
+        else if(suite[i] == 17)
+            ecrireBitsPNG(encodeur, extraSuite[i], 3);
+        else if(suite[i] == 18)
+            ecrireBitsPNG(encodeur, extraSuite[i], 7);
+    }
 
+    // Les longueurs ont été déplacées: on relit celles des distances dans le tableau compacté
+    for(k = 0; k < encodeur->nbSymboles; k++) {
+        if(encodeur->distances[k] == 0) {
+            j = encodeur->symboles[k];
+            ecrireBitsPNG(encodeur, codesLitteraux[j], longueurs[j]);
+        } else {
+            longueur = encodeur->symboles[k];
+            distance = encodeur->distances[k];
+            code = codeLongueurDeflate((int) longueur);
+            ecrireBitsPNG(encodeur, codesLitteraux[257 + code], longueurs[257 + code]);
+            ecrireBitsPNG(encodeur, longueur - baseLongueurDeflate[code], extraLongueurDeflate[code]);
+            code = codeDistanceDeflate((int) distance);
+            ecrireBitsPNG(encodeur, codesDistances[code], longueurs[nbLitteraux + code]);
+            ecrireBitsPNG(encodeur, distance - baseDistanceDeflate[code], extraDistanceDeflate[code]);
+        }
+    }
 
+    ecrireBitsPNG(encodeur, codesLitteraux[256], longueurs[256]);
+}
 
-int binaryToUChar(long int tailleMsgDecrypt, const unsigned char *messageSecretBitOutput, unsigned char **msgSecret, int* lengthmsgSecret) {
+static void insererHachagePNG(encodeurPNG_t* encodeur, long int position) {
 
-    int i,j;
-    unsigned char* data;
-    data = (unsigned char*) malloc(sizeof(unsigned char)*9);
-    if(data== NULL)
-        return ERROR_NOMEM;
+    const unsigned char* octets = encodeur->donnees + position;
+    unsigned int hachage = ((((unsigned int) octets[0] << 16) | ((unsigned int) octets[1] << 8) | octets[2]) * 2654435761u) >> (32 - LOG2_HACHAGE_DEFLATE);
 
-    (*msgSecret) = (unsigned char*) malloc(sizeof(unsigned char) * (tailleMsgDecrypt / 8) + 1);
-    if((*msgSecret)== NULL)
-        return ERROR_NOMEM;
+    encodeur->precedent[position] = encodeur->tete[hachage];
+    encodeur->tete[hachage] = (int) position;
+}
 
-    j = 0;
-    for(i = 0; i<tailleMsgDecrypt; i++) {
+/* Compresse les octets reçus depuis le dernier bloc (LZ77 glouton à chaînes de hachage, l'historique sert de dictionnaire) */
+static void compresserBlocPNG(encodeurPNG_t* encodeur, int dernier) {
+
+    long int i, j, fin = encodeur->remplissage, garde;
+    long int candidat, meilleureLongueur, meilleureDistance, longueur, limite;
+    int essais;
+
+    memset(encodeur->tete, 0xFF, sizeof(int) << LOG2_HACHAGE_DEFLATE);
+    for(i = 0; i + LONGUEUR_MIN_DEFLATE <= encodeur->historique; i++)
+        insererHachagePNG(encodeur, i);
+
+    encodeur->nbSymboles = 0;
+    i = encodeur->historique;
+    while(i < fin) {
+
+        meilleureLongueur = 0;
+        meilleureDistance = 0;
+
+        if(i + LONGUEUR_MIN_DEFLATE <= fin) {
+            limite = fin - i < LONGUEUR_MAX_DEFLATE ? fin - i : LONGUEUR_MAX_DEFLATE;
+            insererHachagePNG(encodeur, i);
+            candidat = encodeur->precedent[i];
+            for(essais = CHAINE_MAX_DEFLATE; candidat >= 0 && i - candidat <= TAILLE_FENETRE_DEFLATE && essais > 0; essais--) {
+                if(encodeur->donnees[candidat + meilleureLongueur] == encodeur->donnees[i + meilleureLongueur] || meilleureLongueur == 0) {
+                    for(longueur = 0; longueur < limite && encodeur->donnees[candidat + longueur] == encodeur->donnees[i + longueur]; longueur++)
+                        ;
+                    if(longueur > meilleureLongueur) {
+                        meilleureLongueur = longueur;
+                        meilleureDistance = i - candidat;
+                        if(longueur == limite)
+                            break;
+                    }
+                }
+                candidat = encodeur->precedent[candidat];
+            }
+        }
 
-        data[i%8] = messageSecretBitOutput[i] + '0';
-        if(i%8 == 7) {
-            (*msgSecret)[j] = strtol((const char*)data, 0, 2);
-            j = j+1;
+        if(meilleureLongueur >= LONGUEUR_MIN_DEFLATE) {
+            encodeur->symboles[encodeur->nbSymboles] = (unsigned short) meilleureLongueur;
+            encodeur->distances[encodeur->nbSymboles++] = (unsigned short) meilleureDistance;
+            for(j = i + 1; j < i + meilleureLongueur && j + LONGUEUR_MIN_DEFLATE <= fin; j++)
+                insererHachagePNG(encodeur, j);
+            i += meilleureLongueur;
+        } else {
+            encodeur->symboles[encodeur->nbSymboles] = encodeur->donnees[i];
+            encodeur->distances[encodeur->nbSymboles++] = 0;
+            i++;
         }
     }
 
-    (*lengthmsgSecret) = j;
-
-    free(data);
+    ecrireBlocDynamiquePNG(encodeur, dernier);
 
-    return ERROR_OK;
+    // Les TAILLE_FENETRE_DEFLATE derniers octets servent d'historique au bloc suivant
+    garde = fin < TAILLE_FENETRE_DEFLATE ? fin : TAILLE_FENETRE_DEFLATE;
+    memmove(encodeur->donnees, encodeur->donnees + fin - garde, (size_t) garde);
+    encodeur->historique = encodeur->remplissage = garde;
 }
 
+static void ajouterOctetsPNG(encodeurPNG_t* encodeur, const unsigned char* octets, long int taille) {
 
-int depermuterTableau(char* key,int tailleTable, unsigned char** table) {
-
-    unsigned long keyHash;
-    int *tablepermutation,i;
-    int temp;
+    long int copie;
 
-    keyHash = hash((unsigned char *) key);
-    srand(keyHash);
+    encodeur->adler = adler32(encodeur->adler, octets, (size_t) taille);
 
-    tablepermutation = (int *) malloc(sizeof(int) * tailleTable);
-    if(tablepermutation == NULL)
-        return ERROR_NOMEM;
+    while(taille > 0) {
+        copie = encodeur->historique + TAILLE_BLOC_DEFLATE - encodeur->remplissage;
+        if(copie > taille)
+            copie = taille;
+        memcpy(encodeur->donnees + encodeur->remplissage, octets, (size_t) copie);
+        encodeur->remplissage += copie;
+        octets += copie;
+        taille -= copie;
 
-    for (i = tailleTable - 1; i >= 0; --i) {
-        tablepermutation[i] = rand() % (i + 1);// NOLINT(cert-msc30-c, cert-msc50-cpp)
+        if(encodeur->remplissage == encodeur->historique + TAILLE_BLOC_DEFLATE)
+            compresserBlocPNG(encodeur, 0);
     }
+}
 
-    for (i = 0; i < tailleTable; i++) {
-        temp = (*table)[i];
-        (*table)[i] = (*table)[tablepermutation[i]];
-        (*table)[tablepermutation[i]] = temp;
+/* Filtre une ligne avec le filtre type, l'octet 0 de sortie reçoit le type. Retourne la somme des valeurs absolues (en signé) */
+static unsigned long filtrerLignePNG(const unsigned char* ligne, const unsigned char* precedente, long int n, int bpp, int type, unsigned char* sortie) {
+
+    long int x;
+    int a, b, c, p, pa, pb, pc, prediction;
+    unsigned long somme = 0;
+
+    sortie[0] = (unsigned char) type;
+
+    for(x = 0; x < n; x++) {
+        a = x >= bpp ? ligne[x - bpp] : 0;
+        b = precedente[x];
+        c = x >= bpp ? precedente[x - bpp] : 0;
+
+        switch(type) {
+            case 1:
+                prediction = a;
+                break;
+            case 2:
+                prediction = b;
+                break;
+            case 3:
+                prediction = (a + b) >> 1;
+                break;
+            case 4:
+                p = a + b - c;
+                pa = abs(p - a);
+                pb = abs(p - b);
+                pc = abs(p - c);
+                prediction = pa <= pb && pa <= pc ? a : (pb <= pc ? b : c);
+                break;
+            default:
+                prediction = 0;
+        }
+
+        sortie[x + 1] = (unsigned char) (ligne[x] - prediction);
+        somme += (unsigned long) abs((signed char) sortie[x + 1]);
     }
 
-    free(tablepermutation);
+    return somme;
+}
 
 
-    return ERROR_OK;
-}
+int writeImagePNG(char* pathFile, const int* matrice, long int imageWidth, long int imageHeight, long int profondeur) {
 
+    static const unsigned char typesCouleur[5] = {0, 0, 4, 2, 6};
+    encodeurPNG_t encodeur;
+    unsigned char ihdr[13], zlib[2] = {0x78, 0x9C}, adler[4];
+    unsigned char *ligne = NULL, *precedente = NULL, *essai = NULL, *meilleur = NULL, *echange;
+    long int n = imageWidth * profondeur, x, y;
+    unsigned long somme, meilleureSomme;
+    int type, error = ERROR_OK;
 
+    if(profondeur < 1 || profondeur > 4)
+        return ERROR_INVARG;
 
-int permuterTableau(char* key,int tailleTable, unsigned char** table) {
+    memset(&encodeur, 0, sizeof(encodeur));
+    encodeur.adler = 1;
 
-    unsigned long keyHash;
-    int i,j;
-    int temp;
+    encodeur.fichier = fopen(pathFile, "wb");
+    if(encodeur.fichier == NULL)
+        return ERROR_OPEN;
 
-    keyHash = hash((unsigned char *) key);
-    srand(keyHash);
+    encodeur.donnees = (unsigned char*) malloc(TAILLE_FENETRE_DEFLATE + TAILLE_BLOC_DEFLATE);
+    encodeur.tete = (int*) malloc(sizeof(int) << LOG2_HACHAGE_DEFLATE);
+    encodeur.precedent = (int*) malloc((TAILLE_FENETRE_DEFLATE + TAILLE_BLOC_DEFLATE) * sizeof(int));
+    encodeur.symboles = (unsigned short*) malloc(TAILLE_BLOC_DEFLATE * sizeof(unsigned short));
+    encodeur.distances = (unsigned short*) malloc(TAILLE_BLOC_DEFLATE * sizeof(unsigned short));
+    encodeur.idat = (unsigned char*) malloc(TAILLE_IDAT_PNG);
+    ligne = (unsigned char*) malloc((size_t) n);
+    precedente = (unsigned char*) calloc((size_t) n, 1);
+    essai = (unsigned char*) malloc((size_t) n + 1);
+    meilleur = (unsigned char*) malloc((size_t) n + 1);
+
+    if(encodeur.donnees == NULL || encodeur.tete == NULL || encodeur.precedent == NULL || encodeur.symboles == NULL || encodeur.distances == NULL || encodeur.idat == NULL
+       || ligne == NULL || precedente == NULL || essai == NULL || meilleur == NULL) {
+        error = ERROR_NOMEM;
+    } else {
+        fwrite(SIGNATURE_PNG, 1, 8, encodeur.fichier);
+        ecrireU32BE(ihdr, (unsigned long) imageWidth);
+        ecrireU32BE(ihdr + 4, (unsigned long) imageHeight);
+        ihdr[8] = 8;
+        ihdr[9] = typesCouleur[profondeur];
+        ihdr[10] = ihdr[11] = ihdr[12] = 0;
+        error = ecrireChunkPNG(encodeur.fichier, "IHDR", ihdr, 13);
+
+        octetSortiePNG(&encodeur, zlib[0]);
+        octetSortiePNG(&encodeur, zlib[1]);
+
+        // Chaque ligne est filtrée (filtre qui minimise la somme des écarts) puis transmise au compresseur
+        for(y = 0; y < imageHeight && error == ERROR_OK; y++) {
+            for(x = 0; x < n; x++)
+                ligne[x] = (unsigned char) matrice[y * n + x];
+
+            meilleureSomme = 0;
+            for(type = 0; type < 5; type++) {
+                somme = filtrerLignePNG(ligne, precedente, n, (int) profondeur, type, essai);
+                if(type == 0 || somme < meilleureSomme) {
+                    meilleureSomme = somme;
+                    echange = meilleur;
+                    meilleur = essai;
+                    essai = echange;
+                }
+            }
+            ajouterOctetsPNG(&encodeur, meilleur, n + 1);
 
-    for (i = tailleTable - 1; i >= 0; --i) {
-        //generate a random number [0, n-1]
-        j = rand() % (i + 1);// NOLINT(cert-msc30-c, cert-msc50-cpp)
+            echange = precedente;
+            precedente = ligne;
+            ligne = echange;
+        }
 
-        //swap the last element with element at random index
-        temp = (*table)[i];
-        (*table)[i] = (*table)[j];
-        (*table)[j] = temp;
+        compresserBlocPNG(&encodeur, 1);
+        if(encodeur.nbBits > 0)
+            ecrireBitsPNG(&encodeur, 0, 8 - encodeur.nbBits);
+        ecrireU32BE(adler, encodeur.adler);
+        for(x = 0; x < 4; x++)
+            octetSortiePNG(&encodeur, adler[x]);
+
+        if(error == ERROR_OK && encodeur.tailleIdat > 0)
+            error = ecrireChunkPNG(encodeur.fichier, "IDAT", encodeur.idat, encodeur.tailleIdat);
+        if(error == ERROR_OK)
+            error = ecrireChunkPNG(encodeur.fichier, "IEND", NULL, 0);
+        if(error == ERROR_OK)
+            error = encodeur.error;
     }
 
-
-    return ERROR_OK;
+    free(encodeur.donnees);
+    free(encodeur.tete);
+    free(encodeur.precedent);
+    free(encodeur.symboles);
+    free(encodeur.distances);
+    free(encodeur.idat);
+    free(ligne);
+    free(precedente);
+    free(essai);
+    free(meilleur);
+    if(fclose(encodeur.fichier) != 0 && error == ERROR_OK)
+        error = ERROR_HANDLE;
+
+    return error;
 }
 
 
-// Cette fonction ajoute une extension à la fin d'un string, les deux se terminant par '\0'
-int addExtension(char** fileOutput, const char *extensionPixelMap) {
 
-    int longueurfileOutput = 0, longueurExtensionPixelMap = 0;
+int fileToBinary(char* fileToCrypt,unsigned char** msgSecretBit, size_t *length) {
 
-    while((*fileOutput)[longueurfileOutput] != '\0') {
-        longueurfileOutput++;
-    }
+    int i;
+    long fsize;
+    unsigned char *string;
 
-    while(extensionPixelMap[longueurExtensionPixelMap] != '\0') {
-        longueurExtensionPixelMap++;
-    }
+    FILE *f = fopen(fileToCrypt, "rb");
+    if(f == NULL)
+        return ERROR_OPEN;
+
+    fseek(f, 0, SEEK_END);
+    fsize = ftell(f);
+    fseek(f, 0, SEEK_SET);  /* same as rewind(f); */
 
+    string = malloc(fsize + 1);
+    if(string == NULL)
+        return ERROR_NOMEM;
+    fread(string, 1, fsize, f);
+    fclose(f);
 
-    (*fileOutput) = realloc((*fileOutput), longueurfileOutput+longueurExtensionPixelMap+2);
-    if((*fileOutput) == NULL)
+    string[fsize] = 0;
+
+    *msgSecretBit = malloc(fsize*8+1);
+    if(msgSecretBit == NULL)
         return ERROR_NOMEM;
+    char bits[8];
+    int k = 0, j=0;
+    for(i=0; i<fsize; i++) {
+        printbincharpad((char)string[i], bits);
 
-    strcat((*fileOutput), extensionPixelMap);
 
+        for (j = 0; j < 8; ++j) {
+            (*msgSecretBit)[k] = bits[j];
+            k++;
+
+        }
+    }
+    *length = k;
+
+    free(string);
     return ERROR_OK;
 }
 
 
-// Fonction qui renvoit la taille (en place mémoire, donc en incluant le . et le \0) et un string correspond à l'extension d'un fichier.
-int getExtension(const char* pathToFile, char** extensionPixelMap) {
 
-    int longueurPathToFile = 0;
-    int i, positionExt;
 
-    while(pathToFile[longueurPathToFile] != '\0') {
-        if(pathToFile[longueurPathToFile] == '.') {
-            positionExt = longueurPathToFile;
-        }
-        longueurPathToFile++;
-    }
+/* Hamming */
+int determineBestHammingSize(unsigned int tailleImg, unsigned int tailleMsg, unsigned int* rows, unsigned int* columns) {
 
 
-    *extensionPixelMap = (char*) malloc(sizeof(char)*(longueurPathToFile-positionExt)+1);
-    if(*extensionPixelMap == NULL)
-        return ERROR_NOMEM;
+    unsigned int capacity;
+    // On initialise la matrice de hamming la plus petite: rows=2 et columns=3
+    *rows = 2;
+    *columns =  (unsigned int)pow(2,(*rows)) - 1;
 
-    (*extensionPixelMap)[0] = '.';
+    // On calcul la capacité
+    capacity = ( tailleImg / (*columns) ) * (*rows);
 
-    for(i = 1; i<(longueurPathToFile-positionExt); i++) {
-        (*extensionPixelMap)[i] = pathToFile[longueurPathToFile-((longueurPathToFile-positionExt)-i)];
+    // Tant que la capacité est supérieur à la taille du message, alors on augmente de 1 le nombre de lignes et on recalcul le nombre de colonnes, tout en recalculant la capacité.
+    while(capacity > tailleMsg) {
+        (*rows)++;
+        *columns =  (unsigned int)pow(2,(*rows)) - 1;
+        capacity = ( tailleImg / (*columns) ) * (*rows);
     }
 
-    (*extensionPixelMap)[(longueurPathToFile-positionExt)] = '\0';
+    // Si la capacité est inférieur à la taille du message, alors on prend la matrice de hamming précédente, c'est à dire celle avec un nombre de lignes moins 1.
+    if(capacity < tailleMsg) {
+        (*rows)--;
+        *columns =  (unsigned int)pow(2,(*rows)) - 1;
+    }
 
     return ERROR_OK;
 }
 
+long long pixelsSegmentsHamming(long int tailleMsgBit, unsigned int rows, long int nbBlocsGrands) {
 
+    long long reste = (long long) tailleMsgBit - (long long) nbBlocsGrands * (rows + 1);
 
-void freeAllVar(void* pointer1, void* pointer2, void* pointer3, void* pointer4, void* pointer5, void* pointer6, void* pointer7) {
-
-    if(pointer1 != NULL)
-        free(pointer1);
-
-    if(pointer2 != NULL)
-        free(pointer2);
+    return (long long) nbBlocsGrands * ((2ll << rows) - 1) + (reste + rows - 1) / rows * ((1ll << rows) - 1);
+}
 
-    if(pointer3 != NULL)
-        free(pointer3);
+int determineSegmentsHamming(long int tailleImg, long int tailleMsgBit, unsigned int* rows, long int* nbBlocsGrands) {
 
-    if(pointer4 != NULL)
-        free(pointer4);
+    long int bas, haut, milieu;
 
-    if(pointer5 != NULL)
-        free(pointer5);
+    *rows = 1;
+    *nbBlocsGrands = 0;
 
-    if(pointer6 != NULL)
-        free(pointer6);
+    if(tailleMsgBit > tailleImg)
+        return ERROR_NOMEM;
+    if(tailleMsgBit <= 0)
+        return ERROR_OK;
 
-    if(pointer7 != NULL)
-        free(pointer7);
+    // Plus grand nombre de lignes pour lequel tout le message tient avec une seule taille de bloc
+    while(*rows + 1 < LIGNES_MAX_HAMMING && pixelsSegmentsHamming(tailleMsgBit, *rows + 1, 0) <= tailleImg)
+        (*rows)++;
 
+    // Chaque bloc passé à rows + 1 lignes utilise au moins un pixel de plus: on cherche par dichotomie le plus grand nombre qui tient
+    bas = 0;
+    haut = tailleMsgBit / (*rows + 1);
+    while(bas < haut) {
+        milieu = bas + (haut - bas + 1) / 2;
+        if(pixelsSegmentsHamming(tailleMsgBit, *rows, milieu) <= tailleImg)
+            bas = milieu;
+        else
+            haut = milieu - 1;
+    }
+    *nbBlocsGrands = bas;
 
+    return ERROR_OK;
 }
 
+/* Insertion de Hamming en blocs sur une suite de pixels: le pixel j de la suite est positionParcoursCalculable(j) si parcours n'est pas NULL, table[j] si table n'est pas NULL, j sinon.
+ * Avec une table (mode MODE_ADAPTATIF), la modification inverse le LSB pour ne pas changer les coûts des voisins. */
+static int insererBlocsHamming(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int pixelIntensity, const parcoursCalculable_t* parcours, const int* table, unsigned int rows, long int nbBlocsGrands, unsigned int* compteurNbBitsModif) {
 
+    long int *positions, bloc = 0, index = 0;
+    unsigned int lignes, nbColonnes, j, syndrome, message, ecart;
+    size_t bit = 0;
+    int* pixel;
 
+    // Positions des pixels du bloc en cours: calculées une fois pour le syndrome et réutilisées pour la modification
+    positions = (long int*) malloc(sizeof(long int) * ((2u << rows) - 1));
+    if(positions == NULL)
+        return ERROR_NOMEM;
 
+    srand(time(NULL));
 
+    while(bit < tailleMsgBit) {
 
-// http://www.cse.yorku.ca/~oz/hash.html
-unsigned long hash(unsigned char *str)
-{
-    unsigned long hash = 5381;
-    int c;
-
-    while ((c = *str++))
-        hash = ((hash << 5) + hash) + c; /* hash * 33 + c */
-
-    return hash;
-}
-
-
-// Convert char to binary table
-void printbincharpad(char c, char* tabBit)
-{
+        lignes = bloc < nbBlocsGrands ? rows + 1 : rows;
+        nbColonnes = (1u << lignes) - 1;
 
-    for(int n = 0; n < 8; n++)
-        tabBit[7-n] = (char) ((c >> n) & 1);
+        syndrome = 0;
+        for(j = 0; j < nbColonnes; j++) {
+            if(parcours != NULL)
+                positions[j] = positionParcoursCalculable(parcours, index + j);
+            else
+                positions[j] = table != NULL ? table[index + j] : index + j;
+            syndrome ^= (j + 1) & (0u - ((unsigned int) matriceImage[positions[j]] & 1u));
+        }
 
-}
+        // Les bits situés après la fin du message gardent la valeur du syndrome
+        message = syndrome;
+        for(j = 0; j < lignes && bit + j < tailleMsgBit; j++) {
+            message = (message & ~(1u << j)) | ((unsigned int) (messageBinary[bit + j] & 1u) << j);
+        }
 
-/* Copié collé depuis https://stackoverflow.com/questions/16870485/how-can-i-read-an-input-string-of-unknown-length */
-char *inputString(FILE* fp, size_t size){
-//The size is extended by the input with the value of the provisional
-    char *str;
-    int ch;
-    size_t len = 0;
-    str = realloc(NULL, sizeof(char)*size);//size is start size
-    if(!str)return str;
-    while(EOF!=(ch=fgetc(fp)) && ch != '\n'){
-        str[len++]=(char)ch;
-        if(len==size){
-            str = realloc(str, sizeof(char)*(size+=16));
-            if(!str)return str;
+        // Modifier le pixel de la colonne c change le syndrome de c + 1
+        ecart = syndrome ^ message;
+        if(ecart != 0) {
+            pixel = &matriceImage[positions[ecart - 1]];
+            if(table != NULL)
+                *pixel ^= 1;
+            else if(*pixel == 0 || (*pixel != pixelIntensity && rand() % 2 == 1)) // NOLINT(cert-msc30-c, cert-msc50-cpp)
+                (*pixel)++;
+            else
+                (*pixel)--;
+            (*compteurNbBitsModif)++;
         }
+
+        bit += lignes;
+        index += nbColonnes;
+        bloc++;
     }
-    str[len++]='\0';
 
-    return realloc(str, sizeof(char)*len);
+    free(positions);
+
+    return ERROR_OK;
 }
 
+int hideMessageHammingSegmente(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, long int debut, unsigned int rows, long int nbBlocsGrands, unsigned int* compteurNbBitsModif) {
 
+    *compteurNbBitsModif = 0;
 
+    if((size_t) nbBlocsGrands * (rows + 1) > tailleMsgBit || pixelsSegmentsHamming((long int) tailleMsgBit, rows, nbBlocsGrands) > dimension - debut)
+        return ERROR_INVARG;
 
+    // Les blocs se suivent à partir de debut: un seul passage calcule le syndrome de chaque bloc sans multiplication de matrices
+    return insererBlocsHamming(messageBinary, tailleMsgBit, matriceImage + debut, pixelIntensity, NULL, NULL, rows, nbBlocsGrands, compteurNbBitsModif);
+}
 
+int hideMessageHammingChiffre(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, long int debut, char* keyCrypt, unsigned int rows, long int nbBlocsGrands, unsigned int* compteurNbBitsModif) {
 
+    parcoursCalculable_t parcours;
 
+    *compteurNbBitsModif = 0;
 
+    if(keyCrypt == NULL || (size_t) nbBlocsGrands * (rows + 1) > tailleMsgBit || pixelsSegmentsHamming((long int) tailleMsgBit, rows, nbBlocsGrands) > dimension - debut)
+        return ERROR_INVARG;
 
+    initParcoursCalculable(&parcours, keyCrypt, dimension, (int) debut);
 
-unsigned char* stringToBinary(char* s, size_t *length) {
-    if(s == NULL) return 0; /* no input string */
-    size_t len = strlen(s);
-    unsigned char *binary = malloc(len*8 + 1); // each char is one byte (8 bits) and + 1 at the end for null terminator
-    binary[0] = '\0';
-    for(size_t i = 0; i < len; ++i) {
-        char ch = s[i];
-        for(int j = 7; j >= 0; --j){
-            if(ch & (1 << j)) {
-                strcat((char*)binary,"1");
-            } else {
-                strcat((char*)binary,"0");
-            }
-        }
-    }
-    *length = len*8;
-    return binary;
+    return insererBlocsHamming(messageBinary, tailleMsgBit, matriceImage, pixelIntensity, &parcours, NULL, rows, nbBlocsGrands, compteurNbBitsModif);
 }
 
-int* num_to_bit(int a, int *len){
-    int arrayLen=0,i=1;
-    while (i<a){
-        arrayLen++;
-        i*=2;
-    }
-    *len=arrayLen;
-    int *bits;
-    bits=(int*)malloc(arrayLen*sizeof(int));
-    arrayLen--;
-    while(a>0){
-        bits[arrayLen--]=a&1;
-        a>>=1;
+int isVectorNull(unsigned int **vector, unsigned int columns) {
+
+
+    int x,null=1;
+    for(x = 0; x < columns; x++) {
+        if(vector[0][x] != 0)
+            null = 0;
     }
-    return bits;
+
+    return null;
 }
 
-int decryptPrefix(const int *matriceImage, long int dimension, int* prefixInt, int* lengthDimensionPrefix) {
+int findInHamming(unsigned int **matriceHamming, unsigned int columns, unsigned int rows, unsigned int **matriceRes, unsigned int *position) {
     int i,j;
-    int *prefixBinary, *dimMaxBinary;
-    //printf("Dimension: %zd", dimension);
+    unsigned int same;
 
-    dimMaxBinary = num_to_bit(dimension, lengthDimensionPrefix);
+    if((columns>2)&&(rows>1)) {
+        for (i = 0; i < columns; i++) {
+            same = 1;
+            for (j = 0; j < rows; j++) {
+                if (matriceHamming[i][j] != matriceRes[0][j]) {
+                    same = 0;
+                }
+            }
+            if (same)
+                *position = i;
+        }
+        return ERROR_OK;
+    } else {
+        return ERROR_INVARG;
+    }
+}
 
 
-    //printf("\nTaille en bits de la dimension max: %d", lengthDimensionPrefix);
-    /*printf("\nTaille en bits de la dimension max en binaire: ");
-    for(i = 0; i<lengthDimensionPrefix; i++) {
-        printf("%d", dimMaxBinary[i]);
-    }*/
 
-    prefixBinary = (int*) malloc((*lengthDimensionPrefix) * sizeof(int));
-    if(prefixBinary == NULL)
-        return ERROR_NOMEM;
-    for(i=0; i<(*lengthDimensionPrefix); i++) {
-        prefixBinary[i] = (matriceImage[i] & ( 1 << 0)) >> 0;
-    }
+void additionMatrice(unsigned int m, unsigned int n, unsigned int** mat1, unsigned int** mat2, unsigned int*** res)
+{
+    unsigned int i, j;
+    for(i=0;i<m;i++)
+        for(j=0;j<n;j++)
+            (*res)[i][j] = (mat1[i][j] + mat2[i][j]) % 2 ;
 
-    /*printf("\nBits du prefixe (%d premiers bits): ", lengthDimensionPrefix);
-    for(i=0; i<lengthDimensionPrefix; i++) {
-        printf("%d", prefixBinary[i]);
-    }*/
-    (*prefixInt) = 0;
-    j=0;
-    for(i=(*lengthDimensionPrefix)-1; i>=0; i--) {
-        (*prefixInt) += prefixBinary[j] * ( (int) pow(2, i));
-        j +=1;
-    }
-    return ERROR_OK;
 }
 
-int decryptMessageHamming(const int *matriceImage, long int dimension, int prefixInt, int lengthDimensionPrefix, unsigned int rows, unsigned int columns, long int *tailleMsgDecrypt, unsigned char **messageSecretBitOutput) {
-
 
+void multiplyMatrice(unsigned int m2, unsigned int** mat1, unsigned int n1, unsigned int n2, unsigned int** mat2, unsigned int*** res)
+{
+    int k, i, j;
 
-    if(columns>2 && rows>1) {
+    for(i = 0; i<n1; i++) {
+        for(j = 0; j < m2; j++) {
+            (*res)[i][j] = 0;
+            for(k=0; k<n2; k++) {
+                (*res)[i][j] +=  ((mat1[k][j]*((mat2[i][k] & ( 1u << 0u)) >> 0u) ) );
 
-        unsigned int **matriceHamming, j, k, o, i, **matriceResMul = NULL, **matriceResAdd = NULL, position, randomNumber;
-        unsigned int **bufferImage, **bufferMsg;
+            }
+            (*res)[i][j] %= 2;
+        }
+    }
 
+}
 
-        genererHamming(&matriceHamming, rows, columns);
 
+int genererHamming(unsigned int*** hamming, unsigned int r, unsigned int c) {
 
+    (*hamming) = (unsigned int **)calloc(c , sizeof(int *));         //Création d'un pointeur => tableau 1 colonne
+    if((*hamming) == NULL)
+        return ERROR_NOMEM;
 
-        bufferImage = (unsigned int **) malloc(sizeof(unsigned int) * 1);
-        if (bufferImage == NULL)
+    for (int i = 0; i < c; i++) {                           //Pour chacune des lignes de ce tableau
+        (*hamming)[i] = (unsigned int *) calloc(r, sizeof(int));     //On malloc le nombre de colonnes que l'on veut
+        if((*hamming)[i] == NULL)
             return ERROR_NOMEM;
+    }
 
-        for (i = 0; i < 1; i++) {
-            bufferImage[i] = (unsigned int *) malloc(sizeof(unsigned int) * columns);
-            if (bufferImage[i] == NULL)
-                return ERROR_NOMEM;
+    int count;                                              //Variable qui permet de calculer le binaire
+    for (int j = 1; j <= c; j++) {                          //On commence à 1 pour pouvoir convertir chaque numéro de colonne en binaire (sauf la colonne 0 => 0 en binaire)
+        count = j;                                          //Pour ne pas modifier le comptage de boucle, on l'attribue à count
+        for (int i = 0; i < r; i++) {                       //Pour chaque ligne
+            if (count > 0) {                                //Tant que le chiffre convertit en binaire est > 0
+                (*hamming)[j-1][i] = count % 2;             //On donne son binaire correspondant à au bit de la ligne
+                count /= 2;
+            }
         }
+    }
 
-        matriceResMul = NULL;
+    return ERROR_OK;
+}
 
-        (*messageSecretBitOutput) = malloc(sizeof(unsigned int) * (prefixInt - lengthDimensionPrefix));
-        if ((*messageSecretBitOutput) == NULL)
-            return ERROR_NOMEM;
 
-        for (i = 0; i < dimension / columns; i++) {
-            for (j = 0; j < columns; j++) {
+/* UI */
 
-                // On crée une matrice bufferImage qui va contenir columns fois le nombre de bits de la matrice image (pour la séparé en séquence)
-                if (j + (i + (i * (columns - 1))) < dimension)
-                    (*bufferImage)[j] = matriceImage[lengthDimensionPrefix + j + (i + (i * (columns - 1)))];
-                else
-                    (*bufferImage)[j] = 1;
 
-            }
+long reponseMenu(int choixMax) {
 
-            // On crée la matrice en mémoire qui va accueillir le résultat de la multiplication
-            if (matriceResMul != NULL)
-                free(matriceResMul);
+    long resultUser = 0;
+    printf("> ");
 
-            matriceResMul = (unsigned int **) malloc(sizeof(unsigned int) * 1);
-            if (matriceResMul == NULL)
-                return ERROR_NOMEM;
+    char *ptr;
+    char str[10];
 
-            for (k = 0; k < 1; k++) {
-                matriceResMul[k] = (unsigned int *) malloc(sizeof(unsigned int) * rows);
-                if (matriceResMul[k] == NULL)
-                    return ERROR_NOMEM;
-            }
+    // Ce code permet de récuperer un entier saisit par l'utilisateur et en verifiant le type et la taille. (Contrairement à scanf)
+    // La ligne entière est lue (les menus peuvent avoir plus de 9 choix)
+    size_t len;
+    if(fgets(str, sizeof(str), stdin) == NULL)
+        return -1;
+    len = strlen(str);
 
-            // On effectue la multiplication (Pas besoin de passer toutes les dimensions de la matrice 1 car n1=m1
-            multiplyMatrice(rows, matriceHamming, 1, columns, bufferImage, &matriceResMul);
+    // On vide le buffer si la ligne est plus longue que str
+    if(len > 0 && str[len-1] != '\n')
+        viderBuffer();
 
-            for (o = 0; o < rows; o++) {
+    resultUser = strtol(str, &ptr, 10);
 
-                if (o + (i + (i * (rows - 1))) < (prefixInt - lengthDimensionPrefix)) {
-                    (*messageSecretBitOutput)[o + (i + (i * (rows - 1)))] = (*matriceResMul)[o];
+    // On vérifie si l'utilisateur à bien rentré un resultat qui rentre bien dans le type long et qui n'est pas null.
+    if( resultUser == LONG_MAX || resultUser == LONG_MIN || !resultUser) {
+        return -1;
+    }
 
-                }
+    // Si ce qu'a rentré l'utilisateur ne correspond pas au choix max alors on retourne -1
+    if((resultUser > choixMax) || (resultUser < 1))
+        return -1;
 
-            }
+    return resultUser;
 
+}
 
-        }
+long reponseNombre() {
 
-        (*tailleMsgDecrypt) = prefixInt - lengthDimensionPrefix;
+    long resultUser;
+    char *saisie, *fin;
 
-        for(i = 0; i < 1; i++) {
-            free(bufferImage[i]);
-        }
-        free(bufferImage);
+    printf("> ");
+    saisie = inputString(stdin, 16);
+    if(saisie == NULL)
+        return -1;
 
+    resultUser = strtol(saisie, &fin, 10);
+    if(fin == saisie || *fin != '\0' || resultUser < 0 || resultUser == LONG_MAX)
+        resultUser = -1;
 
-        for(k = 0; k < 1; k++) {
-            free(matriceResMul[k]);
-        }
-        free(matriceResMul);
+    free(saisie);
 
+    return resultUser;
+}
 
-        for (i = 0; i < columns; i++) {
-            free(matriceHamming[i]);
-        }
+int choisirModeDecryptage(long int dimension, long int prefixInt, long int lengthDimensionPrefix, int portion, char** cryptKey, unsigned int* rows, unsigned int* columns) {
 
-        free(matriceHamming);
+    int mode;
 
+    p("Quel type de decryptage souhaitez vous utiliser ?");
 
-        return ERROR_OK;
-    } else {
-        return ERROR_INVARG;
+    li(1, "Classique: récupération un par un.");
+    li(2, "Chiffré: modifier le sens de parcour grâce à une clé de chiffrement.");
+    li(3, "Hamming: Vecteur de syndrome.");
+    li(4, "Chiffré à accès direct: parcours calculé grâce à une clé de chiffrement.");
+
+    mode = (int) reponseMenu(4);
+
+    // Le parcours par table ne permet pas de localiser un octet: refusé avant de demander la clé
+    if(portion && mode == MODE_CHIFFRE) {
+        p("Cette méthode ne permet pas d'extraire une portion du message.");
+        return -1;
     }
-}
 
-int decryptMessage(const int *matriceImage, long int dimension, int prefixInt, int lengthDimensionPrefix,int crypt, char* keyCript, long int *tailleMsgDecrypt, unsigned char **messageSecretBitOutput) {
+    switch(mode) {
+        case MODE_CLASSIQUE:
+            break;
+        case MODE_CHIFFRE:
+        case MODE_CHIFFRE_CALCULABLE:
 
-    int i,j;
-    int *dimMaxBinary;
-    unsigned long keyHash;
-    int *tablepermutation,*tablepermuteIndex;
-    int temp;
-    //printf("\nPosition du message: %d", prefixInt);
+            p("Entrez la clé de chiffrement.");
+            printf("> ");
+            (*cryptKey) = inputString(stdin, 5);
 
-    //printf("\nBits du message: ");
-    *messageSecretBitOutput = (unsigned char *) malloc(prefixInt * sizeof(unsigned char));
-    if(messageSecretBitOutput == NULL)
-        return ERROR_NOMEM;
+            break;
+        case MODE_HAMMING:
 
-    if(crypt == 1) {
+            determineBestHammingSize(dimension, prefixInt-lengthDimensionPrefix, rows, columns);
+
+            if(!((*columns)>2 && (*rows) > 1)) {
+                mode = MODE_CLASSIQUE;
+                p("Votre message secret était trop volumineux pour avoir été inséré avec la méthode de Hamming, nous allons le décrypter classiquement.");
+            }
+
+            break;
+        default:
+            return -1;
+    }
 
+    return mode;
+}
 
-        keyHash = hash((unsigned char *) keyCript);
 
+int parametresLecture(const enteteConteneur_t* entete, char** cleChiffrement, unsigned int* rows, unsigned int* columns) {
 
-        tablepermuteIndex = (int *) malloc(sizeof(int) * (dimension-lengthDimensionPrefix));
-        if(tablepermuteIndex == NULL)
+    // Modes dont le parcours dépend d'une clé
+    if(entete->mode == MODE_CHIFFRE || entete->mode == MODE_CHIFFRE_CALCULABLE || entete->mode == MODE_HAMMING_CHIFFRE) {
+        p("Entrez la clé de chiffrement.");
+        printf("> ");
+        *cleChiffrement = inputString(stdin, 5);
+        if(*cleChiffrement == NULL)
             return ERROR_NOMEM;
+    }
 
-        for(i = lengthDimensionPrefix; i<dimension; i++) {
-            tablepermuteIndex[i] = i;
-        }
+    switch(entete->mode) {
+        case MODE_HAMMING:
+            // Découpage en segments: initLecteurBits le recalcule à partir de la taille du flux
+            *rows = entete->parametre;
+            *columns = (*rows & HAMMING_SEGMENTE) ? (unsigned int) unitesPrefixe(entete) : (1u << *rows) - 1;
+            break;
+        case MODE_KLSB:
+        case MODE_TERNAIRE:
+            *rows = entete->parametre;
+            break;
+        case MODE_HAMMING_CHIFFRE:
+        case MODE_ADAPTATIF:
+        case MODE_STC:
+            *rows = entete->parametre;
+            *columns = (unsigned int) unitesPrefixe(entete);
+            break;
+        default:
+            break;
+    }
 
-        srand(keyHash);
-        for (i = dimension - 1; i >= lengthDimensionPrefix; --i) {
-            //generate a random number [0, n-1]
-            j = (lengthDimensionPrefix) + ( rand() % (i + 1));// NOLINT(cert-msc30-c, cert-msc50-cpp)
+    return ERROR_OK;
+}
 
+void li(int position, char* text) {
+    printf("[%d] %s\n", position, text);
+}
 
+void p(const char* text) {
 
-            //swap the last element with element at random index
-            temp = tablepermuteIndex[i];
-            tablepermuteIndex[i] = tablepermuteIndex[j];
-            tablepermuteIndex[j] = temp;
-        }
+    printf("\n");
+    printf("    %s", text);
+    printf("\n\n");
 
+}
 
-    }
+unsigned char encoderBitsParCanal(const int bitsParCanal[3]) {
 
-j=0;
-    for(i=lengthDimensionPrefix; i<prefixInt; i++) {
-        if(crypt == 0)
-            (*messageSecretBitOutput)[j] = (matriceImage[i] & ( 1 << 0)) >> 0;
-        else
-            (*messageSecretBitOutput)[j] = (matriceImage[tablepermuteIndex[i]] & (1 << 0)) >> 0;
+    return (unsigned char) ((bitsParCanal[0] - 1) | ((bitsParCanal[1] - 1) << 2) | ((bitsParCanal[2] - 1) << 4));
+}
 
-        j += 1;
-    }
 
-    *tailleMsgDecrypt = prefixInt - lengthDimensionPrefix;
+void decoderBitsParCanal(unsigned char parametre, int bitsParCanal[3]) {
 
-    if(crypt == 1)
-        free(tablepermuteIndex);
+    int c;
 
-    return ERROR_OK;
+    for(c = 0; c < 3; c++) {
+        bitsParCanal[c] = ((parametre >> (2 * c)) & 3) + 1;
+    }
 }
 
 
-int hideDimMsg(size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int* lengthDimensionPrefix) {
-    int i, randomNumber,j, lengthEndOfMsgBinary;
-    unsigned int endOfMsg;
-    int *endOfMsgBinary, *dimMaxBinary;
+long int capaciteKLSB(long int debut, long int dimension, const int bitsParCanal[3]) {
 
-    //printf("tailleMsgBit: %ld", tailleMsgBit);
+    long int nombre, capacite, p;
 
-    //printf("Dimension: %zd", dimension);
-    dimMaxBinary = num_to_bit(dimension, lengthDimensionPrefix);
-    //printf("\nTaille en bits de la dimension max: %d", lengthDimensionPrefix);
-    //printf("\nTaille en bits de la dimension max en binaire: ");
-    /*for(i = 0; i<lengthDimensionPrefix; i++) {
-        printf("%d", dimMaxBinary[i]);
-    }*/
+    if(debut >= dimension)
+        return 0;
 
-    if(tailleMsgBit <= (dimension - (*lengthDimensionPrefix))) {
+    nombre = dimension - debut;
+    capacite = (nombre / 3) * (bitsParCanal[0] + bitsParCanal[1] + bitsParCanal[2]);
+    for(p = debut + (nombre / 3) * 3; p < dimension; p++) {
+        capacite += bitsParCanal[p % 3];
+    }
 
-        //printf("\nTest de mémoire passé");
-        endOfMsg = tailleMsgBit + (*lengthDimensionPrefix);
-        //printf("\nPosition de la fin du message: %d", endOfMsg);
+    return capacite;
+}
 
-        endOfMsgBinary = num_to_bit((int) endOfMsg, &lengthEndOfMsgBinary);
-        //printf("\nTaille en bits de la fin du message: %d", lengthEndOfMsgBinary);
-        //printf("\nPosition de la fin du message en binaire: ");
-        /*for(i = 0; i<lengthEndOfMsgBinary; i++) {
-            printf("%d", endOfMsgBinary[i]);
-        }*/
-        //printf("\n");
 
-        if (((*lengthDimensionPrefix) - lengthEndOfMsgBinary) > 0) {
+long int unitesPrefixe(const enteteConteneur_t* entete) {
 
-            for (i = 0; i < ((*lengthDimensionPrefix) - lengthEndOfMsgBinary); i++) {
-                randomNumber = rand() % 2; // On génère un nombre aléatoire entre 0 et 1;// NOLINT(cert-msc30-c, cert-msc50-cpp)
+    long int tailleBit = ((long int) entete->longueurCharge + 4 * nbBlocsCrc(entete)) * 8;
 
-                if (0 != ((matriceImage[i] & (1 << 0)) >> 0)) {
+    if(entete->mode == MODE_KLSB)
+        return (tailleBit + BITS_UNITE_PREFIXE_KLSB - 1) / BITS_UNITE_PREFIXE_KLSB;
 
-                    if (randomNumber == 1) {
-                        if (matriceImage[i] != pixelIntensity) {
-                            matriceImage[i] = matriceImage[i] + 1;
-                        } else {
-                            matriceImage[i] = matriceImage[i] - 1;
-                        }
-                    } else {
-                        if (matriceImage[i] != 0) {
-                            matriceImage[i] = matriceImage[i] - 1;
-                        } else {
-                            matriceImage[i] = matriceImage[i] + 1;
-                        }
-                    }
+    return tailleBit;
+}
 
-                }
-            }
 
-        }
+void fusionnerKLSB(int* echantillons, const int* valeurs, long int nombre, long int position, const int bitsParCanal[3], long int pixelIntensity) {
 
-        //printf("\n%d zéros ont été ajouté !", (lengthDimensionPrefix - lengthEndOfMsgBinary));
-        //printf("\nOn ajoute la fin du message en binaire: ");
-        j = 0;
-        for (i = ((*lengthDimensionPrefix) - lengthEndOfMsgBinary); i < (*lengthDimensionPrefix); i++) {
-            randomNumber = rand() % 2; // On génère un nombre aléatoire entre 0 et 1;// NOLINT(cert-msc30-c, cert-msc50-cpp)
-            //printf("\n%d avec un i=%d", endOfMsgBinary[j], i);
-            if (endOfMsgBinary[j] != ((matriceImage[i] & (1 << 0)) >> 0)) {
+    long int i = 0;
+    int masque, pas, moitie, nouveau, ecart, c;
 
-                if (randomNumber == 1) {
-                    if (matriceImage[i] != pixelIntensity) {
-                        matriceImage[i] = matriceImage[i] + 1;
-                    } else {
-                        matriceImage[i] = matriceImage[i] - 1;
-                    }
-                } else {
-                    if (matriceImage[i] != 0) {
-                        matriceImage[i] = matriceImage[i] - 1;
-                    } else {
-                        matriceImage[i] = matriceImage[i] + 1;
-                    }
-                }
+#if defined(__x86_64__)
+    __m128i masques[3], pasV[3], moities[3], moitiesNeg[3], limites[3], maximum, s, v, n, d, ajuste;
+    int l, phase;
 
-            }
+    maximum = _mm_set1_epi32((int) pixelIntensity);
 
-            j += 1;
+    // Masques des 3 alignements possibles d'un groupe de 4 pixels sur les canaux R, G, B
+    for(phase = 0; phase < 3; phase++) {
+        int m[4], st[4], mo[4], li[4];
+        for(l = 0; l < 4; l++) {
+            c = (phase + l) % 3;
+            m[l] = (1 << bitsParCanal[c]) - 1;
+            st[l] = 1 << bitsParCanal[c];
+            mo[l] = 1 << (bitsParCanal[c] - 1);
+            li[l] = (int) pixelIntensity + 1 - st[l];
         }
-
+        masques[phase] = _mm_loadu_si128((const __m128i*) m);
+        pasV[phase] = _mm_loadu_si128((const __m128i*) st);
+        moities[phase] = _mm_loadu_si128((const __m128i*) mo);
+        moitiesNeg[phase] = _mm_sub_epi32(_mm_setzero_si128(), moities[phase]);
+        limites[phase] = _mm_loadu_si128((const __m128i*) li);
     }
 
-    return ERROR_OK;
-}
+    phase = (int) (position % 3);
+    for(; i + 4 <= nombre; i += 4) {
+        s = _mm_loadu_si128((const __m128i*) (echantillons + i));
+        v = _mm_loadu_si128((const __m128i*) (valeurs + i));
 
-int hideMessageHamming(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, unsigned int rows, unsigned int columns, unsigned int* compteurNbBitsModif) {
+        // n = (s & ~masque) | v
+        n = _mm_or_si128(_mm_andnot_si128(masques[phase], s), v);
+        d = _mm_sub_epi32(n, s);
 
-    unsigned int **matriceHamming, j,k,o,i, **matriceResMul=NULL, **matriceResAdd = NULL, position, randomNumber;
-    unsigned int** bufferImage, **bufferMsg;
-    int error;
+        // Trop haut (ou au dessus de l'intensité maximale) et n - 2^k >= 0: on retire 2^k
+        ajuste = _mm_or_si128(_mm_cmpgt_epi32(d, moities[phase]), _mm_cmpgt_epi32(n, maximum));
+        ajuste = _mm_and_si128(ajuste, _mm_cmpgt_epi32(n, _mm_sub_epi32(pasV[phase], _mm_set1_epi32(1))));
+        n = _mm_sub_epi32(n, _mm_and_si128(ajuste, pasV[phase]));
 
-    *compteurNbBitsModif = 0;
+        // Trop bas et n + 2^k <= intensité maximale: on ajoute 2^k
+        ajuste = _mm_and_si128(_mm_cmpgt_epi32(moitiesNeg[phase], d), _mm_cmpgt_epi32(limites[phase], n));
+        n = _mm_add_epi32(n, _mm_and_si128(ajuste, pasV[phase]));
 
-    // On génère la matrice de Hamming
-    error = genererHamming(&matriceHamming,rows, columns);
-    if(error != ERROR_OK)
-        return error;
+        _mm_storeu_si128((__m128i*) (echantillons + i), n);
+
+        // 4 pixels plus loin, le canal du premier pixel a avancé de 1
+        phase = phase == 2 ? 0 : phase + 1;
+    }
+#endif
+
+    for(; i < nombre; i++) {
+        c = (int) ((position + i) % 3);
+        masque = (1 << bitsParCanal[c]) - 1;
+        pas = masque + 1;
+        moitie = pas >> 1;
+
+        nouveau = (echantillons[i] & ~masque) | valeurs[i];
+        ecart = nouveau - echantillons[i];
+        if((ecart > moitie || nouveau > pixelIntensity) && nouveau - pas >= 0)
+            nouveau -= pas;
+        else if(ecart < -moitie && nouveau + pas <= pixelIntensity)
+            nouveau += pas;
+
+        echantillons[i] = nouveau;
+    }
+}
 
 
+int hideMessageKLSB(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, const int bitsParCanal[3]) {
 
-    // On crée les tableaux bufferImage et bufferMsg et on les initialises. Ces tableaux contiendront les segments de l'image et du message utilisés pour faire les opérations de matrice.
-    bufferImage = (unsigned int**) malloc(sizeof(unsigned int) * 1);
-    if(bufferImage == NULL)
+    long int nombre, p, b, k, reste;
+    int *valeurs, valeur, bit;
+
+    if((long int) tailleMsgBit > capaciteKLSB(lengthDimensionPrefix, dimension, bitsParCanal))
         return ERROR_NOMEM;
-    for(i = 0; i < 1; i++) {
-        bufferImage[i] = (unsigned int*) malloc(sizeof(unsigned int) * columns);
-        if(bufferImage[i] == NULL)
-            return ERROR_NOMEM;
+
+    // Nombre de pixels entièrement remplis par le message
+    nombre = 0;
+    b = 0;
+    while(b + bitsParCanal[(lengthDimensionPrefix + nombre) % 3] <= (long int) tailleMsgBit) {
+        b += bitsParCanal[(lengthDimensionPrefix + nombre) % 3];
+        nombre++;
     }
 
-    bufferMsg = (unsigned int**) malloc(sizeof(unsigned int) * 1);
-    if(bufferMsg == NULL)
+    valeurs = (int*) malloc((size_t) (nombre > 0 ? nombre : 1) * sizeof(int));
+    if(valeurs == NULL)
         return ERROR_NOMEM;
-    for(i = 0; i < 1; i++) {
-        bufferMsg[i] = (unsigned int*) malloc(sizeof(unsigned int) * rows);
-        if(bufferMsg[i] == NULL)
-            return ERROR_NOMEM;
+
+    // Regroupement des bits du message en une valeur de k bits par pixel
+    b = 0;
+    for(p = 0; p < nombre; p++) {
+        valeur = 0;
+        for(k = bitsParCanal[(lengthDimensionPrefix + p) % 3]; k > 0; k--) {
+            valeur = (valeur << 1) | (messageBinary[b++] & 1);
+        }
+        valeurs[p] = valeur;
     }
 
+    fusionnerKLSB(matriceImage + lengthDimensionPrefix, valeurs, nombre, lengthDimensionPrefix, bitsParCanal, pixelIntensity);
+    free(valeurs);
+
+    // Dernier pixel partiellement rempli: seuls ses bits de poids fort parmi les k sont imposés, les autres sont conservés
+    reste = (long int) tailleMsgBit - b;
+    if(reste > 0) {
+        p = lengthDimensionPrefix + nombre;
+        k = bitsParCanal[p % 3];
+        valeur = matriceImage[p];
+        for(bit = 0; bit < reste; bit++) {
+            valeur &= ~(1 << (k - 1 - bit));
+            valeur |= (messageBinary[b + bit] & 1) << (k - 1 - bit);
+        }
+        if(valeur > pixelIntensity && valeur - (1 << k) >= 0)
+            valeur -= 1 << k;
+        matriceImage[p] = valeur;
+    }
 
-    srand(time(NULL)); // On rend le rank aléatoire pour la modification des bits
+    return ERROR_OK;
+}
 
-    for(i = 0; i<ceil((double)tailleMsgBit/(double)rows); i++) {
+unsigned int colonneSTC(long int k, int hauteur) {
 
-        // On Met à jour les segments de l'image et du message afin d'effectuer les calculs de matrice.
-        for(j = 0; j<columns; j++) {
+    unsigned long long x = ((unsigned long long) k + 1) * 0x9E3779B97F4A7C15ULL;
 
-            // On crée une matrice bufferImage qui va contenir columns fois le nombre de bits de la matrice image (pour la séparé en séquence)
-            if(j+(i+(i*(columns-1))) < dimension)
-                (*bufferImage)[j] = matriceImage[lengthDimensionPrefix + j+(i+(i*(columns-1)))];
-            else
-                (*bufferImage)[j] = 1;
+    x ^= x >> 29u;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 32u;
 
-        }
+    return ((unsigned int) x | 1u | (1u << (hauteur - 1))) & ((1u << hauteur) - 1);
+}
 
-        for(o=0; o<rows; o++) {
-            // On crée une matrice bufferMsg qui va contenir rows fois le nombre de bits de la matrice message (pour la séparé en séquence)
-            if(o+(i+(i*(rows-1))) < tailleMsgBit)
-                (*bufferMsg)[o] = messageBinary[o+(i+(i*(rows-1)))];
-            else
-                (*bufferMsg)[o] = 1;
 
+long int debutBlocSTC(long int bloc, long int nbPixels, long int tailleMsgBit) {
 
-        }
+    return (long int) (((unsigned long long) bloc * (unsigned long long) nbPixels) / (unsigned long long) tailleMsgBit);
+}
 
-        // On crée la matrice en mémoire qui va accueillir le résultat de la multiplication
-        if(matriceResMul != NULL)
-            free(matriceResMul);
 
-        matriceResMul = (unsigned int**) malloc(sizeof(unsigned int) * 1);
-        if(matriceResMul == NULL)
-            return ERROR_NOMEM;
+#if defined(__x86_64__)
+/* Une passe du treillis pour une permutation fixe des valeurs d'un registre (selection est une constante de _mm_shuffle_ps):
+ * le choix de la permutation est fait une fois par pixel et non à chaque registre. 8 registres donnent un mot de décisions. */
+#define BOUCLE_VITERBI_STC(selection) \
+    for(mot = 0; mot < nbEtats / 32; mot++) { \
+        decisionsMot = 0; \
+        for(l = 0; l < 8; l++) { \
+            v = 8 * mot + l; \
+            z = _mm_add_ps(_mm_loadu_ps(ancien + 4 * v), poidsZero); \
+            u = _mm_loadu_ps(ancien + 4 * (v ^ decalageRegistre)); \
+            u = _mm_add_ps(_mm_shuffle_ps(u, u, selection), poidsUn); \
+            _mm_storeu_ps(nouveau + 4 * v, _mm_min_ps(z, u)); \
+            decisionsMot |= (unsigned int) _mm_movemask_ps(_mm_cmplt_ps(u, z)) << (4 * l); \
+        } \
+        decisions[mot] = decisionsMot; \
+    }
+#endif
 
-        for(k = 0; k < 1; k++) {
-            matriceResMul[k] = (unsigned int*) malloc(sizeof(unsigned int) * rows);
-            if(matriceResMul[k] == NULL)
-                return ERROR_NOMEM;
-        }
+void etapeViterbiSTC(const float* ancien, float* nouveau, unsigned int* decisions, int nbEtats, unsigned int colonne, float coutZero, float coutUn) {
 
-        // On effectue la multiplication (Pas besoin de passer toutes les dimensions de la matrice 1 car n1=m1
-        multiplyMatrice(rows, matriceHamming, 1, columns, bufferImage, &matriceResMul);
+    int s = 0, mot;
+    float zero, un;
 
+#if defined(__x86_64__)
+    __m128 z, u, poidsZero = _mm_set1_ps(coutZero), poidsUn = _mm_set1_ps(coutUn);
+    int decalageRegistre = (int) (colonne >> 2u), v, l;
+    unsigned int decisionsMot;
 
-        // On crée la matrice en mémoire qui va accueillir le résultat de l'addition
-        if(matriceResAdd != NULL)
-            free(matriceResAdd);
+    // ancien[s ^ colonne]: les bits de poids fort de la colonne choisissent le registre, les 2 bits de poids faible permutent ses valeurs
+    switch(colonne & 3u) {
+        case 1:
+            BOUCLE_VITERBI_STC(_MM_SHUFFLE(2, 3, 0, 1))
+            break;
+        case 2:
+            BOUCLE_VITERBI_STC(_MM_SHUFFLE(1, 0, 3, 2))
+            break;
+        case 3:
+            BOUCLE_VITERBI_STC(_MM_SHUFFLE(0, 1, 2, 3))
+            break;
+        default:
+            BOUCLE_VITERBI_STC(_MM_SHUFFLE(3, 2, 1, 0))
+            break;
+    }
+    // Moins de 32 états (hauteur < 5): calcul scalaire
+    s = nbEtats & ~31;
+#endif
+
+    for(; s < nbEtats; s++) {
+        mot = s >> 5;
+        if((s & 31) == 0)
+            decisions[mot] = 0;
+        zero = ancien[s] + coutZero;
+        un = ancien[s ^ (int) colonne] + coutUn;
+        nouveau[s] = un < zero ? un : zero;
+        decisions[mot] |= (unsigned int) (un < zero) << (s & 31);
+    }
+}
 
-        matriceResAdd = (unsigned int**) malloc(sizeof(unsigned int) * 1);
-        if(matriceResAdd == NULL)
-            return ERROR_NOMEM;
 
-        for(k = 0; k < 1; k++) {
-            matriceResAdd[k] = (unsigned int*) malloc(sizeof(unsigned int) * rows);
-            if(matriceResAdd[k] == NULL)
-                return ERROR_NOMEM;
-        }
+int hideMessageSTC(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, int hauteur, const float* couts, unsigned int* compteurNbBitsModif) {
 
-        // On aditionne le résultat précédent avec la matrice message
-        additionMatrice(1,rows, matriceResMul, bufferMsg, &matriceResAdd);
+    long int nbPixels = dimension - lengthDimensionPrefix, nbBits = (long int) tailleMsgBit, bloc, debut, fin, j, p, largeurMax;
+    int nbEtats, nbMots, s, etat, bit, randomNumber;
+    unsigned int masque, *colonnes, *decisions;
+    float *tampon, *ancien, *nouveau, *temp, cout;
+#if defined(__x86_64__)
+    __m128 a, b;
+#endif
 
-        // Si le vecteur n'est pas nul, c'est qu'il faut effectuer une modification
-        if(!isVectorNull(matriceResAdd, rows)) {
+    *compteurNbBitsModif = 0;
 
-            // On recherche à quelle ligne on doit effectuer la modification
-            error = findInHamming(matriceHamming, columns, rows, matriceResAdd, &position);
-            if(error != ERROR_OK)
-                return error;
+    if(hauteur < HAUTEUR_STC_MIN || hauteur > HAUTEUR_STC_MAX)
+        return ERROR_INVARG;
+    if(nbBits == 0)
+        return ERROR_OK;
+    if(nbBits > nbPixels)
+        return ERROR_NOMEM;
 
-            // On modifie le tableau en utilisant la même méthode du nombre aléatoire que l'insertion classique
-            randomNumber = rand() % 2; // On génère un nombre aléatoire entre 0 et 1;// NOLINT(cert-msc30-c, cert-msc50-cpp)
-            if(randomNumber == 1) {
-                if(matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] != pixelIntensity) {
-                    matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] = matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] + 1;
-                } else {
-                    matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] = matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] - 1;
-                }
-            } else {
-                if(matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] != 0) {
-                    matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] = matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] - 1;
-                } else {
-                    matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] = matriceImage[lengthDimensionPrefix+position+(i+(i*(columns-1)))] + 1;
-                }
-            }
+    nbEtats = 1 << hauteur;
+    nbMots = (nbEtats + 31) / 32;
 
-            (*compteurNbBitsModif)++;
+    // Les blocs font au plus nbPixels / nbBits + 1 pixels: les colonnes de la sous-matrice sont calculées une fois
+    largeurMax = nbPixels / nbBits + 1;
+    colonnes = (unsigned int*) malloc(sizeof(unsigned int) * (size_t) largeurMax);
+    tampon = (float*) malloc(sizeof(float) * 2 * (size_t) nbEtats);
+    decisions = (unsigned int*) malloc(sizeof(unsigned int) * (size_t) nbMots * (size_t) nbPixels);
+    if(colonnes == NULL || tampon == NULL || decisions == NULL) {
+        freeAllVar(colonnes, tampon, decisions, NULL, NULL, NULL, NULL);
+        return ERROR_NOMEM;
+    }
+    for(j = 0; j < largeurMax; j++) {
+        colonnes[j] = colonneSTC(j, hauteur);
+    }
+    ancien = tampon;
+    nouveau = tampon + nbEtats;
 
+    // Seul l'état nul (syndrome vide) est atteignable au départ
+    ancien[0] = 0;
+    for(s = 1; s < nbEtats; s++) {
+        ancien[s] = INFINITY;
+    }
 
-        }
+    // Passage avant: un bloc de pixels par bit du message, puis le bit de poids faible de l'état doit valoir le bit du message
+    for(bloc = 0; bloc < nbBits; bloc++) {
+        debut = debutBlocSTC(bloc, nbPixels, nbBits);
+        fin = debutBlocSTC(bloc + 1, nbPixels, nbBits);
 
+        // Les dernières lignes de la sous-matrice n'existent plus à la fin du message
+        masque = nbBits - bloc < hauteur ? (1u << (nbBits - bloc)) - 1 : (1u << hauteur) - 1;
 
-    }
+        for(j = debut; j < fin; j++) {
+            p = lengthDimensionPrefix + j;
+            cout = couts != NULL ? couts[p] : 1.0f;
+            if(matriceImage[p] & 1)
+                etapeViterbiSTC(ancien, nouveau, decisions + j * nbMots, nbEtats, colonnes[j - debut] & masque, cout, 0);
+            else
+                etapeViterbiSTC(ancien, nouveau, decisions + j * nbMots, nbEtats, colonnes[j - debut] & masque, 0, cout);
+            temp = ancien;
+            ancien = nouveau;
+            nouveau = temp;
+        }
 
-    // On free toutes les variables que l'on a utilisées
-    for(i = 0; i < 1; i++) {
-        free(bufferImage[i]);
+        bit = messageBinary[bloc] & 1;
+        s = 0;
+#if defined(__x86_64__)
+        // Les états pairs (bit 0) ou impairs (bit 1) de 2 registres forment un registre des nouveaux états
+        for(; 2 * s + 8 <= nbEtats; s += 4) {
+            a = _mm_loadu_ps(ancien + 2 * s);
+            b = _mm_loadu_ps(ancien + 2 * s + 4);
+            _mm_storeu_ps(nouveau + s, bit ? _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)) : _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        }
+#endif
+        for(; s < nbEtats / 2; s++) {
+            nouveau[s] = ancien[(s << 1) | bit];
+        }
+        for(; s < nbEtats; s++) {
+            nouveau[s] = INFINITY;
+        }
+        temp = ancien;
+        ancien = nouveau;
+        nouveau = temp;
     }
-    free(bufferImage);
 
-    for(i = 0; i < 1; i++) {
-        free(bufferMsg[i]);
+    srand(time(NULL)); // On rend le rank aléatoire pour la modification des bits
+
+    // Retour en arrière depuis l'état nul: les décisions donnent le LSB voulu de chaque pixel
+    etat = 0;
+    for(bloc = nbBits - 1; bloc >= 0; bloc--) {
+        debut = debutBlocSTC(bloc, nbPixels, nbBits);
+        fin = debutBlocSTC(bloc + 1, nbPixels, nbBits);
+        masque = nbBits - bloc < hauteur ? (1u << (nbBits - bloc)) - 1 : (1u << hauteur) - 1;
+
+        etat = ((etat << 1) | (messageBinary[bloc] & 1)) & (nbEtats - 1);
+        for(j = fin - 1; j >= debut; j--) {
+            bit = (int) ((decisions[j * nbMots + (etat >> 5)] >> (etat & 31)) & 1u);
+            if(bit)
+                etat ^= (int) (colonnes[j - debut] & masque);
+
+            p = lengthDimensionPrefix + j;
+            if((matriceImage[p] & 1) != bit) {
+                randomNumber = rand() % 2; // On génère un nombre aléatoire entre 0 et 1;// NOLINT(cert-msc30-c, cert-msc50-cpp)
+                if((randomNumber == 1 && matriceImage[p] != pixelIntensity) || matriceImage[p] == 0)
+                    matriceImage[p]++;
+                else
+                    matriceImage[p]--;
+                (*compteurNbBitsModif)++;
+            }
+        }
     }
-    free(bufferMsg);
 
+    freeAllVar(colonnes, tampon, decisions, NULL, NULL, NULL, NULL);
 
-    for(k = 0; k < 1; k++) {
-        free(matriceResMul[k]);
-    }
-    free(matriceResMul);
+    return ERROR_OK;
+}
 
 
-    for(k = 0; k < 1; k++) {
-        free(matriceResAdd[k]);
-    }
+unsigned int lireBitSTC(lecteurBits_t* lecteur, long int position) {
 
-    free(matriceResAdd);
+    long int nbPixels = lecteur->dimension - lecteur->debut, nbBits = (long int) lecteur->columns, hauteur = (long int) lecteur->rows, bloc, debut, fin, j;
+    unsigned int masque, syndrome, bit = 0;
 
-    for (i = 0; i < columns; i++) {
-        free(matriceHamming[i]);
+    if(position < 0 || position >= nbBits)
+        return 0;
+
+    // Seuls les hauteur - 1 blocs précédents participent au bit: inutile de repartir du début
+    if(lecteur->blocCache < 0 || position < lecteur->blocCache || position - lecteur->blocCache >= hauteur) {
+        bloc = position - hauteur + 1 > 0 ? position - hauteur + 1 : 0;
+        syndrome = 0;
+    } else {
+        bloc = lecteur->blocCache;
+        syndrome = lecteur->syndromeCache;
     }
 
-    free(matriceHamming);
+    for(; bloc <= position; bloc++) {
+        debut = debutBlocSTC(bloc, nbPixels, nbBits);
+        fin = debutBlocSTC(bloc + 1, nbPixels, nbBits);
+        masque = nbBits - bloc < hauteur ? (1u << (nbBits - bloc)) - 1 : (1u << hauteur) - 1;
 
-    return ERROR_OK;
+        for(j = debut; j < fin; j++) {
+            syndrome ^= colonneSTC(j - debut, (int) hauteur) & masque & (0u - ((unsigned int) lireEchantillon(lecteur->source, lecteur->debut + j) & 1u));
+        }
 
-}
+        bit = syndrome & 1u;
+        syndrome >>= 1u;
+    }
 
+    lecteur->blocCache = position + 1;
+    lecteur->syndromeCache = syndrome;
 
+    return bit;
+}
 
-int hideMessage(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, int crypt, char* keyCrypt) {
+void ajouterTrits(unsigned int* un, unsigned int* deux, unsigned int b1, unsigned int b2) {
 
-    int i, randomNumber,j, lengthEndOfMsgBinary;
-    int *endOfMsgBinary, *dimMaxBinary, *tablePermuteIndex;
+    unsigned int a1 = *un, a2 = *deux;
 
-    // On setup le random
-    if(tailleMsgBit <= (dimension - lengthDimensionPrefix)) {
+    // 1 + 0, 0 + 1 et 2 + 2 donnent 1; 2 + 0, 0 + 2 et 1 + 1 donnent 2
+    *un = (a1 & ~(b1 | b2)) | (b1 & ~(a1 | a2)) | (a2 & b2);
+    *deux = (a2 & ~(b1 | b2)) | (b2 & ~(a1 | a2)) | (a1 & b1);
+}
 
 
-        j = 0;
-        int p = 0;
-        int bufferBitBinary;
+unsigned int tritsVersEntier(unsigned int un, unsigned int deux, int nbTrits) {
 
+    unsigned int valeur = 0;
+    int i;
 
+    for(i = nbTrits - 1; i >= 0; i--) {
+        valeur = valeur * 3 + ((un >> i) & 1u) + 2 * ((deux >> i) & 1u);
+    }
 
-        if(crypt == 1) {
-            tablePermuteIndex = (int*) malloc(sizeof(int)*(dimension));
-            if(tablePermuteIndex == NULL)
-                return ERROR_NOMEM;
-            for(i = lengthDimensionPrefix; i<dimension; i++) {
-                tablePermuteIndex[i] = i;
-            }
+    return valeur;
+}
 
 
-            unsigned long keyHash = hash((unsigned char *) keyCrypt);
-            srand(keyHash);
-            int f = 0;
-            for (i = dimension - 1; i >= lengthDimensionPrefix; --i) {
-                //generate a random number [0, n-1]
-                j = (lengthDimensionPrefix) + ( rand() % (i + 1));// NOLINT(cert-msc30-c, cert-msc50-cpp)
+int genererTableTernaire(int nbTrits, unsigned int** table, long int* nbColonnes) {
 
-                //swap the last element with element at random index
-                int temp = tablePermuteIndex[i];
-                tablePermuteIndex[i] = tablePermuteIndex[j];
-                tablePermuteIndex[j] = temp;
-                f++;
-            }
+    unsigned int puissance = 1, v, reste, un, deux;
+    long int j = 0;
+    int i;
 
-        }
+    if(nbTrits < TRITS_MIN_TERNAIRE || nbTrits > TRITS_MAX_TERNAIRE)
+        return ERROR_INVARG;
 
+    for(i = 0; i < nbTrits; i++) {
+        puissance *= 3;
+    }
+    *nbColonnes = (long int) (puissance - 1) / 2;
 
-        srand(time(NULL)); // NOLINT(cert-msc30-c, cert-msc50-cpp)
+    *table = (unsigned int*) malloc(sizeof(unsigned int) * 6 * (size_t) (*nbColonnes));
+    if(*table == NULL)
+        return ERROR_NOMEM;
 
-        j=0;
-        for(i = lengthDimensionPrefix; i<(tailleMsgBit + lengthDimensionPrefix); i++) {
+    for(v = 1; v < puissance; v++) {
+
+        // Décomposition de v en trits (poids faible en premier)
+        un = deux = 0;
+        reste = v;
+        for(i = 0; i < nbTrits; i++) {
+            if(reste % 3 == 1)
+                un |= 1u << i;
+            else if(reste % 3 == 2)
+                deux |= 1u << i;
+            reste /= 3;
+        }
 
-            randomNumber = rand() % 2; // On génère un nombre aléatoire entre 0 et 1; // NOLINT(cert-msc30-c, cert-msc50-cpp)
+        // Une seule colonne parmi v et -v: celle dont le premier trit non nul vaut 1
+        if(un != 0 && (deux == 0 || (un & (0u - un)) < (deux & (0u - deux)))) {
+            (*table)[6 * j] = 0;
+            (*table)[6 * j + 1] = 0;
+            (*table)[6 * j + 2] = un;
+            (*table)[6 * j + 3] = deux;
+            (*table)[6 * j + 4] = deux; // 2 * colonne = -colonne: les trits 1 et 2 sont échangés
+            (*table)[6 * j + 5] = un;
+            j++;
+        }
+    }
 
+    return ERROR_OK;
+}
 
-            /* Petit fix pour choisir si on met une img ou un texte */
 
-            if(((messageBinary[j] - '0') == 0 ) || ((messageBinary[j] - '0') == 1 )) {
-                bufferBitBinary = (messageBinary[j] - '0');
-            } else {
-                bufferBitBinary = messageBinary[j];
-            }
+int determineTailleTernaire(long int tailleImg, size_t tailleMsgBit, int* nbTrits, long int* nbColonnes) {
 
-            /* Fin du petit fix */
-            if(crypt == 0) {
-                if (bufferBitBinary != ((matriceImage[i] & (1 << 0)) >> 0)) {
+    long int nbTritsMsg = (long int) ((tailleMsgBit + BITS_GROUPE_TERNAIRE - 1) / BITS_GROUPE_TERNAIRE) * TRITS_GROUPE_TERNAIRE, puissance;
+    int i;
 
-                    if (randomNumber == 1) {
-                        if (matriceImage[i] != pixelIntensity) {
-                            matriceImage[i] = matriceImage[i] + 1;
-                        } else {
-                            matriceImage[i] = matriceImage[i] - 1;
-                        }
-                    } else {
-                        if (matriceImage[i] != 0) {
-                            matriceImage[i] = matriceImage[i] - 1;
-                        } else {
-                            matriceImage[i] = matriceImage[i] + 1;
-                        }
-                    }
+    // Plus les blocs sont grands, moins il y a de modifications par trit: on prend le plus grand code qui tient dans l'image
+    for(*nbTrits = TRITS_MAX_TERNAIRE; *nbTrits >= TRITS_MIN_TERNAIRE; (*nbTrits)--) {
+        puissance = 1;
+        for(i = 0; i < *nbTrits; i++) {
+            puissance *= 3;
+        }
+        *nbColonnes = (puissance - 1) / 2;
 
+        if(((nbTritsMsg + *nbTrits - 1) / *nbTrits) * (*nbColonnes) <= tailleImg)
+            return ERROR_OK;
+    }
 
-                }
-            } else if(crypt == 1) {
-                if (bufferBitBinary != ((matriceImage[tablePermuteIndex[i]] & (1 << 0)) >> 0)) {
+    return ERROR_NOMEM;
+}
 
-                    if (randomNumber == 1) {
-                        if (matriceImage[tablePermuteIndex[i]] != pixelIntensity) {
-                            matriceImage[tablePermuteIndex[i]] = matriceImage[tablePermuteIndex[i]] + 1;
-                        } else {
-                            matriceImage[tablePermuteIndex[i]] = matriceImage[tablePermuteIndex[i]] - 1;
-                        }
-                    } else {
-                        if (matriceImage[tablePermuteIndex[i]] != 0) {
-                            matriceImage[tablePermuteIndex[i]] = matriceImage[tablePermuteIndex[i]] - 1;
-                        } else {
-                            matriceImage[tablePermuteIndex[i]] = matriceImage[tablePermuteIndex[i]] + 1;
-                        }
-                    }
 
+int hideMessageTernaire(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, int nbTrits, unsigned int* compteurNbBitsModif) {
 
-                }
-            } else {
-                return ERROR_INVARG;
-            }
+    long int nbColonnes, nbTritsMsg, nbBlocs, bloc, base, j, t, g;
+    unsigned int *table, s1, s2, c1, c2, valeur, puissance = 1;
+    unsigned char *trits;
+    int *correction, i, r, error;
 
+    *compteurNbBitsModif = 0;
 
-            j += 1;
-            p += 1;
+    error = genererTableTernaire(nbTrits, &table, &nbColonnes);
+    if(error != ERROR_OK)
+        return error;
 
-        }
+    nbTritsMsg = (long int) ((tailleMsgBit + BITS_GROUPE_TERNAIRE - 1) / BITS_GROUPE_TERNAIRE) * TRITS_GROUPE_TERNAIRE;
+    nbBlocs = (nbTritsMsg + nbTrits - 1) / nbTrits;
+    if(lengthDimensionPrefix + nbBlocs * nbColonnes > dimension) {
+        free(table);
+        return ERROR_NOMEM;
+    }
 
-        if(crypt == 1)
-            free(tablePermuteIndex);
+    for(i = 0; i < nbTrits; i++) {
+        puissance *= 3;
+    }
 
-        return ERROR_OK;
-    } else {
+    trits = (unsigned char*) malloc((size_t) (nbTritsMsg > 0 ? nbTritsMsg : 1));
+    correction = (int*) calloc(puissance, sizeof(int));
+    if(trits == NULL || correction == NULL) {
+        freeAllVar(table, trits, correction, NULL, NULL, NULL, NULL);
         return ERROR_NOMEM;
     }
 
-}
-
+    // Chaque groupe de BITS_GROUPE_TERNAIRE bits (poids fort en premier) est écrit en base 3, trit de poids faible en premier
+    for(g = 0; g < nbTritsMsg / TRITS_GROUPE_TERNAIRE; g++) {
+        valeur = 0;
+        for(j = 0; j < BITS_GROUPE_TERNAIRE; j++) {
+            t = g * BITS_GROUPE_TERNAIRE + j;
+            valeur = (valeur << 1) | (t < (long int) tailleMsgBit ? (messageBinary[t] & 1u) : 0u);
+        }
+        for(i = 0; i < TRITS_GROUPE_TERNAIRE; i++) {
+            trits[g * TRITS_GROUPE_TERNAIRE + i] = (unsigned char) (valeur % 3);
+            valeur /= 3;
+        }
+    }
 
+    // Table de correction: pour chaque différence de syndrome, le pixel à modifier (+1) ou (-1), 0 si aucun
+    for(j = 0; j < nbColonnes; j++) {
+        correction[tritsVersEntier(table[6 * j + 2], table[6 * j + 3], nbTrits)] = (int) j + 1;
+        correction[tritsVersEntier(table[6 * j + 4], table[6 * j + 5], nbTrits)] = -((int) j + 1);
+    }
 
+    for(bloc = 0; bloc < nbBlocs; bloc++) {
+        base = lengthDimensionPrefix + bloc * nbColonnes;
 
+        s1 = s2 = 0;
+        for(j = 0; j < nbColonnes; j++) {
+            r = matriceImage[base + j] % 3;
+            ajouterTrits(&s1, &s2, table[6 * j + 2 * r], table[6 * j + 2 * r + 1]);
+        }
 
-/*
- *  Nom: error_str
- *  But: Retourner une chaîne de caractères correspondante à l'erreur fournit en paramètre
- *
- *  Paramètres d'entrées:
- *      err: Le code d'erreur (error_t ou int)
- *
- *  Paramètres de sorties (sous forme de pointer):
- *
- *  Valeur de retour:
- *      (const char*) La chaine de caractère puisée dans le tableau ERROR_STRS du fichier header.h correspondant à l'erreur fournit en paramètre.
- *
- */
-const char* error_str(error_t err)
-{
-    const char* err_str = NULL;
+        // Trits voulus (ceux qui dépassent la fin du message gardent la valeur du syndrome)
+        c1 = s1;
+        c2 = s2;
+        for(i = 0; i < nbTrits; i++) {
+            t = bloc * nbTrits + i;
+            if(t < nbTritsMsg) {
+                c1 = (c1 & ~(1u << i)) | ((unsigned int) (trits[t] == 1) << i);
+                c2 = (c2 & ~(1u << i)) | ((unsigned int) (trits[t] == 2) << i);
+            }
+        }
 
-    // On vérifie que l'erreur fournit en paramètre fait bien parti de la liste des erreurs du type error_t, sinon on rejoint "done" pour retourner NULL;
-    if (err >= ERROR_COUNT) {
-        goto done;
+        // Différence = voulu - syndrome (l'opposé échange les trits 1 et 2)
+        ajouterTrits(&c1, &c2, s2, s1);
+        r = correction[tritsVersEntier(c1, c2, nbTrits)];
+        if(r != 0) {
+            j = base + (r > 0 ? r : -r) - 1;
+            // Seul le reste modulo 3 compte: +2 remplace -1 en 0 et -2 remplace +1 en pixelIntensity
+            if(r > 0)
+                matriceImage[j] += matriceImage[j] != pixelIntensity ? 1 : -2;
+            else
+                matriceImage[j] += matriceImage[j] != 0 ? -1 : 2;
+            (*compteurNbBitsModif)++;
+        }
     }
 
-    err_str = ERROR_STRS[err]; // On va chercher la bonne chaine de caractère correspondant à l'erreur dans le tableau ERROR_STRS initialisé dans header.h. Puisque error_t est un enum alors on peut le passé en indice du tableau car il est considéré comme un int.
+    freeAllVar(table, trits, correction, NULL, NULL, NULL, NULL);
 
-    done:
-    return err_str;
+    return ERROR_OK;
 }
 
 
+// Trit t du message: trit t % rows du syndrome du bloc t / rows
+static unsigned int lireTritTernaire(lecteurBits_t* lecteur, long int t) {
 
-/*
- *  Nom: writeImage
- *  But: Ecrire les valeurs de la matrice de la photo dans un nouveau fichier
- *
- *  Paramètres d'entrées:
- *      pathFile:       Le chemin vers le NOUVEAU fichier Portable pixmap (char*)
- *      matrice:        La matrice (1d) où les données vont être récuperées (int*)
- *      beginningImage: La position du curseur où commence les données de l'image (long int)
- *      dimension:      Les dimensions de l'image (longueur*largeur et * 3 si couleur) (long int)
- *
- *  Paramètres de sorties (sous forme de pointer):
- *
- *  Valeur de retour:
- *      (int) Le code erreur de type error_t à traduire grâce à la fonction error_str. Si la valeur de retour est égal à 0 (ERROR_OK) alors tout c'est déroulé normalement.
- *
- */
-int writeImage(char* pathFile, int* matrice, long int beginningImage, long int dimension) {
-    /* --------- DEFINITION DES VARIABLES --------- */
-    FILE* image = NULL;
-    int i = 0, caractereActuel, error;
-    /* ------- FIN DEFINITION DES VARIABLES ------- */
+    long int bloc = t / lecteur->rows, base, j, p;
+    unsigned int s1 = 0, s2 = 0, valeur;
+    int r, i;
 
-    // On ouvre l'image
-    image = fopen(pathFile, "r+");
+    if(bloc != lecteur->blocCache) {
+        base = lecteur->debut + bloc * (long int) lecteur->columns;
+        for(j = 0; j < (long int) lecteur->columns; j++) {
+            p = base + j;
+            r = p < lecteur->dimension ? lireEchantillon(lecteur->source, p) % 3 : 0;
+            ajouterTrits(&s1, &s2, lecteur->tableTernaire[6 * j + 2 * r], lecteur->tableTernaire[6 * j + 2 * r + 1]);
+        }
+        lecteur->blocCache = bloc;
+        lecteur->syndromeCache = tritsVersEntier(s1, s2, (int) lecteur->rows);
+    }
 
-    if(image != NULL) {
+    valeur = lecteur->syndromeCache;
+    for(i = 0; i < (int) (t % lecteur->rows); i++) {
+        valeur /= 3;
+    }
 
-        error = fseek(image, beginningImage, SEEK_SET);
+    return valeur % 3;
+}
 
-        if(error == 0) {
-            for(i=0; i<dimension; i++) {
-                fwrite(&matrice[i], 1, 1, image);
-            }
 
-        } else {
-            return ERROR_INVARG;
-        }
+unsigned int lireBitTernaire(lecteurBits_t* lecteur, long int position) {
 
-    } else {
-        return ERROR_OPEN;
-    }
+    long int groupe = position / BITS_GROUPE_TERNAIRE;
+    unsigned int valeur = 0, puissance = 1;
+    int i;
 
-    return 0;
+    // Trits lus dans l'ordre des blocs pour profiter du cache du syndrome
+    if(groupe != lecteur->groupeCache) {
+        for(i = 0; i < TRITS_GROUPE_TERNAIRE; i++) {
+            valeur += puissance * lireTritTernaire(lecteur, groupe * TRITS_GROUPE_TERNAIRE + i);
+            puissance *= 3;
+        }
+        lecteur->groupeCache = groupe;
+        lecteur->valeurGroupe = valeur;
+    }
 
+    return (lecteur->valeurGroupe >> (BITS_GROUPE_TERNAIRE - 1 - position % BITS_GROUPE_TERNAIRE)) & 1u;
 }
 
+int hideMessageLSBMR(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, long int dimension, long int pixelIntensity, int lengthDimensionPrefix, unsigned int* compteurNbBitsModif) {
 
-/*
- *  Nom: writeHeader
- *  But: Ecrire les valeurs des paramètres du fichier dans un nouveau fichier
- *
- *  Paramètres d'entrées:
- *      pathFile:       Le chemin vers le NOUVEAU fichier Portable pixmap (char*)
- *      typeFile:       Le type du fichier (exemple "P6") (char*)
- *      imageWidth:     la largeur de l'image (long int)
- *      imageHeight:    La hauteur de l'image (long int)
- *      pixelIntensity: L'intensité des pixels (exemple "255") (long int)
- *
- *  Paramètres de sorties (sous forme de pointer):
- *      positionCursor: La position du curseur à la fin du header (*long int)
- *
- *  Valeur de retour:
- *      (int) Le code erreur de type error_t à traduire grâce à la fonction error_str. Si la valeur de retour est égal à 0 (ERROR_OK) alors tout c'est déroulé normalement.
- *
- */
-int writeHeader(char* pathFile, char* typeFile, long int imageWidth, long int imageHeight, long int pixelIntensity, long int *positionCursor) {
-    /* --------- DEFINITION DES VARIABLES --------- */
-    FILE* image = NULL;
-    /* ------- FIN DEFINITION DES VARIABLES ------- */
-
-    // On ouvre l'image
-    image = fopen(pathFile, "w");
+    long int nbPaires = (long int) tailleMsgBit / 2, k;
+    int *paire, x1, x2, m1, m2, change1, change2, sens1, sens2, reserve = 0;
+    unsigned int alea = 0, modifs = 0;
 
-    // On vérifie si l'ouverture de l'image s'est passée correctement
-    if (image != NULL) {
+    *compteurNbBitsModif = 0;
 
-        fputs(typeFile, image);
-        fprintf(image, "\n%ld %ld", imageWidth, imageHeight);
-        fprintf(image, "\n%ld\n", pixelIntensity);
+    if(lengthDimensionPrefix + (long int) tailleMsgBit > dimension)
+        return ERROR_NOMEM;
 
-        *positionCursor = ftell(image);
-        fclose(image);   // On ferme le fichier
+    srand(time(NULL)); // On rend le rank aléatoire pour la modification des bits
 
-        return ERROR_OK;
+    for(k = 0; k < nbPaires; k++) {
+        paire = matriceImage + lengthDimensionPrefix + 2 * k;
+        x1 = paire[0];
+        x2 = paire[1];
+        m1 = messageBinary[2 * k] & 1;
+        m2 = messageBinary[2 * k + 1] & 1;
+
+        // Un seul appel à rand() pour 30 paires
+        if(reserve == 0) {
+            alea = (unsigned int) rand(); // NOLINT(cert-msc30-c, cert-msc50-cpp)
+            reserve = 30;
+        }
+        reserve--;
+
+        // x1 doit changer: -1 si cela donne aussi le second bit, +1 sinon (sens imposé aux bornes)
+        change1 = (x1 ^ m1) & 1;
+        sens1 = (((((x1 - 1) >> 1) + x2) & 1) == m2) ? -1 : 1;
+        sens1 = x1 == 0 ? 1 : (x1 == pixelIntensity ? -1 : sens1);
+        x1 += (0 - change1) & sens1;
+
+        // x2 ne change que si x1 / 2 + x2 n'a pas la bonne parité (sens aléatoire, imposé aux bornes)
+        change2 = (((x1 >> 1) + x2) ^ m2) & 1;
+        sens2 = (alea & 1u) ? 1 : -1;
+        sens2 = x2 == 0 ? 1 : (x2 == pixelIntensity ? -1 : sens2);
+        x2 += (0 - change2) & sens2;
+        alea >>= 1;
+
+        paire[0] = x1;
+        paire[1] = x2;
+        modifs += (unsigned int) (change1 + change2);
+    }
 
-    } else {
-        // Le fichier n'a pas pu s'ouvrir donc on retourne une erreur
-        return ERROR_OPEN;
+    // Nombre de bits impair: le dernier bit est caché dans le LSB du pixel suivant
+    if(tailleMsgBit & 1) {
+        paire = matriceImage + lengthDimensionPrefix + 2 * nbPaires;
+        if((*paire ^ messageBinary[tailleMsgBit - 1]) & 1) {
+            *paire += *paire != pixelIntensity ? 1 : -1;
+            modifs++;
+        }
     }
+
+    *compteurNbBitsModif = modifs;
+
+    return ERROR_OK;
 }
 
+void geometrieSource(sourceImage_t* source, long int largeur, int nbCanaux) {
 
-/*
- *  Nom: readImage
- *  But: Retourner les valeurs de la matrice de la photo
- *
- *  Paramètres d'entrées:
- *      pathFile:       Le chemin vers le fichier Portable pixmap (char*)
- *
- *  Paramètres de sorties (sous forme de pointer):
- *      matrice:        La matrice (1d) où les données vont être écritent (int*)
- *      beginningImage: La position du curseur où commence les données de l'image (long int)
- *      dimension:      Les dimensions de l'image (longueur*largeur et * 3 si couleur) (long int)
+    source->largeurLigne = largeur * nbCanaux;
+    source->nbCanaux = nbCanaux;
+}
 
- *
- *  Valeur de retour:
- *      (int) Le code erreur de type error_t à traduire grâce à la fonction error_str. Si la valeur de retour est égal à 0 (ERROR_OK) alors tout c'est déroulé normalement.
- *
- */
-int readImage(char* pathFile, int* matrice, long int beginningImage, long int dimension) {
-    /* --------- DEFINITION DES VARIABLES --------- */
-    FILE* image = NULL;
-    int i = 0, error;
-    /* ------- FIN DEFINITION DES VARIABLES ------- */
 
-    // On ouvre l'image
-    image = fopen(pathFile, "r");
+#if defined(__x86_64__)
+/* Activité |g - d| + |h - b| de 4 échantillons, calculée sans les LSB (SSE2 n'a pas de valeur absolue 32 bits) */
+static __m128i activiteSSE(__m128i gauche, __m128i droite, __m128i haut, __m128i bas) {
 
-    if(image != NULL) {
+    __m128i dx = _mm_sub_epi32(_mm_srai_epi32(gauche, 1), _mm_srai_epi32(droite, 1));
+    __m128i dy = _mm_sub_epi32(_mm_srai_epi32(haut, 1), _mm_srai_epi32(bas, 1));
+    __m128i sx = _mm_srai_epi32(dx, 31), sy = _mm_srai_epi32(dy, 31);
 
-        error = fseek(image, beginningImage, SEEK_SET);
+    return _mm_add_epi32(_mm_sub_epi32(_mm_xor_si128(dx, sx), sx), _mm_sub_epi32(_mm_xor_si128(dy, sy), sy));
+}
+#endif
 
-        if(error == 0) {
-            for(i=0; i<dimension; i++) {
-                matrice[i] = fgetc(image);
-            }
+void calculerCoutsLigne(const int* haut, const int* ligne, const int* bas, long int largeur, int nbCanaux, unsigned char* couts) {
 
-            fclose(image);
+    long int x = nbCanaux, activite;
 
-            return ERROR_OK;
+    if(largeur <= 2 * nbCanaux) {
+        memset(couts, COUT_MAX_ADAPTATIF, (size_t) largeur);
+        return;
+    }
 
-        } else {
-            return ERROR_INVARG;
-        }
+    // Bords gauche et droit: pas de voisin horizontal
+    memset(couts, COUT_MAX_ADAPTATIF, (size_t) nbCanaux);
+    memset(couts + largeur - nbCanaux, COUT_MAX_ADAPTATIF, (size_t) nbCanaux);
 
-    } else {
-        return ERROR_OPEN;
+#if defined(__x86_64__)
+    __m128i a0, a1, v, coutMax = _mm_set1_epi16(COUT_MAX_ADAPTATIF);
+
+    for(; x + 8 <= largeur - nbCanaux; x += 8) {
+        a0 = activiteSSE(_mm_loadu_si128((const __m128i*) (ligne + x - nbCanaux)), _mm_loadu_si128((const __m128i*) (ligne + x + nbCanaux)), _mm_loadu_si128((const __m128i*) (haut + x)), _mm_loadu_si128((const __m128i*) (bas + x)));
+        a1 = activiteSSE(_mm_loadu_si128((const __m128i*) (ligne + x + 4 - nbCanaux)), _mm_loadu_si128((const __m128i*) (ligne + x + 4 + nbCanaux)), _mm_loadu_si128((const __m128i*) (haut + x + 4)), _mm_loadu_si128((const __m128i*) (bas + x + 4)));
+
+        // Saturation en 16 bits puis plafonnement à COUT_MAX_ADAPTATIF: le résultat tient dans un octet
+        v = _mm_sub_epi16(coutMax, _mm_min_epi16(_mm_packs_epi32(a0, a1), coutMax));
+        _mm_storel_epi64((__m128i*) (couts + x), _mm_packus_epi16(v, v));
     }
+#endif
 
+    for(; x < largeur - nbCanaux; x++) {
+        activite = labs((long int) (ligne[x - nbCanaux] >> 1) - (ligne[x + nbCanaux] >> 1)) + labs((long int) (haut[x] >> 1) - (bas[x] >> 1));
+        couts[x] = (unsigned char) (COUT_MAX_ADAPTATIF - (activite < COUT_MAX_ADAPTATIF ? activite : COUT_MAX_ADAPTATIF));
+    }
 }
 
 
-/*
- *  Nom: readHeader
- *  But: Retourner les valeurs des paramètres du header des fichiers Portable pixmap
- *
- *  Paramètres d'entrées:
- *      pathFile:       Le chemin vers le fichier Portable pixmap (char*)
- *
- *  Paramètres de sorties (sous forme de pointer):
- *      typeFile:       Le type du fichier (exemple "P6") (char*)
- *      imageWidth:     la largeur de l'image (pointer to long int)
- *      imageHeight:    La hauteur de l'image (pointer to long int)
- *      pixelIntensity: L'intensité des pixels (exemple "255") (pointer to long int)
- *      positionCursor: La position du curseur à la fin du header (*long int)
- *
- *  Valeur de retour:
- *      (int) Le code erreur de type error_t à traduire grâce à la fonction error_str. Si la valeur de retour est égal à 0 (ERROR_OK) alors tout c'est déroulé normalement.
- *
- */
-int readHeader(char* pathFile, char* typeFile, long int *imageWidth, long int *imageHeight, long int *pixelIntensity, long int *positionCursor) {
+/* Ligne y de la source: directement dans le tableau pour une image en mémoire, lue dans tampon sinon */
+static const int* ligneSource(sourceImage_t* source, long int y, int* tampon) {
 
-    /* --------- DEFINITION DES VARIABLES --------- */
-    FILE* image = NULL;
-    char *ptr;
-    int compteurLigne = 0;
-    char buffer[50];
+    long int x, debut = y * source->largeurLigne;
 
-    /* ------- FIN DEFINITION DES VARIABLES ------- */
+    if(source->matriceImage != NULL)
+        return source->matriceImage + debut;
 
-    // On ouvre l'image
-    image = fopen(pathFile, "r");
+    for(x = 0; x < source->largeurLigne; x++) {
+        tampon[x] = lireEchantillon(source, debut + x);
+    }
+
+    return tampon;
+}
 
-    // On vérifie si l'ouverture de l'image s'est passée correctement
-    if (image != NULL) {
+int calculerCoutsAdaptatifs(sourceImage_t* source, long int debut, unsigned int seuil, int** table, long int* nbPositions, long int* histogramme) {
 
-        // Cette boucle va tourner dans le header du fixer Portable pixelmap pour récuperer toutes les informations.
-        while(compteurLigne < 3) {
+    long int largeur = source->largeurLigne, nbLignes, y, x, p;
+    const int *lignes[3] = {NULL, NULL, NULL};
+    int *tampons;
+    unsigned char *couts;
 
-            // On récupère la neme ligne du header que l'on stock dans buffer
-            fgets(buffer, 50, image);
-            // On supprime le '\n' qui se rajoute automatiquement à cause de la fonction fgets
-            strtok(buffer, "\n");
+    *nbPositions = 0;
+    if(table != NULL)
+        *table = NULL;
+    if(histogramme != NULL)
+        memset(histogramme, 0, sizeof(long int) * NB_COUTS_ADAPTATIFS);
 
-            // Si la ligne est un commentaire (i.e commençant par '#' alors on saute la boucle)
-            if(buffer[0] == '#')
-                continue;
+    if(largeur <= 0 || source->dimension % largeur != 0 || source->nbCanauxVue != 0 || seuil > COUT_MAX_ADAPTATIF)
+        return ERROR_INVARG;
+    nbLignes = source->dimension / largeur;
 
-            /*  Ce switch en fonction de compteurLigne nous aide à determiner si la ligne actuelle correspond au type de fichier, à sa largeur etc.....
-             *  On a:
-             *      case 0: La ligne correspond au type du fichier
-             *      case 1: La ligne correspond aux dimensions de l'image (longueur*hauteur)
-             *      case 2: La ligne correspond à l'intensité des pixels
-             *
-             */
-            switch(compteurLigne) {
-                case 0:
-                    strncpy(typeFile, buffer, 50); // On retourne le type de l'image en copiant le buffer dans typeFile
-                    break;
-                case 1:
+    tampons = (int*) malloc(sizeof(int) * 3 * (size_t) largeur);
+    couts = (unsigned char*) malloc((size_t) largeur);
+    if(tampons == NULL || couts == NULL) {
+        free(tampons);
+        free(couts);
+        return ERROR_NOMEM;
+    }
 
-                    /* Ici on rencontre un problème: les dimensions de l'image (longueur*hauteur) sont sur la même ligne.
-                     * On doit donc les séparer en deux en utilisant comme séparateur l'espace vide " ".
-                     * La fonction strtok va nous aider à faire cela.
-                     */
+    if(table != NULL) {
+        *table = (int*) malloc(sizeof(int) * (size_t) (source->dimension > debut ? source->dimension - debut : 1));
+        if(*table == NULL) {
+            free(tampons);
+            free(couts);
+            return ERROR_NOMEM;
+        }
+    }
 
+    // Les lignes y - 1, y et y + 1 utilisent les tampons (y + 2) % 3, y % 3 et (y + 1) % 3: seule la ligne y + 1 est lue à chaque tour
+    lignes[1] = ligneSource(source, 0, tampons);
+    for(y = 0; y < nbLignes; y++) {
 
-                    ptr = strtok(buffer, " ");
+        if(y + 1 < nbLignes)
+            lignes[2] = ligneSource(source, y + 1, tampons + ((y + 1) % 3) * largeur);
 
-                    for(int j=0; j<2; j++) {
-                        if(j == 0) {                  // Si on est à la première partie de la ligne alors c'est la longueur donc on retourne la valeur dans imageWidth en convertissant buffer (chaine de caractère) en long int grâce à la fonction strtol
-                            *imageWidth = strtol(ptr, NULL, 10);
-                        } else if(j == 1) {           // Si on est à la deuxème partie de la ligne alors c'est la hauteur donc on retourne la valeur dans imageHeight en convertissant buffer (chaine de caractère) en long int grâce à la fonction strtol
-                            *imageHeight = strtol(ptr, NULL, 10);
-                        }
-                        ptr = strtok(NULL, " ");
-                    }
-                    break;
-                case 2:
-                    *pixelIntensity = strtol(buffer, NULL, 10); // On retourne la valeur de la ligne dans pixelIntensity en convertissant buffer (chaine de caractère) en long int grâce à la fonction strtol
-                    break;
+        if(y == 0 || y + 1 == nbLignes)
+            memset(couts, COUT_MAX_ADAPTATIF, (size_t) largeur);
+        else
+            calculerCoutsLigne(lignes[0], lignes[1], lignes[2], largeur, source->nbCanaux, couts);
 
-                default: // S'il y a plus de trois paramètres alors il y a une erreur.
-                    return ERROR_HANDLE;
+        for(x = 0, p = y * largeur; x < largeur; x++, p++) {
+            if(p < debut + largeur)
+                continue;
+            if(histogramme != NULL)
+                histogramme[couts[x]]++;
+            if(couts[x] <= seuil) {
+                if(table != NULL)
+                    (*table)[*nbPositions] = (int) p;
+                (*nbPositions)++;
             }
-
-            compteurLigne++;
         }
 
-        *positionCursor = ftell(image); // Position du curseur
-        fclose(image);   // On ferme le fichier
-        return ERROR_OK; // Pas d'erreurs on retourne la valeur normal
-
-    } else {
-        // Le fichier n'a pas pu s'ouvrir donc on retourne une erreur
-        return ERROR_OPEN;
+        lignes[0] = lignes[1];
+        lignes[1] = lignes[2];
     }
 
+    free(tampons);
+    free(couts);
+
+    return ERROR_OK;
 }
 
 
+int choisirSeuilAdaptatif(const long int* histogramme, long int tailleMsgBit, int hamming, unsigned int* seuil) {
 
-int fileToBinary(char* fileToCrypt,unsigned char** msgSecretBit, size_t *length) {
+    long int besoin = hamming ? (long int) pixelsSegmentsHamming(tailleMsgBit, 2, 0) : tailleMsgBit, cumul;
 
-    int i;
-    long fsize;
-    unsigned char *string;
+    while(1) {
+        cumul = 0;
+        for(*seuil = 0; *seuil <= COUT_MAX_ADAPTATIF; (*seuil)++) {
+            cumul += histogramme[*seuil];
+            if(cumul >= besoin)
+                return ERROR_OK;
+        }
 
-    FILE *f = fopen(fileToCrypt, "rb");
-    if(f == NULL)
-        return ERROR_OPEN;
+        // En Hamming, on se contente d'un pixel par bit (blocs d'une ligne en fin de message)
+        if(besoin == tailleMsgBit)
+            return ERROR_NOMEM;
+        besoin = tailleMsgBit;
+    }
+}
 
-    fseek(f, 0, SEEK_END);
-    fsize = ftell(f);
-    fseek(f, 0, SEEK_SET);  /* same as rewind(f); */
 
-    string = malloc(fsize + 1);
-    if(string == NULL)
-        return ERROR_NOMEM;
-    fread(string, 1, fsize, f);
-    fclose(f);
+int hideMessageAdaptatif(const unsigned char* messageBinary, size_t tailleMsgBit, int* matriceImage, const int* table, long int nbPositions, int hamming, unsigned int* compteurNbBitsModif) {
 
-    string[fsize] = 0;
+    unsigned int rows;
+    long int nbBlocsGrands;
+    size_t i;
+    int error;
 
-    *msgSecretBit = malloc(fsize*8+1);
-    if(msgSecretBit == NULL)
-        return ERROR_NOMEM;
-    char bits[8];
-    int k = 0, j=0;
-    for(i=0; i<fsize; i++) {
-        printbincharpad((char)string[i], bits);
+    *compteurNbBitsModif = 0;
 
+    if(hamming) {
+        error = determineSegmentsHamming(nbPositions, (long int) tailleMsgBit, &rows, &nbBlocsGrands);
+        if(error != ERROR_OK)
+            return error;
+        return insererBlocsHamming(messageBinary, tailleMsgBit, matriceImage, 0, NULL, table, rows, nbBlocsGrands, compteurNbBitsModif);
+    }
 
-        for (j = 0; j < 8; ++j) {
-            (*msgSecretBit)[k] = bits[j];
-            k++;
+    if((long int) tailleMsgBit > nbPositions)
+        return ERROR_NOMEM;
 
+    for(i = 0; i < tailleMsgBit; i++) {
+        if(((unsigned int) matriceImage[table[i]] & 1u) != messageBinary[i]) {
+            matriceImage[table[i]] ^= 1;
+            (*compteurNbBitsModif)++;
         }
     }
-    *length = k;
 
-    free(string);
     return ERROR_OK;
 }
 
 
+int listerCanaux(unsigned int masque, int profondeur, int canaux[CANAUX_MAX]) {
 
+    int c, nbCanaux = 0, selectionnables = profondeur < CANAUX_MAX ? profondeur : CANAUX_MAX;
+    unsigned int tous = (1u << selectionnables) - 1;
 
-/* Hamming */
-int determineBestHammingSize(unsigned int tailleImg, unsigned int tailleMsg, unsigned int* rows, unsigned int* columns) {
+    masque &= tous;
+    if(masque == 0 || masque == tous) {
+        for(c = 0; c < selectionnables; c++) {
+            canaux[c] = c;
+        }
+        return profondeur;
+    }
 
+    for(c = 0; c < selectionnables; c++) {
+        if(masque & (1u << c))
+            canaux[nbCanaux++] = c;
+    }
 
-    unsigned int capacity;
-    // On initialise la matrice de hamming la plus petite: rows=2 et columns=3
-    *rows = 2;
-    *columns =  (unsigned int)pow(2,(*rows)) - 1;
+    return nbCanaux;
+}
 
-    // On calcul la capacité
-    capacity = ( tailleImg / (*columns) ) * (*rows);
 
-    // Tant que la capacité est supérieur à la taille du message, alors on augmente de 1 le nombre de lignes et on recalcul le nombre de colonnes, tout en recalculant la capacité.
-    while(capacity > tailleMsg) {
-        (*rows)++;
-        *columns =  (unsigned int)pow(2,(*rows)) - 1;
-        capacity = ( tailleImg / (*columns) ) * (*rows);
+long int positionVueCanaux(long int position, unsigned int masque, int profondeur) {
+
+    int canaux[CANAUX_MAX], nbCanaux, j;
+    long int vue;
+
+    nbCanaux = listerCanaux(masque, profondeur, canaux);
+    if(nbCanaux == profondeur)
+        return position;
+
+    vue = (position / profondeur) * nbCanaux;
+    for(j = 0; j < nbCanaux; j++) {
+        if(canaux[j] < position % profondeur)
+            vue++;
     }
 
-    // Si la capacité est inférieur à la taille du message, alors on prend la matrice de hamming précédente, c'est à dire celle avec un nombre de lignes moins 1.
-    if(capacity < tailleMsg) {
-        (*rows)--;
-        *columns =  (unsigned int)pow(2,(*rows)) - 1;
+    return vue;
+}
+
+
+int lireMasqueComposantes(const char* saisie, int profondeur, unsigned int* masque) {
+
+    *masque = 0;
+
+    if(saisie == NULL)
+        return ERROR_OK;
+
+    for(; *saisie != '\0'; saisie++) {
+        if(*saisie == ' ' || *saisie == ',')
+            continue;
+        if(*saisie < '0' || *saisie - '0' >= profondeur || *saisie - '0' >= CANAUX_MAX)
+            return ERROR_INVARG;
+        *masque |= 1u << (*saisie - '0');
     }
 
+    // Toutes les composantes: pas de vue
+    if(profondeur <= CANAUX_MAX && *masque == (1u << profondeur) - 1)
+        *masque = 0;
+
     return ERROR_OK;
 }
 
-int isVectorNull(unsigned int **vector, unsigned int columns) {
 
+#if defined(__x86_64__)
+// shufps sur des entiers: 2 valeurs de a puis 2 valeurs de b
+#define MELANGER_EPI32(a, b, selection) _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), selection))
+#endif
 
-    int x,null=1;
-    for(x = 0; x < columns; x++) {
-        if(vector[0][x] != 0)
-            null = 0;
+void desentrelacerRGB(const int* rgb, long int nbPixels, int* rouge, int* vert, int* bleu) {
+
+    long int i = 0;
+
+#if defined(__x86_64__)
+    __m128i a, b, c, t0, t1, t2, u;
+
+    for(; i + 4 <= nbPixels; i += 4) {
+        // a = R0 G0 B0 R1, b = G1 B1 R2 G2, c = B2 R3 G3 B3
+        a = _mm_loadu_si128((const __m128i*) (rgb + 3 * i));
+        b = _mm_loadu_si128((const __m128i*) (rgb + 3 * i + 4));
+        c = _mm_loadu_si128((const __m128i*) (rgb + 3 * i + 8));
+
+        t0 = MELANGER_EPI32(a, b, _MM_SHUFFLE(3, 0, 3, 0)); // R0 R1 G1 G2
+        t1 = MELANGER_EPI32(a, c, _MM_SHUFFLE(2, 1, 2, 1)); // G0 B0 R3 G3
+        t2 = MELANGER_EPI32(b, c, _MM_SHUFFLE(3, 0, 2, 1)); // B1 R2 B2 B3
+
+        u = MELANGER_EPI32(t2, t1, _MM_SHUFFLE(2, 2, 1, 1)); // R2 R2 R3 R3
+        _mm_storeu_si128((__m128i*) (rouge + i), MELANGER_EPI32(t0, u, _MM_SHUFFLE(2, 0, 1, 0)));
+
+        u = MELANGER_EPI32(t1, t0, _MM_SHUFFLE(3, 2, 3, 0)); // G0 G3 G1 G2
+        _mm_storeu_si128((__m128i*) (vert + i), _mm_shuffle_epi32(u, _MM_SHUFFLE(1, 3, 2, 0)));
+
+        u = MELANGER_EPI32(t1, t2, _MM_SHUFFLE(0, 0, 1, 1)); // B0 B0 B1 B1
+        _mm_storeu_si128((__m128i*) (bleu + i), MELANGER_EPI32(u, t2, _MM_SHUFFLE(3, 2, 2, 0)));
     }
+#endif
 
-    return null;
+    for(; i < nbPixels; i++) {
+        rouge[i] = rgb[3 * i];
+        vert[i] = rgb[3 * i + 1];
+        bleu[i] = rgb[3 * i + 2];
+    }
 }
 
-int findInHamming(unsigned int **matriceHamming, unsigned int columns, unsigned int rows, unsigned int **matriceRes, unsigned int *position) {
-    int i,j;
-    unsigned int same;
 
-    if((columns>2)&&(rows>1)) {
-        for (i = 0; i < columns; i++) {
-            same = 1;
-            for (j = 0; j < rows; j++) {
-                if (matriceHamming[i][j] != matriceRes[0][j]) {
-                    same = 0;
-                }
-            }
-            if (same)
-                *position = i;
-        }
-        return ERROR_OK;
-    } else {
-        return ERROR_INVARG;
+void entrelacerRGB(const int* rouge, const int* vert, const int* bleu, long int nbPixels, int* rgb) {
+
+    long int i = 0;
+
+#if defined(__x86_64__)
+    __m128i r, g, b, p, q, u, v;
+
+    for(; i + 4 <= nbPixels; i += 4) {
+        r = _mm_loadu_si128((const __m128i*) (rouge + i));
+        g = _mm_loadu_si128((const __m128i*) (vert + i));
+        b = _mm_loadu_si128((const __m128i*) (bleu + i));
+
+        p = _mm_unpacklo_epi32(r, g); // R0 G0 R1 G1
+        q = _mm_unpackhi_epi32(r, g); // R2 G2 R3 G3
+
+        u = MELANGER_EPI32(b, p, _MM_SHUFFLE(2, 2, 0, 0)); // B0 B0 R1 R1
+        _mm_storeu_si128((__m128i*) (rgb + 3 * i), MELANGER_EPI32(p, u, _MM_SHUFFLE(2, 0, 1, 0)));
+
+        u = MELANGER_EPI32(p, b, _MM_SHUFFLE(1, 1, 3, 3)); // G1 G1 B1 B1
+        _mm_storeu_si128((__m128i*) (rgb + 3 * i + 4), MELANGER_EPI32(u, q, _MM_SHUFFLE(1, 0, 2, 0)));
+
+        u = MELANGER_EPI32(b, q, _MM_SHUFFLE(2, 2, 2, 2)); // B2 B2 R3 R3
+        v = MELANGER_EPI32(q, b, _MM_SHUFFLE(3, 3, 3, 3)); // G3 G3 B3 B3
+        _mm_storeu_si128((__m128i*) (rgb + 3 * i + 8), MELANGER_EPI32(u, v, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+#endif
+
+    for(; i < nbPixels; i++) {
+        rgb[3 * i] = rouge[i];
+        rgb[3 * i + 1] = vert[i];
+        rgb[3 * i + 2] = bleu[i];
     }
 }
 
 
+// Entrelace deux plans: x0 y0 x1 y1 ...
+static void entrelacerPaire(const int* x, const int* y, long int nombre, int* paires) {
 
-void additionMatrice(unsigned int m, unsigned int n, unsigned int** mat1, unsigned int** mat2, unsigned int*** res)
-{
-    unsigned int i, j;
-    for(i=0;i<m;i++)
-        for(j=0;j<n;j++)
-            (*res)[i][j] = (mat1[i][j] + mat2[i][j]) % 2 ;
+    long int i = 0;
+
+#if defined(__x86_64__)
+    __m128i a, b;
+
+    for(; i + 4 <= nombre; i += 4) {
+        a = _mm_loadu_si128((const __m128i*) (x + i));
+        b = _mm_loadu_si128((const __m128i*) (y + i));
+        _mm_storeu_si128((__m128i*) (paires + 2 * i), _mm_unpacklo_epi32(a, b));
+        _mm_storeu_si128((__m128i*) (paires + 2 * i + 4), _mm_unpackhi_epi32(a, b));
+    }
+#endif
 
+    for(; i < nombre; i++) {
+        paires[2 * i] = x[i];
+        paires[2 * i + 1] = y[i];
+    }
 }
 
 
-void multiplyMatrice(unsigned int m2, unsigned int** mat1, unsigned int n1, unsigned int n2, unsigned int** mat2, unsigned int*** res)
-{
-    int k, i, j;
+// Opération inverse de entrelacerPaire
+static void desentrelacerPaire(const int* paires, long int nombre, int* x, int* y) {
 
-    for(i = 0; i<n1; i++) {
-        for(j = 0; j < m2; j++) {
-            (*res)[i][j] = 0;
-            for(k=0; k<n2; k++) {
-                (*res)[i][j] +=  ((mat1[k][j]*((mat2[i][k] & ( 1u << 0u)) >> 0u) ) );
+    long int i = 0;
 
-            }
-            (*res)[i][j] %= 2;
-        }
+#if defined(__x86_64__)
+    __m128i a, b;
+
+    for(; i + 4 <= nombre; i += 4) {
+        a = _mm_loadu_si128((const __m128i*) (paires + 2 * i));
+        b = _mm_loadu_si128((const __m128i*) (paires + 2 * i + 4));
+        _mm_storeu_si128((__m128i*) (x + i), MELANGER_EPI32(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_si128((__m128i*) (y + i), MELANGER_EPI32(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
     }
+#endif
 
+    for(; i < nombre; i++) {
+        x[i] = paires[2 * i];
+        y[i] = paires[2 * i + 1];
+    }
 }
 
 
-int genererHamming(unsigned int*** hamming, unsigned int r, unsigned int c) {
+int extraireVueCanaux(const int* matriceImage, long int dimension, int profondeur, unsigned int masque, int** vue, long int* dimensionVue) {
 
-    (*hamming) = (unsigned int **)calloc(c , sizeof(int *));         //Création d'un pointeur => tableau 1 colonne
-    if((*hamming) == NULL)
+    int canaux[CANAUX_MAX], nbCanaux, *plans, j;
+    long int nbPixels = dimension / profondeur, i;
+
+    nbCanaux = listerCanaux(masque, profondeur, canaux);
+    if(nbCanaux < profondeur && dimension % profondeur != 0)
+        return ERROR_INVARG;
+
+    *dimensionVue = positionVueCanaux(dimension, masque, profondeur);
+    *vue = (int*) malloc((size_t) ((*dimensionVue) > 0 ? (*dimensionVue) : 1) * sizeof(int));
+    if(*vue == NULL)
         return ERROR_NOMEM;
 
-    for (int i = 0; i < c; i++) {                           //Pour chacune des lignes de ce tableau
-        (*hamming)[i] = (unsigned int *) calloc(r, sizeof(int));     //On malloc le nombre de colonnes que l'on veut
-        if((*hamming)[i] == NULL)
-            return ERROR_NOMEM;
+    if(nbCanaux == profondeur) {
+        memcpy(*vue, matriceImage, (size_t) dimension * sizeof(int));
+        return ERROR_OK;
     }
 
-    int count;                                              //Variable qui permet de calculer le binaire
-    for (int j = 1; j <= c; j++) {                          //On commence à 1 pour pouvoir convertir chaque numéro de colonne en binaire (sauf la colonne 0 => 0 en binaire)
-        count = j;                                          //Pour ne pas modifier le comptage de boucle, on l'attribue à count
-        for (int i = 0; i < r; i++) {                       //Pour chaque ligne
-            if (count > 0) {                                //Tant que le chiffre convertit en binaire est > 0
-                (*hamming)[j-1][i] = count % 2;             //On donne son binaire correspondant à au bit de la ligne
-                count /= 2;
+    // Autre profondeur que RGB (PAM): copie composante par composante
+    if(profondeur != 3) {
+        for(i = 0; i < nbPixels; i++) {
+            for(j = 0; j < nbCanaux; j++) {
+                (*vue)[i * nbCanaux + j] = matriceImage[i * profondeur + canaux[j]];
             }
         }
+        return ERROR_OK;
     }
 
-    return ERROR_OK;
-}
-
+    plans = (int*) malloc((size_t) (nbPixels > 0 ? 3 * nbPixels : 1) * sizeof(int));
+    if(plans == NULL) {
+        free(*vue);
+        *vue = NULL;
+        return ERROR_NOMEM;
+    }
 
-/* UI */
+    desentrelacerRGB(matriceImage, nbPixels, plans, plans + nbPixels, plans + 2 * nbPixels);
+    if(nbCanaux == 1)
+        memcpy(*vue, plans + canaux[0] * nbPixels, (size_t) nbPixels * sizeof(int));
+    else
+        entrelacerPaire(plans + canaux[0] * nbPixels, plans + canaux[1] * nbPixels, nbPixels, *vue);
 
+    free(plans);
 
-long reponseMenu(int choixMax) {
+    return ERROR_OK;
+}
 
-    long resultUser = 0;
-    printf("> ");
 
-    char *ptr;
-    char str[10];
+int reinsererVueCanaux(int* matriceImage, long int dimension, int profondeur, unsigned int masque, const int* vue) {
 
-    // Ce code permet de récuperer un entier saisit par l'utilisateur et en verifiant le type et la taille. (Contrairement à scanf)
-    size_t len;
-    do {
-        fgets(str, 2, stdin);
-        len = strlen(str) ;
-    } while ( len > 1 && str[len-1] != '\n');
-    resultUser = strtol(str, &ptr, 10);
+    int canaux[CANAUX_MAX], nbCanaux, *plans, j;
+    long int nbPixels = dimension / profondeur, i;
 
-    // On vérifie si l'utilisateur à bien rentré un resultat qui rentre bien dans le type long et qui n'est pas null.
-    if( resultUser == LONG_MAX || resultUser == LONG_MIN || !resultUser) {
-        return -1;
+    nbCanaux = listerCanaux(masque, profondeur, canaux);
+    if(nbCanaux == profondeur) {
+        memcpy(matriceImage, vue, (size_t) dimension * sizeof(int));
+        return ERROR_OK;
     }
+    if(dimension % profondeur != 0)
+        return ERROR_INVARG;
 
+    if(profondeur != 3) {
+        for(i = 0; i < nbPixels; i++) {
+            for(j = 0; j < nbCanaux; j++) {
+                matriceImage[i * profondeur + canaux[j]] = vue[i * nbCanaux + j];
+            }
+        }
+        return ERROR_OK;
+    }
 
-    // On vide le buffer du \n final
-    viderBuffer();
+    plans = (int*) malloc((size_t) (nbPixels > 0 ? 3 * nbPixels : 1) * sizeof(int));
+    if(plans == NULL)
+        return ERROR_NOMEM;
 
-    // Si ce qu'a rentré l'utilisateur ne correspond pas au choix max alors on retourne -1
-    if((resultUser > choixMax) || (resultUser < 1))
-        return -1;
+    // Les canaux non sélectionnés sont repris de l'image, les autres de la vue
+    desentrelacerRGB(matriceImage, nbPixels, plans, plans + nbPixels, plans + 2 * nbPixels);
+    if(nbCanaux == 1)
+        memcpy(plans + canaux[0] * nbPixels, vue, (size_t) nbPixels * sizeof(int));
+    else
+        desentrelacerPaire(vue, nbPixels, plans + canaux[0] * nbPixels, plans + canaux[1] * nbPixels);
+    entrelacerRGB(plans, plans + nbPixels, plans + 2 * nbPixels, nbPixels, matriceImage);
 
-    return resultUser;
+    free(plans);
 
+    return ERROR_OK;
 }
 
-void li(int position, char* text) {
-    printf("[%d] %s\n", position, text);
-}
 
-void p(const char* text) {
+void vueCanauxSource(sourceImage_t* source, unsigned int masque) {
 
-    printf("\n");
-    printf("    %s", text);
-    printf("\n\n");
+    int canaux[CANAUX_MAX] = {0}, nbCanaux, c;
+
+    nbCanaux = listerCanaux(masque, source->nbCanaux, canaux);
 
+    source->masqueCanaux = nbCanaux == source->nbCanaux ? 0 : masque;
+    source->nbCanauxVue = nbCanaux == source->nbCanaux ? 0 : nbCanaux;
+    for(c = 0; c < CANAUX_MAX; c++) {
+        source->canauxVue[c] = canaux[c];
+    }
 }
 
+
 void h1(char* text) {
     printf("\n==================================================\n");
 